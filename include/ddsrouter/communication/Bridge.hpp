@@ -19,12 +19,16 @@
 #ifndef _DDSROUTER_COMMUNICATION_BRIDGE_HPP_
 #define _DDSROUTER_COMMUNICATION_BRIDGE_HPP_
 
+#include <chrono>
 #include <mutex>
+#include <set>
 
 #include <ddsrouter/communication/Track.hpp>
 #include <ddsrouter/participant/IParticipant.hpp>
 #include <ddsrouter/participant/ParticipantsDatabase.hpp>
+#include <ddsrouter/types/endpoint/Endpoint.hpp>
 #include <ddsrouter/types/participant/ParticipantId.hpp>
+#include <ddsrouter/types/Time.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
@@ -36,6 +40,10 @@ namespace ddsrouter {
  *
  * It contains N \c Tracks that will manage each direction of the communication,
  * being N the number of Participants of this communication channel.
+ *
+ * With interest driven endpoints, the Participants that discover endpoints only have a Reader while they have
+ * discovered a remote Writer of the topic, and only have a Writer while they have discovered a remote Reader.
+ * Thus, they only have a \c Track while they have a Reader.
  */
 class Bridge
 {
@@ -45,25 +53,34 @@ public:
      * Bridge constructor by required values
      *
      * In Bridge construction, the inside \c Tracks are created.
-     * In Bridge construction, a Writer and a Reader are created for each Participant.
+     * In Bridge construction, a Writer and a Reader are created for each Participant, except for the Participants
+     * that discover endpoints if \c interest_driven is set. Their endpoints are created by \c update_remote_endpoint .
      *
      * @param topic: Topic of which this Bridge manages communication
      * @param participant_database: Collection of Participants to manage communication
+     * @param payload_pools: Payload pool of each Participant, used by its Reader and Writer
+     * @param thread_pool: Thread pool shared by every Track where transmission is executed
+     * @param specs: Specifications of how the data of \c topic is handled
      * @param enable: Whether the Bridge should be initialized as enabled
+     * @param interest_driven: Whether the endpoints of the Participants that discover endpoints are created on demand
      *
-     * @throw InitializationException in case \c IWriters or \c IReaders creation fails.
+     * @throw InitializationException in case \c IWriters or \c IReaders creation fails, or if \c specs is zero
+     * copy and the data of some Participant would be copied to be sent by other.
      */
     Bridge(
             const RealTopic& topic,
             std::shared_ptr<ParticipantsDatabase> participants_database,
-            std::shared_ptr<PayloadPool> payload_pool,
-            bool enable = false);
+            const std::map<ParticipantId, std::shared_ptr<PayloadPool>>& payload_pools,
+            std::shared_ptr<SlotThreadPool> thread_pool,
+            const TopicSpecs& specs,
+            bool enable = false,
+            bool interest_driven = false);
 
     /**
      * @brief Destructor
      *
      * Before deleting, it calls \c disable.
-     * It deletes all the tracks created and all Writers and Readers.
+     * It deletes all the tracks created and all Writers and Readers that exist.
      */
     virtual ~Bridge();
 
@@ -91,8 +108,86 @@ public:
      */
     void disable() noexcept;
 
+    //! Statistics of the Track of each Participant
+    std::map<ParticipantId, TrackStatistics> tracks_statistics() const noexcept;
+
+    /**
+     * @brief Update a remote endpoint of the topic discovered by a Participant
+     *
+     * With interest driven endpoints, the Reader of the discoverer Participant is created with its first remote
+     * Writer active, and its Writer with its first remote Reader active.
+     * Once the last of them is inactive, the endpoint becomes idle and it is deleted by \c remove_idle_endpoints .
+     *
+     * It does nothing if the Bridge is not interest driven or the discoverer Participant does not discover endpoints.
+     *
+     * Thread safe
+     *
+     * @param endpoint: remote endpoint added, updated or inactive
+     */
+    void update_remote_endpoint(
+            const Endpoint& endpoint) noexcept;
+
+    /**
+     * @brief Delete the endpoints created on demand that have been idle for \c grace_period or longer
+     *
+     * Thread safe
+     *
+     * @param grace_period: time in milliseconds an endpoint is kept without remote endpoints before deleting it
+     */
+    void remove_idle_endpoints(
+            Duration_ms grace_period) noexcept;
+
 protected:
 
+    /**
+     * @brief Whether the endpoints of Participant \c id are created on demand
+     *
+     * WAN and Discovery Server Participants connect with other routers, so their endpoints are always created.
+     * Otherwise, two routers would wait for each other to create their endpoints first.
+     */
+    bool interest_driven_participant_(
+            const ParticipantId& id) const noexcept;
+
+    /**
+     * @brief Create the Reader of Participant \c id and its Track, that writes in every Writer of other Participants
+     *
+     * @throw InitializationException in case the Reader creation fails.
+     */
+    void create_reader_(
+            const ParticipantId& id);
+
+    /**
+     * @brief Create the Writer of Participant \c id and add it to the Tracks of other Participants
+     *
+     * @throw InitializationException in case the Writer creation fails.
+     */
+    void create_writer_(
+            const ParticipantId& id);
+
+    //! Delete the Track of Participant \c id and its Reader
+    void delete_reader_(
+            const ParticipantId& id) noexcept;
+
+    //! Remove the Writer of Participant \c id from every Track and delete it
+    void delete_writer_(
+            const ParticipantId& id) noexcept;
+
+    /**
+     * @brief Whether the data of this topic can be forwarded by the thread of the Reader that receives it
+     *
+     * It is only possible when the Writers are written directly, without egress queues, and no payload pool waits
+     * for memory. Otherwise, the thread receiving data could block waiting for other threads to send or release data.
+     */
+    bool inline_forwarding_supported_() const noexcept;
+
+    /**
+     * @brief Check every Participant in \c ids references the data received by the rest of them
+     *
+     * @throw InitializationException if the data of some Participant would be copied to be sent by other.
+     */
+    void check_zero_copy_(
+            const std::set<ParticipantId>& ids) const;
+
     /**
      * Topic of which this Bridge manages communication
      *
@@ -107,8 +202,14 @@ protected:
      */
     const std::shared_ptr<ParticipantsDatabase> participants_;
 
-    //! Common shared payload pool
-    std::shared_ptr<PayloadPool> payload_pool_;
+    //! Payload pool of each Participant, shared with the rest of Participants of its NUMA node
+    std::map<ParticipantId, std::shared_ptr<PayloadPool>> payload_pools_;
+
+    //! Common shared thread pool
+    std::shared_ptr<SlotThreadPool> thread_pool_;
+
+    //! Specifications of how the data of \c topic_ is handled
+    TopicSpecs specs_;
 
     /**
      * Inside \c Tracks
@@ -119,14 +220,43 @@ protected:
     //! One writer for each Participant, indexed by \c ParticipantId of the Participant the writer belongs to
     std::map<ParticipantId, std::shared_ptr<IWriter>> writers_;
 
+    /**
+     * Writers used by the Tracks, indexed by \c ParticipantId of the Participant the writer belongs to
+     *
+     * They are the same as \c writers_ , or a \c QueuedWriter over them when \c specs_ sets an egress queue
+     * or parallel fan-out.
+     */
+    std::map<ParticipantId, std::shared_ptr<IWriter>> egress_writers_;
+
+    //! Size of the egress queue of each Writer, 0 if the Tracks write directly in the Writers
+    unsigned int egress_queue_size_;
+
+    //! Size of the egress queues used for parallel fan-out when the topic does not set it
+    static constexpr unsigned int DEFAULT_FANOUT_QUEUE_SIZE_ = 32;
+
     //! One reader for each Participant, indexed by \c ParticipantId of the Participant the reader belongs to
     std::map<ParticipantId, std::shared_ptr<IReader>> readers_;
 
+    //! Whether the endpoints of the Participants that discover endpoints are created on demand
+    const bool interest_driven_;
+
+    //! Remote Writers active discovered by each Participant
+    std::map<ParticipantId, std::set<Guid>> remote_writers_;
+
+    //! Remote Readers active discovered by each Participant
+    std::map<ParticipantId, std::set<Guid>> remote_readers_;
+
+    //! Time since the Reader of each Participant has no remote Writer, for Readers created on demand
+    std::map<ParticipantId, std::chrono::steady_clock::time_point> idle_readers_;
+
+    //! Time since the Writer of each Participant has no remote Reader, for Writers created on demand
+    std::map<ParticipantId, std::chrono::steady_clock::time_point> idle_writers_;
+
     //! Whether the Bridge is currently enabled
     bool enabled_;
 
-    //! Mutex to prevent simultaneous calls to enable and/or disable
-    std::recursive_mutex mutex_;
+    //! Mutex to prevent simultaneous calls to enable and/or disable, and to guard the endpoints created on demand
+    mutable std::recursive_mutex mutex_;
 
     // Allow operator << to use private variables
     friend std::ostream& operator <<(
@@ -20,17 +20,34 @@
 #define _DDSROUTER_COMMUNICATION_TRACK_HPP_
 
 #include <atomic>
-#include <condition_variable>
 #include <mutex>
-#include <thread>
+#include <vector>
 
+#include <ddsrouter/communication/thread_pool/SlotThreadPool.hpp>
 #include <ddsrouter/participant/IParticipant.hpp>
 #include <ddsrouter/reader/IReader.hpp>
+#include <ddsrouter/types/topic/TopicSpecs.hpp>
 #include <ddsrouter/writer/IWriter.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
 
+//! Number of payloads a \c Track has given to its Writers, by whether they have referenced, copied or dropped the data
+struct TrackStatistics
+{
+    //! Payloads written referencing the data received by the Reader
+    uint64_t referenced_payloads = 0;
+
+    //! Payloads written copying the data received by the Reader to other payload pool
+    uint64_t copied_payloads = 0;
+
+    //! Payloads not given to a Writer because it had no remote readers, if the topic skips them
+    uint64_t skipped_payloads = 0;
+
+    //! Payloads a Writer did not send because its history was full of data not acknowledged (KEEP_ALL)
+    uint64_t dropped_payloads = 0;
+};
+
 /**
  * Track object manages the communication between one \c IReader as entry point of data and N
  * \c IWriter that will send forward the data received.
@@ -42,26 +59,32 @@ public:
     /**
      * Track constructor by required values.
      *
-     * Track construction creates a new thread that manages the transmission between the reader and the writers.
+     * Track construction registers the transmission between the reader and the writers as a slot of
+     * \c thread_pool , that will be executed by the pool threads every time new data arrives.
      *
-     * @param topic:    Topic that this Track manages communication
-     * @param reader:   Reader that will receive the remote data
-     * @param writers:  Map of Writers that will send the data received by \c source indexed by Participant id
-     * @param enable:   Whether the \c Track should be initialized as enabled. False by default
+     * @param topic:        Topic that this Track manages communication
+     * @param reader:       Reader that will receive the remote data
+     * @param writers:      Map of Writers that will send the data received by \c source indexed by Participant id
+     * @param payload_pools: Payload pool of each Participant, the one of the Reader keeps the data received
+     * @param thread_pool:  Thread pool shared by every Track where transmission is executed
+     * @param specs:        Specifications of how the data of \c topic is handled
+     * @param enable:       Whether the \c Track should be initialized as enabled. False by default
      */
     Track(
             const RealTopic& topic,
             ParticipantId reader_participant_id,
             std::shared_ptr<IReader> reader,
             std::map<ParticipantId, std::shared_ptr<IWriter>>&& writers,
-            std::shared_ptr<PayloadPool> payload_pool,
+            const std::map<ParticipantId, std::shared_ptr<PayloadPool>>& payload_pools,
+            std::shared_ptr<SlotThreadPool> thread_pool,
+            const TopicSpecs& specs,
             bool enable = false) noexcept;
 
     /**
      * @brief Destructor
      *
      * It unsets the callback from Reader.
-     * It should stop and wait for the transmission thread.
+     * It unregisters the transmission slot from the thread pool, waiting for it to finish if it is being executed.
      * It must not destroy any entity as it does not create them.
      */
     virtual ~Track();
@@ -93,6 +116,41 @@ public:
      */
     void disable() noexcept;
 
+    /**
+     * @brief Add a Writer to send the data received
+     *
+     * It waits for the current transmission, if any, to finish.
+     * The Writer is enabled if the Track is enabled.
+     *
+     * Thread safe
+     *
+     * @param writer_participant_id: Id of the Participant of the Writer
+     * @param writer:       Writer to add. Nothing is done if the Track already has a Writer of this Participant
+     */
+    void add_writer(
+            ParticipantId writer_participant_id,
+            std::shared_ptr<IWriter> writer) noexcept;
+
+    /**
+     * @brief Stop sending the data received through the Writer of a Participant
+     *
+     * It waits for the current transmission, if any, to finish, so the Writer is not used once this returns.
+     * The Writer is not disabled, as it may be used by other Tracks.
+     *
+     * Thread safe
+     *
+     * @param writer_participant_id: Id of the Participant of the Writer to remove
+     */
+    void remove_writer(
+            ParticipantId writer_participant_id) noexcept;
+
+    /**
+     * @brief Payloads written by this Track, referenced and copied, and payloads skipped.
+     *
+     * It does not take any lock, so it can be called while the Track is transmitting.
+     */
+    TrackStatistics statistics() const noexcept;
+
 protected:
 
     /*
@@ -121,7 +179,11 @@ protected:
      *
      * This method is sent to the Reader so it could call it when there is new data.
      *
-     * This method will set the variable \c data_available_status_ to \c NEW_DATA_ARRIVED and awake the transmit thread.
+     * This method will set the variable \c data_available_status_ to \c NEW_DATA_ARRIVED without locking any
+     * mutex. Only if the status was \c NO_MORE_DATA (transmission parked) the transmission slot is emitted in the
+     * thread pool, so the thread pool is not touched while the Track is already draining the Reader.
+     * If the topic is forwarded inline, the transmission is executed in the thread calling this callback, that
+     * forwards a single batch and hands off the rest of the data to the pool.
      * If Track is disabled, the callback will be lost.
      */
     void data_available_() noexcept;
@@ -143,10 +205,13 @@ protected:
      * set \c data_available_status_ the Listener could notify new data (it is not possible to guard this
      * behaviour as no shared mutex could be locked in transmit and listen because of FastDDS Reader mutex taken
      * while \c on_data_available callback). If this happens, it should not be set as NO_DATA, but as new data.
-     * If this happens, the transmit thread will stop transmit loop, it will arrive to wait and it will automatically
-     * exit it as there is actual data to be sent, so there is no case where it gets stopped with new data available.
+     * If this happens, the Listener has not emitted the transmission slot, so \c transmit_ must keep transmitting
+     * and there is no case where it gets stopped with new data available.
+     *
+     * @return true if the status has changed to \c NO_MORE_DATA
+     * @return false if new data has arrived meanwhile
      */
-    void no_more_data_available_() noexcept;
+    bool no_more_data_available_() noexcept;
 
     /**
      * Whether this Track is enabled
@@ -156,24 +221,53 @@ protected:
     bool should_transmit_() noexcept;
 
     /**
-     * Main function of Track.
-     * It waits for data to be available
-     * Once there is data available, call \c transmit_ till there is no data to be forwarded, and turn back to read
+     * @brief Busy wait for new data during the spin budget of the topic
+     *
+     * It polls \c data_available_status_ , that the Reader Listener sets to \c NEW_DATA_ARRIVED without emitting
+     * the transmission slot while the Track is transmitting. This way, data arriving meanwhile is forwarded
+     * by the same thread without waking any other.
      *
-     * Transmission is not executed in case track must be terminated or is not enabled.
+     * @return true if new data has arrived before \c TopicSpecs::spin_budget has passed
+     * @return false otherwise, or if the Track is disabled
      */
-    void transmit_thread_function_() noexcept;
+    bool spin_for_data_() const noexcept;
 
     /**
      * Take data from the Reader \c source and send this data through every writer in \c targets .
      *
-     * When no more data is available, call \c no_more_data_available_ and exit.
+     * This is the task executed by the thread pool every time the Track slot is emitted.
      *
-     * It could exit without having finished transmitting all the data if track should terminate or track becomes
-     * disabled.
+     * If the topic skips Writers without remote readers, the data is not stored in their histories.
+     *
+     * Data is taken from the Reader in batches of up to \c TAKE_BATCH_SIZE_ samples.
+     * When no more data is available, wait for new data during the topic spin budget (if any), and if none arrives,
+     * call \c no_more_data_available_ and exit.
+     * In order not to starve other Tracks sharing the pool, it exits after \c MAX_TRANSMISSIONS_PER_TASK_
+     * messages, emitting the slot again so the rest of the data is sent in a later execution.
+     * Each failed take counts as a message, so a Reader that keeps failing does not hold the thread either.
+     * When executed inline by the thread of the Reader, it forwards a single batch without spinning, and emits the
+     * slot if there may be more data.
+     *
+     * It could exit without having finished transmitting all the data if track becomes disabled.
      */
     void transmit_() noexcept;
 
+    /**
+     * @brief Count a data written by the Writer of \c writer_participant_id as referenced or copied
+     *
+     * It compares the payload operations of this thread with the ones taken before writing, so it counts what the
+     * payload pools have actually done. A copy is logged as an error if the topic is zero copy.
+     */
+    void count_payload_operations_(
+            const ParticipantId& writer_participant_id,
+            const PayloadPool::PayloadOperations& operations_before) noexcept;
+
+    //! Maximum number of messages transmitted in a single execution of \c transmit_
+    static constexpr unsigned int MAX_TRANSMISSIONS_PER_TASK_ = 128;
+
+    //! Maximum number of messages taken from the Reader at once
+    static constexpr unsigned int TAKE_BATCH_SIZE_ = 32;
+
     /**
      * @brief Id of the Participant of the Reader
      *
@@ -194,9 +288,30 @@ protected:
     //! Writers that will send data forward
     std::map<ParticipantId, std::shared_ptr<IWriter>> writers_;
 
-    //! Common shared payload pool
+    //! Payload pool of the Participant of the Reader
     std::shared_ptr<PayloadPool> payload_pool_;
 
+    //! Payloads written referencing the data received, as observed in the payload pools
+    std::atomic<uint64_t> referenced_payloads_;
+
+    //! Payloads written copying the data received, as observed in the payload pools
+    std::atomic<uint64_t> copied_payloads_;
+
+    //! Payloads not written because the Writer had no remote readers
+    std::atomic<uint64_t> skipped_payloads_;
+
+    //! Payloads not written because the Writer history was full of data not acknowledged
+    std::atomic<uint64_t> dropped_payloads_;
+
+    //! Common shared thread pool where transmission is executed
+    std::shared_ptr<SlotThreadPool> thread_pool_;
+
+    //! Id of the slot registered in \c thread_pool_ to execute \c transmit_
+    TaskId transmit_slot_id_;
+
+    //! Specifications of how the data of \c topic_ is handled
+    TopicSpecs specs_;
+
     //! Whether the Track is currently enabled
     std::atomic<bool> enabled_;
 
@@ -207,17 +322,7 @@ protected:
     std::recursive_mutex track_mutex_;
 
     /////
-    // Transmit thread part
-
-    /**
-     * Whether the Track must terminate
-     *
-     * This variable is only set in destruction. It forces \c transmit_thread_ to stop even if it is
-     * transmitting data.
-     *
-     * As it is only set in destruction, it is not protected by any mutex
-     */
-    std::atomic<bool> exit_;
+    // Transmit part
 
     /**
      * Current status of the data available
@@ -227,30 +332,23 @@ protected:
      * \c TRANSMITTING_DATA : Track is currently taking data, so there may or may not be data available
      * \c NO_MORE_DATA      : Track has received a NO_DATA from Reader
      *
-     * This variable is protected by \c data_available_mutex_
+     * This variable is not protected by any mutex. The transitions that depend on the current value are atomic
+     * operations, so the Reader Listener never blocks with the transmission.
      */
     std::atomic<DataAvailableStatus> data_available_status_;
 
     /**
-     * Condition variable to wait for new data available or track termination.
-     */
-    std::condition_variable data_available_condition_variable_;
-
-    /**
-     * Mutex to handle access to condition variable \c data_available_condition_variable_ .
-     * Mutex to manage access to variable \c data_available_status_ .
-     */
-    std::mutex data_available_mutex_;
-
-    /**
-     * Thread that will manage the transmission of the data
+     * Mutex to guard while the Track is sending a message.
      */
-    std::thread transmit_thread_;
+    std::mutex on_transmission_mutex_;
 
     /**
-     * Mutex to guard while the Track is sending a message.
+     * Samples taken from the Reader in the current batch.
+     *
+     * It is only accessed from \c transmit_ , that is never executed concurrently.
+     * It is kept between executions so its memory is reused.
      */
-    std::mutex on_transmission_mutex_;
+    std::vector<std::unique_ptr<DataReceived>> taken_data_;
 
     // Allow operator << to use private variables
     friend std::ostream& operator <<(
@@ -0,0 +1,70 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file ArenaPayloadPool.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_ARENAPAYLOADPOOL_HPP_
+#define _DDSROUTER_COMMUNICATION_ARENAPAYLOADPOOL_HPP_
+
+#include <memory>
+
+#include <ddsrouter/communication/payload_pool/MemoryArena.hpp>
+#include <ddsrouter/communication/payload_pool/SlabPayloadPool.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * @brief \c SlabPayloadPool whose memory blocks are carved from a single \c MemoryArena .
+ *
+ * The arena is mapped when the pool is created, optionally with huge pages and pre-faulted, so a large working set
+ * of data does not suffer from TLB misses nor page faults while forwarding.
+ * Blocks released are recycled by size class as in \c SlabPayloadPool , so they never return to the arena.
+ *
+ * Once the arena is exhausted, or if it could not be mapped, new blocks are allocated from the heap. These
+ * allocations are counted in \c arena_exhausted_allocations , and a warning is logged the first time.
+ * Data larger than the largest size class are always allocated from the heap, so \c max_size_class of the
+ * configuration must be as large as the largest data expected for every data to be carved from the arena.
+ */
+class ArenaPayloadPool : public SlabPayloadPool
+{
+public:
+
+    /**
+     * @brief Construct a new ArenaPayloadPool object
+     *
+     * It maps an arena of \c arena_size bytes with the \c huge_pages and \c prefault of the configuration.
+     * The blocks in \c preallocated_payloads of the configuration are carved from the arena in construction.
+     *
+     * @param configuration : configuration of the pool
+     */
+    ArenaPayloadPool(
+            const PayloadPoolConfiguration& configuration = PayloadPoolConfiguration());
+
+    //! Arena the blocks are carved from
+    const MemoryArena& arena() const noexcept;
+
+protected:
+
+    //! Arena the blocks are carved from. It is kept alive by the depot while any block may be in use
+    std::shared_ptr<MemoryArena> arena_;
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_ARENAPAYLOADPOOL_HPP_ */
@@ -50,6 +50,10 @@ public:
     //! Release data in \c payload
     bool release_payload(
             Payload& payload) override;
+
+    //! This pool never references data, not even its own
+    bool references_data_of(
+            const IPayloadPool* data_owner) const noexcept override;
 };
 
 } /* namespace ddsrouter */
@@ -0,0 +1,120 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file FixedSizeFreeList.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_FIXEDSIZEFREELIST_HPP_
+#define _DDSROUTER_COMMUNICATION_FIXEDSIZEFREELIST_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * @brief Lock free list of memory blocks of the same size.
+ *
+ * Every block is carved in construction from a single memory region, so getting and giving back a block is a
+ * single compare and swap, without any call to the heap.
+ * The head of the list holds the index of the first free block along with a counter of the operations done, so
+ * a block taken and given back by another thread in the middle of an operation is detected (ABA problem).
+ *
+ * The region is freed when the list is destroyed, so every block must be given back before.
+ */
+class FixedSizeFreeList
+{
+public:
+
+    /**
+     * @brief Allocate \c count blocks of \c block_size bytes.
+     *
+     * Blocks are aligned to \c std::max_align_t .
+     *
+     * @param block_size : bytes of each block
+     * @param count : number of blocks
+     */
+    FixedSizeFreeList(
+            size_t block_size,
+            uint32_t count);
+
+    //! Free the region of the blocks
+    ~FixedSizeFreeList();
+
+    FixedSizeFreeList(
+            const FixedSizeFreeList&) = delete;
+
+    FixedSizeFreeList& operator =(
+            const FixedSizeFreeList&) = delete;
+
+    /**
+     * @brief Take a free block.
+     *
+     * @return pointer to the block, or nullptr if every block is in use
+     */
+    void* allocate() noexcept;
+
+    /**
+     * @brief Give back a block taken with \c allocate .
+     *
+     * @param block : block to give back. It must be contained in this list.
+     */
+    void free(
+            void* block) noexcept;
+
+    //! Whether \c block belongs to this list
+    bool contains(
+            const void* block) const noexcept;
+
+    //! Bytes of each block
+    size_t block_size() const noexcept;
+
+    //! Number of blocks
+    uint32_t count() const noexcept;
+
+protected:
+
+    //! Index that marks the end of the list
+    static constexpr uint32_t END_OF_LIST = UINT32_MAX;
+
+    //! Head of the list made of the index of the first free block and the number of operations done
+    static uint64_t make_head_(
+            uint32_t index,
+            uint32_t tag) noexcept;
+
+    //! First byte of the region, or nullptr if it could not be allocated
+    unsigned char* region_;
+
+    //! Bytes of each block, rounded up to keep the blocks aligned
+    size_t block_size_;
+
+    //! Number of blocks
+    uint32_t count_;
+
+    //! Index of the next free block of each free block
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;
+
+    //! Index of the first free block in its lower half and number of operations done in its upper half
+    std::atomic<uint64_t> head_;
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_FIXEDSIZEFREELIST_HPP_ */
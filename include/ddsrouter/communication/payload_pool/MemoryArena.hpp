@@ -0,0 +1,121 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file MemoryArena.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_MEMORYARENA_HPP_
+#define _DDSROUTER_COMMUNICATION_MEMORYARENA_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+#include <ddsrouter/types/numa.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * @brief Large memory region reserved at once, from which memory blocks are carved.
+ *
+ * The region is mapped in construction, optionally with huge pages to reduce the TLB misses of a large working set,
+ * and it can be pre-faulted so no page fault happens while forwarding data.
+ * It can be bound to a NUMA node, so its pages are allocated in the memory of that node.
+ * Blocks are carved consecutively and never given back to the arena: whoever gets them must recycle them.
+ * The whole region is unmapped when the arena is destroyed.
+ *
+ * If the region could not be mapped, the arena is empty and every allocation fails.
+ */
+class MemoryArena
+{
+public:
+
+    /**
+     * @brief Map a new region of \c size bytes.
+     *
+     * With \c huge_pages , explicit huge pages are tried first. If they are not available, normal pages are used
+     * and transparent huge pages are requested for the region.
+     *
+     * @param size : bytes of the region
+     * @param huge_pages : whether to back the region with huge pages
+     * @param prefault : whether to touch every page of the region in construction
+     * @param numa_node : NUMA node to bind the region to, or \c numa::NO_NUMA_NODE to let the system place it
+     */
+    MemoryArena(
+            size_t size,
+            bool huge_pages,
+            bool prefault,
+            int numa_node = numa::NO_NUMA_NODE);
+
+    //! Unmap the region. Every block carved from it becomes invalid
+    ~MemoryArena();
+
+    MemoryArena(
+            const MemoryArena&) = delete;
+
+    MemoryArena& operator =(
+            const MemoryArena&) = delete;
+
+    /**
+     * @brief Carve a block of \c size bytes from the region.
+     *
+     * It is lock free, and blocks are aligned to \c std::max_align_t .
+     *
+     * @return pointer to the block, or nullptr if the region is exhausted
+     */
+    void* allocate(
+            size_t size) noexcept;
+
+    //! Whether \c block has been carved from this arena
+    bool contains(
+            const void* block) const noexcept;
+
+    //! Bytes of the region mapped
+    size_t size() const noexcept;
+
+    //! Bytes of the region already carved
+    size_t used() const noexcept;
+
+    //! Whether the region is backed by explicit huge pages
+    bool huge_pages() const noexcept;
+
+protected:
+
+    //! Map the region with explicit huge pages if \c huge_pages , or with normal pages otherwise
+    bool map_(
+            size_t size,
+            bool huge_pages) noexcept;
+
+    //! Touch a byte of every page of the region, so they are backed by physical memory
+    void prefault_() noexcept;
+
+    //! First byte of the region, or nullptr if it could not be mapped
+    unsigned char* region_;
+
+    //! Bytes of the region mapped
+    size_t size_;
+
+    //! Bytes of the region already carved
+    std::atomic<size_t> used_;
+
+    //! Whether the region is backed by explicit huge pages
+    bool huge_pages_;
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_MEMORYARENA_HPP_ */
@@ -19,12 +19,19 @@
 #ifndef _DDSROUTER_COMMUNICATION_PAYLOADPOOL_HPP_
 #define _DDSROUTER_COMMUNICATION_PAYLOADPOOL_HPP_
 
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
 
 #include <fastdds/rtps/common/CacheChange.h>
 #include <fastdds/rtps/common/SerializedPayload.h>
 #include <fastdds/rtps/history/IPayloadPool.h>
 
+#include <ddsrouter/communication/payload_pool/PayloadPoolConfiguration.hpp>
+#include <ddsrouter/communication/payload_pool/PayloadPoolStatistics.hpp>
 #include <ddsrouter/types/Data.hpp>
 
 namespace eprosima {
@@ -47,7 +54,8 @@ class PayloadPool : public eprosima::fastrtps::rtps::IPayloadPool
 public:
 
     //! Construct an empty PayloadPool
-    PayloadPool();
+    PayloadPool(
+            const PayloadPoolConfiguration& configuration = PayloadPoolConfiguration());
 
     //! Delete PayloadPool and erase every Payload still without release
     virtual ~PayloadPool();
@@ -156,6 +164,7 @@ public:
      * This method "should" reuse data in \c src_payload and not copy it in case \c data_owner is \c this .
      *
      * @note This method may reserve new memory in case the owner is not \c this .
+     * The bytes reserved are given by \c copy_reserve_size_ , and \c max_size of \c target_payload is set to them.
      *
      * @param [in] src_payload     Payload to move to target
      * @param [in,out] data_owner      Payload pool owning incoming data \c src_payload
@@ -193,15 +202,126 @@ public:
     virtual bool release_payload(
             Payload& payload) = 0;
 
+    /**
+     * @brief Reserve in \c payload a new data of size \c size received by a Reader.
+     *
+     * It is called from the threads that receive the data (e.g. Fast DDS receive threads), so it never waits for
+     * memory: with \c MEMORY_BLOCK policy, a data that does not fit in the memory budget is rejected as with
+     * \c MEMORY_REJECT .
+     * The data of low priority topics is rejected before reserving any memory once \c low_priority_limit_reached .
+     *
+     * @param [in] size : Size in bytes of the payload that will be reserved
+     * @param [out] payload : the SerializedPayload that will be set
+     * @param [in] low_priority : whether the data belongs to a low priority topic
+     *
+     * @return true if the payload has been reserved
+     * @return false if the data has been rejected or something went wrong
+     */
+    bool get_ingress_payload(
+            uint32_t size,
+            Payload& payload,
+            bool low_priority);
+
+    /**
+     * @brief Store in \c target_payload the data \c src_payload received by a Reader.
+     *
+     * Same as \c get_payload , but the data is rejected as in \c get_ingress_payload when it must be copied.
+     * Data already in this pool is referenced even for low priority topics, as it does not reserve more memory.
+     */
+    bool get_ingress_payload(
+            const Payload& src_payload,
+            IPayloadPool*& data_owner,
+            Payload& target_payload,
+            bool low_priority);
+
     //! Wether every payload get has been released.
     virtual bool is_clean() const noexcept;
 
+    /**
+     * @brief Whether \c get_payload references the data owned by \c data_owner instead of copying it.
+     *
+     * This implementation references the data only if \c data_owner is \c this .
+     */
+    virtual bool references_data_of(
+            const IPayloadPool* data_owner) const noexcept;
+
+    /**
+     * @brief Current usage of this pool.
+     *
+     * It does not take any lock, so it can be called at any time while the pool is being used.
+     */
+    PayloadPoolStatistics statistics() const noexcept;
+
+    //! Payloads given by the \c get_payload calls of a thread, by whether the data has been referenced or copied
+    struct PayloadOperations
+    {
+        //! Payloads that reference a data already in a pool, including the deduplicated ones
+        uint64_t referenced = 0;
+
+        //! Payloads whose data has been copied
+        uint64_t copied = 0;
+    };
+
+    /**
+     * @brief Payloads referenced and copied so far by the calling thread in any pool.
+     *
+     * The difference between two calls is what the \c get_payload calls in between have actually done, e.g. the
+     * ones of a Writer sending a data.
+     */
+    static PayloadOperations thread_payload_operations() noexcept;
+
+    /////
+    // MEMORY BUDGET
+
+    //! Bytes currently reserved from this pool
+    uint64_t reserved_bytes() const noexcept;
+
+    /**
+     * @brief Whether the data of low priority topics must be discarded.
+     *
+     * This happens when the bytes reserved reach \c LOW_PRIORITY_BUDGET_RATIO of the memory budget, so the rest
+     * of the budget is left for the rest of topics.
+     */
+    bool low_priority_limit_reached() const noexcept;
+
+    //! Fraction of the memory budget from which the data of low priority topics are discarded
+    static constexpr double LOW_PRIORITY_BUDGET_RATIO = 0.8;
+
+    //! Whether reserving data may wait for memory to be released (\c MEMORY_BLOCK policy with a memory budget)
+    bool may_block() const noexcept;
+
+    /**
+     * @brief Function that releases a payload kept by its owner (e.g. a sample in a Writer history).
+     *
+     * It returns whether any payload has been released.
+     * It is called with \c MEMORY_EVICT policy when a data does not fit in the memory budget.
+     *
+     * @warning It is called from the thread reserving the data, so it must not block.
+     */
+    using MemoryReclaimer = std::function<bool()>;
+
+    /**
+     * @brief Register a function to release payloads when the memory budget is reached.
+     *
+     * @return id to unregister it
+     */
+    uint64_t register_memory_reclaimer(
+            MemoryReclaimer reclaimer);
+
+    /**
+     * @brief Unregister a function registered with \c register_memory_reclaimer .
+     *
+     * Once it returns, the function is not being called and will not be called anymore.
+     */
+    void unregister_memory_reclaimer(
+            uint64_t reclaimer_id);
+
 protected:
 
     /**
      * @brief Reserve a new space of memory for new data.
      *
-     * It increases \c reserve_count_ .
+     * It increases the reserve count and the size histogram.
      *
      * @param size size of memory chunk to reserve
      * @param payload object where introduce the new data pointer
@@ -216,7 +336,7 @@ protected:
     /**
      * @brief Free a memory space.
      *
-     * It increases \c release_count_ .
+     * It decreases \c live_payloads_ .
      *
      * @param payload object to free the data from
      *
@@ -228,16 +348,137 @@ protected:
     virtual bool release_(
             Payload& payload);
 
-    //! Increase \c reserve_count_
-    void add_reserved_payload_();
+    /**
+     * @brief Bytes to reserve to copy the data of \c src_payload , depending on the configured \c copy_size .
+     *
+     * Sources without length are reserved with their max size.
+     */
+    uint32_t copy_reserve_size_(
+            const Payload& src_payload) const noexcept;
 
-    //! Increase \c release_count_ . Show a warning if there are more releases than reserves.
+    /**
+     * @brief Account \c size bytes as reserved, if they fit in the memory budget.
+     *
+     * If they do not fit, the configured \c memory_policy is applied.
+     *
+     * @return true if the bytes have been accounted
+     * @return false if the bytes do not fit in the memory budget
+     */
+    bool reserve_bytes_(
+            uint64_t size);
+
+    //! Account \c size bytes as released, and wake up the threads waiting for memory
+    void release_bytes_(
+            uint64_t size) noexcept;
+
+    //! Account \c size bytes as reserved if they fit in the memory budget, without applying any policy
+    bool try_reserve_bytes_(
+            uint64_t size) noexcept;
+
+    //! Call the memory reclaimers till \c size bytes fit in the memory budget or nothing else is released
+    bool evict_for_bytes_(
+            uint64_t size);
+
+    //! Wait at most \c memory_block_timeout for \c size bytes to fit in the memory budget
+    bool wait_for_bytes_(
+            uint64_t size);
+
+    //! Increase \c live_payloads_ , and the reserve count and the bucket of \c size in the shard of this thread
+    void add_reserved_payload_(
+            uint32_t size);
+
+    //! Decrease \c live_payloads_ . Throw an exception if there are more releases than reserves.
     void add_release_payload_();
 
-    //! Count the number of reserved data from this pool
-    std::atomic<uint64_t> reserve_count_;
-    //! Count the number of released data from this pool
-    std::atomic<uint64_t> release_count_;
+    //! Increase the reference count in the shard of this thread
+    void add_referenced_payload_();
+
+    //! Increase the copy count in the shard of this thread
+    void add_copied_payload_();
+
+    //! Increase \c low_priority_rejected_count_
+    void add_low_priority_rejected_payload_();
+
+    //! Increase \c deduplicated_count_ and \c deduplicated_bytes_ by \c length
+    void add_deduplicated_payload_(
+            uint32_t length);
+
+    //! Size of a cache line, so values written by different threads are not placed in the same one
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    //! Number of shards of the counters updated in every reservation
+    static constexpr unsigned int NUMBER_OF_COUNTER_SHARDS = 16;
+
+    /**
+     * @brief Counters updated in every reservation, that are only read to get the statistics of the pool.
+     *
+     * Each thread updates the counters of a single shard, in cache lines of its own, so threads reserving data at
+     * the same time do not invalidate the lines of each other.
+     * The statistics add up the counters of every shard.
+     */
+    struct alignas(CACHE_LINE_SIZE) CounterShard
+    {
+        //! Count the number of reserved data
+        std::atomic<uint64_t> reserve_count {0};
+        //! Count the number of payloads that have referenced a data already in the pool
+        std::atomic<uint64_t> reference_count {0};
+        //! Count the number of payloads that have copied a data from other pool
+        std::atomic<uint64_t> copy_count {0};
+        //! Count the number of data reserved by size bucket
+        std::array<std::atomic<uint64_t>, PayloadPoolStatistics::NUMBER_OF_SIZE_BUCKETS> size_histogram {};
+    };
+
+    //! Shard of the counters updated by the calling thread
+    CounterShard& counter_shard_() noexcept;
+
+    //! Configuration of the pool
+    const PayloadPoolConfiguration configuration_;
+
+    //! Counters updated in every reservation, one shard per group of threads
+    std::array<CounterShard, NUMBER_OF_COUNTER_SHARDS> counter_shards_;
+
+    /**
+     * @brief Bytes currently reserved from this pool
+     *
+     * It must be exact to apply the memory budget, so it is not sharded. The values read or written along with it
+     * in every reservation and release share its cache line, and nothing else does.
+     */
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> reserved_bytes_;
+
+    //! Number of data currently reserved from this pool
+    std::atomic<uint64_t> live_payloads_;
+
+    //! Number of threads waiting for memory with \c MEMORY_BLOCK policy
+    std::atomic<uint32_t> memory_waiters_;
+
+    /**
+     * @brief Maximum bytes reserved at the same time from this pool
+     *
+     * It is only written by the reservations that exceed it, never by releases, so its cache line is kept apart.
+     */
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> max_reserved_bytes_;
+
+    //! Count the number of payloads that have referenced an identical data instead of storing their own
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> deduplicated_count_;
+    //! Count the bytes of data not stored thanks to deduplication
+    std::atomic<uint64_t> deduplicated_bytes_;
+    //! Count the number of data of low priority topics rejected before being reserved
+    std::atomic<uint64_t> low_priority_rejected_count_;
+
+    //! Functions to release payloads when the memory budget is reached
+    std::map<uint64_t, MemoryReclaimer> memory_reclaimers_;
+
+    //! Id of the next reclaimer registered
+    uint64_t next_reclaimer_id_;
+
+    //! Guard access to \c memory_reclaimers_ and the calls to them
+    std::mutex memory_reclaimers_mutex_;
+
+    //! Mutex for \c memory_released_cv_
+    std::mutex memory_released_mutex_;
+
+    //! Notified when memory is released and there are threads waiting for it
+    std::condition_variable memory_released_cv_;
 };
 
 } /* namespace ddsrouter */
@@ -0,0 +1,151 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadPoolConfiguration.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_PAYLOADPOOLCONFIGURATION_HPP_
+#define _DDSROUTER_COMMUNICATION_PAYLOADPOOLCONFIGURATION_HPP_
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+
+namespace eprosima {
+namespace ddsrouter {
+
+//! Implementations of \c PayloadPool available
+enum PayloadPoolKind
+{
+    //! \c MapPayloadPool : reference counters in a map guarded by a mutex
+    MAP_PAYLOAD_POOL,
+    //! \c RefCountPayloadPool : lock free reference counters in a header before each data
+    REFCOUNT_PAYLOAD_POOL,
+    //! \c SlabPayloadPool : lock free reference counters and data recycled by size class
+    SLAB_PAYLOAD_POOL,
+    //! \c ArenaPayloadPool : as \c SLAB_PAYLOAD_POOL with data carved from a single mapped memory region
+    ARENA_PAYLOAD_POOL
+};
+
+//! Bytes reserved to copy a data from a different pool
+enum PayloadCopySize
+{
+    //! Reserve the max size of the source payload
+    COPY_MAX_SIZE,
+    //! Reserve the length of the data
+    COPY_LENGTH,
+    //! Reserve the length of the data rounded up to the next power of two
+    COPY_SIZE_CLASS
+};
+
+//! Action taken when a data does not fit in the memory budget of the pool
+enum MemoryBudgetPolicy
+{
+    //! Fail the reservation, so the data is discarded
+    MEMORY_REJECT,
+    //! Remove samples from the Writers histories till the data fits
+    MEMORY_EVICT,
+    //! Wait for other data to be released, at most \c memory_block_timeout . The data received is rejected instead
+    MEMORY_BLOCK
+};
+
+/**
+ * Configuration of the \c PayloadPool shared by every Participant of a DDS Router.
+ *
+ * Every value not configured takes its default, that reproduces the behaviour of a router without it.
+ */
+struct PayloadPoolConfiguration
+{
+    //! Implementation of the pool
+    PayloadPoolKind kind = PayloadPoolKind::MAP_PAYLOAD_POOL;
+
+    //! Bytes reserved to copy a data from a different pool
+    PayloadCopySize copy_size = PayloadCopySize::COPY_MAX_SIZE;
+
+    //! Maximum bytes reserved at the same time. 0 means no limit
+    uint64_t memory_budget = 0;
+
+    //! Action taken when a data does not fit in \c memory_budget
+    MemoryBudgetPolicy memory_policy = MemoryBudgetPolicy::MEMORY_REJECT;
+
+    //! Maximum time in milliseconds waiting for memory with \c MEMORY_BLOCK policy
+    unsigned int memory_block_timeout = 10;
+
+    /**
+     * @brief Size of the largest size class, rounded up to a power of two. Only used by \c SLAB_PAYLOAD_POOL and its
+     * arena variant
+     *
+     * Larger data are allocated from and freed to the heap instead of being recycled or carved from the arena.
+     */
+    uint32_t max_size_class = 1u << 20;
+
+    //! Number of payloads allocated in advance for each size. Only used by \c SLAB_PAYLOAD_POOL and its arena variant
+    std::map<uint32_t, unsigned int> preallocated_payloads;
+
+    //! Bytes of the memory region mapped. Only used by \c ARENA_PAYLOAD_POOL
+    uint64_t arena_size = 256u << 20;
+
+    //! Whether to back the memory region with huge pages. Only used by \c ARENA_PAYLOAD_POOL
+    bool huge_pages = false;
+
+    //! Whether to touch every page of the memory region in creation. Only used by \c ARENA_PAYLOAD_POOL
+    bool prefault = true;
+
+    //! Whether identical data share the same memory. Not supported by \c MAP_PAYLOAD_POOL
+    bool deduplication = false;
+
+    //! Minimum length of the data deduplicated, so small data are not hashed
+    uint32_t deduplication_min_size = 1024;
+
+    //! Maximum size of the data reserved from a lock free list of fixed size blocks. 0 means no list
+    uint32_t small_payload_size = 0;
+
+    //! Number of blocks of the list of small data. Larger numbers of small data are reserved as any other data
+    uint32_t small_payload_count = 4096;
+
+    /**
+     * @brief NUMA node the memory of the pool is bound to, or -1 to let the system place it
+     *
+     * It is not read from the yaml: the DDS Router sets it in the pool of each NUMA node of its Participants.
+     * Only the memory region of \c ARENA_PAYLOAD_POOL is bound explicitly. The heap memory of the rest of pools is
+     * placed in the node of the thread that first touches it.
+     */
+    int numa_node = -1;
+};
+
+//! \c PayloadPoolKind to stream serialization
+std::ostream& operator <<(
+        std::ostream& os,
+        const PayloadPoolKind& kind);
+
+//! \c PayloadCopySize to stream serialization
+std::ostream& operator <<(
+        std::ostream& os,
+        const PayloadCopySize& copy_size);
+
+//! \c MemoryBudgetPolicy to stream serialization
+std::ostream& operator <<(
+        std::ostream& os,
+        const MemoryBudgetPolicy& policy);
+
+//! \c PayloadPoolConfiguration to stream serialization
+std::ostream& operator <<(
+        std::ostream& os,
+        const PayloadPoolConfiguration& configuration);
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_PAYLOADPOOLCONFIGURATION_HPP_ */
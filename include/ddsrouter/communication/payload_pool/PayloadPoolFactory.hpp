@@ -0,0 +1,49 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadPoolFactory.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_PAYLOADPOOLFACTORY_HPP_
+#define _DDSROUTER_COMMUNICATION_PAYLOADPOOLFACTORY_HPP_
+
+#include <memory>
+
+#include <ddsrouter/communication/payload_pool/PayloadPool.hpp>
+#include <ddsrouter/communication/payload_pool/PayloadPoolConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+class PayloadPoolFactory
+{
+public:
+
+    /**
+     * @brief Create a PayloadPool of the kind specified in the configuration.
+     *
+     * @param [in] configuration : configuration of the pool
+     * @return new PayloadPool
+     *
+     * @throw ConfigurationException : in case the configuration is not valid
+     */
+    static std::shared_ptr<PayloadPool> create_payload_pool(
+            const PayloadPoolConfiguration& configuration);
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_PAYLOADPOOLFACTORY_HPP_ */
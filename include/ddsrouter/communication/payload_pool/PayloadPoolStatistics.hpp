@@ -0,0 +1,99 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file PayloadPoolStatistics.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_PAYLOADPOOLSTATISTICS_HPP_
+#define _DDSROUTER_COMMUNICATION_PAYLOADPOOLSTATISTICS_HPP_
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * Snapshot of the usage of a \c PayloadPool .
+ *
+ * Each value is read independently, so values read while the pool is being used may not be consistent among them.
+ */
+struct PayloadPoolStatistics
+{
+    //! Upper limit of the size of the data counted in the first bucket of \c size_histogram
+    static constexpr uint32_t SMALLEST_SIZE_BUCKET = 64;
+
+    //! Number of buckets of \c size_histogram
+    static constexpr unsigned int NUMBER_OF_SIZE_BUCKETS = 20;
+
+    /**
+     * @brief Bucket of \c size_histogram where a data of \c size bytes is counted.
+     *
+     * Bucket \c i counts the data up to \c SMALLEST_SIZE_BUCKET * 2^i bytes not counted in previous buckets.
+     * The last bucket counts every larger data as well.
+     */
+    static unsigned int size_bucket(
+            uint32_t size) noexcept;
+
+    //! Bytes currently reserved
+    uint64_t reserved_bytes = 0;
+
+    //! Maximum bytes reserved at the same time since the creation of the pool
+    uint64_t max_reserved_bytes = 0;
+
+    //! Number of data currently reserved
+    uint64_t live_payloads = 0;
+
+    //! Number of data reserved since the creation of the pool
+    uint64_t reserved_payloads = 0;
+
+    //! Number of payloads that have referenced a data already in the pool without copying it
+    uint64_t referenced_payloads = 0;
+
+    //! Number of payloads that have copied a data from other pool
+    uint64_t copied_payloads = 0;
+
+    //! Number of payloads that have referenced an identical data already in the pool instead of storing their own
+    uint64_t deduplicated_payloads = 0;
+
+    //! Bytes of data not stored thanks to deduplication
+    uint64_t deduplicated_bytes = 0;
+
+    //! Number of data of low priority topics rejected by memory budget before being reserved
+    uint64_t low_priority_rejected_payloads = 0;
+
+    //! Number of data reserved since the creation of the pool by size bucket
+    std::array<uint64_t, NUMBER_OF_SIZE_BUCKETS> size_histogram {};
+
+    /**
+     * @brief Add the statistics of other pool to these ones
+     *
+     * Every value is added, so \c max_reserved_bytes becomes an upper bound of the maximum of both pools together.
+     */
+    PayloadPoolStatistics& operator +=(
+            const PayloadPoolStatistics& other) noexcept;
+};
+
+//! \c PayloadPoolStatistics to stream serialization
+std::ostream& operator <<(
+        std::ostream& os,
+        const PayloadPoolStatistics& statistics);
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_PAYLOADPOOLSTATISTICS_HPP_ */
@@ -0,0 +1,81 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReaderPayloadPool.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_READERPAYLOADPOOL_HPP_
+#define _DDSROUTER_COMMUNICATION_READERPAYLOADPOOL_HPP_
+
+#include <memory>
+
+#include <fastdds/rtps/history/IPayloadPool.h>
+
+#include <ddsrouter/communication/payload_pool/PayloadPool.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * Payload pool given to Fast DDS by a Reader to store the data it receives.
+ *
+ * It reserves the data in the shared \c PayloadPool with \c get_ingress_payload , so the Fast DDS receive threads
+ * never wait for memory, and the data of low priority topics is rejected before reserving it.
+ * The payloads reserved are owned by the shared pool, so they are released and referenced there.
+ *
+ * A data rejected is not added to the Reader history: reliable Writers send it again, and best effort data is lost.
+ */
+class ReaderPayloadPool : public fastrtps::rtps::IPayloadPool
+{
+public:
+
+    /**
+     * @brief Construct a new ReaderPayloadPool object
+     *
+     * @param payload_pool : pool where the data is stored
+     * @param low_priority : whether the data received is of a low priority topic
+     */
+    ReaderPayloadPool(
+            std::shared_ptr<PayloadPool> payload_pool,
+            bool low_priority);
+
+    //! Reserve the payload of a data received in \c payload_pool_
+    bool get_payload(
+            uint32_t size,
+            fastrtps::rtps::CacheChange_t& cache_change) override;
+
+    //! Store the payload of a data received in \c payload_pool_ , referencing it if it is already there
+    bool get_payload(
+            fastrtps::rtps::SerializedPayload_t& data,
+            IPayloadPool*& data_owner,
+            fastrtps::rtps::CacheChange_t& cache_change) override;
+
+    //! Release the payload of \c cache_change in \c payload_pool_
+    bool release_payload(
+            fastrtps::rtps::CacheChange_t& cache_change) override;
+
+protected:
+
+    //! Pool where the data is stored
+    std::shared_ptr<PayloadPool> payload_pool_;
+
+    //! Whether the data received is of a low priority topic
+    const bool low_priority_;
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_READERPAYLOADPOOL_HPP_ */
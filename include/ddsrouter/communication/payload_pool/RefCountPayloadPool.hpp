@@ -0,0 +1,269 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file RefCountPayloadPool.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_REFCOUNTPAYLOADPOOL_HPP_
+#define _DDSROUTER_COMMUNICATION_REFCOUNTPAYLOADPOOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <ddsrouter/communication/payload_pool/FixedSizeFreeList.hpp>
+#include <ddsrouter/communication/payload_pool/PayloadPool.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * @brief PayloadPool class that stores the reference counter of each data in a header before the data.
+ *
+ * It implements zero copy data transmission for payloads get from this pool, as \c MapPayloadPool does,
+ * but without any lock or lookup: referencing and releasing a data is a single atomic operation in its header.
+ * It does not handle limit of pools or sizes.
+ *
+ * Each data reserved is preceded by a \c Header in the same memory block. The pointer set in the payloads is
+ * the one to the data, right after the header.
+ *
+ * With \c deduplication configured, the data referenced or copied to this pool are indexed by the hash of their
+ * content, and a new payload with the same content as a data already in the pool references it instead of keeping
+ * its own copy.
+ *
+ * With \c small_payload_size configured, data up to that size are reserved from a lock free list of blocks of
+ * fixed size allocated in construction, so small data never reach the heap nor the size classes of subclasses.
+ * Once every block of the list is in use, small data are reserved as any other data.
+ *
+ * @warning Every payload get from this pool must be released to it. The data of a payload is not a heap block
+ * by itself, so it cannot be freed by the payload destruction.
+ */
+class RefCountPayloadPool : public PayloadPool
+{
+public:
+
+    /**
+     * @brief Construct a new RefCountPayloadPool object
+     *
+     * The blocks of the list of small data are allocated in construction.
+     *
+     * @param configuration : configuration of the pool
+     */
+    RefCountPayloadPool(
+            const PayloadPoolConfiguration& configuration = PayloadPoolConfiguration());
+
+    //! Destroy pool. Data not released yet are kept, so their payloads remain valid.
+    ~RefCountPayloadPool();
+
+    /**
+     * @brief Reserve new memory of size \c size for this payload.
+     *
+     * The memory block holds the header, with the counter set to 1, followed by the data.
+     *
+     * @param size size of the new chunk of data
+     * @param payload object to store the new data
+     *
+     * @return true if everything OK
+     * @return false if something went wrong
+     */
+    bool get_payload(
+            uint32_t size,
+            Payload& payload) override;
+
+    /**
+     * @brief Set \c target_payload data to \c src_payload .
+     *
+     * In case \c data_owner is \c this , \c target_payload points to the same data as \c src_payload
+     * and its reference counter is increased.
+     * Otherwise, new data is reserved and the data is copied to \c target_payload .
+     *
+     * With deduplication, if other data in the pool has the same content, \c target_payload points to it instead.
+     *
+     * @param [in,out] src_payload     Payload to move to target
+     * @param [in,out] data_owner      Payload pool owning incoming data \c src_payload
+     * @param [in,out] target_payload  Payload to assign the payload to
+     *
+     * @return true if everything OK
+     * @return false if something went wrong
+     *
+     * @throw InconsistencyException if \c data_owner is \c this but the data in \c src_payload is not from this pool.
+     */
+    bool get_payload(
+            const Payload& src_payload,
+            IPayloadPool*& data_owner,
+            Payload& target_payload) override;
+
+    /**
+     * @brief Decrease reference counter for data in \c payload .
+     *
+     * If this was the last payload that was referencing the data, this is released.
+     *
+     * @param payload payload to release
+     *
+     * @return true if everything OK
+     * @return false if something went wrong
+     *
+     * @throw InconsistencyException if the data in \c payload is not from this pool.
+     */
+    bool release_payload(
+            Payload& payload) override;
+
+protected:
+
+    //! Information stored before every data reserved from this pool
+    struct alignas(std::max_align_t) Header
+    {
+        //! Number of payloads that currently reference the data
+        std::atomic<uint32_t> references;
+
+        //! Bytes of data available in the memory block, that may be more than the ones requested
+        uint32_t capacity;
+
+        //! Pool that has reserved the data, to check the payloads released belong to it
+        const RefCountPayloadPool* pool;
+    };
+
+    //! Header of the data of \c payload
+    static Header* header_(
+            const Payload& payload) noexcept;
+
+    //! Header of \c data
+    static Header* header_(
+            PayloadUnit* data) noexcept;
+
+    /**
+     * @brief Reserve a memory block with a header and \c size bytes of data.
+     *
+     * Data up to \c small_payload_size bytes are reserved from \c small_payloads_ while it has free blocks.
+     * The capacity of the block is accounted in the memory budget.
+     * It increases the reserve count.
+     */
+    bool reserve_(
+            uint32_t size,
+            Payload& payload) override;
+
+    /**
+     * @brief Free the memory block of the data, header included.
+     *
+     * Blocks of \c small_payloads_ are given back to it.
+     * It decreases \c live_payloads_ .
+     */
+    bool release_(
+            Payload& payload) override;
+
+    /**
+     * @brief Bytes of data of the memory block used for a data of \c size bytes.
+     *
+     * This implementation uses blocks of the exact size requested.
+     */
+    virtual uint32_t block_capacity_(
+            uint32_t size) const noexcept;
+
+    /**
+     * @brief Get a memory block able to hold a header and \c capacity bytes of data.
+     *
+     * This implementation allocates the block from the heap.
+     *
+     * @param [in] capacity : bytes of data, as returned by \c block_capacity_
+     * @return pointer to the block, or nullptr if it could not be allocated
+     */
+    virtual void* allocate_block_(
+            uint32_t capacity);
+
+    /**
+     * @brief Give back a memory block get from \c allocate_block_ .
+     *
+     * This implementation returns the block to the heap.
+     *
+     * @param [in] block : block to give back
+     * @param [in] capacity : bytes of data the block can hold
+     */
+    virtual void free_block_(
+            void* block,
+            uint32_t capacity);
+
+    //! Throw an \c InconsistencyException if the data of \c payload has not been reserved from this pool
+    void check_owner_(
+            const Payload& payload) const;
+
+    //! Blocks for data up to \c small_payload_size bytes, or nullptr if not configured
+    std::unique_ptr<FixedSizeFreeList> small_payloads_;
+
+    /////
+    // DEDUPLICATION
+
+    //! Content of a data indexed for deduplication
+    struct DeduplicationEntry
+    {
+        //! Hash of the content
+        uint64_t hash;
+
+        //! Length of the content
+        uint32_t length;
+
+        //! Max size of the payloads referencing the data
+        uint32_t max_size;
+    };
+
+    //! Hash of \c length bytes of \c data
+    static uint64_t content_hash_(
+            const PayloadUnit* data,
+            uint32_t length) noexcept;
+
+    //! Whether the data of \c payload must be deduplicated
+    bool deduplicable_(
+            const Payload& payload) const noexcept;
+
+    /**
+     * @brief Set \c target_payload to a data of this pool with the same content as \c src_payload .
+     *
+     * The data of \c src_payload is itself used if it is already indexed.
+     *
+     * @param [in] src_payload : payload with the content to look for
+     * @param [out] target_payload : payload referencing the data found
+     * @param [out] hash : hash of the content of \c src_payload , if it has been calculated
+     *
+     * @return whether a data has been found and referenced
+     */
+    bool reference_duplicate_(
+            const Payload& src_payload,
+            Payload& target_payload,
+            uint64_t& hash);
+
+    //! Index the data of \c payload with \c hash , so next payloads with the same content can reference it
+    void index_data_(
+            const Payload& payload,
+            uint64_t hash);
+
+    //! Remove the data of \c payload from the index, if it is there
+    void unindex_data_(
+            const Payload& payload);
+
+    //! Guard access to \c deduplication_entries_ and \c deduplication_index_
+    std::mutex deduplication_mutex_;
+
+    //! Content of each data indexed
+    std::unordered_map<const PayloadUnit*, DeduplicationEntry> deduplication_entries_;
+
+    //! Data indexed by the hash of their content
+    std::unordered_multimap<uint64_t, PayloadUnit*> deduplication_index_;
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_REFCOUNTPAYLOADPOOL_HPP_ */
@@ -0,0 +1,230 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SlabPayloadPool.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_SLABPAYLOADPOOL_HPP_
+#define _DDSROUTER_COMMUNICATION_SLABPAYLOADPOOL_HPP_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ddsrouter/communication/payload_pool/MemoryArena.hpp>
+#include <ddsrouter/communication/payload_pool/RefCountPayloadPool.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * @brief \c RefCountPayloadPool that recycles the memory blocks of the data released.
+ *
+ * Data are grouped in power of two size classes, from \c MIN_SIZE_CLASS to the \c max_size_class of the
+ * configuration (\c MAX_SIZE_CLASS by default).
+ * A data released is not freed, but kept to be reused by the next data of the same size class, so in steady
+ * state no memory is allocated from the heap.
+ * Data larger than the largest size class are allocated from and freed to the heap.
+ *
+ * Each thread keeps a small magazine of free blocks per size class, so reserving and releasing data does not
+ * take any lock most of the times.
+ * Blocks are moved between the magazines and a depot shared by every thread in batches of half a magazine.
+ *
+ * Blocks are kept by the pool until it is destroyed. Blocks in the magazine of a thread are freed when the
+ * thread finishes.
+ */
+class SlabPayloadPool : public RefCountPayloadPool
+{
+public:
+
+    /**
+     * @brief Construct a new SlabPayloadPool object
+     *
+     * The blocks in \c preallocated_payloads of the configuration are allocated in construction.
+     * Each size is rounded up to its size class. Sizes larger than the largest size class are ignored.
+     *
+     * @param configuration : configuration of the pool
+     */
+    SlabPayloadPool(
+            const PayloadPoolConfiguration& configuration = PayloadPoolConfiguration());
+
+    //! Destroy pool and free the blocks kept in it
+    ~SlabPayloadPool();
+
+    //! Size of the smallest size class
+    static constexpr uint32_t MIN_SIZE_CLASS = 64;
+
+    //! Size of the largest size class by default. Larger data are not recycled
+    static constexpr uint32_t MAX_SIZE_CLASS = 1u << 20;
+
+    //! Maximum size of the largest size class that can be configured
+    static constexpr uint32_t LARGEST_SIZE_CLASS = 1u << 31;
+
+    //! Maximum number of free blocks of each size class kept by each thread
+    static constexpr unsigned int MAGAZINE_SIZE = 32;
+
+    //! Size class of the data of size \c size , or 0 if it is larger than \c max_size_class
+    static uint32_t size_class(
+            uint32_t size,
+            uint32_t max_size_class = MAX_SIZE_CLASS) noexcept;
+
+    //! Size of the largest size class of this pool: \c max_size_class of the configuration rounded up
+    uint32_t max_size_class() const noexcept;
+
+    //! Number of blocks allocated from the heap since the creation of the pool
+    uint64_t heap_allocations() const noexcept;
+
+    //! Number of blocks allocated from the heap because the arena was exhausted
+    uint64_t arena_exhausted_allocations() const noexcept;
+
+protected:
+
+    /**
+     * @brief Construct a new SlabPayloadPool object whose new blocks are carved from \c arena .
+     *
+     * Blocks are allocated from the heap once \c arena is exhausted. A warning is logged the first time.
+     *
+     * @param configuration : configuration of the pool
+     * @param arena : memory region to carve the blocks from, or nullptr to allocate them from the heap
+     */
+    SlabPayloadPool(
+            const PayloadPoolConfiguration& configuration,
+            std::shared_ptr<MemoryArena> arena);
+
+    //! Number of size classes up to \c LARGEST_SIZE_CLASS
+    static constexpr unsigned int NUMBER_OF_SIZE_CLASSES = 26;
+
+    //! List of free blocks of each size class
+    using FreeBlocks = std::array<std::vector<void*>, NUMBER_OF_SIZE_CLASSES>;
+
+    //! Free blocks shared by every thread
+    struct Depot
+    {
+        Depot(
+                std::shared_ptr<MemoryArena> arena);
+
+        //! Free every block in the depot allocated from the heap
+        ~Depot();
+
+        //! Memory region the blocks are carved from, kept alive while any block of it may be in use
+        std::shared_ptr<MemoryArena> arena;
+
+        //! Guard access to \c free_blocks
+        std::mutex mutex;
+
+        //! Free blocks of each size class
+        FreeBlocks free_blocks;
+
+        //! Whether the pool that owns this depot still exists
+        std::atomic<bool> alive {true};
+    };
+
+    //! Free blocks kept by a thread for a pool
+    struct Magazines
+    {
+        Magazines(
+                std::shared_ptr<Depot> depot);
+
+        //! Give back every block to the depot
+        ~Magazines();
+
+        Magazines(
+                const Magazines&) = delete;
+
+        Magazines& operator =(
+                const Magazines&) = delete;
+
+        //! Depot of the pool, kept alive while the thread holds blocks of it
+        std::shared_ptr<Depot> depot;
+
+        //! Free blocks of each size class
+        FreeBlocks free_blocks;
+    };
+
+    //! Magazines of the current thread for every pool it has used
+    struct ThreadCache
+    {
+        //! Magazines indexed by pool id
+        std::map<uint64_t, Magazines> magazines;
+
+        //! Id of the last pool used by this thread
+        uint64_t last_id = 0;
+
+        //! Magazines of the last pool used by this thread
+        Magazines* last = nullptr;
+    };
+
+    //! Index of the size class \c size_class
+    static unsigned int size_class_index_(
+            uint32_t size_class) noexcept;
+
+    //! Magazines of the current thread for this pool
+    Magazines& thread_magazines_();
+
+    //! Cache of the current thread
+    static ThreadCache& thread_cache_();
+
+    //! Allocate a new block of size class \c size_class from the arena, or from the heap if it is exhausted
+    void* allocate_new_block_(
+            uint32_t size_class);
+
+    //! Size class of \c size , or \c size itself if it is larger than \c max_size_class_
+    uint32_t block_capacity_(
+            uint32_t size) const noexcept override;
+
+    /**
+     * @brief Get a block from the magazine of the size class \c capacity .
+     *
+     * If the magazine is empty, it is refilled from the depot, and if this is empty, a new block is allocated.
+     * Data larger than \c max_size_class_ are allocated from the heap.
+     */
+    void* allocate_block_(
+            uint32_t capacity) override;
+
+    /**
+     * @brief Give back a block to the magazine of its size class.
+     *
+     * If the magazine is full, half of it is moved to the depot.
+     * Data larger than \c max_size_class_ are freed to the heap.
+     */
+    void free_block_(
+            void* block,
+            uint32_t capacity) override;
+
+    //! Unique id of this pool, to find its magazines in each thread
+    const uint64_t id_;
+
+    //! Size of the largest size class
+    const uint32_t max_size_class_;
+
+    //! Free blocks shared by every thread
+    std::shared_ptr<Depot> depot_;
+
+    //! Number of blocks allocated from the heap
+    std::atomic<uint64_t> heap_allocations_;
+
+    //! Number of blocks allocated from the heap because the arena was exhausted
+    std::atomic<uint64_t> arena_exhausted_allocations_;
+
+    //! Id of the next pool created
+    static std::atomic<uint64_t> next_id_;
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_SLABPAYLOADPOOL_HPP_ */
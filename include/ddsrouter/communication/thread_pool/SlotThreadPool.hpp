@@ -0,0 +1,300 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SlotThreadPool.hpp
+ */
+
+#ifndef _DDSROUTER_COMMUNICATION_THREADPOOL_SLOTTHREADPOOL_HPP_
+#define _DDSROUTER_COMMUNICATION_THREADPOOL_SLOTTHREADPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace ddsrouter {
+
+//! Identifier of a slot registered in a \c SlotThreadPool
+using TaskId = uint32_t;
+
+//! Callback executed by the \c SlotThreadPool each time a slot is emitted
+using Task = std::function<void()>;
+
+/**
+ * @brief Fixed size pool of threads that executes registered tasks (slots) on demand.
+ *
+ * Each user of the pool registers a slot with the task it wants to execute, and then \c emit this slot
+ * every time the task must be run. The pool guarantees that:
+ * - A slot is never executed by two threads at the same time, so the tasks of a same slot are serialized.
+ * - Emitting a slot that is already queued does nothing, so N emissions before the execution starts
+ *   produce a single execution.
+ * - Emitting a slot that is being executed makes it run once more after the current execution finishes,
+ *   so no emission is lost.
+ *
+ * This allows to share a small number of threads among many users (e.g. every \c Track of a DDS Router)
+ * instead of having a thread per user.
+ *
+ * Each thread (worker) has its own queue of pending slots. A slot is always queued in the worker that executed it
+ * the last time, so its data keeps hot in the cache of the core running this worker.
+ * Idle workers steal pending slots from the queues of busy workers, so a burst in one slot does not leave
+ * the rest of the workers idle.
+ *
+ * The pool can also run every slot in its own thread, woken each time the slot is emitted. This is the model used
+ * before the pool existed, where every \c Track had its own thread, and it is kept to compare both of them.
+ */
+class SlotThreadPool
+{
+public:
+
+    /**
+     * @brief Construct a new SlotThreadPool and start its threads
+     *
+     * @param n_threads number of threads of the pool. At least one thread is always created.
+     * @param thread_per_slot whether every slot runs in its own thread instead. \c n_threads is ignored then.
+     */
+    SlotThreadPool(
+            unsigned int n_threads,
+            bool thread_per_slot = false);
+
+    /**
+     * @brief Destructor
+     *
+     * It stops and joins every thread of the pool.
+     * Emitted slots that have not started yet are not executed.
+     */
+    ~SlotThreadPool();
+
+    /**
+     * @brief Register a new task in the pool
+     *
+     * The task will not be executed until the slot is emitted.
+     *
+     * Thread safe
+     *
+     * @param task callback to execute each time the slot is emitted
+     *
+     * @return Id of the new slot
+     */
+    TaskId register_slot(
+            Task&& task) noexcept;
+
+    /**
+     * @brief Remove a slot from the pool
+     *
+     * After this method returns, the task of this slot is not being executed and it will not be executed again.
+     * Thus, it waits for the task to finish in case it is being executed.
+     *
+     * @warning This method must not be called from inside the task of the slot being unregistered.
+     *
+     * Thread safe
+     *
+     * @param slot_id id of the slot to remove
+     */
+    void unregister_slot(
+            const TaskId& slot_id) noexcept;
+
+    /**
+     * @brief Ask the pool to execute the task of a slot
+     *
+     * The task will be executed by one of the threads of the pool as soon as it is available.
+     * It does nothing if the slot does not exist (e.g. it has been already unregistered).
+     *
+     * Thread safe
+     *
+     * @param slot_id id of the slot to execute
+     */
+    void emit(
+            const TaskId& slot_id) noexcept;
+
+    /**
+     * @brief Execute the task of a slot in the calling thread
+     *
+     * If the slot is idle, its task is executed by the calling thread before this method returns, avoiding the
+     * hand-off to a thread of the pool.
+     * Otherwise (the slot is queued or being executed, or every slot runs in its own thread), it behaves as \c emit .
+     * In both cases, a slot is never executed by two threads at the same time, and \c unregister_slot waits for
+     * this execution to finish.
+     *
+     * Thread safe
+     *
+     * @param slot_id id of the slot to execute
+     */
+    void emit_inline(
+            const TaskId& slot_id) noexcept;
+
+    //! Number of threads of the pool. 0 if every slot runs in its own thread
+    unsigned int n_threads() const noexcept;
+
+protected:
+
+    //! Execution status of a slot
+    enum SlotStatus
+    {
+        IDLE,               //! Slot is not queued nor being executed
+        QUEUED,             //! Slot is waiting in the queue to be executed
+        RUNNING,            //! Slot is being executed
+        RUNNING_PENDING,    //! Slot is being executed and it has been emitted meanwhile
+    };
+
+    //! Internal information of a registered slot
+    struct Slot
+    {
+        Slot(
+                Task&& slot_task)
+            : task(std::move(slot_task))
+            , status(IDLE)
+            , removed(false)
+            , last_worker(NO_WORKER)
+        {
+        }
+
+        //! Callback to execute
+        Task task;
+
+        //! Current execution status
+        std::atomic<SlotStatus> status;
+
+        //! Whether this slot has been unregistered, so it must not be executed anymore
+        std::atomic<bool> removed;
+
+        //! Guards the execution of \c task so \c unregister_slot can wait for it
+        std::mutex execution_mutex;
+
+        //! Index of the worker that executed this slot the last time
+        std::atomic<unsigned int> last_worker;
+
+        //! Thread running \c slot_routine_ , only if every slot runs in its own thread
+        std::thread thread;
+
+        //! Whether the slot has been emitted since its thread started the last execution. Guarded by \c emit_mutex
+        bool emitted = false;
+
+        //! Guards \c emitted and is used to wait in \c emit_condition_variable
+        std::mutex emit_mutex;
+
+        //! Awake the thread of the slot when it is emitted or removed
+        std::condition_variable emit_condition_variable;
+    };
+
+    //! Internal information of each thread of the pool
+    struct Worker
+    {
+        //! Slots waiting to be executed by this worker (or stolen by others)
+        std::deque<std::shared_ptr<Slot>> queue;
+
+        //! Guards access to \c queue
+        std::mutex queue_mutex;
+
+        //! Awake this worker when a slot is queued in it or the pool is destroyed
+        std::condition_variable condition_variable;
+
+        //! Whether this worker is waiting in \c condition_variable . Guarded by \c sleep_mutex_
+        bool sleeping = false;
+
+        //! Thread running \c worker_routine_ for this worker
+        std::thread thread;
+    };
+
+    //! Get a registered slot. nullptr if it does not exist
+    std::shared_ptr<Slot> get_slot_(
+            const TaskId& slot_id) noexcept;
+
+    //! Routine executed by every thread of the pool
+    void worker_routine_(
+            unsigned int worker_index) noexcept;
+
+    //! Take the oldest slot from the queue of worker \c worker_index . nullptr if empty
+    std::shared_ptr<Slot> pop_(
+            unsigned int worker_index) noexcept;
+
+    //! Take the newest slot from the queue of any worker but \c worker_index . nullptr if every queue is empty
+    std::shared_ptr<Slot> steal_(
+            unsigned int worker_index) noexcept;
+
+    /**
+     * @brief Add a slot to the queue of pending slots and awake a thread
+     *
+     * The slot is queued in the last worker that executed it, or in the next worker in round robin if it has
+     * never been executed.
+     * That worker is awaken if it is sleeping. Otherwise, other sleeping worker is awaken to steal it.
+     * If no worker is sleeping, \c sleep_mutex_ is not locked and no thread is notified.
+     */
+    void enqueue_(
+            std::shared_ptr<Slot> slot) noexcept;
+
+    //! Routine of the thread of \c slot , if every slot runs in its own thread
+    void slot_routine_(
+            std::shared_ptr<Slot> slot) noexcept;
+
+    //! Mark \c slot as removed and join its thread, if every slot runs in its own thread
+    void stop_slot_thread_(
+            Slot& slot) noexcept;
+
+    //! Execute the task of a slot (if it has not been removed) and set it back to idle or queued
+    void execute_(
+            std::shared_ptr<Slot> slot,
+            unsigned int worker_index) noexcept;
+
+    //! Value of \c Slot::last_worker for slots never executed
+    static constexpr unsigned int NO_WORKER = std::numeric_limits<unsigned int>::max();
+
+    //! Registered slots indexed by id
+    std::map<TaskId, std::shared_ptr<Slot>> slots_;
+
+    //! Guards access to \c slots_
+    std::shared_timed_mutex slots_mutex_;
+
+    //! Id to assign to the next registered slot
+    TaskId next_slot_id_;
+
+    //! Workers of the pool. The vector is not modified after construction
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    //! Number of slots queued in any worker
+    std::atomic<int64_t> queued_slots_;
+
+    /**
+     * Number of workers sleeping (or about to sleep) in their \c condition_variable
+     *
+     * It is increased before checking \c queued_slots_ to sleep, and \c queued_slots_ is increased before checking
+     * it to notify. Thus, a slot is never queued without any worker noticing it.
+     */
+    std::atomic<unsigned int> sleeping_workers_;
+
+    //! Worker where the next slot never executed is queued
+    std::atomic<unsigned int> next_worker_;
+
+    //! Guards \c terminate_ and \c Worker::sleeping and is used to wait in \c Worker::condition_variable
+    std::mutex sleep_mutex_;
+
+    //! Whether the threads must exit
+    bool terminate_;
+
+    //! Whether every slot runs in its own thread instead of in the workers
+    const bool thread_per_slot_;
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_COMMUNICATION_THREADPOOL_SLOTTHREADPOOL_HPP_ */
@@ -19,11 +19,14 @@
 #ifndef _DDSROUTER_CONFIGURATION_DDS_ROUTERCONFIGURATION_HPP_
 #define _DDSROUTER_CONFIGURATION_DDS_ROUTERCONFIGURATION_HPP_
 
+#include <ddsrouter/communication/payload_pool/PayloadPoolConfiguration.hpp>
 #include <ddsrouter/configuration/ParticipantConfiguration.hpp>
 #include <ddsrouter/configuration/BaseConfiguration.hpp>
 #include <ddsrouter/types/participant/ParticipantId.hpp>
 #include <ddsrouter/types/RawConfiguration.hpp>
+#include <ddsrouter/types/Time.hpp>
 #include <ddsrouter/types/topic/FilterTopic.hpp>
+#include <ddsrouter/types/topic/TopicSpecs.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
@@ -95,6 +98,103 @@ public:
      */
     std::set<RealTopic> real_topics() const;
 
+    /**
+     * @brief Return the number of threads of the DDS Router thread pool
+     *
+     * The value is taken from tag \c threads inside \c specs .
+     * If it is not set, \c DEFAULT_NUMBER_OF_THREADS is returned.
+     *
+     * @return Number of threads
+     *
+     * @throw \c ConfigurationException in case the value is not a positive integer
+     */
+    unsigned int number_of_threads() const;
+
+    //! Number of threads used when it is not set in the configuration
+    static constexpr unsigned int DEFAULT_NUMBER_OF_THREADS = 12;
+
+    /**
+     * @brief Return whether every Track runs in its own thread instead of in the thread pool
+     *
+     * The value is taken from tag \c thread-per-track inside \c specs .
+     * If it is not set, false is returned, and the Tracks share the \c number_of_threads threads of the pool.
+     *
+     * @throw \c ConfigurationException in case the value is not a boolean
+     */
+    bool thread_per_track() const;
+
+    /**
+     * @brief Return the configuration of the payload pool shared by every Participant
+     *
+     * The values are taken from tag \c payload-pool inside \c specs .
+     * Values not set take their default value.
+     *
+     * @return Payload pool configuration
+     *
+     * @throw \c ConfigurationException in case a value is not valid
+     */
+    PayloadPoolConfiguration payload_pool_configuration() const;
+
+    /**
+     * @brief Return whether the endpoints of the Participants are created on the discovery of remote endpoints
+     *
+     * The value is taken from tag \c interest-driven-endpoints inside \c specs .
+     * If it is not set, false is returned, and every Participant has a Writer and a Reader in every topic.
+     *
+     * @throw \c ConfigurationException in case the value is not a boolean
+     */
+    bool interest_driven_endpoints() const;
+
+    /**
+     * @brief Return whether the Bridge of a topic is only created once a remote Writer is discovered in it
+     *
+     * The value is taken from tag \c lazy-bridges inside \c specs .
+     * If it is not set, the value of \c interest_driven_endpoints is returned.
+     *
+     * @throw \c ConfigurationException in case the value is not a boolean
+     */
+    bool lazy_bridges() const;
+
+    /**
+     * @brief Return the time an endpoint created on demand is kept once it has no remote endpoints
+     *
+     * The value is taken from tag \c endpoint-grace-period inside \c specs .
+     * If it is not set, \c DEFAULT_ENDPOINT_GRACE_PERIOD is returned.
+     *
+     * @return Grace period in milliseconds
+     *
+     * @throw \c ConfigurationException in case the value is not a positive integer
+     */
+    Duration_ms endpoint_grace_period() const;
+
+    //! Grace period of the endpoints created on demand when it is not set in the configuration
+    static constexpr Duration_ms DEFAULT_ENDPOINT_GRACE_PERIOD = 5000;
+
+    /**
+     * @brief Return the time a Bridge without remote endpoints nor data is kept before being destroyed
+     *
+     * The value is taken from tag \c bridge-idle-timeout inside \c specs .
+     * If it is not set, 0 is returned, and Bridges are never destroyed.
+     *
+     * @return Idle timeout in milliseconds, 0 if disabled
+     *
+     * @throw \c ConfigurationException in case the value is not a non negative integer
+     */
+    Duration_ms bridge_idle_timeout() const;
+
+    /**
+     * @brief Return the specifications of the topics configured in allowedlist
+     *
+     * Each entry of allowedlist is returned as the filter it represents along with the \c TopicSpecs set in it.
+     * Values not set in an entry take their default value.
+     * A real topic takes the specifications of the first entry that it matches.
+     *
+     * @return List of filters with their specifications, in the same order as in allowedlist
+     *
+     * @throw \c ConfigurationException in case the yaml inside allowedlist is not well-formed
+     */
+    std::list<std::pair<std::shared_ptr<FilterTopic>, TopicSpecs>> topics_specs() const;
+
 protected:
 
     /**
@@ -107,6 +207,39 @@ protected:
      */
     std::list<std::shared_ptr<FilterTopic>> generic_get_topic_list_(
             const char* list_tag) const;
+
+    /**
+     * @brief Get the filter topic represented by an entry of a topic list
+     *
+     * @param [in] topic: yaml of the entry
+     * @return Filter topic, or nullptr if the entry has no name
+     */
+    static std::shared_ptr<FilterTopic> filter_topic_(
+            const RawConfiguration& topic);
+
+    /**
+     * @brief Get the specifications set in an entry of a topic list
+     *
+     * @param [in] topic: yaml of the entry
+     * @return Topic specifications
+     *
+     * @throw \c ConfigurationException in case a value is not valid
+     */
+    static TopicSpecs topic_specs_(
+            const RawConfiguration& topic);
+
+    /**
+     * @brief Get a non negative integer set in a yaml
+     *
+     * @param [in] yaml: yaml containing the value
+     * @param [in] tag: tag of the value
+     * @return Value of \c tag
+     *
+     * @throw \c ConfigurationException in case the value is negative
+     */
+    static unsigned int non_negative_(
+            const RawConfiguration& yaml,
+            const char* tag);
 };
 
 } /* namespace ddsrouter */
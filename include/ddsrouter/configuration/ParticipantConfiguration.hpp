@@ -75,6 +75,15 @@ public:
     //! Yaml Raw Configuration of this configuration object
     RawConfiguration raw_configuration() const noexcept;
 
+    /**
+     * @brief NUMA node the receive path and the payloads of the participant are bound to
+     *
+     * @return node set in the yaml, or \c numa::NO_NUMA_NODE if not set
+     *
+     * @throw \c ConfigurationException if the node is not a non negative integer
+     */
+    int numa_node() const;
+
     /**
      * @brief Equal comparator
      *
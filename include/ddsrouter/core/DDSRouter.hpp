@@ -20,13 +20,20 @@
 #define _DDSROUTER_CORE_DDSROUTER_HPP_
 
 #include <atomic>
+#include <chrono>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <queue>
+#include <set>
 
 #include <ddsrouter/communication/Bridge.hpp>
+#include <ddsrouter/communication/payload_pool/PayloadPoolStatistics.hpp>
+#include <ddsrouter/communication/thread_pool/SlotThreadPool.hpp>
 #include <ddsrouter/configuration/DDSRouterConfiguration.hpp>
 #include <ddsrouter/dynamic/AllowedTopicList.hpp>
 #include <ddsrouter/dynamic/DiscoveryDatabase.hpp>
+#include <ddsrouter/event/PeriodicEventHandler.hpp>
 #include <ddsrouter/participant/IParticipant.hpp>
 #include <ddsrouter/participant/ParticipantsDatabase.hpp>
 #include <ddsrouter/participant/ParticipantFactory.hpp>
@@ -49,7 +56,9 @@ public:
      * Initialize a whole DDSRouter:
      * - Create its associated AllowedTopicList
      * - Create Participants and add them to \c ParticipantsDatabase
-     * - Create the Bridges for RealTopics as disabled (TODO: remove when discovery is ready)
+     * - Create the Bridges for RealTopics as disabled, unless they are lazy
+     * - With interest driven endpoints or lazy Bridges, listen to the endpoints discovered and delete the idle
+     *   ones periodically
      *
      * @param [in] configuration : Configuration for the new DDS Router
      *
@@ -62,6 +71,7 @@ public:
     /**
      * @brief Destroy the DDSRouter object
      *
+     * Stop listening to discovery
      * Stop the DDSRouter
      * Destroy all Bridges
      * Destroy all Participants
@@ -105,6 +115,23 @@ public:
      */
     ReturnCode stop() noexcept;
 
+    /**
+     * @brief Current usage of the PayloadPools of the Participants
+     *
+     * It does not take any lock, so it can be called at any time from any thread.
+     *
+     * @return sum of the statistics of the PayloadPool shared by every Participant and the one of each NUMA node
+     */
+    PayloadPoolStatistics payload_pool_statistics() const noexcept;
+
+    /**
+     * @brief Payloads referenced and copied by the Tracks of \c topic
+     *
+     * @return statistics of the Track of each Participant, empty if the topic has no Bridge
+     */
+    std::map<ParticipantId, TrackStatistics> tracks_statistics(
+            const RealTopic& topic) noexcept;
+
 protected:
 
     /**
@@ -135,7 +162,7 @@ protected:
     // INTERNAL INITIALIZATION METHODS
 
     /**
-     * @brief Load allowed topics from configuration
+     * @brief Load allowed topics and their specifications from configuration
      *
      * @throw \c ConfigurationException in case the yaml inside allowedlist is not well-formed
      */
@@ -151,9 +178,36 @@ protected:
 
     /**
      * @brief  Create a disabled bridge for every real topic
+     *
+     * With lazy Bridges no Bridge is created, as they are created once a remote Writer is discovered.
+     * They are created anyway if no Participant discovers endpoints, as no remote Writer would ever be discovered.
      */
     void init_bridges_();
 
+    /**
+     * @brief Listen to the endpoints discovered by the Participants, if the endpoints are interest driven, Bridges
+     * are lazy or idle Bridges are destroyed
+     *
+     * Endpoints are notified by the \c DiscoveryDatabase from the discovery threads of the Participants.
+     * They are queued and processed by the thread pool, so Writers and Readers are never created from
+     * inside a discovery callback.
+     * Idle endpoints and idle Bridges are deleted periodically.
+     */
+    void init_discovery_();
+
+    /**
+     * @brief Stop listening to discovery and deleting idle endpoints and Bridges
+     *
+     * It waits for the endpoints being processed, if any. Endpoints not processed yet are discarded.
+     */
+    void stop_discovery_() noexcept;
+
+    //! Whether the endpoints discovered by the Participants are processed
+    bool listens_to_discovery_() const noexcept;
+
+    //! Whether Bridges are lazy and some Participant discovers endpoints, so they are created on discovery
+    bool creates_bridges_on_discovery_() const noexcept;
+
     /////
     // INTERNAL AUXILIAR METHODS
 
@@ -170,10 +224,43 @@ protected:
     void discovered_topic_(
             const RealTopic& topic) noexcept;
 
+    /**
+     * @brief Method called from the thread pool to process the endpoints discovered
+     *
+     * The topic of each active Writer is discovered if the Bridges are lazy, so topics without remote
+     * Writers have no Bridge. Otherwise, the topic of each active endpoint is discovered if its Bridge has been
+     * destroyed by idle. The endpoint is notified to the Bridge of its topic, if any.
+     */
+    void process_discovered_endpoints_() noexcept;
+
+    //! Delete the endpoints of every Bridge idle for longer than the grace period
+    void remove_idle_endpoints_() noexcept;
+
+    /**
+     * @brief Destroy the enabled Bridges idle for longer than \c bridge_idle_timeout_
+     *
+     * A Bridge is idle while there is no active user endpoint in its topic (see \c has_user_endpoints_ ) and it does
+     * not transmit any data.
+     * The topic of a Bridge destroyed is forgotten, and it is discovered again with the next remote endpoint.
+     */
+    void remove_idle_bridges_() noexcept;
+
+    /**
+     * @brief Whether \c topic has an active remote endpoint that may belong to a user application
+     *
+     * The endpoints discovered by Participants that connect with other routers are not counted, as they are the
+     * endpoints of the remote routers, which exist as long as their own Bridge does. Otherwise, two linked routers
+     * would keep each other's Bridges alive.
+     * Endpoints whose discoverer is unknown are counted.
+     */
+    bool has_user_endpoints_(
+            const RealTopic& topic) const noexcept;
+
     /**
      * @brief Create a new \c Bridge object
      *
      * It is created enabled if the DDSRouter is enabled.
+     * With interest driven endpoints, the Bridge is notified of the endpoints of its topic already discovered.
      *
      * @param [in] topic : new topic
      */
@@ -211,6 +298,27 @@ protected:
      */
     void deactivate_all_topics_() noexcept;
 
+    /**
+     * @brief Specifications of a topic
+     *
+     * @param [in] topic : Topic to get the specifications for
+     * @return Specifications of the first entry in \c topics_specs_ that matches \c topic , or default ones if none
+     */
+    TopicSpecs topic_specs_(
+            const RealTopic& topic) const noexcept;
+
+    /**
+     * @brief Payload pool of a Participant
+     *
+     * Participants bound to a NUMA node share the pool of that node, that is created with the first of them.
+     * The rest share \c payload_pool_ .
+     *
+     * @param [in] participant_configuration : configuration of the Participant
+     * @return pool the Participant must use
+     */
+    std::shared_ptr<PayloadPool> participant_payload_pool_(
+            const ParticipantConfiguration& participant_configuration);
+
     /////
     // DATA STORAGE
 
@@ -223,6 +331,24 @@ protected:
      */
     std::shared_ptr<PayloadPool> payload_pool_;
 
+    /**
+     * @brief Payload pool of each NUMA node with Participants bound to it
+     *
+     * Data received by a Participant bound to a node are stored in the memory of that node.
+     * They are referenced by the Participants of the same node, and copied once by each Participant of other node.
+     */
+    std::map<int, std::shared_ptr<PayloadPool>> numa_payload_pools_;
+
+    //! Payload pool used by each Participant: the one of its NUMA node or \c payload_pool_
+    std::map<ParticipantId, std::shared_ptr<PayloadPool>> participants_payload_pools_;
+
+    /**
+     * @brief Common thread pool where every Track executes its transmission
+     *
+     * Its size is given by the configuration, so the number of threads does not grow with the number of topics.
+     */
+    std::shared_ptr<SlotThreadPool> thread_pool_;
+
     /**
      * @brief Object that stores every Participant running in the DDSRouter
      */
@@ -254,9 +380,64 @@ protected:
     //! List of allowed and blocked topics
     AllowedTopicList allowed_topics_;
 
+    //! Specifications of the topics configured in the allowlist
+    std::list<std::pair<std::shared_ptr<FilterTopic>, TopicSpecs>> topics_specs_;
+
     //! Participant factory instance
     ParticipantFactory participant_factory_;
 
+    /////
+    // INTEREST DRIVEN ENDPOINTS
+
+    //! Whether the Writers and Readers of the Participants that discover endpoints are created on demand
+    bool interest_driven_endpoints_;
+
+    //! Whether the Bridge of a topic is only created once a remote Writer is discovered in it
+    bool lazy_bridges_;
+
+    //! Time in milliseconds the endpoints created on demand are kept once they have no remote endpoints
+    Duration_ms endpoint_grace_period_;
+
+    //! Endpoints notified by the \c DiscoveryDatabase not processed yet
+    std::queue<Endpoint> discovered_endpoints_;
+
+    //! Guard access to \c discovered_endpoints_
+    std::mutex discovered_endpoints_mutex_;
+
+    //! Id of the slot registered in \c thread_pool_ to execute \c process_discovered_endpoints_
+    TaskId discovery_slot_id_;
+
+    //! Id of the callback registered in \c discovery_database_ to queue the endpoints discovered
+    uint64_t endpoint_callback_id_;
+
+    //! Handler that deletes the idle endpoints periodically
+    std::unique_ptr<event::PeriodicEventHandler> idle_endpoints_handler_;
+
+    /////
+    // IDLE BRIDGES
+
+    //! Activity of a Bridge, to know since when it is idle
+    struct BridgeActivity
+    {
+        //! Payloads transmitted by the Bridge the last time it was checked
+        uint64_t transmitted_payloads = 0;
+
+        //! Last time the Bridge had user endpoints or transmitted data
+        std::chrono::steady_clock::time_point last_active;
+    };
+
+    //! Time in milliseconds a Bridge is kept once idle. 0 if Bridges are never destroyed
+    Duration_ms bridge_idle_timeout_;
+
+    //! Activity of each Bridge checked by \c remove_idle_bridges_
+    std::map<RealTopic, BridgeActivity> bridges_activity_;
+
+    //! Topics whose Bridge has been destroyed by idle, created again once a remote endpoint is discovered
+    std::set<RealTopic> idle_topics_;
+
+    //! Handler that destroys the idle Bridges periodically
+    std::unique_ptr<event::PeriodicEventHandler> idle_bridges_handler_;
+
     /////
     // AUXILIAR VARIABLES
 
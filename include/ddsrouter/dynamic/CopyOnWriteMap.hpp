@@ -0,0 +1,116 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CopyOnWriteMap.hpp
+ */
+
+#ifndef _DDSROUTER_DYNAMIC_COPYONWRITEMAP_HPP_
+#define _DDSROUTER_DYNAMIC_COPYONWRITEMAP_HPP_
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * @brief Map whose copies share with the original every part not modified since the copy
+ *
+ * The elements are split by the hash of their key in buckets, and the buckets in groups. Copying the map only
+ * copies the pointers to the groups, and modifying a copy replaces the group and bucket of the element by new
+ * ones, so the rest of the map is shared and the original is never modified.
+ * This way, a map that is never modified once shared can be read concurrently with the creation of a modified
+ * copy, at the cost of copying a single bucket per modification.
+ *
+ * The values are stored as pointers to constant values, so they are shared as well.
+ *
+ * @warning This class is not thread safe: a map must not be modified while it is being read.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class CopyOnWriteMap
+{
+public:
+
+    /**
+     * @brief Get the value of \c key
+     *
+     * @param [in] key : key to look for
+     * @return value of \c key , or nullptr if the map does not have it
+     */
+    std::shared_ptr<const Value> find(
+            const Key& key) const noexcept;
+
+    /**
+     * @brief Set the value of \c key , adding it if the map does not have it
+     *
+     * The bucket of \c key is copied, so copies of this map are not modified.
+     *
+     * @param [in] key : key to set
+     * @param [in] value : new value of \c key
+     */
+    void set(
+            const Key& key,
+            std::shared_ptr<const Value> value);
+
+    /**
+     * @brief Remove \c key from the map
+     *
+     * The bucket of \c key is copied, so copies of this map are not modified.
+     *
+     * @param [in] key : key to remove
+     * @return whether the map had \c key
+     */
+    bool erase(
+            const Key& key);
+
+    //! Number of elements in the map
+    size_t size() const noexcept;
+
+protected:
+
+    //! Number of groups of buckets
+    static constexpr size_t GROUPS_ = 64;
+
+    //! Number of buckets in each group
+    static constexpr size_t BUCKETS_PER_GROUP_ = 64;
+
+    //! Elements with the same bucket position
+    using Bucket = std::map<Key, std::shared_ptr<const Value>>;
+
+    //! Buckets with the same group position. Buckets without elements are nullptr
+    using Group = std::array<std::shared_ptr<const Bucket>, BUCKETS_PER_GROUP_>;
+
+    //! Index of the group and index of the bucket in the group of \c key
+    static std::pair<size_t, size_t> position_(
+            const Key& key) noexcept;
+
+    //! Groups of buckets. Groups without elements are nullptr
+    std::array<std::shared_ptr<const Group>, GROUPS_> groups_;
+
+    //! Number of elements in the map
+    size_t size_ = 0;
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+// Include implementation template file
+#include <ddsrouter/dynamic/impl/CopyOnWriteMap.ipp>
+
+#endif /* _DDSROUTER_DYNAMIC_COPYONWRITEMAP_HPP_ */
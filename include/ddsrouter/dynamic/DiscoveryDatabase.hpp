@@ -19,45 +19,100 @@
 #ifndef _DDSROUTER_DYNAMIC_DISCOVERYDATABASE_HPP_
 #define _DDSROUTER_DYNAMIC_DISCOVERYDATABASE_HPP_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <map>
-#include <shared_mutex>
+#include <memory>
 #include <string>
 #include <mutex>
+#include <utility>
+#include <vector>
 
+#include <ddsrouter/dynamic/CopyOnWriteMap.hpp>
 #include <ddsrouter/types/endpoint/Endpoint.hpp>
 #include <ddsrouter/types/endpoint/Guid.hpp>
+#include <ddsrouter/types/participant/ParticipantId.hpp>
 #include <ddsrouter/types/ReturnCode.hpp>
 #include <ddsrouter/types/topic/RealTopic.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
 
+//! Operation of the \c DiscoveryDatabase notified to the endpoint callbacks
+enum class DatabaseOperation
+{
+    ADD,    //! An endpoint has been added, or an inactive one has been replaced
+    UPDATE, //! An endpoint has been updated
+    ERASE,  //! An endpoint has been erased
+};
+
+//! Number of active endpoints of a topic in the \c DiscoveryDatabase
+struct TopicEndpointsCount
+{
+    //! Active Readers of the topic
+    uint32_t readers = 0;
+
+    //! Active Writers of the topic
+    uint32_t writers = 0;
+};
+
 /**
  * Class that stores a collection of discovered remote (not belonging to this DDSRouter) Endpoints.
+ *
+ * Endpoints are indexed by guid and discoverer Participant, and by topic, so the queries of a topic do not go
+ * through every endpoint.
+ * An endpoint discovered by several Participants has an entry for each of them, so each Participant adds, updates
+ * and erases its own entry without modifying the others.
+ * Callbacks can be registered to be notified of every change in the database.
+ *
+ * Queries read an immutable snapshot of the database, so they never wait for a modification nor block it.
+ * Modifications are serialized, and each of them publishes a new snapshot that shares with the previous one every
+ * part of the database it has not modified. A snapshot is released once the last query reading it finishes.
  */
 class DiscoveryDatabase
 {
 public:
 
+    //! Function called with every endpoint added, updated or erased
+    using EndpointCallback = std::function<void(DatabaseOperation, const Endpoint&)>;
+
     /**
      * @brief Whether a topic exists in any Endpoint in the database
      *
+     * It only looks up the topic index.
+     *
      * @param [in] topic: topic to check if it exists
      * @return true if any endpoint has this topic, false otherwise
      */
     bool topic_exists(
             const RealTopic& topic) const noexcept;
 
-    //! Whether this guid is in the database
+    /**
+     * @brief Number of active Readers and Writers of a topic
+     *
+     * It only looks up the topic index.
+     *
+     * @param [in] topic: topic of the endpoints
+     * @return count of the active endpoints of this topic
+     */
+    TopicEndpointsCount topic_endpoints_count(
+            const RealTopic& topic) const noexcept;
+
+    //! Whether the endpoint with this guid discovered by \c discoverer is in the database
     bool endpoint_exists(
-            const Guid& guid) const noexcept;
+            const Guid& guid,
+            const ParticipantId& discoverer = ParticipantId()) const noexcept;
 
     /**
      * @brief Add a new endpoint to the database.
      *
      * @param [in] new_endpoint: new endpoint to store
      * @return true if the endpoint has been added
-     * @throw \c InconsistencyException in case an endpoint with the same guid already exists and is active
+     * @throw \c InconsistencyException in case an endpoint with the same guid and discoverer already exists and is
+     * active
      */
     bool add_endpoint(
             const Endpoint& new_endpoint);
@@ -67,7 +122,8 @@ public:
      *
      * @param [in] new_endpoint: new endpoint to store
      * @return true if the endpoint has been updated
-     * @throw \c InconsistencyException in case there is no entry associated to this endpoint
+     * @throw \c InconsistencyException in case there is no entry associated to the guid and discoverer of this
+     * endpoint
      */
     bool update_endpoint(
             const Endpoint& new_endpoint);
@@ -75,33 +131,156 @@ public:
     /**
      * @brief Erase an endpoint inside the database
      *
+     * The entries of the same endpoint discovered by other Participants are kept.
+     *
      * @param [in] guid_of_endpoint_to_erase guid of endpoint that will be erased
+     * @param [in] discoverer: Participant that has discovered the endpoint
      * @return \c RETCODE_OK if correctly erased
-     * @throw \c InconsistencyException in case there is no entry associated to this guid
+     * @throw \c InconsistencyException in case there is no entry associated to this guid and discoverer
      */
     ReturnCode erase_endpoint(
-            const Guid& guid_of_endpoint_to_erase);
+            const Guid& guid_of_endpoint_to_erase,
+            const ParticipantId& discoverer = ParticipantId());
 
     /**
-     * @brief Get the endpoint object with this guid
+     * @brief Get the endpoint object with this guid discovered by \c discoverer
      *
      * @param [in] guid: guid to query
+     * @param [in] discoverer: Participant that has discovered the endpoint
      * @return Endpoint referring to this guid
-     * @throw \c InconsistencyException in case there is no entry associated to this guid
+     * @throw \c InconsistencyException in case there is no entry associated to this guid and discoverer
      */
     Endpoint get_endpoint(
-            const Guid& endpoint_guid) const;
+            const Guid& endpoint_guid,
+            const ParticipantId& discoverer = ParticipantId()) const;
+
+    /**
+     * @brief Get every endpoint of a topic, active or not
+     *
+     * Only the endpoints of the topic are visited.
+     * An endpoint discovered by several Participants is returned once for each of them.
+     *
+     * @param [in] topic: topic of the endpoints
+     * @return copy of the endpoints with this topic
+     */
+    std::vector<Endpoint> topic_endpoints(
+            const RealTopic& topic) const noexcept;
+
+    /**
+     * @brief Register a callback called every time an endpoint is added, updated or erased
+     *
+     * The callback receives the operation and the endpoint as stored in the database.
+     * Endpoints erased are received as inactive.
+     * It is called after the database has been modified, without the database lock taken, from the thread that
+     * has modified it. Modifications are notified in the same order they are published, so a modification made
+     * from other thread may wait for the callbacks of the previous one to return.
+     * It must not register nor unregister callbacks, nor modify the database.
+     *
+     * @param [in] callback: callback to call
+     * @return id of the callback, to unregister it
+     */
+    uint64_t register_endpoint_callback(
+            EndpointCallback callback) noexcept;
 
-    // TODO
-    // some way of allowing participants to subscribe to a callback when new information arrives
+    /**
+     * @brief Unregister a callback registered with \c register_endpoint_callback .
+     *
+     * Once it returns, the callback is not being called and will not be called anymore.
+     */
+    void unregister_endpoint_callback(
+            uint64_t callback_id) noexcept;
 
 protected:
 
-    //! Database of endpoints indexed by guid
-    std::map<Guid, Endpoint> entities_;
+    //! Key of an endpoint in the database: its guid and the Participant that has discovered it
+    using EndpointKey = std::pair<Guid, ParticipantId>;
+
+    //! Endpoints of a topic in the database. Entries are never modified once in a snapshot
+    struct TopicEntry
+    {
+        //! Key of every endpoint of the topic, active or not. Sorted vector, so an entry is copied in one block
+        std::vector<EndpointKey> endpoints;
+
+        //! Number of active endpoints of the topic, counted once per discoverer
+        TopicEndpointsCount count;
+    };
+
+    //! Hash of an endpoint key, to place it in the endpoints map
+    struct EndpointKeyHash
+    {
+        size_t operator ()(
+                const EndpointKey& key) const noexcept;
+    };
+
+    //! Hash of a topic, to place it in the topics map
+    struct TopicHash
+    {
+        size_t operator ()(
+                const RealTopic& topic) const noexcept;
+    };
+
+    //! State of the database at some point. Snapshots are never modified once published
+    struct Snapshot
+    {
+        //! Database of endpoints indexed by guid and discoverer
+        CopyOnWriteMap<EndpointKey, Endpoint, EndpointKeyHash> entities;
+
+        //! Endpoints of each topic with any endpoint in \c entities
+        CopyOnWriteMap<RealTopic, TopicEntry, TopicHash> topics;
+    };
+
+    //! Key of the entry of \c endpoint
+    static EndpointKey key_(
+            const Endpoint& endpoint) noexcept;
+
+    //! Get the snapshot currently published. It remains valid while the pointer is kept
+    std::shared_ptr<const Snapshot> snapshot_() const noexcept;
+
+    //! Add \c endpoint to the topic index of \c snapshot
+    static void index_endpoint_(
+            Snapshot& snapshot,
+            const Endpoint& endpoint) noexcept;
+
+    //! Remove \c endpoint from the topic index of \c snapshot , and its topic if it has no endpoints left
+    static void unindex_endpoint_(
+            Snapshot& snapshot,
+            const Endpoint& endpoint) noexcept;
+
+    /**
+     * @brief Call every callback registered with \c operation and \c endpoint
+     *
+     * It waits until the modifications published before have been notified.
+     *
+     * @param [in] sequence: number of the modification in publish order
+     */
+    void notify_endpoint_(
+            uint64_t sequence,
+            DatabaseOperation operation,
+            const Endpoint& endpoint) noexcept;
+
+    //! Snapshot of the database currently published. Replaced by every modification
+    std::atomic<std::shared_ptr<const Snapshot>> current_snapshot_ {std::make_shared<const Snapshot>()};
+
+    //! Mutex to serialize the modifications of the database
+    std::mutex write_mutex_;
+
+    //! Number of the next modification published. Guarded by \c write_mutex_
+    uint64_t next_published_sequence_ = 0;
+
+    //! Callbacks called with every endpoint added, updated or erased, indexed by their id
+    std::map<uint64_t, EndpointCallback> endpoint_callbacks_;
+
+    //! Id of the next callback registered
+    uint64_t next_callback_id_ = 0;
+
+    //! Number of the next modification to notify. Guarded by \c callback_mutex_
+    uint64_t next_notified_sequence_ = 0;
+
+    //! Mutex to guard \c endpoint_callbacks_ , taken while they are called
+    std::mutex callback_mutex_;
 
-    //! Mutex to guard queries to the database
-    mutable std::shared_timed_mutex mutex_;
+    //! Wakes the modifications waiting for their turn to be notified
+    std::condition_variable notified_cv_;
 };
 
 } /* namespace ddsrouter */
@@ -0,0 +1,116 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CopyOnWriteMap.ipp
+ */
+
+#ifndef _DDSROUTER_DYNAMIC_IMPL_COPYONWRITEMAP_IPP_
+#define _DDSROUTER_DYNAMIC_IMPL_COPYONWRITEMAP_IPP_
+
+namespace eprosima {
+namespace ddsrouter {
+
+template <typename Key, typename Value, typename Hash>
+std::shared_ptr<const Value> CopyOnWriteMap<Key, Value, Hash>::find(
+        const Key& key) const noexcept
+{
+    std::pair<size_t, size_t> position = position_(key);
+
+    const std::shared_ptr<const Group>& group = groups_[position.first];
+    if (!group)
+    {
+        return nullptr;
+    }
+
+    const std::shared_ptr<const Bucket>& bucket = (*group)[position.second];
+    if (!bucket)
+    {
+        return nullptr;
+    }
+
+    auto it = bucket->find(key);
+    if (it == bucket->end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+template <typename Key, typename Value, typename Hash>
+void CopyOnWriteMap<Key, Value, Hash>::set(
+        const Key& key,
+        std::shared_ptr<const Value> value)
+{
+    std::pair<size_t, size_t> position = position_(key);
+
+    // Group and bucket are copied, as they may be shared with other maps
+    std::shared_ptr<Group> group = groups_[position.first] ?
+            std::make_shared<Group>(*groups_[position.first]) :
+            std::make_shared<Group>();
+    std::shared_ptr<Bucket> bucket = (*group)[position.second] ?
+            std::make_shared<Bucket>(*(*group)[position.second]) :
+            std::make_shared<Bucket>();
+
+    if (bucket->insert_or_assign(key, value).second)
+    {
+        size_++;
+    }
+
+    (*group)[position.second] = bucket;
+    groups_[position.first] = group;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool CopyOnWriteMap<Key, Value, Hash>::erase(
+        const Key& key)
+{
+    if (!find(key))
+    {
+        return false;
+    }
+
+    std::pair<size_t, size_t> position = position_(key);
+
+    // Group and bucket are copied, as they may be shared with other maps
+    std::shared_ptr<Group> group = std::make_shared<Group>(*groups_[position.first]);
+    std::shared_ptr<Bucket> bucket = std::make_shared<Bucket>(*(*group)[position.second]);
+
+    bucket->erase(key);
+    size_--;
+
+    (*group)[position.second] = bucket->empty() ? nullptr : bucket;
+    groups_[position.first] = group;
+
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t CopyOnWriteMap<Key, Value, Hash>::size() const noexcept
+{
+    return size_;
+}
+
+template <typename Key, typename Value, typename Hash>
+std::pair<size_t, size_t> CopyOnWriteMap<Key, Value, Hash>::position_(
+        const Key& key) noexcept
+{
+    size_t hash = Hash()(key);
+    return std::make_pair(hash % GROUPS_, (hash / GROUPS_) % BUCKETS_PER_GROUP_);
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_DYNAMIC_IMPL_COPYONWRITEMAP_IPP_ */
@@ -26,6 +26,7 @@
 #include <ddsrouter/types/participant/ParticipantId.hpp>
 #include <ddsrouter/types/participant/ParticipantType.hpp>
 #include <ddsrouter/types/RawConfiguration.hpp>
+#include <ddsrouter/types/topic/TopicSpecs.hpp>
 #include <ddsrouter/writer/IWriter.hpp>
 
 namespace eprosima {
@@ -62,6 +63,15 @@ public:
      */
     virtual ParticipantType type() const noexcept = 0;
 
+    /**
+     * @brief Whether this Participant adds the remote endpoints it discovers to the \c DiscoveryDatabase
+     *
+     * Only the Participants that report their discovery can have their Writers and Readers created on demand.
+     *
+     * @return true if the endpoints discovered are added to the database with this Participant as discoverer
+     */
+    virtual bool discovers_endpoints() const noexcept = 0;
+
     /**
      * @brief Return a new Writer
      *
@@ -69,13 +79,15 @@ public:
      * This writer will forward messages in this topic.
      *
      * @param [in] topic : Topic that this Writer will work with.
+     * @param [in] specs : Specifications of the topic, that may configure the Writer (e.g. its history).
      *
      * @return Writer in this Participant referring this topic
      *
      * @throw \c InitializationException in case the writer creation fails.
      */
     virtual std::shared_ptr<IWriter> create_writer(
-            RealTopic topic) = 0;
+            RealTopic topic,
+            const TopicSpecs& specs) = 0;
 
     /**
      * @brief Return a new Reader
@@ -84,13 +96,15 @@ public:
      * This reader will receive messages in this topic.
      *
      * @param [in] topic : Topic that this Reader will work with.
+     * @param [in] specs : Specifications of the topic, that may configure the Reader (e.g. its priority).
      *
      * @return Reader in this Participant referring this topic
      *
      * @throw \c InitializationException in case the reader creation fails.
      */
     virtual std::shared_ptr<IReader> create_reader(
-            RealTopic topic) = 0;
+            RealTopic topic,
+            const TopicSpecs& specs) = 0;
 
     /**
      * @brief Delete Writer
@@ -83,6 +83,15 @@ public:
      */
     ParticipantType type() const noexcept override;
 
+    /**
+     * @brief Override discovers_endpoints() IParticipant method
+     *
+     * Participants do not report their discovery unless they override this method.
+     *
+     * @return false
+     */
+    bool discovers_endpoints() const noexcept override;
+
     /**
      * @brief Override create_writer() IParticipant method
      *
@@ -92,7 +101,8 @@ public:
      * Thread safe with mutex \c mutex_ .
      */
     std::shared_ptr<IWriter> create_writer(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     /**
      * @brief Override create_reader() IParticipant method
@@ -103,7 +113,8 @@ public:
      * Thread safe with mutex \c mutex_ .
      */
     std::shared_ptr<IReader> create_reader(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     /**
      * @brief Override delete_writer() IParticipant method
@@ -133,10 +144,12 @@ protected:
      * @note Implement this method in every Participant in order to create a class specific Writer
      *
      * @param [in] topic : Topic that this Writer refers to.
+     * @param [in] specs : Specifications of the topic.
      * @return Writer
      */
     virtual std::shared_ptr<IWriter> create_writer_(
-            RealTopic topic) = 0;
+            RealTopic topic,
+            const TopicSpecs& specs) = 0;
 
     /**
      * @brief Create a reader object
@@ -144,10 +157,12 @@ protected:
      * @note Implement this method in every Participant in order to create a class specific Reader
      *
      * @param [in] topic : Topic that this Reader refers to.
+     * @param [in] specs : Specifications of the topic.
      * @return Reader
      */
     virtual std::shared_ptr<IReader> create_reader_(
-            RealTopic topic) = 0;
+            RealTopic topic,
+            const TopicSpecs& specs) = 0;
 
     /**
      * @brief Do nothing
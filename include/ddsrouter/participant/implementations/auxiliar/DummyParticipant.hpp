@@ -59,16 +59,37 @@ public:
      */
     virtual ~DummyParticipant();
 
+    /**
+     * @brief Override discovers_endpoints() IParticipant method
+     *
+     * The endpoints simulated to be discovered are reported with this Participant as discoverer.
+     *
+     * @return true
+     */
+    bool discovers_endpoints() const noexcept override;
+
     /**
      * @brief Simulate that this Participant has discovered a new endpoint
      *
+     * The endpoint is added to the Discovery Database with this Participant as discoverer.
+     *
      * @param new_endpoint : Endpoint discovered
      */
     void simulate_discovered_endpoint(
             const Endpoint& new_endpoint);
 
     /**
-     * @brief Get the discovered endpoint object referring to \c guid
+     * @brief Simulate that an endpoint discovered by this Participant has left
+     *
+     * The endpoint is set as inactive in the Discovery Database.
+     *
+     * @param guid : \c Guid of the Endpoint that has left
+     */
+    void simulate_undiscovered_endpoint(
+            const Guid& guid);
+
+    /**
+     * @brief Get the endpoint object referring to \c guid discovered by this Participant
      *
      * Search this guid in the endpoints in the Discovery Database
      *
@@ -107,6 +128,34 @@ public:
             RealTopic topic,
             uint16_t n) const noexcept;
 
+    /**
+     * @brief Simulate whether the Writer in topic \c topic is matched with any remote reader
+     *
+     * @param topic : Topic that refers to the Writer
+     * @param [in] remote_readers : whether the Writer has remote readers
+     */
+    void simulate_remote_readers(
+            RealTopic topic,
+            bool remote_readers) noexcept;
+
+    /**
+     * @brief Simulate whether the history of the Writer in topic \c topic is full of data not acknowledged
+     *
+     * @param topic : Topic that refers to the Writer
+     * @param [in] full_history : whether the history of the Writer is full
+     */
+    void simulate_full_history(
+            RealTopic topic,
+            bool full_history) noexcept;
+
+    //! Whether this Participant currently has a Reader in topic \c topic
+    bool has_reader(
+            RealTopic topic) const noexcept;
+
+    //! Whether this Participant currently has a Writer in topic \c topic
+    bool has_writer(
+            RealTopic topic) const noexcept;
+
     /**
      * @brief Get a DummyParticipant by ID
      *
@@ -126,11 +175,13 @@ protected:
 
     //! Override create_writer_() BaseParticipant method
     std::shared_ptr<IWriter> create_writer_(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     //! Override create_reader_() BaseParticipant method
     std::shared_ptr<IReader> create_reader_(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     // Specific enable/disable do not need to be implemented
 
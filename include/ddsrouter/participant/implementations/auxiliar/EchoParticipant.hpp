@@ -38,11 +38,13 @@ protected:
 
     //! Override create_writer_() BaseParticipant method
     std::shared_ptr<IWriter> create_writer_(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     //! Override create_reader_() BaseParticipant method
     std::shared_ptr<IReader> create_reader_(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     // Deleters do not need to be implemented
 };
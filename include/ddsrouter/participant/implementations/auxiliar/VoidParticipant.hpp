@@ -46,13 +46,18 @@ public:
     //! Override type() IParticipant method
     ParticipantType type() const noexcept override;
 
+    //! Override discovers_endpoints() IParticipant method
+    bool discovers_endpoints() const noexcept override;
+
     //! Override create_writer() IParticipant method
     std::shared_ptr<IWriter> create_writer(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     //! Override create_reader() IParticipant method
     std::shared_ptr<IReader> create_reader(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     //! Override delete_writer() IParticipant method
     void delete_writer(
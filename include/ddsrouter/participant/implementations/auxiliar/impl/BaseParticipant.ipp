@@ -78,9 +78,16 @@ ParticipantType BaseParticipant<ConfigurationType>::type() const noexcept
     return configuration_.type();
 }
 
+template <class ConfigurationType>
+bool BaseParticipant<ConfigurationType>::discovers_endpoints() const noexcept
+{
+    return false;
+}
+
 template <class ConfigurationType>
 std::shared_ptr<IWriter> BaseParticipant<ConfigurationType>::create_writer(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs& specs)
 {
     std::lock_guard <std::recursive_mutex> lock(mutex_);
 
@@ -92,7 +99,7 @@ std::shared_ptr<IWriter> BaseParticipant<ConfigurationType>::create_writer(
                       ". Writer already exists.");
     }
 
-    std::shared_ptr <IWriter> new_writer = create_writer_(topic);
+    std::shared_ptr <IWriter> new_writer = create_writer_(topic, specs);
 
     logInfo(DDSROUTER_BASEPARTICIPANT, "Created writer in Participant " << id() << " for topic " << topic);
 
@@ -104,7 +111,8 @@ std::shared_ptr<IWriter> BaseParticipant<ConfigurationType>::create_writer(
 
 template <class ConfigurationType>
 std::shared_ptr<IReader> BaseParticipant<ConfigurationType>::create_reader(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs& specs)
 {
     std::lock_guard <std::recursive_mutex> lock(mutex_);
 
@@ -116,7 +124,7 @@ std::shared_ptr<IReader> BaseParticipant<ConfigurationType>::create_reader(
                       ". Reader already exists.");
     }
 
-    std::shared_ptr <IReader> new_reader = create_reader_(topic);
+    std::shared_ptr <IReader> new_reader = create_reader_(topic, specs);
 
     logInfo(DDSROUTER_BASEPARTICIPANT, "Created reader in Participant " << id() << " for topic " << topic);
 
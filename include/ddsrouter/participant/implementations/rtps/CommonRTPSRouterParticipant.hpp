@@ -54,6 +54,15 @@ public:
 
     virtual ~CommonRTPSRouterParticipant();
 
+    /**
+     * @brief Override discovers_endpoints() IParticipant method
+     *
+     * Remote Readers and Writers discovered are added to the Discovery Database with this Participant as discoverer.
+     *
+     * @return true
+     */
+    bool discovers_endpoints() const noexcept override;
+
     virtual void onParticipantDiscovery(
             fastrtps::rtps::RTPSParticipant* participant,
             fastrtps::rtps::ParticipantDiscoveryInfo&& info);
@@ -70,11 +79,32 @@ protected:
 
     void create_participant_();
 
+    /**
+     * @brief Create an \c Endpoint discovered by this Participant from the information of a remote endpoint
+     *
+     * @param [in] info : discovery information of a Reader or a Writer
+     * @param [in] kind : whether \c info is from a Reader or a Writer
+     */
+    template <class DiscoveryInfoKind>
+    Endpoint create_endpoint_from_info_(
+            const DiscoveryInfoKind& info,
+            EndpointKind kind) const noexcept;
+
+    /**
+     * @brief Add \c endpoint to the Discovery Database, or update it if it is already there
+     *
+     * It is called from discovery callbacks, so errors are logged instead of thrown.
+     */
+    void update_discovered_endpoint_(
+            const Endpoint& endpoint) noexcept;
+
     std::shared_ptr<IWriter> create_writer_(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     std::shared_ptr<IReader> create_reader_(
-            RealTopic topic) override;
+            RealTopic topic,
+            const TopicSpecs& specs) override;
 
     /////
     // RTPS specific methods
@@ -26,6 +26,7 @@
 
 #include <ddsrouter/reader/implementations/rtps/Reader.hpp>
 #include <ddsrouter/writer/implementations/rtps/Writer.hpp>
+#include <ddsrouter/exceptions/InconsistencyException.hpp>
 #include <ddsrouter/exceptions/InitializationException.hpp>
 #include <ddsrouter/participant/implementations/auxiliar/BaseParticipant.hpp>
 
@@ -52,6 +53,12 @@ CommonRTPSRouterParticipant<ConfigurationType>::~CommonRTPSRouterParticipant()
     }
 }
 
+template <class ConfigurationType>
+bool CommonRTPSRouterParticipant<ConfigurationType>::discovers_endpoints() const noexcept
+{
+    return true;
+}
+
 template <class ConfigurationType>
 void CommonRTPSRouterParticipant<ConfigurationType>::onParticipantDiscovery(
         fastrtps::rtps::RTPSParticipant*,
@@ -86,6 +93,8 @@ void CommonRTPSRouterParticipant<ConfigurationType>::onReaderDiscovery(
 {
     if (info.info.guid().guidPrefix != this->rtps_participant_->getGuid().guidPrefix)
     {
+        Endpoint info_reader = create_endpoint_from_info_(info, EndpointKind::READER);
+
         if (info.status == fastrtps::rtps::ReaderDiscoveryInfo::DISCOVERED_READER)
         {
             logInfo(DDSROUTER_DISCOVERY,
@@ -98,11 +107,15 @@ void CommonRTPSRouterParticipant<ConfigurationType>::onReaderDiscovery(
         else if (info.status == fastrtps::rtps::ReaderDiscoveryInfo::REMOVED_READER)
         {
             logInfo(DDSROUTER_DISCOVERY, "Reader " << info.info.guid() << " removed.");
+            info_reader.active(false);
         }
         else
         {
             logInfo(DDSROUTER_DISCOVERY, "Reader " << info.info.guid() << " dropped.");
+            info_reader.active(false);
         }
+
+        update_discovered_endpoint_(info_reader);
     }
 }
 
@@ -113,6 +126,8 @@ void CommonRTPSRouterParticipant<ConfigurationType>::onWriterDiscovery(
 {
     if (info.info.guid().guidPrefix != this->rtps_participant_->getGuid().guidPrefix)
     {
+        Endpoint info_writer = create_endpoint_from_info_(info, EndpointKind::WRITER);
+
         if (info.status == fastrtps::rtps::WriterDiscoveryInfo::DISCOVERED_WRITER)
         {
             logInfo(DDSROUTER_DISCOVERY,
@@ -125,11 +140,15 @@ void CommonRTPSRouterParticipant<ConfigurationType>::onWriterDiscovery(
         else if (info.status == fastrtps::rtps::WriterDiscoveryInfo::REMOVED_WRITER)
         {
             logInfo(DDSROUTER_DISCOVERY, "Writer " << info.info.guid() << " removed.");
+            info_writer.active(false);
         }
         else
         {
             logInfo(DDSROUTER_DISCOVERY, "Writer " << info.info.guid() << " dropped.");
+            info_writer.active(false);
         }
+
+        update_discovered_endpoint_(info_writer);
     }
 }
 
@@ -155,20 +174,65 @@ void CommonRTPSRouterParticipant<ConfigurationType>::create_participant_()
             " in domain " << domain << " with guid " << rtps_participant_->getGuid());
 }
 
+template <class ConfigurationType>
+template <class DiscoveryInfoKind>
+Endpoint CommonRTPSRouterParticipant<ConfigurationType>::create_endpoint_from_info_(
+        const DiscoveryInfoKind& info,
+        EndpointKind kind) const noexcept
+{
+    // Parse QoS
+    QoS info_qos(
+        info.info.m_qos.m_durability.durabilityKind(),
+        info.info.m_qos.m_reliability.kind == fastdds::dds::BEST_EFFORT_RELIABILITY_QOS ?
+        fastrtps::rtps::BEST_EFFORT : fastrtps::rtps::RELIABLE);
+
+    // Parse Topic
+    RealTopic info_topic(std::string(info.info.topicName()), std::string(info.info.typeName()));
+
+    // Id got without locking, as this is called from discovery callbacks
+    return Endpoint(kind, info.info.guid(), info_qos, info_topic, this->id_nts_());
+}
+
+template <class ConfigurationType>
+void CommonRTPSRouterParticipant<ConfigurationType>::update_discovered_endpoint_(
+        const Endpoint& endpoint) noexcept
+{
+    try
+    {
+        if (this->discovery_database_->endpoint_exists(endpoint.guid(), endpoint.discoverer_participant_id()))
+        {
+            this->discovery_database_->update_endpoint(endpoint);
+        }
+        else if (endpoint.active())
+        {
+            this->discovery_database_->add_endpoint(endpoint);
+        }
+    }
+    catch (const InconsistencyException& e)
+    {
+        logWarning(DDSROUTER_DISCOVERY,
+                "Error storing Endpoint " << endpoint << " discovered in Participant " << this->id_nts_() << ": "
+                                          << e.what() << ".");
+    }
+}
+
 template <class ConfigurationType>
 std::shared_ptr<IWriter> CommonRTPSRouterParticipant<ConfigurationType>::create_writer_(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs& specs)
 {
     return std::make_shared<Writer>(
         this->id(), topic,
-        this->payload_pool_, rtps_participant_);
+        this->payload_pool_, rtps_participant_, specs);
 }
 
 template <class ConfigurationType>
 std::shared_ptr<IReader> CommonRTPSRouterParticipant<ConfigurationType>::create_reader_(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs& specs)
 {
-    return std::make_shared<Reader>(this->id(), topic, this->payload_pool_, rtps_participant_);
+    return std::make_shared<Reader>(this->id(), topic, this->payload_pool_, rtps_participant_, specs,
+                   this->configuration_.numa_node());
 }
 
 template <class ConfigurationType>
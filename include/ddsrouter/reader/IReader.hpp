@@ -20,6 +20,8 @@
 #define _DDSROUTER_READER_IDDS_ROUTERREADER_HPP_
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include <ddsrouter/types/Data.hpp>
 #include <ddsrouter/types/ReturnCode.hpp>
@@ -98,6 +100,38 @@ public:
      */
     virtual ReturnCode take(
             std::unique_ptr<DataReceived>& data) noexcept = 0;
+
+    /**
+     * @brief Take several of the oldest received messages from the Reader at once
+     *
+     * This method takes up to \c max_samples samples, oldest first, and appends them to \c data with the same
+     * semantics as \c take .
+     * Implementations should take every sample of the batch under one lock acquisition, so the locking and history
+     * access costs are paid once per batch instead of once per sample.
+     *
+     * @param [out] data : vector where the samples taken are appended
+     * @param [in] max_samples : maximum number of samples to take
+     *
+     * @return \c RETCODE_OK if at least one sample has been taken
+     * @return \c RETCODE_NO_DATA if there is no data to take
+     * @return \c RETCODE_ERROR if there has been any error and no sample has been taken
+     * @return \c RETCODE_NOT_ENABLED if the reader is not enabled (this should not happen)
+     */
+    virtual ReturnCode take_batch(
+            std::vector<std::unique_ptr<DataReceived>>& data,
+            size_t max_samples) noexcept = 0;
+
+    /**
+     * @brief Give back to the Reader the samples taken with \c take_batch
+     *
+     * The objects in \c data are reused by the Reader in following takes, so forwarding data does not require to
+     * allocate new objects in steady state.
+     * The payloads of the samples must have been released before calling this method.
+     *
+     * @param [in,out] data : samples to give back. It is cleared after the call.
+     */
+    virtual void return_loan(
+            std::vector<std::unique_ptr<DataReceived>>& data) noexcept = 0;
 };
 
 } /* namespace ddsrouter */
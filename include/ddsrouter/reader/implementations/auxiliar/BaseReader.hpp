@@ -46,11 +46,13 @@ public:
      * @param participant_id parent participant id
      * @param topic topic that this Reader will refer to
      * @param payload_pool DDS Router shared PayloadPool
+     * @param low_priority whether the topic is low priority, so its data is rejected first by memory budget
      */
     BaseReader(
             const ParticipantId& participant_id,
             const RealTopic& topic,
-            std::shared_ptr<PayloadPool> payload_pool);
+            std::shared_ptr<PayloadPool> payload_pool,
+            bool low_priority = false);
 
     /**
      * @brief Set this Reader as enabled
@@ -110,6 +112,35 @@ public:
     ReturnCode take(
             std::unique_ptr<DataReceived>& data) noexcept override;
 
+    /**
+     * @brief Override take_batch() IReader method
+     *
+     * This method calls the protected method \c take_batch_ to make the actual take function.
+     * It only manages the enable/disable status.
+     *
+     * Thread safe with mutex \c mutex_ .
+     */
+    ReturnCode take_batch(
+            std::vector<std::unique_ptr<DataReceived>>& data,
+            size_t max_samples) noexcept override;
+
+    /**
+     * @brief Override return_loan() IReader method
+     *
+     * Store the objects in \c data so they are reused in next takes.
+     *
+     * Thread safe with mutex \c mutex_ .
+     */
+    void return_loan(
+            std::vector<std::unique_ptr<DataReceived>>& data) noexcept override;
+
+    /**
+     * @brief Number of \c DataReceived objects allocated by this Reader
+     *
+     * Objects given back with \c return_loan are reused, so this number must not grow in steady state.
+     */
+    uint64_t data_allocations() const noexcept;
+
 protected:
 
     /**
@@ -143,6 +174,33 @@ protected:
     virtual ReturnCode take_(
             std::unique_ptr<DataReceived>& data) noexcept = 0;
 
+    /**
+     * @brief Take batch method
+     *
+     * By default it calls \c take_ till \c max_samples samples are taken or there is no more data.
+     * Override this method in Readers that can take several samples cheaper than one by one.
+     */
+    virtual ReturnCode take_batch_(
+            std::vector<std::unique_ptr<DataReceived>>& data,
+            size_t max_samples) noexcept;
+
+    /**
+     * @brief Get an empty \c DataReceived to take a sample in
+     *
+     * It reuses an object from \c data_free_list_ if any, otherwise it allocates a new one.
+     *
+     * @note must be called with mutex \c mutex_ taken
+     */
+    std::unique_ptr<DataReceived> get_data_() noexcept;
+
+    /**
+     * @brief Give back an object got with \c get_data_ that has not been used
+     *
+     * @note must be called with mutex \c mutex_ taken
+     */
+    void recycle_data_(
+            std::unique_ptr<DataReceived>&& data) noexcept;
+
     //! Participant parent ID
     ParticipantId participant_id_;
 
@@ -152,6 +210,9 @@ protected:
     //! DDS Router shared Payload Pool
     std::shared_ptr<PayloadPool> payload_pool_;
 
+    //! Whether the data received is of a low priority topic, rejected when reserving it by memory budget
+    const bool low_priority_;
+
     //! Lambda to call the callback whenever a new data arrives
     std::function<void()> on_data_available_lambda_;
 
@@ -161,6 +222,12 @@ protected:
     //! Whether the Reader is currently enabled
     std::atomic<bool> enabled_;
 
+    //! \c DataReceived objects given back by \c return_loan , ready to be reused
+    std::vector<std::unique_ptr<DataReceived>> data_free_list_;
+
+    //! Number of \c DataReceived objects allocated
+    std::atomic<uint64_t> data_allocations_;
+
     //! Mutex that guards every access to the Reader
     mutable std::recursive_mutex mutex_;
 
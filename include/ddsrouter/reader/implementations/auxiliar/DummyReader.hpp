@@ -71,6 +71,28 @@ protected:
     ReturnCode take_(
             std::unique_ptr<DataReceived>& data) noexcept override;
 
+    /**
+     * @brief Take batch specific method
+     *
+     * Take up to \c max_samples data from \c data_to_send_ with \c dummy_mutex_ taken only once.
+     *
+     * @param data : vector where the data taken is appended
+     * @param max_samples : maximum number of samples to take
+     * @return \c RETCODE_OK if at least one sample has been correctly taken
+     * @return \c RETCODE_NO_DATA if \c data_to_send_ is empty
+     */
+    ReturnCode take_batch_(
+            std::vector<std::unique_ptr<DataReceived>>& data,
+            size_t max_samples) noexcept override;
+
+    /**
+     * @brief Move the oldest data of \c data_to_send_ to \c data . Must be called with \c dummy_mutex_ taken
+     *
+     * @return \c RETCODE_OUT_OF_RESOURCES if the data could not be stored in the payload pool, so it is discarded
+     */
+    ReturnCode take_next_nts_(
+            std::unique_ptr<DataReceived>& data) noexcept;
+
     //! Stores the data that must be retrieved with \c take() method
     std::queue<DummyDataReceived> data_to_send_;
 
@@ -49,6 +49,15 @@ public:
     //! Override take() IReader method
     ReturnCode take(
             std::unique_ptr<DataReceived>& data) noexcept override;
+
+    //! Override take_batch() IReader method
+    ReturnCode take_batch(
+            std::vector<std::unique_ptr<DataReceived>>& data,
+            size_t max_samples) noexcept override;
+
+    //! Override return_loan() IReader method
+    void return_loan(
+            std::vector<std::unique_ptr<DataReceived>>& data) noexcept override;
 };
 
 } /* namespace ddsrouter */
@@ -28,8 +28,11 @@
 #include <fastrtps/rtps/reader/RTPSReader.h>
 #include <fastrtps/rtps/reader/ReaderListener.h>
 
+#include <ddsrouter/communication/payload_pool/ReaderPayloadPool.hpp>
 #include <ddsrouter/reader/implementations/auxiliar/BaseReader.hpp>
+#include <ddsrouter/types/numa.hpp>
 #include <ddsrouter/types/participant/ParticipantId.hpp>
+#include <ddsrouter/types/topic/TopicSpecs.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
@@ -53,6 +56,8 @@ public:
      * @param topic             Topic that this Reader subscribes to.
      * @param payload_pool      Shared Payload Pool to received data and take it.
      * @param rtps_participant  RTPS Participant pointer (this is not stored).
+     * @param specs             Specifications of the topic (e.g. whether it is low priority).
+     * @param numa_node         NUMA node to bind the threads that receive the data of this Reader to.
      *
      * @throw \c InitializationException in case any creation has failed
      */
@@ -60,7 +65,9 @@ public:
             const ParticipantId& participant_id,
             const RealTopic& topic,
             std::shared_ptr<PayloadPool> payload_pool,
-            fastrtps::rtps::RTPSParticipant* rtps_participant);
+            fastrtps::rtps::RTPSParticipant* rtps_participant,
+            const TopicSpecs& specs,
+            int numa_node = numa::NO_NUMA_NODE);
 
     /**
      * @brief Destroy the Reader object
@@ -77,6 +84,7 @@ public:
      *
      * This method is call every time a new CacheChange is received by this Reader.
      * Filter this same Participant messages.
+     * The first time it is called from a thread, the thread is bound to the NUMA node of the Reader, if any.
      * Call the on_data_available_ callback (method \c on_data_available_ from \c BaseReader ).
      *
      * @param [in] change new change received
@@ -119,6 +127,35 @@ protected:
     ReturnCode take_(
             std::unique_ptr<DataReceived>& data) noexcept override;
 
+    /**
+     * @brief Take batch specific method
+     *
+     * Check how many messages there are to take, and take up to \c max_samples of them.
+     * The RTPS Reader mutex is taken and the unread count is checked only once for the whole batch.
+     *
+     * @note guard by mutex \c rtps_mutex_
+     *
+     * @param data : vector where the data taken is appended
+     * @param max_samples : maximum number of samples to take
+     * @return \c RETCODE_OK if at least one sample has been correctly taken
+     * @return \c RETCODE_NO_DATA if there are no messages to take
+     * @return \c RETCODE_ERROR if no message could be taken correctly
+     */
+    ReturnCode take_batch_(
+            std::vector<std::unique_ptr<DataReceived>>& data,
+            size_t max_samples) noexcept override;
+
+    /**
+     * @brief Take next Untaken Change and set \c data with it
+     *
+     * Does not check whether there are messages to take.
+     * Remove this change from Reader History and release.
+     *
+     * @note must be called with mutex \c rtps_mutex_ taken
+     */
+    ReturnCode take_next_change_nts_(
+            std::unique_ptr<DataReceived>& data) noexcept;
+
     /////
     // RTPS specific methods
 
@@ -157,6 +194,16 @@ protected:
     bool come_from_this_participant_(
             const fastrtps::rtps::GUID_t guid) const noexcept;
 
+    /**
+     * @brief Bind the calling thread to \c numa_node_ , if it has not been bound yet
+     *
+     * Fast DDS threads are not created by the DDS Router, so they are bound from the first callback they execute.
+     * Data reserved from then on by the thread are placed in the memory of the node.
+     * A thread is bound only once: a thread shared by Readers of different nodes stays in the node of the first
+     * Reader that has bound it.
+     */
+    void bind_receive_thread_() const noexcept;
+
     /////
     // VARIABLES
 
@@ -166,8 +213,14 @@ protected:
     //! RTPS Reader History associated to \c rtps_reader_
     fastrtps::rtps::ReaderHistory* rtps_history_;
 
+    //! Pool given to \c rtps_reader_ to store the data received in \c payload_pool_
+    std::shared_ptr<ReaderPayloadPool> reader_payload_pool_;
+
     //! Mutex that guards every access to the RTPS Reader
     mutable std::recursive_mutex rtps_mutex_;
+
+    //! NUMA node the receive threads are bound to, or \c numa::NO_NUMA_NODE
+    const int numa_node_;
 };
 
 } /* namespace rtps */
@@ -26,6 +26,8 @@
 namespace eprosima {
 namespace ddsrouter {
 
+class PayloadPool;
+
 //! Kind of every unit that creates a Payload
 using PayloadUnit = eprosima::fastrtps::rtps::octet;
 
@@ -35,9 +37,12 @@ using Payload = fastrtps::rtps::SerializedPayload_t;
 //! Structure of the Data received from a Reader containing the data itself and the attributes of the source
 struct DataReceived
 {
-    //! Payload of the data received. The data in this payload must belong to the PayloadPool.
+    //! Payload of the data received. The data in this payload must belong to \c payload_owner .
     Payload payload;
 
+    //! PayloadPool the data belongs to, that must be used to reference and release it
+    PayloadPool* payload_owner = nullptr;
+
     //! Guid of the source entity that has transmit the data
     Guid source_guid;
 };
@@ -27,6 +27,9 @@ namespace ddsrouter {
 //! Type of Duration in milliseconds
 using Duration_ms = uint32_t;
 
+//! Type of Duration in microseconds
+using Duration_us = uint32_t;
+
 /**
  * Type used to represent time points
  */
@@ -33,8 +33,58 @@ constexpr const char* BLOCKLIST_TAG("blocklist");   //! List of blocked topics
 constexpr const char* TOPIC_NAME_TAG("name");       //! Name of a topic
 constexpr const char* TOPIC_TYPE_NAME_TAG("type");  //! Type name of a topic
 constexpr const char* TOPIC_KIND_TAG("keyed");      //! Kind of a topic (with or without key)
+constexpr const char* TOPIC_SPIN_BUDGET_TAG("spin-budget"); //! Microseconds a topic Track polls before parking
+constexpr const char* TOPIC_INLINE_TAG("inline");   //! Whether a topic is forwarded by the thread receiving it
+constexpr const char* TOPIC_EGRESS_QUEUE_TAG("egress-queue"); //! Max samples queued in each Writer of a topic
+constexpr const char* TOPIC_EGRESS_OVERFLOW_TAG("egress-overflow"); //! What to do when an egress queue is full
+constexpr const char* TOPIC_EGRESS_OVERFLOW_DROP_OLDEST_TAG("drop-oldest"); //! Drop oldest queued sample
+constexpr const char* TOPIC_EGRESS_OVERFLOW_DROP_NEWEST_TAG("drop-newest"); //! Drop new sample
+constexpr const char* TOPIC_EGRESS_OVERFLOW_BLOCK_TAG("block"); //! Wait until the sample fits in the queue
+constexpr const char* TOPIC_PARALLEL_FANOUT_TAG("parallel-fanout"); //! Whether Writers of a topic are written concurrently
+constexpr const char* TOPIC_HISTORY_DEPTH_TAG("history-depth"); //! Samples kept by each Writer history (KEEP_LAST)
+constexpr const char* TOPIC_HISTORY_MAX_SAMPLES_TAG("history-max-samples"); //! Max samples of a KEEP_ALL history
+constexpr const char* TOPIC_LOW_PRIORITY_TAG("low-priority"); //! Whether data is discarded first when memory runs out
+constexpr const char* TOPIC_SKIP_WITHOUT_READERS_TAG("skip-without-readers"); //! Skip Writers without matched readers
+constexpr const char* TOPIC_ZERO_COPY_TAG("zero-copy"); //! Whether a topic must be forwarded without copying its data
 
 constexpr const char* PARTICIPANT_TYPE_TAG("type"); //! Participant Type
+constexpr const char* PARTICIPANT_NUMA_NODE_TAG("numa-node"); //! NUMA node of the receive path and payloads
+
+// DDS Router specs related tags
+constexpr const char* SPECS_TAG("specs");               //! DDS Router internal specifications
+constexpr const char* NUMBER_THREADS_TAG("threads");    //! Number of threads of the DDS Router thread pool
+constexpr const char* THREAD_PER_TRACK_TAG("thread-per-track"); //! Run every Track in its own thread
+constexpr const char* PAYLOAD_POOL_TAG("payload-pool");  //! Payload pool shared by every Participant
+constexpr const char* PAYLOAD_POOL_TYPE_TAG("type");     //! Implementation of the payload pool
+constexpr const char* PAYLOAD_POOL_MAP_TAG("map");       //! Payload pool with reference counters in a map
+constexpr const char* PAYLOAD_POOL_REFCOUNT_TAG("refcount"); //! Payload pool with lock free reference counters
+constexpr const char* PAYLOAD_POOL_SLAB_TAG("slab");     //! Payload pool recycling data by size class
+constexpr const char* PAYLOAD_POOL_ARENA_TAG("arena");   //! Slab payload pool carving data from a mapped region
+constexpr const char* PAYLOAD_POOL_COPY_SIZE_TAG("copy-size"); //! Bytes reserved to copy data from other pool
+constexpr const char* PAYLOAD_POOL_COPY_MAX_SIZE_TAG("max-size"); //! Reserve the max size of the source
+constexpr const char* PAYLOAD_POOL_COPY_LENGTH_TAG("length"); //! Reserve the length of the data
+constexpr const char* PAYLOAD_POOL_COPY_SIZE_CLASS_TAG("size-class"); //! Reserve the length rounded to a power of two
+constexpr const char* PAYLOAD_POOL_MEMORY_BUDGET_TAG("memory-budget"); //! Maximum bytes reserved at the same time
+constexpr const char* PAYLOAD_POOL_MEMORY_POLICY_TAG("memory-policy"); //! Action when a data does not fit in budget
+constexpr const char* PAYLOAD_POOL_MEMORY_REJECT_TAG("reject"); //! Discard the data
+constexpr const char* PAYLOAD_POOL_MEMORY_EVICT_TAG("evict"); //! Remove samples from Writers histories
+constexpr const char* PAYLOAD_POOL_MEMORY_BLOCK_TAG("block"); //! Wait for memory to be released
+constexpr const char* PAYLOAD_POOL_MEMORY_BLOCK_TIMEOUT_TAG("memory-block-timeout"); //! Max wait for memory in ms
+constexpr const char* PAYLOAD_POOL_PREALLOCATE_TAG("preallocate"); //! Payloads allocated in advance
+constexpr const char* PAYLOAD_POOL_SIZE_TAG("size");     //! Size of the payloads preallocated
+constexpr const char* PAYLOAD_POOL_COUNT_TAG("count");   //! Number of payloads preallocated
+constexpr const char* PAYLOAD_POOL_MAX_SIZE_CLASS_TAG("max-size-class"); //! Size of the largest size class recycled
+constexpr const char* PAYLOAD_POOL_ARENA_SIZE_TAG("arena-size"); //! Bytes of the region mapped by arena pool
+constexpr const char* PAYLOAD_POOL_HUGE_PAGES_TAG("huge-pages"); //! Back the arena with huge pages
+constexpr const char* PAYLOAD_POOL_PREFAULT_TAG("prefault"); //! Touch every page of the arena in creation
+constexpr const char* PAYLOAD_POOL_DEDUP_TAG("dedup");   //! Share the memory of identical data
+constexpr const char* PAYLOAD_POOL_DEDUP_MIN_SIZE_TAG("dedup-min-size"); //! Minimum length of data deduplicated
+constexpr const char* PAYLOAD_POOL_SMALL_PAYLOAD_SIZE_TAG("small-payload-size"); //! Max size of data in the free list
+constexpr const char* PAYLOAD_POOL_SMALL_PAYLOAD_COUNT_TAG("small-payload-count"); //! Blocks of the free list
+constexpr const char* INTEREST_DRIVEN_ENDPOINTS_TAG("interest-driven-endpoints"); //! Create endpoints on discovery
+constexpr const char* LAZY_BRIDGES_TAG("lazy-bridges"); //! Create topics on the discovery of a remote Writer
+constexpr const char* ENDPOINT_GRACE_PERIOD_TAG("endpoint-grace-period"); //! Time in ms idle endpoints are kept
+constexpr const char* BRIDGE_IDLE_TIMEOUT_TAG("bridge-idle-timeout"); //! Time in ms idle Bridges are kept
 
 // RTPS related tags
 // Simple RTPS related tags
@@ -21,6 +21,7 @@
 
 #include <ddsrouter/types/endpoint/Guid.hpp>
 #include <ddsrouter/types/endpoint/QoS.hpp>
+#include <ddsrouter/types/participant/ParticipantId.hpp>
 #include <ddsrouter/types/topic/RealTopic.hpp>
 
 namespace eprosima {
@@ -48,12 +49,15 @@ public:
 
     /**
      * Constructor with Endpoint information
+     *
+     * @param discoverer_participant_id: Id of the Participant that has discovered the endpoint, invalid if unknown
      */
     Endpoint(
             const EndpointKind& kind,
             const Guid& guid,
             const QoS& qos,
-            const RealTopic& topic) noexcept;
+            const RealTopic& topic,
+            const ParticipantId& discoverer_participant_id = ParticipantId()) noexcept;
 
     //! Endpoint kind getter
     EndpointKind kind() const noexcept;
@@ -67,6 +71,9 @@ public:
     //! Topic getter
     RealTopic topic() const noexcept;
 
+    //! Id of the Participant that has discovered the endpoint
+    ParticipantId discoverer_participant_id() const noexcept;
+
     //! Whether the endpoint referenced is currently active
     bool active() const noexcept;
 
@@ -109,6 +116,9 @@ protected:
     //! Topic that this endpoint belongs to
     RealTopic topic_;
 
+    //! Participant of this DDS Router that has discovered the endpoint
+    ParticipantId discoverer_participant_id_;
+
     //! Whether the endpoint is currently active
     bool active_;
 
@@ -0,0 +1,94 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file numa.hpp
+ *
+ * This file contains functions to place threads and memory in the NUMA nodes of the host
+ */
+
+#ifndef _DDSROUTER_TYPES_NUMA_HPP_
+#define _DDSROUTER_TYPES_NUMA_HPP_
+
+#include <cstddef>
+#include <set>
+#include <string>
+
+namespace eprosima {
+namespace ddsrouter {
+namespace numa {
+
+//! Value of a NUMA node not set
+constexpr const int NO_NUMA_NODE = -1;
+
+/**
+ * @brief Number of NUMA nodes of the host
+ *
+ * Hosts without NUMA support, or where it could not be checked, have a single node.
+ */
+unsigned int number_of_nodes() noexcept;
+
+/**
+ * @brief CPUs of NUMA node \c node
+ *
+ * @return set of CPU indexes, empty if the node does not exist or it could not be checked
+ */
+std::set<unsigned int> node_cpus(
+        int node) noexcept;
+
+/**
+ * @brief Parse a list of CPUs as written by the kernel, e.g. "0-3,8,10-11"
+ *
+ * @return set of CPU indexes, empty if the list is not well formed
+ */
+std::set<unsigned int> parse_cpu_list(
+        const std::string& cpu_list) noexcept;
+
+/**
+ * @brief Bind the calling thread to the CPUs of \c node and prefer the memory of \c node for its allocations
+ *
+ * Memory already allocated is not moved.
+ *
+ * @return whether the thread has been bound
+ */
+bool bind_thread_to_node(
+        int node) noexcept;
+
+/**
+ * @brief Bind the pages of the memory region starting at \c address to \c node
+ *
+ * Pages not touched yet are allocated in \c node when first touched, and pages already touched are moved.
+ * \c address must be aligned to the page size.
+ *
+ * @return whether the region has been bound
+ */
+bool bind_memory_to_node(
+        void* address,
+        size_t size,
+        int node) noexcept;
+
+/**
+ * @brief NUMA node where the page of \c address resides
+ *
+ * @return node of the page, or \c NO_NUMA_NODE if it could not be checked
+ */
+int node_of_address(
+        const void* address) noexcept;
+
+} /* namespace numa */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_TYPES_NUMA_HPP_ */
@@ -65,6 +65,14 @@ public:
      */
     bool is_valid() const noexcept;
 
+    /**
+     * @brief Whether Participants of this type connect with other DDS Routers
+     *
+     * WAN and Discovery Server Participants are used to link routers, so the endpoints they discover may belong to
+     * other routers instead of to user applications.
+     */
+    bool connects_routers() const noexcept;
+
     //! Convert this ParticipantType to string using the << operator
     std::string to_string() const noexcept;
 
@@ -0,0 +1,145 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TopicSpecs.hpp
+ */
+
+#ifndef _DDSROUTER_TYPES_TOPIC_TOPICSPECS_HPP_
+#define _DDSROUTER_TYPES_TOPIC_TOPICSPECS_HPP_
+
+#include <ostream>
+
+#include <ddsrouter/types/Time.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+//! What a Writer egress queue does with a new sample when it is full
+enum EgressOverflowPolicy
+{
+    //! Discard the oldest sample in the queue to make room for the new one
+    DROP_OLDEST,
+    //! Discard the new sample
+    DROP_NEWEST,
+    //! Keep the Track that writes the sample until there is room in the queue
+    BLOCK
+};
+
+/**
+ * Specifications of how the DDS Router handles the data of a topic.
+ *
+ * They are configured in the allowlist entry that the topic matches. Every value not configured takes its default,
+ * that reproduces the behaviour of a topic without specifications.
+ */
+struct TopicSpecs
+{
+    /**
+     * Time that a Track keeps polling its Reader when it runs out of data, before parking its transmission.
+     *
+     * Data arriving during this time is forwarded by the same thread without waking any other thread, at the cost
+     * of keeping a thread of the pool busy. 0 parks the transmission as soon as there is no data.
+     */
+    Duration_us spin_budget = 0;
+
+    /**
+     * Whether the data is forwarded by the thread that receives it.
+     *
+     * This avoids the hand-off to a thread of the pool, but the reception of new data in the Reader is blocked while
+     * the data is being written. Use it only for small payloads and writers that do not block.
+     * It only forwards a single batch, and it is ignored with egress queues or a payload pool that waits for memory.
+     */
+    bool inline_forwarding = false;
+
+    /**
+     * Maximum number of samples waiting to be sent in the egress queue of each Writer.
+     *
+     * With an egress queue every Writer sends its data from its own task, so a slow or congested Writer does not
+     * delay the rest of Writers of the topic. Queued samples reference the payload, they are not copied.
+     * 0 disables the queues and every Writer is written directly by the Track.
+     */
+    unsigned int egress_queue_size = 0;
+
+    //! What to do with a new sample when the egress queue of a Writer is full
+    EgressOverflowPolicy egress_overflow_policy = EgressOverflowPolicy::BLOCK;
+
+    /**
+     * Whether the data is written in the different Writers concurrently.
+     *
+     * Each Writer is written from its own task in the thread pool, referencing the same payload, so the latency of
+     * a sample does not grow with the number of Participants. It uses the egress queues of the Writers, with a
+     * default size if \c egress_queue_size is not set.
+     */
+    bool parallel_fanout = false;
+
+    /**
+     * Number of samples kept in the history of each Writer (KEEP_LAST).
+     *
+     * When the history is full, the oldest sample is removed and its payload released to make room for the new one.
+     * 0 keeps every sample (KEEP_ALL), limited by \c history_max_samples .
+     */
+    unsigned int history_depth = 0;
+
+    /**
+     * Maximum number of samples in the history of each Writer when it keeps every sample (KEEP_ALL).
+     *
+     * When the history is full, only samples already acknowledged by every reader are removed. If there is none,
+     * the new sample is not written and it is counted as dropped in \c TrackStatistics . The Track does not wait for
+     * samples to be acknowledged, as it would delay the data of every Writer of the topic. 0 does not limit the
+     * history.
+     */
+    unsigned int history_max_samples = 0;
+
+    /**
+     * Whether the data of this topic is discarded first when the memory budget of the payload pool is running out.
+     *
+     * Once the memory reserved reaches \c PayloadPool::LOW_PRIORITY_BUDGET_RATIO of the budget, the Readers of low
+     * priority topics reject the data they receive before reserving it, so the rest of the budget is left for the
+     * rest of topics.
+     */
+    bool low_priority = false;
+
+    /**
+     * Whether the data is not written in the Writers that are not matched with any remote reader.
+     *
+     * It saves the cost of writing data nobody would receive, but the data skipped is not kept in the history of the
+     * Writer, so readers that match later do not receive it even if they are TRANSIENT_LOCAL. Hence, it is only
+     * meant for topics without late joiners, e.g. VOLATILE ones.
+     */
+    bool skip_without_readers = false;
+
+    /**
+     * Whether the data of this topic must be forwarded without copying its payload.
+     *
+     * The Bridge of the topic is not created if any of its Tracks would copy the data to send it, e.g. because
+     * the Participants use different payload pools, and every data copied while being sent is logged as an error.
+     * It is meant to check in tests that a path is zero copy.
+     */
+    bool zero_copy = false;
+};
+
+//! \c EgressOverflowPolicy to stream serialization
+std::ostream& operator <<(
+        std::ostream& os,
+        const EgressOverflowPolicy& policy);
+
+//! \c TopicSpecs to stream serialization
+std::ostream& operator <<(
+        std::ostream& os,
+        const TopicSpecs& specs);
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_TYPES_TOPIC_TOPICSPECS_HPP_ */
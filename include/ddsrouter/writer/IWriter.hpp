@@ -78,6 +78,17 @@ public:
      */
     virtual ReturnCode write(
             std::unique_ptr<DataReceived>& data) noexcept = 0;
+
+    /**
+     * @brief Whether the data written would currently reach any remote endpoint
+     *
+     * It is called before writing every data of the topics that skip Writers without readers, so it must be cheap
+     * and must not lock any mutex.
+     * Writers that do not know which endpoints receive their data should always return true.
+     *
+     * @return false if no remote endpoint would receive a data written now
+     */
+    virtual bool has_remote_readers() const noexcept = 0;
 };
 
 } /* namespace ddsrouter */
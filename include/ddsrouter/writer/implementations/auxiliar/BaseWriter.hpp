@@ -85,6 +85,13 @@ public:
     virtual ReturnCode write(
             std::unique_ptr<DataReceived>& data) noexcept override;
 
+    /**
+     * @brief Override has_remote_readers() IWriter method
+     *
+     * By default every Writer is considered to have remote readers.
+     */
+    virtual bool has_remote_readers() const noexcept override;
+
 protected:
 
     /**
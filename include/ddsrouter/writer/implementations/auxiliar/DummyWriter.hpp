@@ -19,9 +19,11 @@
 #ifndef _DATABROKER_WRITER_IMPLEMENTATIONS_AUX_DUMMYWRITER_HPP_
 #define _DATABROKER_WRITER_IMPLEMENTATIONS_AUX_DUMMYWRITER_HPP_
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 
+#include <ddsrouter/types/numa.hpp>
 #include <ddsrouter/types/participant/ParticipantId.hpp>
 #include <ddsrouter/types/Time.hpp>
 #include <ddsrouter/writer/implementations/auxiliar/BaseWriter.hpp>
@@ -42,6 +44,9 @@ struct DummyDataStored
 
     //! Timestamp of the theoretic publication time
     Timestamp timestamp;
+
+    //! NUMA node of the memory of the payload sent, only checked if the Writer is placed in a NUMA node
+    int numa_node = numa::NO_NUMA_NODE;
 };
 
 /**
@@ -51,8 +56,19 @@ class DummyWriter : public BaseWriter
 {
 public:
 
-    //! Use parent constructors
-    using BaseWriter::BaseWriter;
+    /**
+     * @brief Construct a new Dummy Writer object
+     *
+     * @param participant_id id of participant
+     * @param topic topic that this Writer will refer to
+     * @param payload_pool DDS Router shared PayloadPool
+     * @param check_numa_node whether to store the NUMA node of the memory of each payload sent
+     */
+    DummyWriter(
+            const ParticipantId& participant_id,
+            const RealTopic& topic,
+            std::shared_ptr<PayloadPool> payload_pool,
+            bool check_numa_node = false);
 
     /**
      * @brief Get the data that should have been sent by this writer
@@ -70,6 +86,27 @@ public:
     void wait_until_n_data_sent(
             uint16_t n) const noexcept;
 
+    //! Override has_remote_readers() IWriter method. True unless simulated otherwise
+    bool has_remote_readers() const noexcept override;
+
+    /**
+     * @brief Simulate whether this Writer is matched with any remote reader
+     *
+     * @param [in] remote_readers : whether the Writer has remote readers
+     */
+    void simulate_remote_readers(
+            bool remote_readers) noexcept;
+
+    /**
+     * @brief Simulate whether the history of this Writer is full of data not acknowledged
+     *
+     * Meanwhile, the data written is not sent and \c RETCODE_OUT_OF_RESOURCES is returned, as a KEEP_ALL Writer does.
+     *
+     * @param [in] full_history : whether the history of the Writer is full
+     */
+    void simulate_full_history(
+            bool full_history) noexcept;
+
 protected:
 
     /**
@@ -79,7 +116,8 @@ protected:
      * had published.
      *
      * @param data : data to simulate publication
-     * @return RETCODE_OK always
+     * @return RETCODE_OK if the data has been stored
+     * @return RETCODE_OUT_OF_RESOURCES if the history is simulated to be full
      */
     ReturnCode write_(
             std::unique_ptr<DataReceived>& data) noexcept override;
@@ -94,6 +132,15 @@ protected:
 
     //! Guard access to \c data_stored_
     mutable std::mutex dummy_mutex_;
+
+    //! Whether this Writer simulates to be matched with remote readers
+    std::atomic<bool> remote_readers_ {true};
+
+    //! Whether this Writer simulates to have its history full
+    std::atomic<bool> full_history_ {false};
+
+    //! Whether the NUMA node of the memory of each payload sent is stored
+    const bool check_numa_node_;
 };
 
 } /* namespace ddsrouter */
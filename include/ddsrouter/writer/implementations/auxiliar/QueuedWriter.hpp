@@ -0,0 +1,197 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file QueuedWriter.hpp
+ */
+
+#ifndef _DDSROUTER_WRITER_IMPLEMENTATIONS_AUX_QUEUEDWRITER_HPP_
+#define _DDSROUTER_WRITER_IMPLEMENTATIONS_AUX_QUEUEDWRITER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ddsrouter/communication/payload_pool/PayloadPool.hpp>
+#include <ddsrouter/communication/thread_pool/SlotThreadPool.hpp>
+#include <ddsrouter/types/topic/TopicSpecs.hpp>
+#include <ddsrouter/writer/IWriter.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+/**
+ * Writer that decouples the write of the data from the actual Writer by a bounded egress queue.
+ *
+ * The data written is stored in the queue referencing its payload (it is not copied), and it is sent to the
+ * internal Writer by a task of the thread pool. This way, a slow Writer only delays its own data, and the
+ * Track that writes it can keep forwarding data to the rest of Writers.
+ *
+ * When the queue is full, the new data is handled as the \c EgressOverflowPolicy set says.
+ * With \c BLOCK , the write waits for the drain task to make room, and only sends data itself when the drain task
+ * has not run for \c DRAIN_STALL_PERIOD_ , as every thread of the pool may be waiting for a full queue.
+ */
+class QueuedWriter : public IWriter
+{
+public:
+
+    /**
+     * @brief Construct a new Queued Writer object
+     *
+     * The samples of the queue are allocated in advance, so writing does not allocate memory.
+     *
+     * @param writer Writer that actually sends the data
+     * @param payload_pool DDS Router shared PayloadPool
+     * @param thread_pool DDS Router shared thread pool where the queue is drained
+     * @param max_size maximum number of samples in the queue (at least 1)
+     * @param overflow_policy what to do with new data when the queue is full
+     */
+    QueuedWriter(
+            std::shared_ptr<IWriter> writer,
+            std::shared_ptr<PayloadPool> payload_pool,
+            std::shared_ptr<SlotThreadPool> thread_pool,
+            unsigned int max_size,
+            EgressOverflowPolicy overflow_policy);
+
+    /**
+     * @brief Destroy the Queued Writer object
+     *
+     * Wait for the data being sent, and release the payloads of the data still in the queue.
+     */
+    virtual ~QueuedWriter();
+
+    //! Enable the internal Writer and start draining the queue
+    void enable() noexcept override;
+
+    /**
+     * @brief Disable the internal Writer
+     *
+     * The data in the queue is discarded, as a disabled Writer does not send data.
+     */
+    void disable() noexcept override;
+
+    /**
+     * @brief Store the data in the queue to be sent by the internal Writer
+     *
+     * The payload is referenced from the PayloadPool, so \c data keeps its payload and can be released
+     * by the caller. It is referenced before locking the queue, so a PayloadPool that waits for memory to be
+     * released does not stop the drain of the queue meanwhile.
+     *
+     * @return \c RETCODE_OK if the data has been queued or dropped by the overflow policy
+     * @return \c RETCODE_ERROR if the payload could not be referenced
+     * @return \c RETCODE_NOT_ENABLED if the writer is not enabled
+     */
+    ReturnCode write(
+            std::unique_ptr<DataReceived>& data) noexcept override;
+
+    //! Whether the internal Writer has remote readers
+    bool has_remote_readers() const noexcept override;
+
+    //! Number of samples discarded because the queue or the history of the internal Writer was full
+    uint64_t dropped_samples() const noexcept;
+
+    //! Number of samples waiting in the queue
+    size_t queued_samples() const noexcept;
+
+protected:
+
+    /**
+     * @brief Send the data in the queue through the internal Writer
+     *
+     * This is the task executed in the thread pool. After sending \c MAX_WRITES_PER_TASK_ samples
+     * it emits itself again so other tasks can use the thread.
+     */
+    void drain_() noexcept;
+
+    /**
+     * @brief Send the oldest sample in the queue through the internal Writer
+     *
+     * Thread safe with mutex \c drain_mutex_ , so samples are sent in order.
+     *
+     * @return whether a sample has been sent
+     */
+    bool write_next_() noexcept;
+
+    //! Release the payloads of every sample in the queue and empty it. Guarded by \c queue_mutex_
+    void clear_queue_nts_() noexcept;
+
+    /**
+     * @brief Get a sample from \c free_data_ . Guarded by \c queue_mutex_
+     *
+     * A new one is allocated only if it is empty, which happens when several threads write at the same time
+     * in a full queue.
+     */
+    std::unique_ptr<DataReceived> take_free_sample_nts_() noexcept;
+
+    //! Release the payload of \c sample and keep it in \c free_data_ to be reused. Guarded by \c queue_mutex_
+    void release_sample_nts_(
+            std::unique_ptr<DataReceived>& sample) noexcept;
+
+    //! Writer that actually sends the data
+    std::shared_ptr<IWriter> writer_;
+
+    //! DDS Router shared Payload Pool
+    std::shared_ptr<PayloadPool> payload_pool_;
+
+    //! DDS Router shared thread pool
+    std::shared_ptr<SlotThreadPool> thread_pool_;
+
+    //! Maximum number of samples in \c queue_
+    const unsigned int max_size_;
+
+    //! What to do when \c queue_ is full
+    const EgressOverflowPolicy overflow_policy_;
+
+    //! Id of the task that drains the queue in \c thread_pool_
+    TaskId drain_slot_id_;
+
+    //! Whether the Writer is currently enabled
+    std::atomic<bool> enabled_;
+
+    //! Samples waiting to be sent, oldest first
+    std::deque<std::unique_ptr<DataReceived>> queue_;
+
+    //! Samples already sent, kept to be reused and avoid allocations
+    std::vector<std::unique_ptr<DataReceived>> free_data_;
+
+    //! Whether the drain task is being executed
+    std::atomic<bool> draining_;
+
+    //! Number of samples dropped
+    std::atomic<uint64_t> dropped_samples_;
+
+    //! Guard access to \c queue_ and \c free_data_
+    mutable std::mutex queue_mutex_;
+
+    //! Notified when a sample leaves the queue or the Writer is disabled. Used with \c queue_mutex_
+    std::condition_variable room_available_cv_;
+
+    //! Guard the sending of data, so it is always sent in order
+    std::mutex drain_mutex_;
+
+    //! Number of samples sent in a single execution of the drain task
+    static constexpr unsigned int MAX_WRITES_PER_TASK_ = 128;
+
+    //! Time a write waits for room in a full queue before checking whether the drain task is running
+    static constexpr std::chrono::milliseconds DRAIN_STALL_PERIOD_ = std::chrono::milliseconds(10);
+};
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _DDSROUTER_WRITER_IMPLEMENTATIONS_AUX_QUEUEDWRITER_HPP_ */
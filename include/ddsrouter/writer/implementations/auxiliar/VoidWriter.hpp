@@ -41,6 +41,9 @@ public:
     //! Override write() IWriter method
     ReturnCode write(
             std::unique_ptr<DataReceived>& data) noexcept override;
+
+    //! Override has_remote_readers() IWriter method. Data written never reaches anything
+    bool has_remote_readers() const noexcept override;
 };
 
 } /* namespace ddsrouter */
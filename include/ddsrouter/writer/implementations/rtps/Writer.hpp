@@ -19,6 +19,8 @@
 #ifndef _DDSROUTER_WRITER_IMPLEMENTATIONS_RTPS_WRITER_HPP_
 #define _DDSROUTER_WRITER_IMPLEMENTATIONS_RTPS_WRITER_HPP_
 
+#include <atomic>
+
 #include <fastdds/rtps/rtps_fwd.h>
 #include <fastrtps/rtps/attributes/HistoryAttributes.h>
 #include <fastrtps/attributes/TopicAttributes.h>
@@ -26,8 +28,10 @@
 #include <fastrtps/rtps/history/WriterHistory.h>
 #include <fastrtps/rtps/attributes/WriterAttributes.h>
 #include <fastrtps/rtps/writer/RTPSWriter.h>
+#include <fastrtps/rtps/writer/WriterListener.h>
 
 #include <ddsrouter/types/participant/ParticipantId.hpp>
+#include <ddsrouter/types/topic/TopicSpecs.hpp>
 #include <ddsrouter/writer/implementations/auxiliar/BaseWriter.hpp>
 
 namespace eprosima {
@@ -36,8 +40,11 @@ namespace rtps {
 
 /**
  * Standard RTPS Writer with less restrictive Attributes.
+ *
+ * It implements the WriterListener for itself with \c onWriterMatched callback, in order to know whether
+ * there is any remote reader to send the data to.
  */
-class Writer : public BaseWriter
+class Writer : public BaseWriter, public fastrtps::rtps::WriterListener
 {
 public:
 
@@ -50,6 +57,7 @@ public:
      * @param topic             Topic that this Writer subscribes to.
      * @param payload_pool      Shared Payload Pool to received data and take it.
      * @param rtps_participant  RTPS Participant pointer (this is not stored).
+     * @param specs             Specifications of the topic, that set the limits of the Writer History.
      *
      * @throw \c InitializationException in case any creation has failed
      */
@@ -57,7 +65,8 @@ public:
             const ParticipantId& participant_id,
             const RealTopic& topic,
             std::shared_ptr<PayloadPool> payload_pool,
-            fastrtps::rtps::RTPSParticipant* rtps_participant);
+            fastrtps::rtps::RTPSParticipant* rtps_participant,
+            const TopicSpecs& specs);
 
     /**
      * @brief Destroy the Writer object
@@ -69,6 +78,30 @@ public:
      */
     virtual ~Writer();
 
+    /**
+     * @brief Override has_remote_readers() IWriter method
+     *
+     * It does not lock any mutex, it only reads \c matched_readers_ .
+     *
+     * @return whether this Writer is matched with any reader of other Participant
+     */
+    bool has_remote_readers() const noexcept override;
+
+    /////
+    // LISTENER METHODS
+
+    /**
+     * @brief Writer Listener callback when a new Reader is matched or unmatched
+     *
+     * This method is call every time a new Reader is matched or unmatched from this Writer.
+     * It updates the number of readers matched, ignoring the ones from this same Participant.
+     *
+     * @param [in] info information about the matched Reader
+     */
+    void onWriterMatched(
+            fastrtps::rtps::RTPSWriter* writer,
+            fastrtps::rtps::MatchingInfo& info) noexcept override;
+
 protected:
 
     // Specific enable/disable do not need to be implemented
@@ -91,6 +124,26 @@ protected:
     virtual ReturnCode write_(
             std::unique_ptr<DataReceived>& data) noexcept override;
 
+    /**
+     * @brief Remove old changes from a bounded History so a new change fits in it
+     *
+     * With KEEP_LAST the oldest changes are removed. With KEEP_ALL only the oldest changes acknowledged by every
+     * reader are removed. The payloads of the removed changes are released to the PayloadPool.
+     *
+     * @return whether there is room for a new change
+     */
+    bool make_room_in_history_() noexcept;
+
+    /**
+     * @brief Remove the oldest change of the History to release its payload to the PayloadPool
+     *
+     * It is registered in the PayloadPool as memory reclaimer, so it is called from other threads when the memory
+     * budget is reached. It does not wait for the History if it is being used by other thread.
+     *
+     * @return whether a change has been removed
+     */
+    bool reclaim_memory_() noexcept;
+
     /////
     // RTPS specific methods
 
@@ -128,6 +181,18 @@ protected:
 
     //! RTPS Writer History associated to \c rtps_reader_
     fastrtps::rtps::WriterHistory* rtps_history_;
+
+    //! Number of changes kept in \c rtps_history_ (KEEP_LAST). 0 for KEEP_ALL
+    const unsigned int history_depth_;
+
+    //! Maximum number of changes in \c rtps_history_ with KEEP_ALL. 0 for unlimited
+    const unsigned int history_max_samples_;
+
+    //! Id of \c reclaim_memory_ registered in the PayloadPool
+    uint64_t memory_reclaimer_id_;
+
+    //! Number of readers of other Participants currently matched with \c rtps_writer_
+    std::atomic<uint32_t> matched_readers_;
 };
 
 } /* namespace rtps */
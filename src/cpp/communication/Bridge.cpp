@@ -18,8 +18,11 @@
  */
 
 #include <ddsrouter/communication/Bridge.hpp>
+#include <ddsrouter/exceptions/InitializationException.hpp>
 #include <ddsrouter/exceptions/UnsupportedException.hpp>
 #include <ddsrouter/types/Log.hpp>
+#include <ddsrouter/types/utils.hpp>
+#include <ddsrouter/writer/implementations/auxiliar/QueuedWriter.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
@@ -27,39 +30,62 @@ namespace ddsrouter {
 Bridge::Bridge(
         const RealTopic& topic,
         std::shared_ptr<ParticipantsDatabase> participants_database,
-        std::shared_ptr<PayloadPool> payload_pool,
-        bool enable /* = false */)
+        const std::map<ParticipantId, std::shared_ptr<PayloadPool>>& payload_pools,
+        std::shared_ptr<SlotThreadPool> thread_pool,
+        const TopicSpecs& specs,
+        bool enable /* = false */,
+        bool interest_driven /* = false */)
     : topic_(topic)
     , participants_(participants_database)
-    , payload_pool_(payload_pool)
+    , payload_pools_(payload_pools)
+    , thread_pool_(thread_pool)
+    , specs_(specs)
+    , egress_queue_size_(specs.egress_queue_size)
+    , interest_driven_(interest_driven)
     , enabled_(false)
 {
     logDebug(DDSROUTER_BRIDGE, "Creating Bridge " << *this << ".");
 
     std::set<ParticipantId> ids = participants_->get_participants_ids();
 
-    // Generate readers and writers for each participant
-    for (ParticipantId id: ids)
+    // Zero copy topics are checked before creating any endpoint
+    if (specs_.zero_copy)
     {
-        std::shared_ptr<IParticipant> participant = participants_->get_participant(id);
-        writers_[id] = participant->create_writer(topic);
-        readers_[id] = participant->create_reader(topic);
+        check_zero_copy_(ids);
     }
 
-    // Generate tracks
-    for (ParticipantId id: ids)
+    // Parallel fan-out only makes sense when each Track writes in more than one Writer
+    bool parallel_fanout = specs_.parallel_fanout && ids.size() > 2;
+    if (parallel_fanout && egress_queue_size_ == 0)
     {
-        // List of all Participants
-        std::map<ParticipantId, std::shared_ptr<IWriter>> writers_except_one =
-                writers_; // Create a copy of the map
+        egress_queue_size_ = DEFAULT_FANOUT_QUEUE_SIZE_;
+    }
 
-        // Get this Track source participant before removing it from map
-        writers_except_one.erase(id); // TODO: check if this element is removed in erase or if source is still valid
+    // The thread of a Reader must not wait for an egress queue or for memory, so the data is handed off to the pool
+    if (specs_.inline_forwarding && !inline_forwarding_supported_())
+    {
+        logWarning(DDSROUTER_BRIDGE,
+                "Topic " << topic_ << " is not forwarded inline, as its Writers are queued or may wait for memory.");
+        specs_.inline_forwarding = false;
+    }
+
+    // Generate writers for each participant whose endpoints are not created on demand
+    for (ParticipantId id: ids)
+    {
+        if (!interest_driven_participant_(id))
+        {
+            create_writer_(id);
+        }
+    }
 
-        // This insert is required as there is no copy method for Track
-        // Tracks are always created disabled and then enabled with Bridge enable() method
-        tracks_[id] =
-                std::make_unique<Track>(topic_, id, readers_[id], std::move(writers_except_one), payload_pool_, false);
+    // Generate readers and their tracks
+    // Tracks are always created disabled and then enabled with Bridge enable() method
+    for (ParticipantId id: ids)
+    {
+        if (!interest_driven_participant_(id))
+        {
+            create_reader_(id);
+        }
     }
 
     if (enable)
@@ -80,23 +106,21 @@ Bridge::~Bridge()
     // Force deleting tracks before deleting Bridge
     tracks_.clear();
 
-    // Remove all Writers and Readers that were created in construction
-    for (ParticipantId id: participants_->get_participants_ids())
-    {
-        std::shared_ptr<IParticipant> participant = participants_->get_participant(id);
-        auto writer = writers_.find(id);
-        auto reader = readers_.find(id);
-
-        // Writer and Reader must exist in this Bridge Map for each participant
-        assert(writer != writers_.end());
-        assert(reader != readers_.end());
+    // Egress queues must be destroyed before the writers they send data to
+    egress_writers_.clear();
 
-        participant->delete_writer(writer->second);
-        participant->delete_reader(reader->second);
+    // Remove all Writers and Readers that exist
+    for (auto& writer_it : writers_)
+    {
+        participants_->get_participant(writer_it.first)->delete_writer(writer_it.second);
+    }
+    writers_.clear();
 
-        writers_.erase(writer);
-        readers_.erase(reader);
+    for (auto& reader_it : readers_)
+    {
+        participants_->get_participant(reader_it.first)->delete_reader(reader_it.second);
     }
+    readers_.clear();
 
     // Participants must not be removed as they belong to the Participant Database
 
@@ -139,6 +163,253 @@ void Bridge::disable() noexcept
     }
 }
 
+std::map<ParticipantId, TrackStatistics> Bridge::tracks_statistics() const noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    std::map<ParticipantId, TrackStatistics> statistics;
+    for (const auto& track_it : tracks_)
+    {
+        statistics[track_it.first] = track_it.second->statistics();
+    }
+    return statistics;
+}
+
+void Bridge::update_remote_endpoint(
+        const Endpoint& endpoint) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    ParticipantId id = endpoint.discoverer_participant_id();
+    if (!endpoint.is_valid() || !interest_driven_participant_(id))
+    {
+        return;
+    }
+
+    // Remote Writers are the interest of the Reader of the Participant, and remote Readers of its Writer
+    std::set<Guid>& remote_endpoints = endpoint.is_writer() ? remote_writers_[id] : remote_readers_[id];
+    if (endpoint.active())
+    {
+        remote_endpoints.insert(endpoint.guid());
+    }
+    else
+    {
+        remote_endpoints.erase(endpoint.guid());
+    }
+
+    auto& local_endpoints_idle = endpoint.is_writer() ? idle_readers_ : idle_writers_;
+    bool local_endpoint_exists = endpoint.is_writer() ?
+            readers_.find(id) != readers_.end() :
+            writers_.find(id) != writers_.end();
+
+    if (remote_endpoints.empty())
+    {
+        // Keep the endpoint during the grace period, in case a remote endpoint arrives again
+        if (local_endpoint_exists && local_endpoints_idle.find(id) == local_endpoints_idle.end())
+        {
+            local_endpoints_idle[id] = std::chrono::steady_clock::now();
+        }
+        return;
+    }
+
+    local_endpoints_idle.erase(id);
+    if (local_endpoint_exists)
+    {
+        return;
+    }
+
+    try
+    {
+        if (endpoint.is_writer())
+        {
+            logInfo(DDSROUTER_BRIDGE,
+                    "Creating Reader in Participant " << id << " for topic " << topic_ << " on remote Writer "
+                                                      << endpoint.guid() << ".");
+            create_reader_(id);
+        }
+        else
+        {
+            logInfo(DDSROUTER_BRIDGE,
+                    "Creating Writer in Participant " << id << " for topic " << topic_ << " on remote Reader "
+                                                      << endpoint.guid() << ".");
+            create_writer_(id);
+        }
+    }
+    catch (const InitializationException& e)
+    {
+        logError(DDSROUTER_BRIDGE,
+                "Error creating endpoint in Participant " << id << " for topic " << topic_ << ": " << e.what()
+                                                          << ".");
+    }
+}
+
+void Bridge::remove_idle_endpoints(
+        Duration_ms grace_period) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    auto idle_limit = std::chrono::steady_clock::now() - std::chrono::milliseconds(grace_period);
+
+    for (auto it = idle_readers_.begin(); it != idle_readers_.end();)
+    {
+        if (it->second <= idle_limit)
+        {
+            logInfo(DDSROUTER_BRIDGE, "Deleting idle Reader in Participant " << it->first << " for topic " << topic_
+                                                                             << ".");
+            delete_reader_(it->first);
+            it = idle_readers_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto it = idle_writers_.begin(); it != idle_writers_.end();)
+    {
+        if (it->second <= idle_limit)
+        {
+            logInfo(DDSROUTER_BRIDGE, "Deleting idle Writer in Participant " << it->first << " for topic " << topic_
+                                                                             << ".");
+            delete_writer_(it->first);
+            it = idle_writers_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool Bridge::interest_driven_participant_(
+        const ParticipantId& id) const noexcept
+{
+    if (!interest_driven_)
+    {
+        return false;
+    }
+
+    std::shared_ptr<IParticipant> participant = participants_->get_participant(id);
+
+    // Participants facing other routers keep their endpoints, as the remote router only creates its endpoints
+    // once it discovers these ones
+    return participant && participant->discovers_endpoints() && !participant->type().connects_routers();
+}
+
+bool Bridge::inline_forwarding_supported_() const noexcept
+{
+    if (egress_queue_size_ > 0)
+    {
+        return false;
+    }
+
+    for (const auto& payload_pool_it : payload_pools_)
+    {
+        if (payload_pool_it.second->may_block())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Bridge::create_reader_(
+        const ParticipantId& id)
+{
+    std::shared_ptr<IParticipant> participant = participants_->get_participant(id);
+    std::shared_ptr<IReader> reader = participant->create_reader(topic_, specs_);
+    readers_[id] = reader;
+
+    // The Track writes in every Writer except the one of its own Participant
+    std::map<ParticipantId, std::shared_ptr<IWriter>> writers_except_one = egress_writers_;
+    writers_except_one.erase(id);
+
+    // This insert is required as there is no copy method for Track
+    tracks_[id] =
+            std::make_unique<Track>(topic_, id, reader, std::move(writers_except_one), payload_pools_,
+                    thread_pool_, specs_, enabled_);
+}
+
+void Bridge::create_writer_(
+        const ParticipantId& id)
+{
+    std::shared_ptr<IParticipant> participant = participants_->get_participant(id);
+    std::shared_ptr<IWriter> writer = participant->create_writer(topic_, specs_);
+    writers_[id] = writer;
+
+    // With egress queues, each writer sends its data independently of the Tracks that write in it
+    if (egress_queue_size_ > 0)
+    {
+        egress_writers_[id] = std::make_shared<QueuedWriter>(writer, payload_pools_[id], thread_pool_,
+                        egress_queue_size_, specs_.egress_overflow_policy);
+    }
+    else
+    {
+        egress_writers_[id] = writer;
+    }
+
+    for (auto& track_it : tracks_)
+    {
+        if (track_it.first != id)
+        {
+            track_it.second->add_writer(id, egress_writers_[id]);
+        }
+    }
+}
+
+void Bridge::delete_reader_(
+        const ParticipantId& id) noexcept
+{
+    // The Track must be destroyed before the Reader it takes data from
+    tracks_.erase(id);
+
+    auto reader = readers_.find(id);
+    if (reader != readers_.end())
+    {
+        participants_->get_participant(id)->delete_reader(reader->second);
+        readers_.erase(reader);
+    }
+}
+
+void Bridge::delete_writer_(
+        const ParticipantId& id) noexcept
+{
+    // No Track uses the Writer once it has been removed from them
+    for (auto& track_it : tracks_)
+    {
+        track_it.second->remove_writer(id);
+    }
+
+    // Egress queue must be destroyed before the writer it sends data to
+    egress_writers_.erase(id);
+
+    auto writer = writers_.find(id);
+    if (writer != writers_.end())
+    {
+        participants_->get_participant(id)->delete_writer(writer->second);
+        writers_.erase(writer);
+    }
+}
+
+void Bridge::check_zero_copy_(
+        const std::set<ParticipantId>& ids) const
+{
+    for (ParticipantId reader_id : ids)
+    {
+        for (ParticipantId writer_id : ids)
+        {
+            if (reader_id != writer_id &&
+                    !payload_pools_.at(writer_id)->references_data_of(payload_pools_.at(reader_id).get()))
+            {
+                throw InitializationException(utils::Formatter()
+                              << "Topic " << topic_ << " is zero copy, but data received by Participant "
+                              << reader_id << " would be copied to be sent by Participant " << writer_id << ".");
+            }
+        }
+    }
+}
+
 std::ostream& operator <<(
         std::ostream& os,
         const Bridge& bridge)
@@ -17,6 +17,9 @@
  *
  */
 
+#include <chrono>
+#include <iterator>
+
 #include <ddsrouter/communication/Track.hpp>
 #include <ddsrouter/exceptions/UnsupportedException.hpp>
 #include <ddsrouter/types/Log.hpp>
@@ -24,30 +27,46 @@
 namespace eprosima {
 namespace ddsrouter {
 
+namespace {
+
+//! Whether the calling thread is transmitting a Track from the callback of its Reader
+thread_local bool transmitting_inline = false;
+
+} /* namespace */
+
 Track::Track(
         const RealTopic& topic,
         ParticipantId reader_participant_id,
         std::shared_ptr<IReader> reader,
         std::map<ParticipantId, std::shared_ptr<IWriter>>&& writers,
-        std::shared_ptr<PayloadPool> payload_pool,
+        const std::map<ParticipantId, std::shared_ptr<PayloadPool>>& payload_pools,
+        std::shared_ptr<SlotThreadPool> thread_pool,
+        const TopicSpecs& specs,
         bool enable /* = false */) noexcept
     : reader_participant_id_(reader_participant_id)
     , topic_(topic)
     , reader_(reader)
     , writers_(writers)
-    , payload_pool_(payload_pool)
+    , payload_pool_(payload_pools.at(reader_participant_id))
+    , referenced_payloads_(0)
+    , copied_payloads_(0)
+    , skipped_payloads_(0)
+    , dropped_payloads_(0)
+    , thread_pool_(thread_pool)
+    , specs_(specs)
     , enabled_(false)
-    , exit_(false)
     , data_available_status_(NO_MORE_DATA)
 {
     logDebug(DDSROUTER_TRACK, "Creating Track " << *this << ".");
 
+    taken_data_.reserve(TAKE_BATCH_SIZE_);
+
+    // Register transmission in thread pool, so it is executed each time the slot is emitted
+    transmit_slot_id_ = thread_pool_->register_slot(std::bind(&Track::transmit_, this));
+
     // Set this track to on_data_available lambda call
     reader_->set_on_data_available_callback(std::bind(&Track::data_available_, this));
 
-    // Activate transmit thread even without being enabled
-    transmit_thread_ = std::thread(&Track::transmit_thread_function_, this);
-
     if (enable)
     {
         // Activate Track
@@ -66,15 +85,8 @@ Track::~Track()
     // Unset callback on the Reader (this is needed as Reader will live longer than Track)
     reader_->unset_on_data_available_callback();
 
-    // It does need to guard the mutex to avoid notifying Track thread while it is checking variable condition
-    {
-        // Set exit status and call transmit thread to awake and terminate. Then wait for it.
-        std::lock_guard<std::mutex> lock(data_available_mutex_);
-        exit_.store(true);
-    }
-
-    data_available_condition_variable_.notify_all();
-    transmit_thread_.join();
+    // Remove transmission from thread pool. It waits in case it is being executed
+    thread_pool_->unregister_slot(transmit_slot_id_);
 
     logDebug(DDSROUTER_TRACK, "Track " << *this << " destroyed.");
 }
@@ -97,6 +109,12 @@ void Track::enable() noexcept
         reader_->enable();
 
         enabled_ = true;
+
+        // Data may have been notified before this Track was disabled and not transmitted yet
+        if (is_data_available_())
+        {
+            thread_pool_->emit(transmit_slot_id_);
+        }
     }
 }
 
@@ -126,26 +144,96 @@ void Track::disable() noexcept
     }
 }
 
-void Track::no_more_data_available_() noexcept
+void Track::add_writer(
+        ParticipantId writer_participant_id,
+        std::shared_ptr<IWriter> writer) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(track_mutex_);
+    std::lock_guard<std::mutex> transmission_lock(on_transmission_mutex_);
+
+    auto inserted = writers_.emplace(writer_participant_id, writer);
+    if (!inserted.second)
+    {
+        return;
+    }
+
+    if (enabled_)
+    {
+        writer->enable();
+    }
+
+    logDebug(DDSROUTER_TRACK, "Track " << *this << " writing in Participant " << writer_participant_id << ".");
+}
+
+void Track::remove_writer(
+        ParticipantId writer_participant_id) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(track_mutex_);
+    std::lock_guard<std::mutex> transmission_lock(on_transmission_mutex_);
+
+    auto writer = writers_.find(writer_participant_id);
+    if (writer == writers_.end())
+    {
+        return;
+    }
+
+    writers_.erase(writer);
+
+    logDebug(DDSROUTER_TRACK,
+            "Track " << *this << " no longer writing in Participant " << writer_participant_id << ".");
+}
+
+TrackStatistics Track::statistics() const noexcept
 {
-    std::lock_guard<std::mutex> lock(data_available_mutex_);
+    TrackStatistics statistics;
+    statistics.referenced_payloads = referenced_payloads_.load(std::memory_order_relaxed);
+    statistics.copied_payloads = copied_payloads_.load(std::memory_order_relaxed);
+    statistics.skipped_payloads = skipped_payloads_.load(std::memory_order_relaxed);
+    statistics.dropped_payloads = dropped_payloads_.load(std::memory_order_relaxed);
+    return statistics;
+}
 
+bool Track::no_more_data_available_() noexcept
+{
     // It may occur that within the process of set data_available_status, the actual status had changed
     // Thus, it must take care that it is only set to NO_DATA when it comes from transmitting data
-    if (data_available_status_ == DataAvailableStatus::TRANSMITTING_DATA)
+    DataAvailableStatus expected = DataAvailableStatus::TRANSMITTING_DATA;
+    if (data_available_status_.compare_exchange_strong(expected, DataAvailableStatus::NO_MORE_DATA))
     {
         logDebug(DDSROUTER_TRACK, "Track " << *this << " has no more data to send.");
-        data_available_status_.store(DataAvailableStatus::NO_MORE_DATA);
+        return true;
     }
+
     // If it is NEW_DATA_ARRIVED is that the Listener has notified new data AFTER Track has received a NO_DATA
     // from the Reader. Very unlikely timing, but possible.
     // In this occasion, it must not be set as NO_MORE_DATA because THERE IS data.
     // If it is NO_MORE_DATA it does not need to be changed (however it should never happen)
+    return false;
 }
 
 bool Track::should_transmit_() noexcept
 {
-    return !exit_ && enabled_ && this->is_data_available_();
+    return enabled_ && this->is_data_available_();
+}
+
+bool Track::spin_for_data_() const noexcept
+{
+    auto spin_end = std::chrono::steady_clock::now() + std::chrono::microseconds(specs_.spin_budget);
+
+    while (enabled_)
+    {
+        if (data_available_status_.load() == DataAvailableStatus::NEW_DATA_ARRIVED)
+        {
+            return true;
+        }
+
+        if (std::chrono::steady_clock::now() >= spin_end)
+        {
+            break;
+        }
+    }
+
+    return false;
 }
 
 void Track::data_available_() noexcept
@@ -155,14 +243,27 @@ void Track::data_available_() noexcept
     {
         logDebug(DDSROUTER_TRACK, "Track " << *this << " has data ready to be sent.");
 
-        // It does need to guard the mutex to avoid notifying Track thread while it is checking variable condition
+        // Set data available to true
+        DataAvailableStatus previous_status = data_available_status_.exchange(DataAvailableStatus::NEW_DATA_ARRIVED);
+
+        // Only ask the thread pool to transmit if transmission is parked.
+        // Otherwise, transmit_ is already running or emitted, and it will see the new status before finishing.
+        if (previous_status == DataAvailableStatus::NO_MORE_DATA)
         {
-            // Set data available to true and notify transmit thread
-            std::lock_guard<std::mutex> lock(data_available_mutex_);
-            data_available_status_.store(DataAvailableStatus::NEW_DATA_ARRIVED);
+            if (specs_.inline_forwarding)
+            {
+                // Transmit from this same thread. The pool still guarantees it is not executed concurrently.
+                // The previous value is restored in case a Writer delivers data to another Track in this thread
+                bool previously_inline = transmitting_inline;
+                transmitting_inline = true;
+                thread_pool_->emit_inline(transmit_slot_id_);
+                transmitting_inline = previously_inline;
+            }
+            else
+            {
+                thread_pool_->emit(transmit_slot_id_);
+            }
         }
-
-        data_available_condition_variable_.notify_one();
     }
 }
 
@@ -172,37 +273,14 @@ bool Track::is_data_available_() const noexcept
            data_available_status_ == DataAvailableStatus::TRANSMITTING_DATA;
 }
 
-void Track::transmit_thread_function_() noexcept
-{
-    while (!exit_)
-    {
-        // Wait in Condition Variable till there is data to send or it must exit
-        {
-            std::unique_lock<std::mutex> lock(data_available_mutex_);
-            data_available_condition_variable_.wait(
-                lock,
-                [this]
-                {
-                    return this->is_data_available_() || this->exit_;
-                });
-        }
-
-        // Once thread awakes, transmit without any mutex guarded
-        if (!this->exit_)
-        {
-            transmit_();
-        }
-    }
-}
-
 void Track::transmit_() noexcept
 {
     // Loop that ends if it should stop transmitting (should_transmit_nts_).
     // Called inside the loop so it is protected by a mutex that is freed in every iteration.
-    while (true)
+    for (unsigned int transmissions = 0; ;)
     {
-        // Lock Mutex on_transmition while a data is being transmitted
-        // This prevents the Track to be disabled (and disable writers and readers) while sending a data
+        // Lock Mutex on_transmition while data is being transmitted
+        // This prevents the Track to be disabled (and disable writers and readers) while sending data
         std::unique_lock<std::mutex> lock(on_transmission_mutex_);
 
         // If it must not keep transmitting, stop loop
@@ -211,18 +289,39 @@ void Track::transmit_() noexcept
             break;
         }
 
+        // Give other Tracks the chance to use this thread. The rest of the data is sent in a new execution.
+        // The thread of the Reader only forwards a single batch, so it is handed off to the pool right away
+        if (transmissions >= MAX_TRANSMISSIONS_PER_TASK_ || (transmitting_inline && transmissions > 0))
+        {
+            thread_pool_->emit(transmit_slot_id_);
+            break;
+        }
+
         // It starts transmitting, so it sets the data available status as transmitting
-        data_available_status_ = TRANSMITTING_DATA;
+        data_available_status_.store(DataAvailableStatus::TRANSMITTING_DATA);
 
         // Get data received
-        std::unique_ptr<DataReceived> data = std::make_unique<DataReceived>();
-        ReturnCode ret = reader_->take(data);
+        ReturnCode ret = reader_->take_batch(taken_data_, TAKE_BATCH_SIZE_);
 
         if (ret == ReturnCode::RETCODE_NO_DATA)
         {
-            // There is no more data, so finish loop and wait again for new data
-            no_more_data_available_();
-            break;
+            // Low latency topics keep this thread waiting for new data for a while before parking
+            if (specs_.spin_budget > 0 && !transmitting_inline)
+            {
+                lock.unlock();
+                if (spin_for_data_())
+                {
+                    continue;
+                }
+            }
+
+            // There is no more data, so finish loop and wait again for new data.
+            // If new data has arrived meanwhile, keep transmitting as nobody else will emit the slot.
+            if (no_more_data_available_())
+            {
+                break;
+            }
+            continue;
         }
         else if (ret == ReturnCode::RETCODE_NOT_ENABLED)
         {
@@ -236,28 +335,90 @@ void Track::transmit_() noexcept
             // Error reading data
             logWarning(DDSROUTER_TRACK, "Error taking data in Track " << topic_ << ". Error code " << ret
                                                                       << ". Skipping data and continue.");
+
+            // Failed takes count as transmissions, so a run of them does not keep this thread from other Tracks
+            transmissions++;
             continue;
         }
 
-        logDebug(DDSROUTER_TRACK,
-                "Track " << reader_participant_id_ << " for topic " << topic_ <<
-                " transmitting data from remote endpoint " << data->source_guid << ".");
-
-        // Send data through writers
-        for (auto& writer_it : writers_)
+        for (std::unique_ptr<DataReceived>& sample : taken_data_)
         {
-            ret = writer_it.second->write(data);
+            logDebug(DDSROUTER_TRACK,
+                    "Track " << reader_participant_id_ << " for topic " << topic_ <<
+                    " transmitting data from remote endpoint " << sample->source_guid << ".");
 
-            if (!ret)
+            // Send data through writers
+            for (auto& writer_it : writers_)
             {
-                logWarning(DDSROUTER_TRACK, "Error writting data in Track " << topic_ << ". Error code "
-                                                                            << ret <<
-                        ". Skipping data for this writer and continue.");
-                continue;
+                // Nobody would receive the data now, and the topic does not keep it for late joiners
+                if (specs_.skip_without_readers && !writer_it.second->has_remote_readers())
+                {
+                    skipped_payloads_.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                // The Writer gets the payload to send in this thread, so the operations of the pools in between are
+                // the ones it has done with this data
+                PayloadPool::PayloadOperations operations = PayloadPool::thread_payload_operations();
+
+                ret = writer_it.second->write(sample);
+
+                // A KEEP_ALL history full of data not acknowledged keeps it, and the new data is dropped
+                if (ret == ReturnCode::RETCODE_OUT_OF_RESOURCES)
+                {
+                    dropped_payloads_.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (!ret)
+                {
+                    logWarning(DDSROUTER_TRACK, "Error writting data in Track " << topic_ << ". Error code "
+                                                                                << ret <<
+                            ". Skipping data for this writer and continue.");
+                    continue;
+                }
+
+                count_payload_operations_(writer_it.first, operations);
             }
+
+            sample->payload_owner->release_payload(sample->payload);
+        }
+
+        // Give back the samples to the Reader so they are reused and no allocation is needed in next batches.
+        // This leaves taken_data_ empty for the next iteration.
+        bool full_batch = taken_data_.size() >= TAKE_BATCH_SIZE_;
+        transmissions += taken_data_.size();
+        reader_->return_loan(taken_data_);
+
+        // A batch not filled has drained the Reader, so the thread of the Reader parks the transmission without
+        // going through the pool, unless new data has arrived meanwhile
+        if (transmitting_inline && !full_batch && no_more_data_available_())
+        {
+            break;
         }
+    }
+}
+
+void Track::count_payload_operations_(
+        const ParticipantId& writer_participant_id,
+        const PayloadPool::PayloadOperations& operations_before) noexcept
+{
+    PayloadPool::PayloadOperations operations = PayloadPool::thread_payload_operations();
 
-        payload_pool_->release_payload(data->payload);
+    if (operations.copied > operations_before.copied)
+    {
+        copied_payloads_.fetch_add(1, std::memory_order_relaxed);
+
+        if (specs_.zero_copy)
+        {
+            logError(DDSROUTER_TRACK,
+                    "Topic " << topic_ << " is zero copy, but data received by Participant " << reader_participant_id_
+                             << " has been copied to be sent by Participant " << writer_participant_id << ".");
+        }
+    }
+    else if (operations.referenced > operations_before.referenced)
+    {
+        referenced_payloads_.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
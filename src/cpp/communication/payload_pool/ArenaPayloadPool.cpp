@@ -0,0 +1,46 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file ArenaPayloadPool.cpp
+ *
+ */
+
+#include <ddsrouter/communication/payload_pool/ArenaPayloadPool.hpp>
+#include <ddsrouter/types/Log.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+ArenaPayloadPool::ArenaPayloadPool(
+        const PayloadPoolConfiguration& configuration)
+    : SlabPayloadPool(
+        configuration,
+        std::make_shared<MemoryArena>(configuration.arena_size, configuration.huge_pages, configuration.prefault,
+        configuration.numa_node))
+    , arena_(depot_->arena)
+{
+    logInfo(DDSROUTER_PAYLOADPOOL,
+            "ArenaPayloadPool created with an arena of " << arena_->size() << " bytes"
+                                                         << (arena_->huge_pages() ? " in huge pages." : "."));
+}
+
+const MemoryArena& ArenaPayloadPool::arena() const noexcept
+{
+    return *arena_;
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
@@ -41,13 +41,14 @@ bool CopyPayloadPool::get_payload(
     // As this class copies always the data, it does not matter the owner of this data
     static_cast<void>(data_owner);
 
-    if (!get_payload(src_payload.max_size, target_payload))
+    if (!get_payload(copy_reserve_size_(src_payload), target_payload))
     {
         return false;
     }
     std::memcpy(target_payload.data, src_payload.data, src_payload.length);
     target_payload.length = src_payload.length;
-    target_payload.max_size = src_payload.max_size;
+
+    add_copied_payload_();
 
     return true;
 }
@@ -58,5 +59,12 @@ bool CopyPayloadPool::release_payload(
     return release_(payload);
 }
 
+bool CopyPayloadPool::references_data_of(
+        const IPayloadPool* data_owner) const noexcept
+{
+    static_cast<void>(data_owner);
+    return false;
+}
+
 } /* namespace ddsrouter */
 } /* namespace eprosima */
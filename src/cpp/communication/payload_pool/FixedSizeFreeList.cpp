@@ -0,0 +1,138 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file FixedSizeFreeList.cpp
+ *
+ */
+
+#include <cstdlib>
+
+#include <ddsrouter/communication/payload_pool/FixedSizeFreeList.hpp>
+#include <ddsrouter/types/Log.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+namespace {
+
+//! Round \c size up to a multiple of the alignment of \c std::max_align_t
+constexpr size_t align_up(
+        size_t size) noexcept
+{
+    return (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+}
+
+} /* namespace */
+
+FixedSizeFreeList::FixedSizeFreeList(
+        size_t block_size,
+        uint32_t count)
+    : region_(nullptr)
+    , block_size_(align_up(block_size))
+    , count_(count)
+    , next_(new std::atomic<uint32_t>[count])
+    , head_(make_head_(END_OF_LIST, 0))
+{
+    if (count_ == 0)
+    {
+        return;
+    }
+
+    region_ = static_cast<unsigned char*>(std::malloc(block_size_ * count_));
+    if (region_ == nullptr)
+    {
+        logWarning(DDSROUTER_PAYLOADPOOL,
+                "Error allocating " << count_ << " blocks of " << block_size_ << " bytes. Free list is empty.");
+        count_ = 0;
+        return;
+    }
+
+    // Every block is free, in the order of the region
+    for (uint32_t i = 0; i < count_; i++)
+    {
+        next_[i].store(i + 1 < count_ ? i + 1 : END_OF_LIST, std::memory_order_relaxed);
+    }
+    head_.store(make_head_(0, 0), std::memory_order_release);
+}
+
+FixedSizeFreeList::~FixedSizeFreeList()
+{
+    std::free(region_);
+}
+
+void* FixedSizeFreeList::allocate() noexcept
+{
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint32_t index;
+    do
+    {
+        index = static_cast<uint32_t>(head);
+        if (index == END_OF_LIST)
+        {
+            return nullptr;
+        }
+        // If the block has been taken by other thread meanwhile, the tag has changed and the exchange fails
+    } while (!head_.compare_exchange_weak(
+                head,
+                make_head_(next_[index].load(std::memory_order_relaxed), static_cast<uint32_t>(head >> 32) + 1),
+                std::memory_order_acquire,
+                std::memory_order_acquire));
+
+    return region_ + index * block_size_;
+}
+
+void FixedSizeFreeList::free(
+        void* block) noexcept
+{
+    uint32_t index = static_cast<uint32_t>((static_cast<unsigned char*>(block) - region_) / block_size_);
+
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    do
+    {
+        next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while (!head_.compare_exchange_weak(
+                head,
+                make_head_(index, static_cast<uint32_t>(head >> 32) + 1),
+                std::memory_order_release,
+                std::memory_order_relaxed));
+}
+
+bool FixedSizeFreeList::contains(
+        const void* block) const noexcept
+{
+    const unsigned char* address = static_cast<const unsigned char*>(block);
+    return region_ != nullptr && address >= region_ && address < region_ + block_size_ * count_;
+}
+
+size_t FixedSizeFreeList::block_size() const noexcept
+{
+    return block_size_;
+}
+
+uint32_t FixedSizeFreeList::count() const noexcept
+{
+    return count_;
+}
+
+uint64_t FixedSizeFreeList::make_head_(
+        uint32_t index,
+        uint32_t tag) noexcept
+{
+    return (static_cast<uint64_t>(tag) << 32) | index;
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
@@ -66,7 +66,7 @@ bool MapPayloadPool::get_payload(
     if (data_owner != this)
     {
         // Store space for payload
-        if (!get_payload(src_payload.max_size, target_payload))
+        if (!get_payload(copy_reserve_size_(src_payload), target_payload))
         {
             return false;
         }
@@ -74,6 +74,8 @@ bool MapPayloadPool::get_payload(
         // Copy info
         std::memcpy(target_payload.data, src_payload.data, src_payload.length);
         target_payload.length = src_payload.length;
+
+        add_copied_payload_();
     }
     else
     {
@@ -94,6 +96,8 @@ bool MapPayloadPool::get_payload(
         target_payload.data = src_payload.data;
         target_payload.length = src_payload.length;
         target_payload.max_size = src_payload.max_size;
+
+        add_referenced_payload_();
     }
     return true;
 }
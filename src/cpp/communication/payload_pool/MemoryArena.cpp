@@ -0,0 +1,220 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file MemoryArena.cpp
+ *
+ */
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // if defined(_WIN32)
+
+#include <ddsrouter/communication/payload_pool/MemoryArena.hpp>
+#include <ddsrouter/types/Log.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+namespace {
+
+//! Size of the huge pages mapped explicitly
+constexpr size_t HUGE_PAGE_SIZE = 2u << 20;
+
+//! Round \c size up to a multiple of \c alignment , that must be a power of two
+constexpr size_t align_up(
+        size_t size,
+        size_t alignment) noexcept
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+} /* namespace */
+
+MemoryArena::MemoryArena(
+        size_t size,
+        bool huge_pages,
+        bool prefault,
+        int numa_node /* = numa::NO_NUMA_NODE */)
+    : region_(nullptr)
+    , size_(0)
+    , used_(0)
+    , huge_pages_(false)
+{
+    if (size == 0)
+    {
+        logWarning(DDSROUTER_PAYLOADPOOL, "Creating a MemoryArena of 0 bytes, every data will use the heap.");
+        return;
+    }
+
+    if (huge_pages)
+    {
+        huge_pages_ = map_(align_up(size, HUGE_PAGE_SIZE), true);
+        if (!huge_pages_)
+        {
+            logWarning(DDSROUTER_PAYLOADPOOL,
+                    "Huge pages not available for a MemoryArena of " << size << " bytes, using normal pages.");
+        }
+    }
+
+    if (!huge_pages_ && !map_(size, false))
+    {
+        logWarning(DDSROUTER_PAYLOADPOOL,
+                "Error mapping a MemoryArena of " << size << " bytes, every data will use the heap.");
+        return;
+    }
+
+#if !defined(_WIN32) && defined(MADV_HUGEPAGE)
+    if (huge_pages && !huge_pages_)
+    {
+        // Let the kernel back the region with transparent huge pages, if enabled
+        madvise(region_, size_, MADV_HUGEPAGE);
+    }
+#endif // if !defined(_WIN32) && defined(MADV_HUGEPAGE)
+
+    // Bind before touching any page, so they are allocated in the node from the beginning
+    if (numa_node != numa::NO_NUMA_NODE)
+    {
+        numa::bind_memory_to_node(region_, size_, numa_node);
+    }
+
+    if (prefault)
+    {
+        prefault_();
+    }
+
+    logDebug(DDSROUTER_PAYLOADPOOL,
+            "MemoryArena of " << size_ << " bytes created" << (huge_pages_ ? " with huge pages." : "."));
+}
+
+MemoryArena::~MemoryArena()
+{
+    if (region_ == nullptr)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    VirtualFree(region_, 0, MEM_RELEASE);
+#else
+    munmap(region_, size_);
+#endif // if defined(_WIN32)
+}
+
+void* MemoryArena::allocate(
+        size_t size) noexcept
+{
+    size = align_up(size, alignof(std::max_align_t));
+
+    size_t offset = used_.load(std::memory_order_relaxed);
+    do
+    {
+        if (size > size_ - offset)
+        {
+            return nullptr;
+        }
+    } while (!used_.compare_exchange_weak(offset, offset + size, std::memory_order_relaxed));
+
+    return region_ + offset;
+}
+
+bool MemoryArena::contains(
+        const void* block) const noexcept
+{
+    const unsigned char* byte = static_cast<const unsigned char*>(block);
+    return region_ != nullptr && byte >= region_ && byte < region_ + size_;
+}
+
+size_t MemoryArena::size() const noexcept
+{
+    return size_;
+}
+
+size_t MemoryArena::used() const noexcept
+{
+    return used_;
+}
+
+bool MemoryArena::huge_pages() const noexcept
+{
+    return huge_pages_;
+}
+
+bool MemoryArena::map_(
+        size_t size,
+        bool huge_pages) noexcept
+{
+#if defined(_WIN32)
+    // Large pages require a privilege that the router does not have
+    if (huge_pages)
+    {
+        return false;
+    }
+
+    void* region = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (region == nullptr)
+    {
+        return false;
+    }
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if (huge_pages)
+    {
+#if defined(MAP_HUGETLB)
+        flags |= MAP_HUGETLB;
+#else
+        return false;
+#endif // if defined(MAP_HUGETLB)
+    }
+
+    void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (region == MAP_FAILED)
+    {
+        return false;
+    }
+#endif // if defined(_WIN32)
+
+    region_ = static_cast<unsigned char*>(region);
+    size_ = size;
+    return true;
+}
+
+void MemoryArena::prefault_() noexcept
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    size_t page_size = info.dwPageSize;
+#else
+    size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif // if defined(_WIN32)
+
+    if (huge_pages_)
+    {
+        page_size = HUGE_PAGE_SIZE;
+    }
+
+    // Writing is required, as reading an untouched anonymous page maps the shared zero page
+    for (size_t offset = 0; offset < size_; offset += page_size)
+    {
+        static_cast<volatile unsigned char*>(region_)[offset] = 0;
+    }
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
@@ -17,6 +17,10 @@
  *
  */
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
 #include <ddsrouter/communication/payload_pool/PayloadPool.hpp>
 #include <ddsrouter/exceptions/InconsistencyException.hpp>
 #include <ddsrouter/types/Log.hpp>
@@ -24,27 +28,48 @@
 namespace eprosima {
 namespace ddsrouter {
 
-PayloadPool::PayloadPool()
-    : reserve_count_(0)
-    , release_count_(0)
+namespace {
+
+//! Whether the calling thread is reserving the data received by a Reader, so it must not wait for memory
+thread_local bool reserving_ingress = false;
+
+//! Payloads referenced and copied by the calling thread
+thread_local PayloadPool::PayloadOperations thread_operations;
+
+//! Shard of the counters of the next thread that updates them
+std::atomic<unsigned int> next_counter_shard(0);
+
+} /* namespace */
+
+PayloadPool::PayloadPool(
+        const PayloadPoolConfiguration& configuration)
+    : configuration_(configuration)
+    , counter_shards_()
+    , reserved_bytes_(0)
+    , live_payloads_(0)
+    , memory_waiters_(0)
+    , max_reserved_bytes_(0)
+    , deduplicated_count_(0)
+    , deduplicated_bytes_(0)
+    , low_priority_rejected_count_(0)
+    , next_reclaimer_id_(0)
 {
 }
 
 PayloadPool::~PayloadPool()
 {
-    if (reserve_count_ < release_count_)
-    {
-        logWarning(DDSROUTER_PAYLOADPOOL, "Removing non Consistent PayloadPool.");
-    }
-    else if (reserve_count_ != release_count_)
+    uint64_t reserve_count = statistics().reserved_payloads;
+
+    if (live_payloads_ != 0)
     {
         logWarning(DDSROUTER_PAYLOADPOOL,
-                "From " << reserve_count_ << " payloads reserved only " << release_count_ << " has been released.");
+                "From " << reserve_count << " payloads reserved only " << reserve_count - live_payloads_
+                        << " has been released.");
     }
     else
     {
         logInfo(DDSROUTER_PAYLOADPOOL,
-                "Removing PayloadPool correctly after reserve: " << reserve_count_ << " payloads.");
+                "Removing PayloadPool correctly after reserve: " << reserve_count << " payloads.");
     }
 }
 
@@ -107,30 +132,330 @@ bool PayloadPool::release_payload(
     }
 }
 
+bool PayloadPool::get_ingress_payload(
+        uint32_t size,
+        Payload& payload,
+        bool low_priority)
+{
+    // Low priority data is rejected before reserving anything, so it never takes memory from the rest of topics
+    if (low_priority && low_priority_limit_reached())
+    {
+        add_low_priority_rejected_payload_();
+        return false;
+    }
+
+    reserving_ingress = true;
+    bool reserved = get_payload(size, payload);
+    reserving_ingress = false;
+
+    return reserved;
+}
+
+bool PayloadPool::get_ingress_payload(
+        const Payload& src_payload,
+        IPayloadPool*& data_owner,
+        Payload& target_payload,
+        bool low_priority)
+{
+    // Referencing a data already in the pool does not reserve memory
+    if (references_data_of(data_owner))
+    {
+        return get_payload(src_payload, data_owner, target_payload);
+    }
+
+    if (low_priority && low_priority_limit_reached())
+    {
+        add_low_priority_rejected_payload_();
+        return false;
+    }
+
+    reserving_ingress = true;
+    bool reserved = get_payload(src_payload, data_owner, target_payload);
+    reserving_ingress = false;
+
+    return reserved;
+}
+
+PayloadPool::PayloadOperations PayloadPool::thread_payload_operations() noexcept
+{
+    return thread_operations;
+}
+
 bool PayloadPool::is_clean() const noexcept
 {
-    return reserve_count_ == release_count_;
+    return live_payloads_ == 0;
+}
+
+bool PayloadPool::references_data_of(
+        const IPayloadPool* data_owner) const noexcept
+{
+    return data_owner == this;
+}
+
+PayloadPoolStatistics PayloadPool::statistics() const noexcept
+{
+    PayloadPoolStatistics statistics;
+
+    statistics.live_payloads = live_payloads_.load(std::memory_order_relaxed);
+    statistics.reserved_bytes = reserved_bytes_.load(std::memory_order_relaxed);
+    statistics.max_reserved_bytes = max_reserved_bytes_.load(std::memory_order_relaxed);
+    statistics.deduplicated_payloads = deduplicated_count_.load(std::memory_order_relaxed);
+    statistics.deduplicated_bytes = deduplicated_bytes_.load(std::memory_order_relaxed);
+    statistics.low_priority_rejected_payloads = low_priority_rejected_count_.load(std::memory_order_relaxed);
+
+    // Counters updated in every reservation are added up from every shard
+    for (const CounterShard& shard : counter_shards_)
+    {
+        statistics.reserved_payloads += shard.reserve_count.load(std::memory_order_relaxed);
+        statistics.referenced_payloads += shard.reference_count.load(std::memory_order_relaxed);
+        statistics.copied_payloads += shard.copy_count.load(std::memory_order_relaxed);
+        for (unsigned int i = 0; i < PayloadPoolStatistics::NUMBER_OF_SIZE_BUCKETS; i++)
+        {
+            statistics.size_histogram[i] += shard.size_histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    return statistics;
+}
+
+/////
+// MEMORY BUDGET
+
+uint64_t PayloadPool::reserved_bytes() const noexcept
+{
+    return reserved_bytes_;
+}
+
+bool PayloadPool::low_priority_limit_reached() const noexcept
+{
+    return configuration_.memory_budget > 0 &&
+           reserved_bytes_ >= configuration_.memory_budget * LOW_PRIORITY_BUDGET_RATIO;
+}
+
+bool PayloadPool::may_block() const noexcept
+{
+    return configuration_.memory_budget > 0 && configuration_.memory_policy == MemoryBudgetPolicy::MEMORY_BLOCK;
+}
+
+uint64_t PayloadPool::register_memory_reclaimer(
+        MemoryReclaimer reclaimer)
+{
+    std::lock_guard<std::mutex> lock(memory_reclaimers_mutex_);
+    memory_reclaimers_[next_reclaimer_id_] = reclaimer;
+    return next_reclaimer_id_++;
+}
+
+void PayloadPool::unregister_memory_reclaimer(
+        uint64_t reclaimer_id)
+{
+    std::lock_guard<std::mutex> lock(memory_reclaimers_mutex_);
+    memory_reclaimers_.erase(reclaimer_id);
 }
 
 /////
 // INTERNAL PART
 
-void PayloadPool::add_reserved_payload_()
+bool PayloadPool::reserve_bytes_(
+        uint64_t size)
 {
-    ++reserve_count_;
+    if (try_reserve_bytes_(size))
+    {
+        return true;
+    }
+
+    bool reserved = false;
+    switch (configuration_.memory_policy)
+    {
+        case MemoryBudgetPolicy::MEMORY_EVICT:
+            reserved = evict_for_bytes_(size);
+            break;
+
+        case MemoryBudgetPolicy::MEMORY_BLOCK:
+            // Threads receiving data must not be stopped, so the data they receive is rejected instead
+            if (!reserving_ingress)
+            {
+                reserved = wait_for_bytes_(size);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (!reserved)
+    {
+        logWarning(DDSROUTER_PAYLOADPOOL,
+                "Data of " << size << " bytes does not fit in memory budget of " << configuration_.memory_budget
+                           << " bytes with " << reserved_bytes_ << " bytes reserved. Discarding it.");
+    }
+
+    return reserved;
+}
+
+void PayloadPool::release_bytes_(
+        uint64_t size) noexcept
+{
+    reserved_bytes_ -= size;
+
+    // Waiters register themselves before checking the budget, so either they see these bytes released or
+    // they are notified
+    if (memory_waiters_ > 0)
+    {
+        std::lock_guard<std::mutex> lock(memory_released_mutex_);
+        memory_released_cv_.notify_all();
+    }
+}
+
+bool PayloadPool::try_reserve_bytes_(
+        uint64_t size) noexcept
+{
+    uint64_t reserved = 0;
+
+    if (configuration_.memory_budget == 0)
+    {
+        reserved = reserved_bytes_ += size;
+    }
+    else
+    {
+        uint64_t current = reserved_bytes_.load();
+        do
+        {
+            if (current + size > configuration_.memory_budget)
+            {
+                return false;
+            }
+        } while (!reserved_bytes_.compare_exchange_weak(current, current + size));
+
+        reserved = current + size;
+    }
+
+    // Update the high watermark. It is only written when raised, never when releasing, so in steady state it is
+    // only read. It only loops if other thread has raised it at the same time
+    uint64_t max_reserved = max_reserved_bytes_.load(std::memory_order_relaxed);
+    while (reserved > max_reserved &&
+            !max_reserved_bytes_.compare_exchange_weak(max_reserved, reserved, std::memory_order_relaxed))
+    {
+    }
+
+    return true;
+}
+
+bool PayloadPool::evict_for_bytes_(
+        uint64_t size)
+{
+    std::lock_guard<std::mutex> lock(memory_reclaimers_mutex_);
+
+    // Ask each reclaimer in turn, so the samples evicted are spread among every owner
+    bool any_released = true;
+    while (any_released)
+    {
+        any_released = false;
+        for (auto& reclaimer : memory_reclaimers_)
+        {
+            if (try_reserve_bytes_(size))
+            {
+                return true;
+            }
+            any_released = reclaimer.second() || any_released;
+        }
+    }
+
+    return try_reserve_bytes_(size);
+}
+
+bool PayloadPool::wait_for_bytes_(
+        uint64_t size)
+{
+    std::unique_lock<std::mutex> lock(memory_released_mutex_);
+    memory_waiters_++;
+
+    bool reserved = memory_released_cv_.wait_for(
+        lock,
+        std::chrono::milliseconds(configuration_.memory_block_timeout),
+        [this, size]()
+        {
+            return try_reserve_bytes_(size);
+        });
+
+    memory_waiters_--;
+    return reserved;
+}
+
+uint32_t PayloadPool::copy_reserve_size_(
+        const Payload& src_payload) const noexcept
+{
+    if (src_payload.length == 0)
+    {
+        return src_payload.max_size;
+    }
+
+    switch (configuration_.copy_size)
+    {
+        case PayloadCopySize::COPY_LENGTH:
+            return src_payload.length;
+
+        case PayloadCopySize::COPY_SIZE_CLASS:
+            // Never reserve more than the source max size
+            return std::min(std::bit_ceil(src_payload.length), std::max(src_payload.max_size, src_payload.length));
+
+        default:
+            return src_payload.max_size;
+    }
+}
+
+void PayloadPool::add_reserved_payload_(
+        uint32_t size)
+{
+    ++live_payloads_;
+
+    CounterShard& shard = counter_shard_();
+    shard.reserve_count.fetch_add(1, std::memory_order_relaxed);
+    shard.size_histogram[PayloadPoolStatistics::size_bucket(size)].fetch_add(1, std::memory_order_relaxed);
 }
 
 void PayloadPool::add_release_payload_()
 {
-    ++release_count_;
-    if (release_count_ > reserve_count_)
+    if (live_payloads_.fetch_sub(1) == 0)
     {
+        ++live_payloads_;
         logError(DDSROUTER_PAYLOADPOOL,
                 "Inconsistent PayloadPool, releasing more payloads than reserved.");
         throw InconsistencyException("Inconsistent PayloadPool, releasing more payloads than reserved.");
     }
 }
 
+void PayloadPool::add_referenced_payload_()
+{
+    counter_shard_().reference_count.fetch_add(1, std::memory_order_relaxed);
+    ++thread_operations.referenced;
+}
+
+void PayloadPool::add_copied_payload_()
+{
+    counter_shard_().copy_count.fetch_add(1, std::memory_order_relaxed);
+    ++thread_operations.copied;
+}
+
+PayloadPool::CounterShard& PayloadPool::counter_shard_() noexcept
+{
+    // Threads take consecutive shards, so up to NUMBER_OF_COUNTER_SHARDS threads never share one
+    thread_local unsigned int shard = next_counter_shard++ % NUMBER_OF_COUNTER_SHARDS;
+    return counter_shards_[shard];
+}
+
+void PayloadPool::add_low_priority_rejected_payload_()
+{
+    low_priority_rejected_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PayloadPool::add_deduplicated_payload_(
+        uint32_t length)
+{
+    deduplicated_count_.fetch_add(1, std::memory_order_relaxed);
+    deduplicated_bytes_.fetch_add(length, std::memory_order_relaxed);
+    ++thread_operations.referenced;
+}
+
 bool PayloadPool::reserve_(
         uint32_t size,
         Payload& payload)
@@ -142,9 +467,14 @@ bool PayloadPool::reserve_(
         return false;
     }
 
+    if (!reserve_bytes_(size))
+    {
+        return false;
+    }
+
     payload.reserve(size);
 
-    add_reserved_payload_();
+    add_reserved_payload_(size);
 
     return true;
 }
@@ -152,6 +482,8 @@ bool PayloadPool::reserve_(
 bool PayloadPool::release_(
         Payload& payload)
 {
+    uint32_t size = payload.data != nullptr ? payload.max_size : 0;
+
     payload.empty();
 
     if (payload.data != nullptr)
@@ -159,6 +491,7 @@ bool PayloadPool::release_(
         return false;
     }
 
+    release_bytes_(size);
     add_release_payload_();
 
     return true;
@@ -0,0 +1,125 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadPoolConfiguration.cpp
+ */
+
+#include <ddsrouter/communication/payload_pool/PayloadPoolConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+std::ostream& operator <<(
+        std::ostream& os,
+        const PayloadPoolKind& kind)
+{
+    switch (kind)
+    {
+        case PayloadPoolKind::MAP_PAYLOAD_POOL:
+            os << "map";
+            break;
+
+        case PayloadPoolKind::REFCOUNT_PAYLOAD_POOL:
+            os << "refcount";
+            break;
+
+        case PayloadPoolKind::SLAB_PAYLOAD_POOL:
+            os << "slab";
+            break;
+
+        case PayloadPoolKind::ARENA_PAYLOAD_POOL:
+            os << "arena";
+            break;
+
+        default:
+            os << "unknown";
+            break;
+    }
+    return os;
+}
+
+std::ostream& operator <<(
+        std::ostream& os,
+        const PayloadCopySize& copy_size)
+{
+    switch (copy_size)
+    {
+        case PayloadCopySize::COPY_MAX_SIZE:
+            os << "max-size";
+            break;
+
+        case PayloadCopySize::COPY_LENGTH:
+            os << "length";
+            break;
+
+        case PayloadCopySize::COPY_SIZE_CLASS:
+            os << "size-class";
+            break;
+
+        default:
+            os << "unknown";
+            break;
+    }
+    return os;
+}
+
+std::ostream& operator <<(
+        std::ostream& os,
+        const MemoryBudgetPolicy& policy)
+{
+    switch (policy)
+    {
+        case MemoryBudgetPolicy::MEMORY_REJECT:
+            os << "reject";
+            break;
+
+        case MemoryBudgetPolicy::MEMORY_EVICT:
+            os << "evict";
+            break;
+
+        case MemoryBudgetPolicy::MEMORY_BLOCK:
+            os << "block";
+            break;
+
+        default:
+            os << "unknown";
+            break;
+    }
+    return os;
+}
+
+std::ostream& operator <<(
+        std::ostream& os,
+        const PayloadPoolConfiguration& configuration)
+{
+    os << "PayloadPoolConfiguration{kind:" << configuration.kind << ";copy-size:" << configuration.copy_size
+       << ";memory-budget:" << configuration.memory_budget << ";memory-policy:" << configuration.memory_policy
+       << ";memory-block-timeout:" << configuration.memory_block_timeout
+       << ";max-size-class:" << configuration.max_size_class << ";arena-size:" << configuration.arena_size
+       << ";huge-pages:" << configuration.huge_pages << ";prefault:" << configuration.prefault
+       << ";dedup:" << configuration.deduplication << ";dedup-min-size:" << configuration.deduplication_min_size
+       << ";small-payload-size:" << configuration.small_payload_size
+       << ";small-payload-count:" << configuration.small_payload_count << ";numa-node:" << configuration.numa_node
+       << ";preallocated:[";
+    for (const auto& preallocation : configuration.preallocated_payloads)
+    {
+        os << preallocation.first << ":" << preallocation.second << ";";
+    }
+    os << "]}";
+    return os;
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
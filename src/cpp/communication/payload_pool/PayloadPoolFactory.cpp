@@ -0,0 +1,80 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PayloadPoolFactory.cpp
+ */
+
+#include <ddsrouter/communication/payload_pool/ArenaPayloadPool.hpp>
+#include <ddsrouter/communication/payload_pool/MapPayloadPool.hpp>
+#include <ddsrouter/communication/payload_pool/PayloadPoolFactory.hpp>
+#include <ddsrouter/communication/payload_pool/RefCountPayloadPool.hpp>
+#include <ddsrouter/communication/payload_pool/SlabPayloadPool.hpp>
+#include <ddsrouter/exceptions/ConfigurationException.hpp>
+#include <ddsrouter/types/Log.hpp>
+#include <ddsrouter/types/utils.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+std::shared_ptr<PayloadPool> PayloadPoolFactory::create_payload_pool(
+        const PayloadPoolConfiguration& configuration)
+{
+    logDebug(DDSROUTER_PAYLOADPOOL, "Creating PayloadPool with " << configuration << ".");
+
+    if (!configuration.preallocated_payloads.empty() &&
+            configuration.kind != PayloadPoolKind::SLAB_PAYLOAD_POOL &&
+            configuration.kind != PayloadPoolKind::ARENA_PAYLOAD_POOL)
+    {
+        logWarning(DDSROUTER_PAYLOADPOOL,
+                "Payloads preallocation is not supported by payload pool " << configuration.kind << ", ignoring it.");
+    }
+
+    if (configuration.deduplication && configuration.kind == PayloadPoolKind::MAP_PAYLOAD_POOL)
+    {
+        logWarning(DDSROUTER_PAYLOADPOOL,
+                "Data deduplication is not supported by payload pool " << configuration.kind << ", ignoring it.");
+    }
+
+    if (configuration.small_payload_size > 0 && configuration.kind == PayloadPoolKind::MAP_PAYLOAD_POOL)
+    {
+        logWarning(DDSROUTER_PAYLOADPOOL,
+                "Small payloads list is not supported by payload pool " << configuration.kind << ", ignoring it.");
+    }
+
+    // Create a new PayloadPool depending on the kind specified by the configuration
+    switch (configuration.kind)
+    {
+        case PayloadPoolKind::MAP_PAYLOAD_POOL:
+            return std::make_shared<MapPayloadPool>(configuration);
+
+        case PayloadPoolKind::REFCOUNT_PAYLOAD_POOL:
+            return std::make_shared<RefCountPayloadPool>(configuration);
+
+        case PayloadPoolKind::SLAB_PAYLOAD_POOL:
+            return std::make_shared<SlabPayloadPool>(configuration);
+
+        case PayloadPoolKind::ARENA_PAYLOAD_POOL:
+            return std::make_shared<ArenaPayloadPool>(configuration);
+
+        default:
+            // This should not happen as every kind must be in the switch
+            utils::tsnh(
+                utils::Formatter() << "Value of PayloadPoolKind out of enumeration.");
+            return nullptr; // Unreachable code
+    }
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
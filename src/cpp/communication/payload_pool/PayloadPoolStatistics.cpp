@@ -0,0 +1,85 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file PayloadPoolStatistics.cpp
+ */
+
+#include <algorithm>
+#include <bit>
+
+#include <ddsrouter/communication/payload_pool/PayloadPoolStatistics.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+unsigned int PayloadPoolStatistics::size_bucket(
+        uint32_t size) noexcept
+{
+    if (size <= SMALLEST_SIZE_BUCKET)
+    {
+        return 0;
+    }
+
+    unsigned int bucket = std::bit_width(size - 1) - std::bit_width(SMALLEST_SIZE_BUCKET - 1);
+    return std::min(bucket, NUMBER_OF_SIZE_BUCKETS - 1);
+}
+
+PayloadPoolStatistics& PayloadPoolStatistics::operator +=(
+        const PayloadPoolStatistics& other) noexcept
+{
+    reserved_bytes += other.reserved_bytes;
+    max_reserved_bytes += other.max_reserved_bytes;
+    live_payloads += other.live_payloads;
+    reserved_payloads += other.reserved_payloads;
+    referenced_payloads += other.referenced_payloads;
+    copied_payloads += other.copied_payloads;
+    deduplicated_payloads += other.deduplicated_payloads;
+    deduplicated_bytes += other.deduplicated_bytes;
+    low_priority_rejected_payloads += other.low_priority_rejected_payloads;
+    for (unsigned int i = 0; i < NUMBER_OF_SIZE_BUCKETS; i++)
+    {
+        size_histogram[i] += other.size_histogram[i];
+    }
+    return *this;
+}
+
+std::ostream& operator <<(
+        std::ostream& os,
+        const PayloadPoolStatistics& statistics)
+{
+    os << "PayloadPoolStatistics{reserved-bytes:" << statistics.reserved_bytes
+       << ";max-reserved-bytes:" << statistics.max_reserved_bytes
+       << ";live-payloads:" << statistics.live_payloads
+       << ";reserved-payloads:" << statistics.reserved_payloads
+       << ";referenced-payloads:" << statistics.referenced_payloads
+       << ";copied-payloads:" << statistics.copied_payloads
+       << ";deduplicated-payloads:" << statistics.deduplicated_payloads
+       << ";deduplicated-bytes:" << statistics.deduplicated_bytes
+       << ";low-priority-rejected-payloads:" << statistics.low_priority_rejected_payloads << ";size-histogram:[";
+    for (unsigned int i = 0; i < PayloadPoolStatistics::NUMBER_OF_SIZE_BUCKETS; i++)
+    {
+        if (statistics.size_histogram[i] > 0)
+        {
+            os << (static_cast<uint64_t>(PayloadPoolStatistics::SMALLEST_SIZE_BUCKET) << i) << ":"
+               << statistics.size_histogram[i] << ";";
+        }
+    }
+    os << "]}";
+    return os;
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
@@ -0,0 +1,66 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReaderPayloadPool.cpp
+ */
+
+#include <ddsrouter/communication/payload_pool/ReaderPayloadPool.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+ReaderPayloadPool::ReaderPayloadPool(
+        std::shared_ptr<PayloadPool> payload_pool,
+        bool low_priority)
+    : payload_pool_(payload_pool)
+    , low_priority_(low_priority)
+{
+}
+
+bool ReaderPayloadPool::get_payload(
+        uint32_t size,
+        fastrtps::rtps::CacheChange_t& cache_change)
+{
+    if (!payload_pool_->get_ingress_payload(size, cache_change.serializedPayload, low_priority_))
+    {
+        return false;
+    }
+
+    cache_change.payload_owner(payload_pool_.get());
+    return true;
+}
+
+bool ReaderPayloadPool::get_payload(
+        fastrtps::rtps::SerializedPayload_t& data,
+        IPayloadPool*& data_owner,
+        fastrtps::rtps::CacheChange_t& cache_change)
+{
+    if (!payload_pool_->get_ingress_payload(data, data_owner, cache_change.serializedPayload, low_priority_))
+    {
+        return false;
+    }
+
+    cache_change.payload_owner(payload_pool_.get());
+    return true;
+}
+
+bool ReaderPayloadPool::release_payload(
+        fastrtps::rtps::CacheChange_t& cache_change)
+{
+    return payload_pool_->release_payload(cache_change);
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
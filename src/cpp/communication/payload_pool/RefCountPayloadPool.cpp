@@ -0,0 +1,451 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file RefCountPayloadPool.cpp
+ *
+ */
+
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <ddsrouter/communication/payload_pool/RefCountPayloadPool.hpp>
+#include <ddsrouter/exceptions/InconsistencyException.hpp>
+#include <ddsrouter/types/Log.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+namespace {
+
+constexpr uint64_t HASH_PRIME_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t HASH_PRIME_3 = 0x165667B19E3779F9ull;
+
+//! Load 8 bytes from a possibly unaligned address
+uint64_t load_64(
+        const PayloadUnit* data) noexcept
+{
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+//! Mix \c value into the hash lane \c lane
+uint64_t hash_round(
+        uint64_t lane,
+        uint64_t value) noexcept
+{
+    lane += value * HASH_PRIME_2;
+    lane = std::rotl(lane, 31);
+    return lane * HASH_PRIME_1;
+}
+
+} /* namespace */
+
+RefCountPayloadPool::RefCountPayloadPool(
+        const PayloadPoolConfiguration& configuration)
+    : PayloadPool(configuration)
+{
+    if (configuration.small_payload_size > 0 && configuration.small_payload_count > 0)
+    {
+        small_payloads_ = std::make_unique<FixedSizeFreeList>(
+            sizeof(Header) + configuration.small_payload_size,
+            configuration.small_payload_count);
+    }
+}
+
+RefCountPayloadPool::~RefCountPayloadPool()
+{
+    if (!is_clean())
+    {
+        logError(
+            DDSROUTER_PAYLOADPOOL,
+            "Removing RefCountPayloadPool with still " << live_payloads_ << " payloads referenced.");
+
+        // Small data not released yet live in the list, so it is not freed
+        static_cast<void>(small_payloads_.release());
+    }
+}
+
+bool RefCountPayloadPool::get_payload(
+        uint32_t size,
+        Payload& payload)
+{
+    return reserve_(size, payload);
+}
+
+bool RefCountPayloadPool::get_payload(
+        const Payload& src_payload,
+        IPayloadPool*& data_owner,
+        Payload& target_payload)
+{
+    if (data_owner == this)
+    {
+        check_owner_(src_payload);
+    }
+
+    // Reference a data with the same content, if there is any
+    uint64_t hash = 0;
+    bool deduplicable = deduplicable_(src_payload);
+    if (deduplicable && reference_duplicate_(src_payload, target_payload, hash))
+    {
+        return true;
+    }
+
+    // If we are not the owner, create a new payload. Else, reference the existing one
+    if (data_owner != this)
+    {
+        // Store space for payload
+        if (!get_payload(copy_reserve_size_(src_payload), target_payload))
+        {
+            return false;
+        }
+
+        // Copy info
+        std::memcpy(target_payload.data, src_payload.data, src_payload.length);
+        target_payload.length = src_payload.length;
+
+        add_copied_payload_();
+    }
+    else
+    {
+        // Add reference. No ordering is required, as the caller already holds a reference to the data
+        header_(src_payload)->references.fetch_add(1, std::memory_order_relaxed);
+
+        // Set Payload to refer same payload
+        target_payload.data = src_payload.data;
+        target_payload.length = src_payload.length;
+        target_payload.max_size = src_payload.max_size;
+
+        add_referenced_payload_();
+    }
+
+    // Next payloads with the same content will reference this data
+    if (deduplicable)
+    {
+        index_data_(target_payload, hash);
+    }
+
+    return true;
+}
+
+bool RefCountPayloadPool::release_payload(
+        Payload& payload)
+{
+    check_owner_(payload);
+
+    // In case it was the last reference, release payload.
+    // Acquire-release so every access from other references happens before the data is freed
+    if (header_(payload)->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        if (!release_(payload))
+        {
+            return false;
+        }
+    }
+
+    // Restore payload info
+    payload.length = 0;
+    payload.pos = 0;
+    payload.max_size = 0;
+    payload.data = nullptr;
+
+    return true;
+}
+
+RefCountPayloadPool::Header* RefCountPayloadPool::header_(
+        const Payload& payload) noexcept
+{
+    return header_(payload.data);
+}
+
+RefCountPayloadPool::Header* RefCountPayloadPool::header_(
+        PayloadUnit* data) noexcept
+{
+    return reinterpret_cast<Header*>(data) - 1;
+}
+
+bool RefCountPayloadPool::reserve_(
+        uint32_t size,
+        Payload& payload)
+{
+    if (size == 0)
+    {
+        logError(DDSROUTER_PAYLOADPOOL,
+                "Trying to reserve a data block of 0 bytes.");
+        return false;
+    }
+
+    void* block = nullptr;
+    uint32_t capacity = 0;
+
+    // Small data are taken from the free list, unless it is exhausted
+    if (small_payloads_ && size <= configuration_.small_payload_size)
+    {
+        block = small_payloads_->allocate();
+        if (block != nullptr)
+        {
+            capacity = configuration_.small_payload_size;
+            if (!reserve_bytes_(capacity))
+            {
+                small_payloads_->free(block);
+                return false;
+            }
+        }
+    }
+
+    if (block == nullptr)
+    {
+        capacity = block_capacity_(size);
+        if (!reserve_bytes_(capacity))
+        {
+            return false;
+        }
+
+        block = allocate_block_(capacity);
+        if (block == nullptr)
+        {
+            release_bytes_(capacity);
+            logError(DDSROUTER_PAYLOADPOOL,
+                    "Error reserving a data block of " << size << " bytes.");
+            return false;
+        }
+    }
+
+    Header* header = new (block) Header();
+    header->references.store(1, std::memory_order_relaxed);
+    header->capacity = capacity;
+    header->pool = this;
+
+    payload.data = reinterpret_cast<PayloadUnit*>(header + 1);
+    payload.max_size = size;
+
+    add_reserved_payload_(size);
+
+    return true;
+}
+
+bool RefCountPayloadPool::release_(
+        Payload& payload)
+{
+    // Data must leave the index before being freed, so it is not found by other payloads
+    if (configuration_.deduplication)
+    {
+        unindex_data_(payload);
+    }
+
+    Header* header = header_(payload);
+    uint32_t capacity = header->capacity;
+    header->~Header();
+    if (small_payloads_ && small_payloads_->contains(header))
+    {
+        small_payloads_->free(header);
+    }
+    else
+    {
+        free_block_(header, capacity);
+    }
+    release_bytes_(capacity);
+
+    payload.data = nullptr;
+
+    add_release_payload_();
+
+    return true;
+}
+
+uint32_t RefCountPayloadPool::block_capacity_(
+        uint32_t size) const noexcept
+{
+    return size;
+}
+
+void* RefCountPayloadPool::allocate_block_(
+        uint32_t capacity)
+{
+    return std::malloc(sizeof(Header) + capacity);
+}
+
+void RefCountPayloadPool::free_block_(
+        void* block,
+        uint32_t capacity)
+{
+    static_cast<void>(capacity);
+    std::free(block);
+}
+
+void RefCountPayloadPool::check_owner_(
+        const Payload& payload) const
+{
+    if (payload.data == nullptr || header_(payload)->pool != this)
+    {
+        logError(DDSROUTER_PAYLOADPOOL, "Trying to use a payload from this pool that has not been reserved here.");
+        throw InconsistencyException("Trying to use a payload from this pool that has not been reserved here.");
+    }
+}
+
+uint64_t RefCountPayloadPool::content_hash_(
+        const PayloadUnit* data,
+        uint32_t length) noexcept
+{
+    // Four independent lanes of 8 bytes, so the main loop can be vectorized
+    uint64_t lanes[4] = {
+        HASH_PRIME_1 + HASH_PRIME_2,
+        HASH_PRIME_2,
+        0,
+        0 - HASH_PRIME_1};
+
+    uint32_t position = 0;
+    for (; position + 32 <= length; position += 32)
+    {
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            lanes[i] = hash_round(lanes[i], load_64(data + position + 8 * i));
+        }
+    }
+
+    uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) +
+            std::rotl(lanes[3], 18) + length;
+
+    // Remaining bytes
+    for (; position + 8 <= length; position += 8)
+    {
+        hash ^= hash_round(0, load_64(data + position));
+        hash = std::rotl(hash, 27) * HASH_PRIME_1 + HASH_PRIME_3;
+    }
+    for (; position < length; position++)
+    {
+        hash ^= data[position] * HASH_PRIME_3;
+        hash = std::rotl(hash, 11) * HASH_PRIME_1;
+    }
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+bool RefCountPayloadPool::deduplicable_(
+        const Payload& payload) const noexcept
+{
+    return configuration_.deduplication && payload.length > 0 &&
+           payload.length >= configuration_.deduplication_min_size;
+}
+
+bool RefCountPayloadPool::reference_duplicate_(
+        const Payload& src_payload,
+        Payload& target_payload,
+        uint64_t& hash)
+{
+    {
+        std::lock_guard<std::mutex> lock(deduplication_mutex_);
+
+        // The data is already indexed, so it is the one to reference
+        if (deduplication_entries_.find(src_payload.data) != deduplication_entries_.end())
+        {
+            header_(src_payload)->references.fetch_add(1, std::memory_order_relaxed);
+
+            target_payload.data = src_payload.data;
+            target_payload.length = src_payload.length;
+            target_payload.max_size = src_payload.max_size;
+
+            add_referenced_payload_();
+            return true;
+        }
+    }
+
+    // Hash outside the lock, as it is the most expensive part
+    hash = content_hash_(src_payload.data, src_payload.length);
+
+    std::lock_guard<std::mutex> lock(deduplication_mutex_);
+
+    auto candidates = deduplication_index_.equal_range(hash);
+    for (auto it = candidates.first; it != candidates.second; ++it)
+    {
+        PayloadUnit* data = it->second;
+        const DeduplicationEntry& entry = deduplication_entries_[data];
+
+        // Same hash does not guarantee same content
+        if (entry.length != src_payload.length || std::memcmp(data, src_payload.data, entry.length) != 0)
+        {
+            continue;
+        }
+
+        // Add reference unless the data is being released by other thread
+        std::atomic<uint32_t>& references = header_(data)->references;
+        uint32_t current = references.load(std::memory_order_relaxed);
+        while (current > 0 &&
+                !references.compare_exchange_weak(current, current + 1, std::memory_order_relaxed))
+        {
+        }
+        if (current == 0)
+        {
+            continue;
+        }
+
+        target_payload.data = data;
+        target_payload.length = entry.length;
+        target_payload.max_size = entry.max_size;
+
+        add_deduplicated_payload_(entry.length);
+        return true;
+    }
+
+    return false;
+}
+
+void RefCountPayloadPool::index_data_(
+        const Payload& payload,
+        uint64_t hash)
+{
+    std::lock_guard<std::mutex> lock(deduplication_mutex_);
+
+    if (deduplication_entries_.emplace(payload.data, DeduplicationEntry{hash, payload.length, payload.max_size}).second)
+    {
+        deduplication_index_.emplace(hash, payload.data);
+    }
+}
+
+void RefCountPayloadPool::unindex_data_(
+        const Payload& payload)
+{
+    std::lock_guard<std::mutex> lock(deduplication_mutex_);
+
+    auto entry = deduplication_entries_.find(payload.data);
+    if (entry == deduplication_entries_.end())
+    {
+        return;
+    }
+
+    auto candidates = deduplication_index_.equal_range(entry->second.hash);
+    for (auto it = candidates.first; it != candidates.second; ++it)
+    {
+        if (it->second == payload.data)
+        {
+            deduplication_index_.erase(it);
+            break;
+        }
+    }
+    deduplication_entries_.erase(entry);
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
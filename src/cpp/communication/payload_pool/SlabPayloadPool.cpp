@@ -0,0 +1,295 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SlabPayloadPool.cpp
+ *
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+#include <ddsrouter/communication/payload_pool/SlabPayloadPool.hpp>
+#include <ddsrouter/types/Log.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+std::atomic<uint64_t> SlabPayloadPool::next_id_(1);
+
+SlabPayloadPool::SlabPayloadPool(
+        const PayloadPoolConfiguration& configuration)
+    : SlabPayloadPool(configuration, nullptr)
+{
+}
+
+SlabPayloadPool::SlabPayloadPool(
+        const PayloadPoolConfiguration& configuration,
+        std::shared_ptr<MemoryArena> arena)
+    : RefCountPayloadPool(configuration)
+    , id_(next_id_++)
+    , max_size_class_(std::bit_ceil(std::clamp(configuration.max_size_class, MIN_SIZE_CLASS, LARGEST_SIZE_CLASS)))
+    , depot_(std::make_shared<Depot>(arena))
+    , heap_allocations_(0)
+    , arena_exhausted_allocations_(0)
+{
+    for (const auto& preallocation : configuration.preallocated_payloads)
+    {
+        uint32_t block_size_class = size_class(preallocation.first, max_size_class_);
+        if (block_size_class == 0)
+        {
+            logWarning(DDSROUTER_PAYLOADPOOL,
+                    "Not preallocating payloads of " << preallocation.first << " bytes, larger than the largest "
+                    "size class of " << max_size_class_ << " bytes.");
+            continue;
+        }
+
+        std::vector<void*>& free_blocks = depot_->free_blocks[size_class_index_(block_size_class)];
+        for (unsigned int i = 0; i < preallocation.second; i++)
+        {
+            void* block = allocate_new_block_(block_size_class);
+            if (block == nullptr)
+            {
+                logWarning(DDSROUTER_PAYLOADPOOL,
+                        "Error preallocating payloads of " << block_size_class << " bytes.");
+                break;
+            }
+            free_blocks.push_back(block);
+        }
+    }
+
+    logDebug(DDSROUTER_PAYLOADPOOL, "SlabPayloadPool created with " << heap_allocations_ << " blocks preallocated.");
+}
+
+SlabPayloadPool::~SlabPayloadPool()
+{
+    depot_->alive = false;
+
+    // Blocks of this pool in the current thread are given back now. Other threads give them back on their next
+    // access to a pool or when they finish
+    ThreadCache& cache = thread_cache_();
+    cache.magazines.erase(id_);
+    if (cache.last_id == id_)
+    {
+        cache.last_id = 0;
+        cache.last = nullptr;
+    }
+}
+
+uint32_t SlabPayloadPool::size_class(
+        uint32_t size,
+        uint32_t max_size_class /* = MAX_SIZE_CLASS */) noexcept
+{
+    if (size > max_size_class)
+    {
+        return 0;
+    }
+    else if (size <= MIN_SIZE_CLASS)
+    {
+        return MIN_SIZE_CLASS;
+    }
+    else
+    {
+        return std::bit_ceil(size);
+    }
+}
+
+uint32_t SlabPayloadPool::max_size_class() const noexcept
+{
+    return max_size_class_;
+}
+
+uint64_t SlabPayloadPool::heap_allocations() const noexcept
+{
+    return heap_allocations_;
+}
+
+uint64_t SlabPayloadPool::arena_exhausted_allocations() const noexcept
+{
+    return arena_exhausted_allocations_;
+}
+
+SlabPayloadPool::Depot::Depot(
+        std::shared_ptr<MemoryArena> arena)
+    : arena(arena)
+{
+}
+
+SlabPayloadPool::Depot::~Depot()
+{
+    // Blocks carved from the arena are released when it is unmapped
+    for (std::vector<void*>& size_class_blocks : free_blocks)
+    {
+        for (void* block : size_class_blocks)
+        {
+            if (!arena || !arena->contains(block))
+            {
+                std::free(block);
+            }
+        }
+    }
+}
+
+SlabPayloadPool::Magazines::Magazines(
+        std::shared_ptr<Depot> depot)
+    : depot(depot)
+{
+}
+
+SlabPayloadPool::Magazines::~Magazines()
+{
+    std::lock_guard<std::mutex> lock(depot->mutex);
+
+    for (unsigned int i = 0; i < NUMBER_OF_SIZE_CLASSES; i++)
+    {
+        depot->free_blocks[i].insert(depot->free_blocks[i].end(), free_blocks[i].begin(), free_blocks[i].end());
+    }
+}
+
+unsigned int SlabPayloadPool::size_class_index_(
+        uint32_t size_class) noexcept
+{
+    return std::countr_zero(size_class) - std::countr_zero(MIN_SIZE_CLASS);
+}
+
+SlabPayloadPool::Magazines& SlabPayloadPool::thread_magazines_()
+{
+    ThreadCache& cache = thread_cache_();
+
+    // Fast path: same pool as last access from this thread
+    if (cache.last_id == id_)
+    {
+        return *cache.last;
+    }
+
+    // Give back the blocks of the pools already destroyed, so they are freed with their depot
+    for (auto it = cache.magazines.begin(); it != cache.magazines.end();)
+    {
+        if (!it->second.depot->alive)
+        {
+            it = cache.magazines.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    auto it = cache.magazines.try_emplace(id_, depot_).first;
+    cache.last_id = id_;
+    cache.last = &it->second;
+
+    return it->second;
+}
+
+SlabPayloadPool::ThreadCache& SlabPayloadPool::thread_cache_()
+{
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+void* SlabPayloadPool::allocate_new_block_(
+        uint32_t size_class)
+{
+    if (depot_->arena)
+    {
+        void* block = depot_->arena->allocate(sizeof(Header) + size_class);
+        if (block != nullptr)
+        {
+            return block;
+        }
+    }
+
+    void* block = std::malloc(sizeof(Header) + size_class);
+    if (block != nullptr)
+    {
+        heap_allocations_++;
+
+        // Only the first block out of the arena is logged, as every following one will be out of it as well
+        if (depot_->arena && arena_exhausted_allocations_++ == 0)
+        {
+            logWarning(DDSROUTER_PAYLOADPOOL,
+                    "Arena of " << depot_->arena->size() << " bytes exhausted. New blocks are allocated from "
+                    "the heap: increase the arena size to keep every data in it.");
+        }
+    }
+    return block;
+}
+
+uint32_t SlabPayloadPool::block_capacity_(
+        uint32_t size) const noexcept
+{
+    uint32_t block_size_class = size_class(size, max_size_class_);
+    return block_size_class == 0 ? size : block_size_class;
+}
+
+void* SlabPayloadPool::allocate_block_(
+        uint32_t capacity)
+{
+    if (capacity > max_size_class_)
+    {
+        return RefCountPayloadPool::allocate_block_(capacity);
+    }
+
+    unsigned int index = size_class_index_(capacity);
+    std::vector<void*>& magazine = thread_magazines_().free_blocks[index];
+
+    if (magazine.empty())
+    {
+        // Refill half of the magazine from the depot
+        std::lock_guard<std::mutex> lock(depot_->mutex);
+        std::vector<void*>& free_blocks = depot_->free_blocks[index];
+        size_t n_blocks = std::min<size_t>(free_blocks.size(), MAGAZINE_SIZE / 2);
+        magazine.insert(magazine.end(), free_blocks.end() - n_blocks, free_blocks.end());
+        free_blocks.resize(free_blocks.size() - n_blocks);
+    }
+
+    if (magazine.empty())
+    {
+        return allocate_new_block_(capacity);
+    }
+
+    void* block = magazine.back();
+    magazine.pop_back();
+    return block;
+}
+
+void SlabPayloadPool::free_block_(
+        void* block,
+        uint32_t capacity)
+{
+    if (capacity > max_size_class_)
+    {
+        RefCountPayloadPool::free_block_(block, capacity);
+        return;
+    }
+
+    unsigned int index = size_class_index_(capacity);
+    std::vector<void*>& magazine = thread_magazines_().free_blocks[index];
+
+    if (magazine.size() >= MAGAZINE_SIZE)
+    {
+        // Move half of the magazine to the depot
+        std::lock_guard<std::mutex> lock(depot_->mutex);
+        std::vector<void*>& free_blocks = depot_->free_blocks[index];
+        free_blocks.insert(free_blocks.end(), magazine.end() - MAGAZINE_SIZE / 2, magazine.end());
+        magazine.resize(magazine.size() - MAGAZINE_SIZE / 2);
+    }
+
+    magazine.push_back(block);
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
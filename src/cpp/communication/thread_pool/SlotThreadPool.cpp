@@ -0,0 +1,419 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SlotThreadPool.cpp
+ *
+ */
+
+#include <ddsrouter/communication/thread_pool/SlotThreadPool.hpp>
+#include <ddsrouter/types/Log.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+SlotThreadPool::SlotThreadPool(
+        unsigned int n_threads,
+        bool thread_per_slot /* = false */)
+    : next_slot_id_(0)
+    , queued_slots_(0)
+    , sleeping_workers_(0)
+    , next_worker_(0)
+    , terminate_(false)
+    , thread_per_slot_(thread_per_slot)
+{
+    if (thread_per_slot_)
+    {
+        logDebug(DDSROUTER_THREADPOOL, "Creating thread pool with a thread per slot.");
+        return;
+    }
+
+    if (n_threads == 0)
+    {
+        logWarning(DDSROUTER_THREADPOOL, "Thread pool cannot have 0 threads. Using 1 thread instead.");
+        n_threads = 1;
+    }
+
+    logDebug(DDSROUTER_THREADPOOL, "Creating thread pool with " << n_threads << " threads.");
+
+    // Create every worker before starting the threads, as workers steal from each other
+    for (unsigned int i = 0; i < n_threads; ++i)
+    {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    for (unsigned int i = 0; i < n_threads; ++i)
+    {
+        workers_[i]->thread = std::thread(&SlotThreadPool::worker_routine_, this, i);
+    }
+}
+
+SlotThreadPool::~SlotThreadPool()
+{
+    logDebug(DDSROUTER_THREADPOOL, "Destroying thread pool.");
+
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        terminate_ = true;
+    }
+
+    for (std::unique_ptr<Worker>& worker : workers_)
+    {
+        worker->condition_variable.notify_all();
+    }
+
+    for (std::unique_ptr<Worker>& worker : workers_)
+    {
+        worker->thread.join();
+    }
+
+    for (auto& slot_it : slots_)
+    {
+        stop_slot_thread_(*slot_it.second);
+    }
+
+    logDebug(DDSROUTER_THREADPOOL, "Thread pool destroyed.");
+}
+
+TaskId SlotThreadPool::register_slot(
+        Task&& task) noexcept
+{
+    std::unique_lock<std::shared_timed_mutex> lock(slots_mutex_);
+
+    TaskId new_id = next_slot_id_++;
+    std::shared_ptr<Slot> slot = std::make_shared<Slot>(std::move(task));
+    slots_[new_id] = slot;
+
+    if (thread_per_slot_)
+    {
+        slot->thread = std::thread(&SlotThreadPool::slot_routine_, this, slot);
+    }
+
+    return new_id;
+}
+
+void SlotThreadPool::unregister_slot(
+        const TaskId& slot_id) noexcept
+{
+    std::shared_ptr<Slot> slot;
+
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(slots_mutex_);
+
+        auto it = slots_.find(slot_id);
+        if (it == slots_.end())
+        {
+            return;
+        }
+
+        slot = it->second;
+        slots_.erase(it);
+    }
+
+    // From now on the slot will not be executed again, even if it is still in the queue
+    slot->removed.store(true);
+    stop_slot_thread_(*slot);
+
+    // Wait for the current execution to finish (if any)
+    std::lock_guard<std::mutex> execution_lock(slot->execution_mutex);
+}
+
+void SlotThreadPool::emit(
+        const TaskId& slot_id) noexcept
+{
+    std::shared_ptr<Slot> slot = get_slot_(slot_id);
+    if (!slot)
+    {
+        return;
+    }
+
+    if (thread_per_slot_)
+    {
+        {
+            std::lock_guard<std::mutex> lock(slot->emit_mutex);
+            slot->emitted = true;
+        }
+        slot->emit_condition_variable.notify_one();
+        return;
+    }
+
+    SlotStatus status = slot->status.load();
+    while (true)
+    {
+        if (status == IDLE)
+        {
+            if (slot->status.compare_exchange_weak(status, QUEUED))
+            {
+                enqueue_(slot);
+                return;
+            }
+        }
+        else if (status == RUNNING)
+        {
+            // It will be queued again by the thread executing it once it finishes
+            if (slot->status.compare_exchange_weak(status, RUNNING_PENDING))
+            {
+                return;
+            }
+        }
+        else
+        {
+            // Already QUEUED or RUNNING_PENDING, so it will be executed in the future
+            return;
+        }
+    }
+}
+
+void SlotThreadPool::emit_inline(
+        const TaskId& slot_id) noexcept
+{
+    std::shared_ptr<Slot> slot = get_slot_(slot_id);
+    if (!slot || thread_per_slot_)
+    {
+        emit(slot_id);
+        return;
+    }
+
+    // Take the slot as if it were queued, so no other thread executes it meanwhile
+    SlotStatus status = IDLE;
+    if (slot->status.compare_exchange_strong(status, QUEUED))
+    {
+        // Keep the last worker so the slot returns to it if it must be queued afterwards
+        execute_(slot, slot->last_worker.load());
+        return;
+    }
+
+    // It is queued or running, so it is already going to be executed
+    emit(slot_id);
+}
+
+unsigned int SlotThreadPool::n_threads() const noexcept
+{
+    return workers_.size();
+}
+
+std::shared_ptr<SlotThreadPool::Slot> SlotThreadPool::get_slot_(
+        const TaskId& slot_id) noexcept
+{
+    std::shared_lock<std::shared_timed_mutex> lock(slots_mutex_);
+
+    auto it = slots_.find(slot_id);
+    if (it == slots_.end())
+    {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+void SlotThreadPool::worker_routine_(
+        unsigned int worker_index) noexcept
+{
+    Worker& worker = *workers_[worker_index];
+
+    while (true)
+    {
+        // Look for work in its own queue first, and if empty, steal from others
+        std::shared_ptr<Slot> slot = pop_(worker_index);
+        if (!slot)
+        {
+            slot = steal_(worker_index);
+        }
+
+        if (slot)
+        {
+            execute_(slot, worker_index);
+            continue;
+        }
+
+        // No work anywhere, wait till something is queued
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        worker.sleeping = true;
+        sleeping_workers_++;
+        worker.condition_variable.wait(
+            lock,
+            [this]
+            {
+                return terminate_ || queued_slots_.load() > 0;
+            });
+        sleeping_workers_--;
+        worker.sleeping = false;
+
+        if (terminate_)
+        {
+            return;
+        }
+    }
+}
+
+std::shared_ptr<SlotThreadPool::Slot> SlotThreadPool::pop_(
+        unsigned int worker_index) noexcept
+{
+    Worker& worker = *workers_[worker_index];
+    std::lock_guard<std::mutex> lock(worker.queue_mutex);
+
+    if (worker.queue.empty())
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Slot> slot = worker.queue.front();
+    worker.queue.pop_front();
+    queued_slots_--;
+    return slot;
+}
+
+std::shared_ptr<SlotThreadPool::Slot> SlotThreadPool::steal_(
+        unsigned int worker_index) noexcept
+{
+    // Start looking in the next worker so not every thief goes to the same victim
+    for (unsigned int i = 1; i < workers_.size(); ++i)
+    {
+        Worker& victim = *workers_[(worker_index + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.queue_mutex);
+
+        if (!victim.queue.empty())
+        {
+            // Steal from the back, the opposite end than the owner, to reduce contention
+            std::shared_ptr<Slot> slot = victim.queue.back();
+            victim.queue.pop_back();
+            queued_slots_--;
+            return slot;
+        }
+    }
+
+    return nullptr;
+}
+
+void SlotThreadPool::enqueue_(
+        std::shared_ptr<Slot> slot) noexcept
+{
+    unsigned int worker_index = slot->last_worker.load();
+    if (worker_index == NO_WORKER)
+    {
+        worker_index = next_worker_++ % workers_.size();
+    }
+
+    {
+        Worker& worker = *workers_[worker_index];
+        std::lock_guard<std::mutex> lock(worker.queue_mutex);
+        worker.queue.push_back(slot);
+    }
+
+    queued_slots_++;
+
+    // Every worker is awake, so one of them will find the slot before going to sleep
+    if (sleeping_workers_.load() == 0)
+    {
+        return;
+    }
+
+    // Lock so a worker cannot check the counter and go to sleep without being notified
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+
+    // Awake the owner if sleeping, so the slot keeps in the same core.
+    // Otherwise awake another sleeping worker so it steals it.
+    if (workers_[worker_index]->sleeping)
+    {
+        workers_[worker_index]->condition_variable.notify_one();
+        return;
+    }
+
+    for (std::unique_ptr<Worker>& worker : workers_)
+    {
+        if (worker->sleeping)
+        {
+            worker->condition_variable.notify_one();
+            return;
+        }
+    }
+}
+
+void SlotThreadPool::slot_routine_(
+        std::shared_ptr<Slot> slot) noexcept
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(slot->emit_mutex);
+            slot->emit_condition_variable.wait(
+                lock,
+                [&slot]
+                {
+                    return slot->emitted || slot->removed.load();
+                });
+
+            if (slot->removed)
+            {
+                return;
+            }
+
+            // Emissions from now on run the task once more
+            slot->emitted = false;
+        }
+
+        std::lock_guard<std::mutex> execution_lock(slot->execution_mutex);
+        if (slot->removed)
+        {
+            return;
+        }
+        slot->task();
+    }
+}
+
+void SlotThreadPool::stop_slot_thread_(
+        Slot& slot) noexcept
+{
+    if (!slot.thread.joinable())
+    {
+        return;
+    }
+
+    {
+        // Lock so the thread cannot check the flag and go to sleep without being notified
+        std::lock_guard<std::mutex> lock(slot.emit_mutex);
+        slot.removed.store(true);
+    }
+    slot.emit_condition_variable.notify_one();
+    slot.thread.join();
+}
+
+void SlotThreadPool::execute_(
+        std::shared_ptr<Slot> slot,
+        unsigned int worker_index) noexcept
+{
+    {
+        std::lock_guard<std::mutex> execution_lock(slot->execution_mutex);
+
+        if (slot->removed)
+        {
+            return;
+        }
+
+        slot->status.store(RUNNING);
+        slot->last_worker.store(worker_index);
+        slot->task();
+    }
+
+    // If it has been emitted while running, queue it again at the end so other slots are not starved
+    SlotStatus status = RUNNING;
+    if (!slot->status.compare_exchange_strong(status, IDLE))
+    {
+        slot->status.store(QUEUED);
+        enqueue_(slot);
+    }
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
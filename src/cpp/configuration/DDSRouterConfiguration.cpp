@@ -18,8 +18,10 @@
  */
 
 #include <ddsrouter/configuration/DDSRouterConfiguration.hpp>
+#include <ddsrouter/communication/payload_pool/SlabPayloadPool.hpp>
 #include <ddsrouter/types/configuration_tags.hpp>
 #include <ddsrouter/types/Log.hpp>
+#include <ddsrouter/types/utils.hpp>
 #include <ddsrouter/types/topic/WildcardTopic.hpp>
 #include <ddsrouter/exceptions/ConfigurationException.hpp>
 
@@ -87,57 +89,396 @@ std::set<RealTopic> DDSRouterConfiguration::real_topics() const
     return result;
 }
 
-std::list<std::shared_ptr<FilterTopic>> DDSRouterConfiguration::generic_get_topic_list_(
-        const char* list_tag) const
+unsigned int DDSRouterConfiguration::number_of_threads() const
 {
-    // TODO: support regex topic
+    int number_of_threads = DEFAULT_NUMBER_OF_THREADS;
 
-    std::list<std::shared_ptr<FilterTopic>> result;
+    try
+    {
+        if (raw_configuration_[SPECS_TAG] && raw_configuration_[SPECS_TAG][NUMBER_THREADS_TAG])
+        {
+            number_of_threads = raw_configuration_[SPECS_TAG][NUMBER_THREADS_TAG].as<int>();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error while getting " << NUMBER_THREADS_TAG << " in DDSRouter configuration: " << e.what());
+    }
+
+    if (number_of_threads <= 0)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Number of threads in DDSRouter configuration must be positive, "
+                      << number_of_threads << " given.");
+    }
+
+    return static_cast<unsigned int>(number_of_threads);
+}
+
+bool DDSRouterConfiguration::thread_per_track() const
+{
+    try
+    {
+        if (raw_configuration_[SPECS_TAG] && raw_configuration_[SPECS_TAG][THREAD_PER_TRACK_TAG])
+        {
+            return raw_configuration_[SPECS_TAG][THREAD_PER_TRACK_TAG].as<bool>();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error while getting " << THREAD_PER_TRACK_TAG << " in DDSRouter configuration: "
+                      << e.what());
+    }
+
+    return false;
+}
+
+PayloadPoolConfiguration DDSRouterConfiguration::payload_pool_configuration() const
+{
+    PayloadPoolConfiguration configuration;
 
     try
     {
-        if (raw_configuration_[list_tag])
+        if (!raw_configuration_[SPECS_TAG] || !raw_configuration_[SPECS_TAG][PAYLOAD_POOL_TAG])
         {
-            for (auto topic : raw_configuration_[list_tag])
+            return configuration;
+        }
+
+        RawConfiguration pool = raw_configuration_[SPECS_TAG][PAYLOAD_POOL_TAG];
+
+        if (pool[PAYLOAD_POOL_TYPE_TAG])
+        {
+            std::string kind = pool[PAYLOAD_POOL_TYPE_TAG].as<std::string>();
+            if (kind == PAYLOAD_POOL_MAP_TAG)
+            {
+                configuration.kind = PayloadPoolKind::MAP_PAYLOAD_POOL;
+            }
+            else if (kind == PAYLOAD_POOL_REFCOUNT_TAG)
+            {
+                configuration.kind = PayloadPoolKind::REFCOUNT_PAYLOAD_POOL;
+            }
+            else if (kind == PAYLOAD_POOL_SLAB_TAG)
+            {
+                configuration.kind = PayloadPoolKind::SLAB_PAYLOAD_POOL;
+            }
+            else if (kind == PAYLOAD_POOL_ARENA_TAG)
+            {
+                configuration.kind = PayloadPoolKind::ARENA_PAYLOAD_POOL;
+            }
+            else
             {
-                std::string new_topic_name;
-                std::string new_topic_type;
-                bool new_topic_has_keyed_set = false;
-                bool new_topic_with_key = false;    // optional entry, false by default
+                throw ConfigurationException(utils::Formatter()
+                              << "Unknown value " << kind << " for " << PAYLOAD_POOL_TYPE_TAG << " in "
+                              << PAYLOAD_POOL_TAG << ".");
+            }
+        }
 
-                if (topic[TOPIC_NAME_TAG])
-                {
-                    new_topic_name = topic[TOPIC_NAME_TAG].as<std::string>();
-                }
-                else
-                {
-                    // TODO: Add warning
-                    // Not allowed topics without name
-                    continue;
-                }
+        if (pool[PAYLOAD_POOL_COPY_SIZE_TAG])
+        {
+            std::string copy_size = pool[PAYLOAD_POOL_COPY_SIZE_TAG].as<std::string>();
+            if (copy_size == PAYLOAD_POOL_COPY_MAX_SIZE_TAG)
+            {
+                configuration.copy_size = PayloadCopySize::COPY_MAX_SIZE;
+            }
+            else if (copy_size == PAYLOAD_POOL_COPY_LENGTH_TAG)
+            {
+                configuration.copy_size = PayloadCopySize::COPY_LENGTH;
+            }
+            else if (copy_size == PAYLOAD_POOL_COPY_SIZE_CLASS_TAG)
+            {
+                configuration.copy_size = PayloadCopySize::COPY_SIZE_CLASS;
+            }
+            else
+            {
+                throw ConfigurationException(utils::Formatter()
+                              << "Unknown value " << copy_size << " for " << PAYLOAD_POOL_COPY_SIZE_TAG << " in "
+                              << PAYLOAD_POOL_TAG << ".");
+            }
+        }
+
+        if (pool[PAYLOAD_POOL_MEMORY_BUDGET_TAG])
+        {
+            int64_t memory_budget = pool[PAYLOAD_POOL_MEMORY_BUDGET_TAG].as<int64_t>();
+            if (memory_budget < 0)
+            {
+                throw ConfigurationException(utils::Formatter()
+                              << PAYLOAD_POOL_MEMORY_BUDGET_TAG << " in " << PAYLOAD_POOL_TAG
+                              << " must not be negative, " << memory_budget << " given.");
+            }
+            configuration.memory_budget = static_cast<uint64_t>(memory_budget);
+        }
 
-                if (topic[TOPIC_TYPE_NAME_TAG])
+        if (pool[PAYLOAD_POOL_MEMORY_POLICY_TAG])
+        {
+            std::string policy = pool[PAYLOAD_POOL_MEMORY_POLICY_TAG].as<std::string>();
+            if (policy == PAYLOAD_POOL_MEMORY_REJECT_TAG)
+            {
+                configuration.memory_policy = MemoryBudgetPolicy::MEMORY_REJECT;
+            }
+            else if (policy == PAYLOAD_POOL_MEMORY_EVICT_TAG)
+            {
+                configuration.memory_policy = MemoryBudgetPolicy::MEMORY_EVICT;
+            }
+            else if (policy == PAYLOAD_POOL_MEMORY_BLOCK_TAG)
+            {
+                configuration.memory_policy = MemoryBudgetPolicy::MEMORY_BLOCK;
+            }
+            else
+            {
+                throw ConfigurationException(utils::Formatter()
+                              << "Unknown value " << policy << " for " << PAYLOAD_POOL_MEMORY_POLICY_TAG << " in "
+                              << PAYLOAD_POOL_TAG << ".");
+            }
+        }
+
+        if (pool[PAYLOAD_POOL_MEMORY_BLOCK_TIMEOUT_TAG])
+        {
+            configuration.memory_block_timeout = non_negative_(pool, PAYLOAD_POOL_MEMORY_BLOCK_TIMEOUT_TAG);
+        }
+
+        if (pool[PAYLOAD_POOL_MAX_SIZE_CLASS_TAG])
+        {
+            int64_t max_size_class = pool[PAYLOAD_POOL_MAX_SIZE_CLASS_TAG].as<int64_t>();
+            if (max_size_class <= 0 || max_size_class > SlabPayloadPool::LARGEST_SIZE_CLASS)
+            {
+                throw ConfigurationException(utils::Formatter()
+                              << PAYLOAD_POOL_MAX_SIZE_CLASS_TAG << " in " << PAYLOAD_POOL_TAG
+                              << " must be positive and not larger than " << SlabPayloadPool::LARGEST_SIZE_CLASS
+                              << ", " << max_size_class << " given.");
+            }
+            configuration.max_size_class = static_cast<uint32_t>(max_size_class);
+        }
+
+        if (pool[PAYLOAD_POOL_ARENA_SIZE_TAG])
+        {
+            int64_t arena_size = pool[PAYLOAD_POOL_ARENA_SIZE_TAG].as<int64_t>();
+            if (arena_size <= 0)
+            {
+                throw ConfigurationException(utils::Formatter()
+                              << PAYLOAD_POOL_ARENA_SIZE_TAG << " in " << PAYLOAD_POOL_TAG
+                              << " must be positive, " << arena_size << " given.");
+            }
+            configuration.arena_size = static_cast<uint64_t>(arena_size);
+        }
+
+        if (pool[PAYLOAD_POOL_HUGE_PAGES_TAG])
+        {
+            configuration.huge_pages = pool[PAYLOAD_POOL_HUGE_PAGES_TAG].as<bool>();
+        }
+
+        if (pool[PAYLOAD_POOL_PREFAULT_TAG])
+        {
+            configuration.prefault = pool[PAYLOAD_POOL_PREFAULT_TAG].as<bool>();
+        }
+
+        if (pool[PAYLOAD_POOL_DEDUP_TAG])
+        {
+            configuration.deduplication = pool[PAYLOAD_POOL_DEDUP_TAG].as<bool>();
+        }
+
+        if (pool[PAYLOAD_POOL_DEDUP_MIN_SIZE_TAG])
+        {
+            configuration.deduplication_min_size = non_negative_(pool, PAYLOAD_POOL_DEDUP_MIN_SIZE_TAG);
+        }
+
+        if (pool[PAYLOAD_POOL_SMALL_PAYLOAD_SIZE_TAG])
+        {
+            configuration.small_payload_size = non_negative_(pool, PAYLOAD_POOL_SMALL_PAYLOAD_SIZE_TAG);
+        }
+
+        if (pool[PAYLOAD_POOL_SMALL_PAYLOAD_COUNT_TAG])
+        {
+            configuration.small_payload_count = non_negative_(pool, PAYLOAD_POOL_SMALL_PAYLOAD_COUNT_TAG);
+        }
+
+        if (pool[PAYLOAD_POOL_PREALLOCATE_TAG])
+        {
+            for (auto preallocation : pool[PAYLOAD_POOL_PREALLOCATE_TAG])
+            {
+                if (!preallocation[PAYLOAD_POOL_SIZE_TAG] || !preallocation[PAYLOAD_POOL_COUNT_TAG])
                 {
-                    new_topic_type = topic[TOPIC_TYPE_NAME_TAG].as<std::string>();
+                    throw ConfigurationException(utils::Formatter()
+                                  << "Entries of " << PAYLOAD_POOL_PREALLOCATE_TAG << " require "
+                                  << PAYLOAD_POOL_SIZE_TAG << " and " << PAYLOAD_POOL_COUNT_TAG << ".");
                 }
 
-                if (topic[TOPIC_KIND_TAG])
+                unsigned int size = non_negative_(preallocation, PAYLOAD_POOL_SIZE_TAG);
+                if (size == 0)
                 {
-                    new_topic_has_keyed_set = true;
-                    new_topic_with_key = topic[TOPIC_KIND_TAG].as<bool>();
+                    throw ConfigurationException(utils::Formatter()
+                                  << PAYLOAD_POOL_SIZE_TAG << " in " << PAYLOAD_POOL_PREALLOCATE_TAG
+                                  << " must be positive.");
                 }
 
-                if (new_topic_type.empty())
+                configuration.preallocated_payloads[size] += non_negative_(preallocation, PAYLOAD_POOL_COUNT_TAG);
+            }
+        }
+    }
+    catch (const ConfigurationException&)
+    {
+        throw;
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error while getting " << PAYLOAD_POOL_TAG << " in DDSRouter configuration: " << e.what());
+    }
+
+    return configuration;
+}
+
+bool DDSRouterConfiguration::interest_driven_endpoints() const
+{
+    try
+    {
+        if (raw_configuration_[SPECS_TAG] && raw_configuration_[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG])
+        {
+            return raw_configuration_[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG].as<bool>();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error while getting " << INTEREST_DRIVEN_ENDPOINTS_TAG << " in DDSRouter configuration: "
+                      << e.what());
+    }
+
+    return false;
+}
+
+bool DDSRouterConfiguration::lazy_bridges() const
+{
+    try
+    {
+        if (raw_configuration_[SPECS_TAG] && raw_configuration_[SPECS_TAG][LAZY_BRIDGES_TAG])
+        {
+            return raw_configuration_[SPECS_TAG][LAZY_BRIDGES_TAG].as<bool>();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error while getting " << LAZY_BRIDGES_TAG << " in DDSRouter configuration: "
+                      << e.what());
+    }
+
+    // Interest driven endpoints create the topics on demand as well, unless it is set otherwise
+    return interest_driven_endpoints();
+}
+
+Duration_ms DDSRouterConfiguration::endpoint_grace_period() const
+{
+    int grace_period = DEFAULT_ENDPOINT_GRACE_PERIOD;
+
+    try
+    {
+        if (raw_configuration_[SPECS_TAG] && raw_configuration_[SPECS_TAG][ENDPOINT_GRACE_PERIOD_TAG])
+        {
+            grace_period = raw_configuration_[SPECS_TAG][ENDPOINT_GRACE_PERIOD_TAG].as<int>();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error while getting " << ENDPOINT_GRACE_PERIOD_TAG << " in DDSRouter configuration: "
+                      << e.what());
+    }
+
+    if (grace_period <= 0)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Endpoint grace period in DDSRouter configuration must be positive, "
+                      << grace_period << " given.");
+    }
+
+    return static_cast<Duration_ms>(grace_period);
+}
+
+Duration_ms DDSRouterConfiguration::bridge_idle_timeout() const
+{
+    int idle_timeout = 0;
+
+    try
+    {
+        if (raw_configuration_[SPECS_TAG] && raw_configuration_[SPECS_TAG][BRIDGE_IDLE_TIMEOUT_TAG])
+        {
+            idle_timeout = raw_configuration_[SPECS_TAG][BRIDGE_IDLE_TIMEOUT_TAG].as<int>();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error while getting " << BRIDGE_IDLE_TIMEOUT_TAG << " in DDSRouter configuration: "
+                      << e.what());
+    }
+
+    if (idle_timeout < 0)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Bridge idle timeout in DDSRouter configuration must not be negative, "
+                      << idle_timeout << " given.");
+    }
+
+    return static_cast<Duration_ms>(idle_timeout);
+}
+
+std::list<std::pair<std::shared_ptr<FilterTopic>, TopicSpecs>> DDSRouterConfiguration::topics_specs() const
+{
+    std::list<std::pair<std::shared_ptr<FilterTopic>, TopicSpecs>> result;
+
+    try
+    {
+        if (raw_configuration_[ALLOWLIST_TAG])
+        {
+            for (auto topic : raw_configuration_[ALLOWLIST_TAG])
+            {
+                std::shared_ptr<FilterTopic> filter = filter_topic_(topic);
+
+                // Not allowed topics without name
+                if (filter)
                 {
-                    result.push_back(
-                        std::make_shared<WildcardTopic>(new_topic_name, new_topic_has_keyed_set, new_topic_with_key));
+                    result.push_back(std::make_pair(filter, topic_specs_(topic)));
                 }
-                else
+            }
+        }
+    }
+    catch (const ConfigurationException&)
+    {
+        throw;
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error while getting topic specs in " << ALLOWLIST_TAG << " in DDSRouter configuration: "
+                      << e.what());
+    }
+
+    return result;
+}
+
+std::list<std::shared_ptr<FilterTopic>> DDSRouterConfiguration::generic_get_topic_list_(
+        const char* list_tag) const
+{
+    // TODO: support regex topic
+
+    std::list<std::shared_ptr<FilterTopic>> result;
+
+    try
+    {
+        if (raw_configuration_[list_tag])
+        {
+            for (auto topic : raw_configuration_[list_tag])
+            {
+                std::shared_ptr<FilterTopic> filter = filter_topic_(topic);
+
+                if (filter)
                 {
-                    result.push_back(
-                        std::make_shared<WildcardTopic>(new_topic_name, new_topic_type, new_topic_has_keyed_set,
-                        new_topic_with_key));
+                    result.push_back(filter);
                 }
+                // TODO: Add warning
+                // Not allowed topics without name
             }
         }
     }
@@ -153,5 +494,154 @@ std::list<std::shared_ptr<FilterTopic>> DDSRouterConfiguration::generic_get_topi
     return result;
 }
 
+std::shared_ptr<FilterTopic> DDSRouterConfiguration::filter_topic_(
+        const RawConfiguration& topic)
+{
+    std::string new_topic_name;
+    std::string new_topic_type;
+    bool new_topic_has_keyed_set = false;
+    bool new_topic_with_key = false;    // optional entry, false by default
+
+    if (topic[TOPIC_NAME_TAG])
+    {
+        new_topic_name = topic[TOPIC_NAME_TAG].as<std::string>();
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    if (topic[TOPIC_TYPE_NAME_TAG])
+    {
+        new_topic_type = topic[TOPIC_TYPE_NAME_TAG].as<std::string>();
+    }
+
+    if (topic[TOPIC_KIND_TAG])
+    {
+        new_topic_has_keyed_set = true;
+        new_topic_with_key = topic[TOPIC_KIND_TAG].as<bool>();
+    }
+
+    if (new_topic_type.empty())
+    {
+        return std::make_shared<WildcardTopic>(new_topic_name, new_topic_has_keyed_set, new_topic_with_key);
+    }
+    else
+    {
+        return std::make_shared<WildcardTopic>(new_topic_name, new_topic_type, new_topic_has_keyed_set,
+                       new_topic_with_key);
+    }
+}
+
+TopicSpecs DDSRouterConfiguration::topic_specs_(
+        const RawConfiguration& topic)
+{
+    TopicSpecs specs;
+
+    if (topic[TOPIC_SPIN_BUDGET_TAG])
+    {
+        specs.spin_budget = static_cast<Duration_us>(non_negative_(topic, TOPIC_SPIN_BUDGET_TAG));
+    }
+
+    if (topic[TOPIC_INLINE_TAG])
+    {
+        specs.inline_forwarding = topic[TOPIC_INLINE_TAG].as<bool>();
+    }
+
+    if (topic[TOPIC_EGRESS_QUEUE_TAG])
+    {
+        specs.egress_queue_size = non_negative_(topic, TOPIC_EGRESS_QUEUE_TAG);
+    }
+
+    if (topic[TOPIC_EGRESS_OVERFLOW_TAG])
+    {
+        std::string policy = topic[TOPIC_EGRESS_OVERFLOW_TAG].as<std::string>();
+
+        if (policy == TOPIC_EGRESS_OVERFLOW_DROP_OLDEST_TAG)
+        {
+            specs.egress_overflow_policy = EgressOverflowPolicy::DROP_OLDEST;
+        }
+        else if (policy == TOPIC_EGRESS_OVERFLOW_DROP_NEWEST_TAG)
+        {
+            specs.egress_overflow_policy = EgressOverflowPolicy::DROP_NEWEST;
+        }
+        else if (policy == TOPIC_EGRESS_OVERFLOW_BLOCK_TAG)
+        {
+            specs.egress_overflow_policy = EgressOverflowPolicy::BLOCK;
+        }
+        else
+        {
+            throw ConfigurationException(utils::Formatter()
+                          << "Topic " << TOPIC_EGRESS_OVERFLOW_TAG << " in DDSRouter configuration must be <"
+                          << TOPIC_EGRESS_OVERFLOW_DROP_OLDEST_TAG << ">, <" << TOPIC_EGRESS_OVERFLOW_DROP_NEWEST_TAG
+                          << "> or <" << TOPIC_EGRESS_OVERFLOW_BLOCK_TAG << ">, " << policy << " given.");
+        }
+    }
+
+    if (topic[TOPIC_PARALLEL_FANOUT_TAG])
+    {
+        specs.parallel_fanout = topic[TOPIC_PARALLEL_FANOUT_TAG].as<bool>();
+    }
+
+    if (topic[TOPIC_LOW_PRIORITY_TAG])
+    {
+        specs.low_priority = topic[TOPIC_LOW_PRIORITY_TAG].as<bool>();
+    }
+
+    if (topic[TOPIC_SKIP_WITHOUT_READERS_TAG])
+    {
+        specs.skip_without_readers = topic[TOPIC_SKIP_WITHOUT_READERS_TAG].as<bool>();
+    }
+
+    if (topic[TOPIC_ZERO_COPY_TAG])
+    {
+        specs.zero_copy = topic[TOPIC_ZERO_COPY_TAG].as<bool>();
+    }
+
+    if (topic[TOPIC_HISTORY_DEPTH_TAG])
+    {
+        specs.history_depth = non_negative_(topic, TOPIC_HISTORY_DEPTH_TAG);
+    }
+
+    if (topic[TOPIC_HISTORY_MAX_SAMPLES_TAG])
+    {
+        specs.history_max_samples = non_negative_(topic, TOPIC_HISTORY_MAX_SAMPLES_TAG);
+    }
+
+    // A KEEP_LAST history is already limited by its depth
+    if (specs.history_depth > 0 && specs.history_max_samples > 0)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Topic " << TOPIC_HISTORY_DEPTH_TAG << " and " << TOPIC_HISTORY_MAX_SAMPLES_TAG
+                      << " cannot be set at the same time in DDSRouter configuration.");
+    }
+
+    // Spinning in the reception thread would block the reception of the data it waits for
+    if (specs.inline_forwarding && specs.spin_budget > 0)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Topic " << TOPIC_SPIN_BUDGET_TAG << " and " << TOPIC_INLINE_TAG
+                      << " cannot be set at the same time in DDSRouter configuration.");
+    }
+
+    return specs;
+}
+
+unsigned int DDSRouterConfiguration::non_negative_(
+        const RawConfiguration& yaml,
+        const char* tag)
+{
+    int value = yaml[tag].as<int>();
+
+    if (value < 0)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Value of " << tag << " in DDSRouter configuration must not be negative, "
+                      << value << " given.");
+    }
+
+    return static_cast<unsigned int>(value);
+}
+
 } /* namespace ddsrouter */
 } /* namespace eprosima */
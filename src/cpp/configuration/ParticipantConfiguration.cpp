@@ -19,8 +19,10 @@
 #include <ddsrouter/configuration/ParticipantConfiguration.hpp>
 #include <ddsrouter/exceptions/ConfigurationException.hpp>
 #include <ddsrouter/types/configuration_tags.hpp>
+#include <ddsrouter/types/numa.hpp>
 #include <ddsrouter/types/participant/ParticipantType.hpp>
 #include <ddsrouter/types/topic/WildcardTopic.hpp>
+#include <ddsrouter/types/utils.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
@@ -89,6 +91,35 @@ RawConfiguration ParticipantConfiguration::raw_configuration() const noexcept
     return raw_configuration_;
 }
 
+int ParticipantConfiguration::numa_node() const
+{
+    if (!raw_configuration_[PARTICIPANT_NUMA_NODE_TAG])
+    {
+        return numa::NO_NUMA_NODE;
+    }
+
+    int node;
+    try
+    {
+        node = raw_configuration_[PARTICIPANT_NUMA_NODE_TAG].as<int>();
+    }
+    catch (const std::exception& e)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << "Error reading " << PARTICIPANT_NUMA_NODE_TAG << " of Participant " << id_ << ": "
+                      << e.what());
+    }
+
+    if (node < 0)
+    {
+        throw ConfigurationException(utils::Formatter()
+                      << PARTICIPANT_NUMA_NODE_TAG << " of Participant " << id_ << " must not be negative, "
+                      << node << " given.");
+    }
+
+    return node;
+}
+
 bool ParticipantConfiguration::operator ==(
         const ParticipantConfiguration& other) const noexcept
 {
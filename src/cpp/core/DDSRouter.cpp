@@ -17,13 +17,17 @@
  *
  */
 
-#include <ddsrouter/communication/payload_pool/MapPayloadPool.hpp>
+#include <algorithm>
+#include <functional>
+
+#include <ddsrouter/communication/payload_pool/PayloadPoolFactory.hpp>
 #include <ddsrouter/configuration/DDSRouterConfiguration.hpp>
 #include <ddsrouter/core/DDSRouter.hpp>
 #include <ddsrouter/exceptions/ConfigurationException.hpp>
 #include <ddsrouter/exceptions/InitializationException.hpp>
 #include <ddsrouter/exceptions/InconsistencyException.hpp>
 #include <ddsrouter/types/Log.hpp>
+#include <ddsrouter/types/numa.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
@@ -32,23 +36,41 @@ namespace ddsrouter {
 
 DDSRouter::DDSRouter(
         const DDSRouterConfiguration& configuration)
-    : payload_pool_(new MapPayloadPool())
+    : payload_pool_(PayloadPoolFactory::create_payload_pool(configuration.payload_pool_configuration()))
+    , thread_pool_(std::make_shared<SlotThreadPool>(
+                configuration.number_of_threads(),
+                configuration.thread_per_track()))
     , participants_database_(new ParticipantsDatabase())
     , discovery_database_(new DiscoveryDatabase())
     , allowed_topics_()
     , bridges_()
     , configuration_(configuration)
     , participant_factory_()
+    , interest_driven_endpoints_(configuration.interest_driven_endpoints())
+    , lazy_bridges_(configuration.lazy_bridges())
+    , endpoint_grace_period_(configuration.endpoint_grace_period())
+    , bridge_idle_timeout_(configuration.bridge_idle_timeout())
     , enabled_(false)
 {
-    logDebug(DDSROUTER, "Creating DDS Router.");
+    logDebug(DDSROUTER, "Creating DDS Router with " << thread_pool_->n_threads() << " threads.");
 
     // Init topic allowed
     init_allowed_topics_();
-    // Load Participants
-    init_participants_();
-    // Create Bridges
-    init_bridges_();
+    // Listen to discovery before any Participant is created
+    init_discovery_();
+    try
+    {
+        // Load Participants
+        init_participants_();
+        // Create Bridges
+        init_bridges_();
+    }
+    catch (...)
+    {
+        // The destructor is not called, and the Participants created could still notify discovery
+        stop_discovery_();
+        throw;
+    }
 
     logDebug(DDSROUTER, "DDS Router created.");
 }
@@ -57,6 +79,9 @@ DDSRouter::~DDSRouter()
 {
     logDebug(DDSROUTER, "Destroying DDS Router.");
 
+    // Stop listening to discovery, so no endpoint is created or deleted from now on
+    stop_discovery_();
+
     // Stop all communications
     stop_();
 
@@ -97,6 +122,10 @@ ReturnCode DDSRouter::reload_configuration(
             new_configuration.allowlist(),
             new_configuration.blocklist());
 
+        // New Bridges are created with the new topic specifications.
+        // Existing Bridges keep the specifications they were created with.
+        topics_specs_ = new_configuration.topics_specs();
+
         // Check if it should change or is the same configuration
         if (new_allowed_topic_list == allowed_topics_)
         {
@@ -111,10 +140,13 @@ ReturnCode DDSRouter::reload_configuration(
 
         // TODO refactor with discovery functionality
         // TODO add bridge creation when initial topics configuration added
-        // Create new bridges for topics that does not exist yet
-        for (RealTopic topic : new_configuration.real_topics())
+        // Create new bridges for topics that does not exist yet, unless they wait for a remote Writer
+        if (!creates_bridges_on_discovery_())
         {
-            discovered_topic_(topic);
+            for (RealTopic topic : new_configuration.real_topics())
+            {
+                discovered_topic_(topic);
+            }
         }
 
         // It must change the configuration. Check every topic discovered and active if needed.
@@ -178,6 +210,29 @@ ReturnCode DDSRouter::stop() noexcept
     return ret;
 }
 
+PayloadPoolStatistics DDSRouter::payload_pool_statistics() const noexcept
+{
+    PayloadPoolStatistics statistics = payload_pool_->statistics();
+    for (const auto& numa_payload_pool : numa_payload_pools_)
+    {
+        statistics += numa_payload_pool.second->statistics();
+    }
+    return statistics;
+}
+
+std::map<ParticipantId, TrackStatistics> DDSRouter::tracks_statistics(
+        const RealTopic& topic) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    auto it_bridge = bridges_.find(topic);
+    if (it_bridge == bridges_.end())
+    {
+        return std::map<ParticipantId, TrackStatistics>();
+    }
+    return it_bridge->second->tracks_statistics();
+}
+
 ReturnCode DDSRouter::start_() noexcept
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
@@ -224,6 +279,8 @@ void DDSRouter::init_allowed_topics_()
         configuration_.allowlist(),
         configuration_.blocklist());
 
+    topics_specs_ = configuration_.topics_specs();
+
     logInfo(DDSROUTER, "DDS Router configured with allowed topics: " << allowed_topics_);
 }
 
@@ -233,13 +290,14 @@ void DDSRouter::init_participants_()
             configuration_.participants_configurations())
     {
         std::shared_ptr<IParticipant> new_participant;
+        std::shared_ptr<PayloadPool> payload_pool = participant_payload_pool_(participant_config);
 
         // Create participant
         // This should not be in try catch case as if it fails the whole init must fail
         new_participant =
                 participant_factory_.create_participant(
             participant_config,
-            payload_pool_,
+            payload_pool,
             discovery_database_);
 
         // create_participant should throw an exception in fail, never return nullptr
@@ -260,6 +318,7 @@ void DDSRouter::init_participants_()
             participants_database_->add_participant_(
                 new_participant->id(),
                 new_participant);
+            participants_payload_pools_[new_participant->id()] = payload_pool;
         }
         catch (const InconsistencyException& e)
         {
@@ -279,12 +338,218 @@ void DDSRouter::init_participants_()
 
 void DDSRouter::init_bridges_()
 {
+    // With lazy Bridges, they are created once a remote Writer of their topic is discovered
+    if (creates_bridges_on_discovery_())
+    {
+        return;
+    }
+
+    if (lazy_bridges_)
+    {
+        logWarning(DDSROUTER, "No Participant discovers endpoints, so Bridges are created for every topic.");
+    }
+
     for (RealTopic topic : configuration_.real_topics())
     {
         discovered_topic_(topic);
     }
 }
 
+void DDSRouter::init_discovery_()
+{
+    if (!listens_to_discovery_())
+    {
+        return;
+    }
+
+    discovery_slot_id_ = thread_pool_->register_slot(std::bind(&DDSRouter::process_discovered_endpoints_, this));
+
+    endpoint_callback_id_ = discovery_database_->register_endpoint_callback(
+        [this](DatabaseOperation, const Endpoint& endpoint)
+        {
+            {
+                std::lock_guard<std::mutex> lock(discovered_endpoints_mutex_);
+                discovered_endpoints_.push(endpoint);
+            }
+            thread_pool_->emit(discovery_slot_id_);
+        });
+
+    // Idle endpoints and Bridges are checked twice per period
+    if (interest_driven_endpoints_)
+    {
+        logInfo(DDSROUTER, "Creating endpoints on demand, deleted after " << endpoint_grace_period_ << " ms idle.");
+
+        idle_endpoints_handler_ = std::make_unique<event::PeriodicEventHandler>(
+            std::bind(&DDSRouter::remove_idle_endpoints_, this),
+            std::max<Duration_ms>(endpoint_grace_period_ / 2, 1));
+    }
+
+    if (bridge_idle_timeout_ > 0)
+    {
+        logInfo(DDSROUTER, "Destroying Bridges after " << bridge_idle_timeout_ << " ms idle.");
+
+        idle_bridges_handler_ = std::make_unique<event::PeriodicEventHandler>(
+            std::bind(&DDSRouter::remove_idle_bridges_, this),
+            std::max<Duration_ms>(bridge_idle_timeout_ / 2, 1));
+    }
+}
+
+void DDSRouter::stop_discovery_() noexcept
+{
+    if (!listens_to_discovery_())
+    {
+        return;
+    }
+
+    discovery_database_->unregister_endpoint_callback(endpoint_callback_id_);
+    idle_bridges_handler_.reset();
+    idle_endpoints_handler_.reset();
+    thread_pool_->unregister_slot(discovery_slot_id_);
+}
+
+bool DDSRouter::listens_to_discovery_() const noexcept
+{
+    return interest_driven_endpoints_ || lazy_bridges_ || bridge_idle_timeout_ > 0;
+}
+
+bool DDSRouter::creates_bridges_on_discovery_() const noexcept
+{
+    if (!lazy_bridges_)
+    {
+        return false;
+    }
+
+    for (ParticipantId id : participants_database_->get_participants_ids())
+    {
+        if (participants_database_->get_participant(id)->discovers_endpoints())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void DDSRouter::process_discovered_endpoints_() noexcept
+{
+    while (true)
+    {
+        Endpoint endpoint;
+        {
+            std::lock_guard<std::mutex> lock(discovered_endpoints_mutex_);
+            if (discovered_endpoints_.empty())
+            {
+                return;
+            }
+            endpoint = discovered_endpoints_.front();
+            discovered_endpoints_.pop();
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+        // With lazy Bridges, only remote Writers create Bridges, as a topic nobody publishes has nothing to
+        // forward. Otherwise, only the topics of the Bridges destroyed by idle are rediscovered
+        bool discovers_topic = lazy_bridges_ ?
+                endpoint.is_writer() :
+                idle_topics_.find(endpoint.topic()) != idle_topics_.end();
+
+        if (endpoint.active() && discovers_topic)
+        {
+            discovered_topic_(endpoint.topic());
+        }
+
+        auto it_bridge = bridges_.find(endpoint.topic());
+        if (it_bridge != bridges_.end())
+        {
+            it_bridge->second->update_remote_endpoint(endpoint);
+        }
+    }
+}
+
+void DDSRouter::remove_idle_endpoints_() noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    for (auto& bridge_it : bridges_)
+    {
+        bridge_it.second->remove_idle_endpoints(endpoint_grace_period_);
+    }
+}
+
+void DDSRouter::remove_idle_bridges_() noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    auto now = std::chrono::steady_clock::now();
+    auto idle_limit = now - std::chrono::milliseconds(bridge_idle_timeout_);
+
+    for (auto bridge_it = bridges_.begin(); bridge_it != bridges_.end();)
+    {
+        const RealTopic& topic = bridge_it->first;
+
+        // Disabled Bridges are kept, as they are not expected to have any activity
+        if (!current_topics_[topic])
+        {
+            bridges_activity_.erase(topic);
+            ++bridge_it;
+            continue;
+        }
+
+        uint64_t transmitted_payloads = 0;
+        for (const auto& track_statistics : bridge_it->second->tracks_statistics())
+        {
+            transmitted_payloads += track_statistics.second.referenced_payloads +
+                    track_statistics.second.copied_payloads + track_statistics.second.skipped_payloads +
+                    track_statistics.second.dropped_payloads;
+        }
+
+        // The first time a Bridge is checked, its idle time starts
+        auto activity = bridges_activity_.emplace(topic, BridgeActivity{transmitted_payloads, now});
+        BridgeActivity& bridge_activity = activity.first->second;
+
+        if (has_user_endpoints_(topic) || bridge_activity.transmitted_payloads != transmitted_payloads)
+        {
+            bridge_activity.transmitted_payloads = transmitted_payloads;
+            bridge_activity.last_active = now;
+        }
+
+        if (bridge_activity.last_active > idle_limit)
+        {
+            ++bridge_it;
+            continue;
+        }
+
+        logInfo(DDSROUTER, "Destroying Bridge for topic " << topic << " idle for " << bridge_idle_timeout_ << " ms.");
+
+        // The topic is forgotten, so it is discovered again with the next remote endpoint
+        idle_topics_.insert(topic);
+        current_topics_.erase(topic);
+        bridges_activity_.erase(topic);
+        bridge_it = bridges_.erase(bridge_it);
+    }
+}
+
+bool DDSRouter::has_user_endpoints_(
+        const RealTopic& topic) const noexcept
+{
+    for (const Endpoint& endpoint : discovery_database_->topic_endpoints(topic))
+    {
+        if (!endpoint.active())
+        {
+            continue;
+        }
+
+        std::shared_ptr<IParticipant> discoverer =
+                participants_database_->get_participant(endpoint.discoverer_participant_id());
+        if (!discoverer || !discoverer->type().connects_routers())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void DDSRouter::discovered_topic_(
         const RealTopic& topic) noexcept
 {
@@ -300,6 +565,9 @@ void DDSRouter::discovered_topic_(
         return;
     }
 
+    // A topic whose Bridge was destroyed by idle is active again
+    idle_topics_.erase(topic);
+
     // Add topic to current_topics as non activated
     current_topics_.emplace(topic, false);
 
@@ -316,17 +584,36 @@ void DDSRouter::create_new_bridge(
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-    logInfo(DDSROUTER, "Creating Bridge for topic: " << topic << ".");
+    TopicSpecs specs = topic_specs_(topic);
+
+    logInfo(DDSROUTER, "Creating Bridge for topic: " << topic << " with " << specs << ".");
 
     try
     {
-        bridges_[topic] = std::make_unique<Bridge>(topic, participants_database_, payload_pool_, enabled);
+        bridges_[topic] = std::make_unique<Bridge>(
+            topic,
+            participants_database_,
+            participants_payload_pools_,
+            thread_pool_,
+            specs,
+            enabled,
+            interest_driven_endpoints_);
     }
     catch (const InitializationException& e)
     {
         logError(DDSROUTER,
                 "Error creating Bridge for topic " << topic <<
                 ". Error code:" << e.what() << ".");
+        return;
+    }
+
+    // Endpoints discovered before the Bridge existed
+    if (interest_driven_endpoints_)
+    {
+        for (const Endpoint& endpoint : discovery_database_->topic_endpoints(topic))
+        {
+            bridges_[topic]->update_remote_endpoint(endpoint);
+        }
     }
 }
 
@@ -397,5 +684,52 @@ void DDSRouter::deactivate_all_topics_() noexcept
     }
 }
 
+TopicSpecs DDSRouter::topic_specs_(
+        const RealTopic& topic) const noexcept
+{
+    for (const auto& filter_specs : topics_specs_)
+    {
+        if (filter_specs.first->matches(topic))
+        {
+            return filter_specs.second;
+        }
+    }
+
+    return TopicSpecs();
+}
+
+std::shared_ptr<PayloadPool> DDSRouter::participant_payload_pool_(
+        const ParticipantConfiguration& participant_configuration)
+{
+    int numa_node = participant_configuration.numa_node();
+    if (numa_node == numa::NO_NUMA_NODE)
+    {
+        return payload_pool_;
+    }
+
+    auto numa_payload_pool = numa_payload_pools_.find(numa_node);
+    if (numa_payload_pool != numa_payload_pools_.end())
+    {
+        return numa_payload_pool->second;
+    }
+
+    if (numa_node >= static_cast<int>(numa::number_of_nodes()))
+    {
+        logWarning(DDSROUTER,
+                "Participant " << participant_configuration.id() << " configured in NUMA node " << numa_node
+                               << ", but this host has " << numa::number_of_nodes()
+                               << " nodes. Its payloads will use a separate pool not bound to any node.");
+    }
+
+    logInfo(DDSROUTER, "Creating PayloadPool for NUMA node " << numa_node << ".");
+
+    PayloadPoolConfiguration pool_configuration = configuration_.payload_pool_configuration();
+    pool_configuration.numa_node = numa_node;
+    std::shared_ptr<PayloadPool> payload_pool = PayloadPoolFactory::create_payload_pool(pool_configuration);
+    numa_payload_pools_[numa_node] = payload_pool;
+
+    return payload_pool;
+}
+
 } /* namespace ddsrouter */
 } /* namespace eprosima */
@@ -17,6 +17,10 @@
  *
  */
 
+#include <algorithm>
+#include <functional>
+#include <string>
+
 #include <ddsrouter/dynamic/DiscoveryDatabase.hpp>
 #include <ddsrouter/exceptions/InconsistencyException.hpp>
 #include <ddsrouter/types/Log.hpp>
@@ -27,123 +31,329 @@ namespace ddsrouter {
 bool DiscoveryDatabase::topic_exists(
         const RealTopic& topic) const noexcept
 {
-    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return snapshot_()->topics.find(topic) != nullptr;
+}
 
-    // Loop over every Endpoint checking if topic matches
-    // It is not required to be reference
-    for (auto entity : entities_)
+TopicEndpointsCount DiscoveryDatabase::topic_endpoints_count(
+        const RealTopic& topic) const noexcept
+{
+    std::shared_ptr<const TopicEntry> entry = snapshot_()->topics.find(topic);
+    if (!entry)
     {
-        if (entity.second.topic() == topic)
-        {
-            return true;
-        }
+        return TopicEndpointsCount();
     }
-    return false;
+    return entry->count;
 }
 
 bool DiscoveryDatabase::endpoint_exists(
-        const Guid& guid) const noexcept
+        const Guid& guid,
+        const ParticipantId& discoverer /* = ParticipantId() */) const noexcept
 {
-    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
-    return entities_.find(guid) != entities_.end();
+    return snapshot_()->entities.find(EndpointKey(guid, discoverer)) != nullptr;
 }
 
 bool DiscoveryDatabase::add_endpoint(
         const Endpoint& new_endpoint)
 {
-    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-
-    auto it = entities_.find(new_endpoint.guid());
-    if (it != entities_.end())
+    uint64_t sequence;
     {
-        // Already exists
-        if (it->second.active())
+        std::lock_guard<std::mutex> lock(write_mutex_);
+
+        std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>(*snapshot_());
+
+        std::shared_ptr<const Endpoint> endpoint = snapshot->entities.find(key_(new_endpoint));
+        if (endpoint)
         {
-            throw InconsistencyException(
-                      utils::Formatter() <<
-                          "Error adding Endpoint to database. Endpoint already exists." << new_endpoint);
+            // Already exists
+            if (endpoint->active())
+            {
+                throw InconsistencyException(
+                          utils::Formatter() <<
+                              "Error adding Endpoint to database. Endpoint already exists." << new_endpoint);
+            }
+            else
+            {
+                // If exists but inactive, modify entry
+                unindex_endpoint_(*snapshot, *endpoint);
+
+                logInfo(DDSROUTER_DISCOVERY_DATABASE,
+                        "Modifying an already discovered (inactive) Endpoint " << new_endpoint << ".");
+            }
         }
         else
         {
-            // If exists but inactive, modify entry
-            it->second = new_endpoint;
+            logInfo(DDSROUTER_DISCOVERY_DATABASE, "Inserting a new discovered Endpoint " << new_endpoint << ".");
+        }
 
-            logInfo(DDSROUTER_DISCOVERY_DATABASE,
-                    "Modifying an already discovered (inactive) Endpoint " << new_endpoint << ".");
+        snapshot->entities.set(key_(new_endpoint), std::make_shared<const Endpoint>(new_endpoint));
+        index_endpoint_(*snapshot, new_endpoint);
 
-            return true;
-        }
+        current_snapshot_.store(snapshot, std::memory_order_release);
+        sequence = next_published_sequence_++;
     }
-    else
-    {
-        // Add it to the dictionary
-        entities_.insert(std::pair<Guid, Endpoint>(new_endpoint.guid(), new_endpoint));
 
-        logInfo(DDSROUTER_DISCOVERY_DATABASE, "Inserting a new discovered Endpoint " << new_endpoint << ".");
+    notify_endpoint_(sequence, DatabaseOperation::ADD, new_endpoint);
 
-        return true;
-    }
+    return true;
 }
 
 bool DiscoveryDatabase::update_endpoint(
         const Endpoint& new_endpoint)
 {
-    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-
-    auto it = entities_.find(new_endpoint.guid());
-    if (it == entities_.end())
-    {
-        // Entry not found
-        throw InconsistencyException(
-                  utils::Formatter() <<
-                      "Error updating Endpoint in database. Endpoint entry not found." << new_endpoint);
-    }
-    else
+    uint64_t sequence;
     {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+
+        std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>(*snapshot_());
+
+        std::shared_ptr<const Endpoint> endpoint = snapshot->entities.find(key_(new_endpoint));
+        if (!endpoint)
+        {
+            // Entry not found
+            throw InconsistencyException(
+                      utils::Formatter() <<
+                          "Error updating Endpoint in database. Endpoint entry not found." << new_endpoint);
+        }
+
         // Modify entry
-        it->second = new_endpoint;
+        unindex_endpoint_(*snapshot, *endpoint);
+        snapshot->entities.set(key_(new_endpoint), std::make_shared<const Endpoint>(new_endpoint));
+        index_endpoint_(*snapshot, new_endpoint);
 
-        logInfo(DDSROUTER_DISCOVERY_DATABASE, "Modifying an already discovered Endpoint " << new_endpoint << ".");
+        current_snapshot_.store(snapshot, std::memory_order_release);
+        sequence = next_published_sequence_++;
 
-        return true;
+        logInfo(DDSROUTER_DISCOVERY_DATABASE, "Modifying an already discovered Endpoint " << new_endpoint << ".");
     }
+
+    notify_endpoint_(sequence, DatabaseOperation::UPDATE, new_endpoint);
+
+    return true;
 }
 
 ReturnCode DiscoveryDatabase::erase_endpoint(
-        const Guid& guid_of_endpoint_to_erase)
+        const Guid& guid_of_endpoint_to_erase,
+        const ParticipantId& discoverer /* = ParticipantId() */)
 {
-    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    EndpointKey key(guid_of_endpoint_to_erase, discoverer);
+
+    Endpoint erased_endpoint;
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+
+        std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>(*snapshot_());
+
+        std::shared_ptr<const Endpoint> endpoint = snapshot->entities.find(key);
+        if (!endpoint)
+        {
+            throw InconsistencyException(
+                      utils::Formatter() <<
+                          "Error erasing Endpoint with GUID " << guid_of_endpoint_to_erase <<
+                          " discovered by " << discoverer << " from database. Endpoint entry not found.");
+        }
+
+        erased_endpoint = *endpoint;
+        unindex_endpoint_(*snapshot, erased_endpoint);
+        snapshot->entities.erase(key);
 
-    auto erased = entities_.erase(guid_of_endpoint_to_erase);
+        current_snapshot_.store(snapshot, std::memory_order_release);
+        sequence = next_published_sequence_++;
+    }
+
+    // An erased endpoint is no longer active
+    erased_endpoint.active(false);
+    notify_endpoint_(sequence, DatabaseOperation::ERASE, erased_endpoint);
+
+    return ReturnCode::RETCODE_OK;
+}
 
-    if (erased == 0)
+Endpoint DiscoveryDatabase::get_endpoint(
+        const Guid& endpoint_guid,
+        const ParticipantId& discoverer /* = ParticipantId() */) const
+{
+    std::shared_ptr<const Endpoint> endpoint = snapshot_()->entities.find(EndpointKey(endpoint_guid, discoverer));
+    if (!endpoint)
     {
         throw InconsistencyException(
                   utils::Formatter() <<
-                      "Error erasing Endpoint with GUID " << guid_of_endpoint_to_erase <<
+                      "Error retrieving Endpoint with GUID " << endpoint_guid << " discovered by " << discoverer <<
                       " from database. Endpoint entry not found.");
     }
+
+    return *endpoint;
+}
+
+std::vector<Endpoint> DiscoveryDatabase::topic_endpoints(
+        const RealTopic& topic) const noexcept
+{
+    // Topic index and endpoints are read from the same snapshot, so they are consistent
+    std::shared_ptr<const Snapshot> snapshot = snapshot_();
+
+    std::vector<Endpoint> endpoints;
+
+    std::shared_ptr<const TopicEntry> entry = snapshot->topics.find(topic);
+    if (!entry)
+    {
+        return endpoints;
+    }
+
+    endpoints.reserve(entry->endpoints.size());
+    for (const EndpointKey& key : entry->endpoints)
+    {
+        endpoints.push_back(*snapshot->entities.find(key));
+    }
+    return endpoints;
+}
+
+uint64_t DiscoveryDatabase::register_endpoint_callback(
+        EndpointCallback callback) noexcept
+{
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    endpoint_callbacks_[next_callback_id_] = callback;
+    return next_callback_id_++;
+}
+
+void DiscoveryDatabase::unregister_endpoint_callback(
+        uint64_t callback_id) noexcept
+{
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    endpoint_callbacks_.erase(callback_id);
+}
+
+size_t DiscoveryDatabase::EndpointKeyHash::operator ()(
+        const EndpointKey& key) const noexcept
+{
+    // FNV-1a over every byte of the guid and of the discoverer name
+    size_t hash = 14695981039346656037ULL;
+    for (auto byte : key.first.guidPrefix.value)
+    {
+        hash = (hash ^ byte) * 1099511628211ULL;
+    }
+    for (auto byte : key.first.entityId.value)
+    {
+        hash = (hash ^ byte) * 1099511628211ULL;
+    }
+    for (char byte : key.second.id_name())
+    {
+        hash = (hash ^ static_cast<unsigned char>(byte)) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+size_t DiscoveryDatabase::TopicHash::operator ()(
+        const RealTopic& topic) const noexcept
+{
+    return std::hash<std::string>()(topic.topic_name()) ^ (std::hash<std::string>()(topic.topic_type()) << 1);
+}
+
+DiscoveryDatabase::EndpointKey DiscoveryDatabase::key_(
+        const Endpoint& endpoint) noexcept
+{
+    return EndpointKey(endpoint.guid(), endpoint.discoverer_participant_id());
+}
+
+std::shared_ptr<const DiscoveryDatabase::Snapshot> DiscoveryDatabase::snapshot_() const noexcept
+{
+    return current_snapshot_.load(std::memory_order_acquire);
+}
+
+void DiscoveryDatabase::index_endpoint_(
+        Snapshot& snapshot,
+        const Endpoint& endpoint) noexcept
+{
+    // The entry may be shared with other snapshots, so a new one is created
+    std::shared_ptr<const TopicEntry> current_entry = snapshot.topics.find(endpoint.topic());
+    std::shared_ptr<TopicEntry> entry = current_entry ?
+            std::make_shared<TopicEntry>(*current_entry) :
+            std::make_shared<TopicEntry>();
+
+    EndpointKey key = key_(endpoint);
+    auto it = std::lower_bound(entry->endpoints.begin(), entry->endpoints.end(), key);
+    if (it == entry->endpoints.end() || !(*it == key))
+    {
+        entry->endpoints.insert(it, key);
+    }
+
+    if (endpoint.active())
+    {
+        if (endpoint.is_writer())
+        {
+            entry->count.writers++;
+        }
+        else if (endpoint.is_reader())
+        {
+            entry->count.readers++;
+        }
+    }
+
+    snapshot.topics.set(endpoint.topic(), entry);
+}
+
+void DiscoveryDatabase::unindex_endpoint_(
+        Snapshot& snapshot,
+        const Endpoint& endpoint) noexcept
+{
+    std::shared_ptr<const TopicEntry> current_entry = snapshot.topics.find(endpoint.topic());
+    if (!current_entry)
+    {
+        return;
+    }
+
+    // The entry may be shared with other snapshots, so a new one is created
+    std::shared_ptr<TopicEntry> entry = std::make_shared<TopicEntry>(*current_entry);
+    EndpointKey key = key_(endpoint);
+    auto it = std::lower_bound(entry->endpoints.begin(), entry->endpoints.end(), key);
+    if (it != entry->endpoints.end() && *it == key)
+    {
+        entry->endpoints.erase(it);
+    }
+
+    if (endpoint.active())
+    {
+        if (endpoint.is_writer())
+        {
+            entry->count.writers--;
+        }
+        else if (endpoint.is_reader())
+        {
+            entry->count.readers--;
+        }
+    }
+
+    if (entry->endpoints.empty())
+    {
+        snapshot.topics.erase(endpoint.topic());
+    }
     else
     {
-        return ReturnCode::RETCODE_OK;
+        snapshot.topics.set(endpoint.topic(), entry);
     }
 }
 
-Endpoint DiscoveryDatabase::get_endpoint(
-        const Guid& endpoint_guid) const
+void DiscoveryDatabase::notify_endpoint_(
+        uint64_t sequence,
+        DatabaseOperation operation,
+        const Endpoint& endpoint) noexcept
 {
-    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    // The lock is kept while calling, so no callback is unregistered while it is being called
+    std::unique_lock<std::mutex> lock(callback_mutex_);
+
+    // Modifications published before are notified first, so callbacks see them in publish order
+    notified_cv_.wait(
+        lock,
+        [sequence, this]
+        {
+            return next_notified_sequence_ == sequence;
+        });
 
-    auto it = entities_.find(endpoint_guid);
-    if (it == entities_.end())
+    for (const auto& callback : endpoint_callbacks_)
     {
-        throw InconsistencyException(
-                  utils::Formatter() <<
-                      "Error retrieving Endpoint with GUID " << endpoint_guid <<
-                      " from database. Endpoint entry not found.");
+        callback.second(operation, endpoint);
     }
 
-    return it->second;
+    next_notified_sequence_++;
+    notified_cv_.notify_all();
 }
 
 } /* namespace ddsrouter */
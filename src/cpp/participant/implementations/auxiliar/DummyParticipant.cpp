@@ -18,6 +18,7 @@
 
 #include <ddsrouter/participant/implementations/auxiliar/DummyParticipant.hpp>
 #include <ddsrouter/reader/implementations/auxiliar/DummyReader.hpp>
+#include <ddsrouter/types/numa.hpp>
 #include <ddsrouter/types/participant/ParticipantType.hpp>
 #include <ddsrouter/writer/implementations/auxiliar/DummyWriter.hpp>
 
@@ -47,28 +48,45 @@ DummyParticipant::~DummyParticipant()
     participants_.erase(id());
 }
 
+bool DummyParticipant::discovers_endpoints() const noexcept
+{
+    return true;
+}
+
 std::shared_ptr<IWriter> DummyParticipant::create_writer_(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs&)
 {
-    return std::make_shared<DummyWriter>(id(), topic, payload_pool_);
+    // Writers of Participants placed in a NUMA node check where the data they send is
+    return std::make_shared<DummyWriter>(id(), topic, payload_pool_, configuration_.numa_node() != numa::NO_NUMA_NODE);
 }
 
 std::shared_ptr<IReader> DummyParticipant::create_reader_(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs& specs)
 {
-    return std::make_shared<DummyReader>(id(), topic, payload_pool_);
+    return std::make_shared<DummyReader>(id(), topic, payload_pool_, specs.low_priority);
 }
 
 void DummyParticipant::simulate_discovered_endpoint(
         const Endpoint& new_endpoint)
 {
-    discovery_database_->add_endpoint(new_endpoint);
+    discovery_database_->add_endpoint(
+        Endpoint(new_endpoint.kind(), new_endpoint.guid(), new_endpoint.qos(), new_endpoint.topic(), id()));
+}
+
+void DummyParticipant::simulate_undiscovered_endpoint(
+        const Guid& guid)
+{
+    Endpoint endpoint = discovery_database_->get_endpoint(guid, id());
+    endpoint.active(false);
+    discovery_database_->update_endpoint(endpoint);
 }
 
 Endpoint DummyParticipant::get_discovered_endpoint(
         const Guid& guid) const
 {
-    return discovery_database_->get_endpoint(guid);
+    return discovery_database_->get_endpoint(guid, id());
 }
 
 void DummyParticipant::simulate_data_reception(
@@ -110,6 +128,48 @@ void DummyParticipant::wait_until_n_data_sent(
     }
 }
 
+void DummyParticipant::simulate_remote_readers(
+        RealTopic topic,
+        bool remote_readers) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    auto it = writers_.find(topic);
+    if (it != writers_.end())
+    {
+        std::shared_ptr<DummyWriter> writer = std::dynamic_pointer_cast<DummyWriter>(it->second);
+        writer->simulate_remote_readers(remote_readers);
+    }
+}
+
+void DummyParticipant::simulate_full_history(
+        RealTopic topic,
+        bool full_history) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    auto it = writers_.find(topic);
+    if (it != writers_.end())
+    {
+        std::shared_ptr<DummyWriter> writer = std::dynamic_pointer_cast<DummyWriter>(it->second);
+        writer->simulate_full_history(full_history);
+    }
+}
+
+bool DummyParticipant::has_reader(
+        RealTopic topic) const noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return readers_.find(topic) != readers_.end();
+}
+
+bool DummyParticipant::has_writer(
+        RealTopic topic) const noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return writers_.find(topic) != writers_.end();
+}
+
 DummyParticipant* DummyParticipant::get_participant(
         ParticipantId id)
 {
@@ -25,13 +25,15 @@ namespace eprosima {
 namespace ddsrouter {
 
 std::shared_ptr<IWriter> EchoParticipant::create_writer_(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs&)
 {
     return std::make_shared<EchoWriter>(id(), topic, payload_pool_);
 }
 
 std::shared_ptr<IReader> EchoParticipant::create_reader_(
-        RealTopic)
+        RealTopic,
+        const TopicSpecs&)
 {
     return std::make_shared<VoidReader>();
 }
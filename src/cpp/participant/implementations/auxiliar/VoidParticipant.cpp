@@ -40,14 +40,21 @@ ParticipantType VoidParticipant::type() const noexcept
     return ParticipantType::VOID;
 }
 
+bool VoidParticipant::discovers_endpoints() const noexcept
+{
+    return false;
+}
+
 std::shared_ptr<IWriter> VoidParticipant::create_writer(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs& specs)
 {
     return std::make_shared<VoidWriter>();
 }
 
 std::shared_ptr<IReader> VoidParticipant::create_reader(
-        RealTopic topic)
+        RealTopic topic,
+        const TopicSpecs& specs)
 {
     return std::make_shared<VoidReader>();
 }
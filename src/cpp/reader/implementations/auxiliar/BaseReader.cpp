@@ -32,13 +32,16 @@ const std::function<void()> BaseReader::DEFAULT_ON_DATA_AVAILABLE_CALLBACK =
 BaseReader::BaseReader(
         const ParticipantId& participant_id,
         const RealTopic& topic,
-        std::shared_ptr<PayloadPool> payload_pool)
+        std::shared_ptr<PayloadPool> payload_pool,
+        bool low_priority /* = false */)
     : participant_id_(participant_id)
     , topic_(topic)
     , payload_pool_(payload_pool)
+    , low_priority_(low_priority)
     , on_data_available_lambda_(DEFAULT_ON_DATA_AVAILABLE_CALLBACK)
     , on_data_available_lambda_set_(false)
     , enabled_(false)
+    , data_allocations_(0)
 {
     logDebug(DDSROUTER_BASEREADER, "Creating Reader " << *this << ".");
 }
@@ -117,6 +120,42 @@ ReturnCode BaseReader::take(
     }
 }
 
+ReturnCode BaseReader::take_batch(
+        std::vector<std::unique_ptr<DataReceived>>& data,
+        size_t max_samples) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    if (enabled_.load())
+    {
+        return take_batch_(data, max_samples);
+    }
+    else
+    {
+        logWarning(DDSROUTER_BASEREADER, "Attempt to take data from disabled Reader in topic " <<
+                topic_ << " in Participant " << participant_id_);
+        return ReturnCode::RETCODE_NOT_ENABLED;
+    }
+}
+
+void BaseReader::return_loan(
+        std::vector<std::unique_ptr<DataReceived>>& data) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    for (std::unique_ptr<DataReceived>& sample : data)
+    {
+        recycle_data_(std::move(sample));
+    }
+
+    data.clear();
+}
+
+uint64_t BaseReader::data_allocations() const noexcept
+{
+    return data_allocations_.load();
+}
+
 void BaseReader::on_data_available_() const noexcept
 {
     if (on_data_available_lambda_set_)
@@ -130,6 +169,54 @@ void BaseReader::on_data_available_() const noexcept
     }
 }
 
+ReturnCode BaseReader::take_batch_(
+        std::vector<std::unique_ptr<DataReceived>>& data,
+        size_t max_samples) noexcept
+{
+    ReturnCode ret = ReturnCode::RETCODE_NO_DATA;
+
+    for (size_t taken = 0; taken < max_samples; ++taken)
+    {
+        std::unique_ptr<DataReceived> sample = get_data_();
+        ReturnCode sample_ret = take_(sample);
+
+        if (!sample_ret)
+        {
+            recycle_data_(std::move(sample));
+
+            // Errors are only reported if nothing has been taken, otherwise the samples taken must be processed
+            return taken > 0 ? ReturnCode::RETCODE_OK : sample_ret;
+        }
+
+        data.push_back(std::move(sample));
+        ret = ReturnCode::RETCODE_OK;
+    }
+
+    return ret;
+}
+
+std::unique_ptr<DataReceived> BaseReader::get_data_() noexcept
+{
+    if (data_free_list_.empty())
+    {
+        data_allocations_++;
+        return std::make_unique<DataReceived>();
+    }
+
+    std::unique_ptr<DataReceived> data = std::move(data_free_list_.back());
+    data_free_list_.pop_back();
+    return data;
+}
+
+void BaseReader::recycle_data_(
+        std::unique_ptr<DataReceived>&& data) noexcept
+{
+    if (data)
+    {
+        data_free_list_.push_back(std::move(data));
+    }
+}
+
 void BaseReader::enable_() noexcept
 {
     // It does nothing. Override this method so it has functionality.
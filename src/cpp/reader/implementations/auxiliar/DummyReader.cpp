@@ -47,6 +47,45 @@ ReturnCode DummyReader::take_(
         return ReturnCode::RETCODE_NO_DATA;
     }
 
+    return take_next_nts_(data);
+}
+
+ReturnCode DummyReader::take_batch_(
+        std::vector<std::unique_ptr<DataReceived>>& data,
+        size_t max_samples) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(dummy_mutex_);
+
+    // There is no data pending sent
+    if (data_to_send_.empty())
+    {
+        return ReturnCode::RETCODE_NO_DATA;
+    }
+
+    bool any_taken = false;
+
+    for (size_t taken = 0; taken < max_samples && !data_to_send_.empty(); ++taken)
+    {
+        std::unique_ptr<DataReceived> sample = get_data_();
+
+        // Data that does not fit in the payload pool is discarded and the rest of the batch is still taken
+        if (take_next_nts_(sample) == ReturnCode::RETCODE_OK)
+        {
+            data.push_back(std::move(sample));
+            any_taken = true;
+        }
+        else
+        {
+            recycle_data_(std::move(sample));
+        }
+    }
+
+    return any_taken ? ReturnCode::RETCODE_OK : ReturnCode::RETCODE_OUT_OF_RESOURCES;
+}
+
+ReturnCode DummyReader::take_next_nts_(
+        std::unique_ptr<DataReceived>& data) noexcept
+{
     // Get next data received
     DummyDataReceived next_data_to_send = data_to_send_.front();
     data_to_send_.pop();
@@ -54,10 +93,17 @@ ReturnCode DummyReader::take_(
     // Write (copy) values in data
     data->source_guid = next_data_to_send.source_guid;
 
-    // Move Payload to DDSRouter Payload Pool
-    payload_pool_->get_payload(
-        next_data_to_send.payload.size() * sizeof(PayloadUnit),
-        data->payload);
+    // Move Payload to DDSRouter Payload Pool as a real Reader stores the data it receives
+    if (!payload_pool_->get_ingress_payload(
+                next_data_to_send.payload.size() * sizeof(PayloadUnit),
+                data->payload,
+                low_priority_))
+    {
+        logDebug(DDSROUTER_DUMMYREADER,
+                "Data rejected by payload pool in Reader " << *this << ". Discarding it.");
+        return ReturnCode::RETCODE_OUT_OF_RESOURCES;
+    }
+    data->payload_owner = payload_pool_.get();
 
     // Set values in Payload as the data was not in the DDSRouter Payload Pool
     for (int i = 0; i < next_data_to_send.payload.size(); i++)
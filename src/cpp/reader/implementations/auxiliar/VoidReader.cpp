@@ -44,5 +44,18 @@ ReturnCode VoidReader::take(
     return ReturnCode::RETCODE_NO_DATA;
 }
 
+ReturnCode VoidReader::take_batch(
+        std::vector<std::unique_ptr<DataReceived>>&,
+        size_t) noexcept
+{
+    return ReturnCode::RETCODE_NO_DATA;
+}
+
+void VoidReader::return_loan(
+        std::vector<std::unique_ptr<DataReceived>>& data) noexcept
+{
+    data.clear();
+}
+
 } /* namespace ddsrouter */
 } /* namespace eprosima */
@@ -16,6 +16,8 @@
  * @file Reader.cpp
  */
 
+#include <algorithm>
+
 #include <fastrtps/rtps/RTPSDomain.h>
 #include <fastrtps/rtps/participant/RTPSParticipant.h>
 
@@ -31,8 +33,12 @@ Reader::Reader(
         const ParticipantId& participant_id,
         const RealTopic& topic,
         std::shared_ptr<PayloadPool> payload_pool,
-        fastrtps::rtps::RTPSParticipant* rtps_participant)
-    : BaseReader(participant_id, topic, payload_pool)
+        fastrtps::rtps::RTPSParticipant* rtps_participant,
+        const TopicSpecs& specs,
+        int numa_node /* = numa::NO_NUMA_NODE */)
+    : BaseReader(participant_id, topic, payload_pool, specs.low_priority)
+    , reader_payload_pool_(std::make_shared<ReaderPayloadPool>(payload_pool, specs.low_priority))
+    , numa_node_(numa_node)
 {
     // Create History
     fastrtps::rtps::HistoryAttributes history_att = history_attributes_();
@@ -43,7 +49,7 @@ Reader::Reader(
     rtps_reader_ = fastrtps::rtps::RTPSDomain::createRTPSReader(
         rtps_participant,
         reader_att,
-        payload_pool_,
+        reader_payload_pool_,
         rtps_history_,
         this);
 
@@ -101,6 +107,47 @@ ReturnCode Reader::take_(
         return ReturnCode::RETCODE_NO_DATA;
     }
 
+    return take_next_change_nts_(data);
+}
+
+ReturnCode Reader::take_batch_(
+        std::vector<std::unique_ptr<DataReceived>>& data,
+        size_t max_samples) noexcept
+{
+    std::lock_guard<std::recursive_mutex> lock(rtps_mutex_);
+
+    // Check how much data is available, only once for the whole batch
+    uint64_t unread_count = rtps_reader_->get_unread_count();
+    if (!(unread_count > 0))
+    {
+        return ReturnCode::RETCODE_NO_DATA;
+    }
+
+    size_t samples_to_take = static_cast<size_t>(std::min<uint64_t>(unread_count, max_samples));
+    bool any_taken = false;
+
+    for (size_t i = 0; i < samples_to_take; ++i)
+    {
+        std::unique_ptr<DataReceived> sample = get_data_();
+
+        // Inconsistent changes are discarded and the rest of the batch is still taken
+        if (take_next_change_nts_(sample) == ReturnCode::RETCODE_OK)
+        {
+            data.push_back(std::move(sample));
+            any_taken = true;
+        }
+        else
+        {
+            recycle_data_(std::move(sample));
+        }
+    }
+
+    return any_taken ? ReturnCode::RETCODE_OK : ReturnCode::RETCODE_ERROR;
+}
+
+ReturnCode Reader::take_next_change_nts_(
+        std::unique_ptr<DataReceived>& data) noexcept
+{
     fastrtps::rtps::CacheChange_t* received_change = nullptr;
     fastrtps::rtps::WriterProxy* wp = nullptr;
 
@@ -141,10 +188,22 @@ ReturnCode Reader::take_(
 
     // Store it in DDSRouter PayloadPool
     eprosima::fastrtps::rtps::IPayloadPool* payload_owner = received_change->payload_owner();
-    payload_pool_->get_payload(
-        received_change->serializedPayload,
-        payload_owner,
-        data->payload);
+    if (!payload_pool_->get_payload(
+                received_change->serializedPayload,
+                payload_owner,
+                data->payload))
+    {
+        // Only happens if the data is not already in the pool and it does not fit in the memory budget
+        logWarning(DDSROUTER_RTPS_READER_LISTENER,
+                "Error storing data in payload pool from remote writer " << received_change->writerGUID
+                                                                         << ". Discarding it.");
+
+        // Remove the change in the History and release it in the reader
+        rtps_reader_->getHistory()->remove_change(received_change);
+
+        return ReturnCode::RETCODE_OUT_OF_RESOURCES;
+    }
+    data->payload_owner = payload_pool_.get();
 
     logDebug(DDSROUTER_RTPS_READER_LISTENER,
             "Data transmiting to track from Reader " << *this << " with payload " <<
@@ -220,6 +279,8 @@ void Reader::onNewCacheChangeAdded(
         fastrtps::rtps::RTPSReader*,
         const fastrtps::rtps::CacheChange_t* const change) noexcept
 {
+    bind_receive_thread_();
+
     if (enabled_ && !come_from_this_participant_(change))
     {
         // Call Track callback (by calling BaseReader callback method)
@@ -255,6 +316,21 @@ void Reader::onReaderMatched(
     }
 }
 
+void Reader::bind_receive_thread_() const noexcept
+{
+    // Node the current thread has been bound to. Threads are only bound once, even if it fails, so a receive thread
+    // shared by Readers of different nodes keeps the node of the first one instead of being moved on every callback
+    thread_local int bound_numa_node = numa::NO_NUMA_NODE;
+
+    if (numa_node_ != numa::NO_NUMA_NODE && bound_numa_node == numa::NO_NUMA_NODE)
+    {
+        logInfo(DDSROUTER_RTPS_READER_LISTENER,
+                "Binding receive thread of Reader " << *this << " to NUMA node " << numa_node_ << ".");
+        numa::bind_thread_to_node(numa_node_);
+        bound_numa_node = numa_node_;
+    }
+}
+
 } /* namespace rtps */
 } /* namespace ddsrouter */
 } /* namespace eprosima */
@@ -31,6 +31,7 @@ std::set<std::string> ddsrouter_tags() noexcept
         {
             ALLOWLIST_TAG,
             BLOCKLIST_TAG,
+            SPECS_TAG,
             TOPIC_NAME_TAG,
             TOPIC_TYPE_NAME_TAG
         };
@@ -31,11 +31,13 @@ Endpoint::Endpoint(
         const EndpointKind& kind,
         const Guid& guid,
         const QoS& qos,
-        const RealTopic& topic) noexcept
+        const RealTopic& topic,
+        const ParticipantId& discoverer_participant_id /* = ParticipantId() */) noexcept
     : kind_(kind)
     , guid_(guid)
     , qos_(qos)
     , topic_(topic)
+    , discoverer_participant_id_(discoverer_participant_id)
     , active_(true)
 {
 }
@@ -60,6 +62,11 @@ RealTopic Endpoint::topic() const noexcept
     return topic_;
 }
 
+ParticipantId Endpoint::discoverer_participant_id() const noexcept
+{
+    return discoverer_participant_id_;
+}
+
 bool Endpoint::active() const noexcept
 {
     return active_;
@@ -94,13 +101,15 @@ Endpoint& Endpoint::operator =(
     this->kind_ = other.kind_;
     this->qos_ = other.qos_;
     this->topic_ = other.topic_;
+    this->discoverer_participant_id_ = other.discoverer_participant_id_;
     return *this;
 }
 
 bool Endpoint::operator ==(
         const Endpoint& other) const noexcept
 {
-    return guid_ == other.guid() && kind_ == other.kind() && qos_ == other.qos() && topic_ == other.topic();
+    return guid_ == other.guid() && kind_ == other.kind() && qos_ == other.qos() && topic_ == other.topic() &&
+           discoverer_participant_id_ == other.discoverer_participant_id();
 }
 
 std::ostream& operator <<(
@@ -108,7 +117,7 @@ std::ostream& operator <<(
         const Endpoint& endpoint)
 {
     os << "Endpoint{" << endpoint.guid_ << ";" << endpoint.topic_ << ";" << endpoint.qos_ << ";" <<
-        endpoint.kind_ << ";" << endpoint.active_ << "}";
+        endpoint.kind_ << ";" << endpoint.discoverer_participant_id_ << ";" << endpoint.active_ << "}";
     return os;
 }
 
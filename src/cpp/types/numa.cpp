@@ -0,0 +1,236 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/**
+ * @file numa.cpp
+ *
+ */
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // if defined(__linux__)
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+#include <ddsrouter/types/Log.hpp>
+#include <ddsrouter/types/numa.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+namespace numa {
+
+namespace {
+
+#if defined(__linux__)
+
+// Values of the kernel memory policy interface, so libnuma is not required
+constexpr int MPOL_PREFERRED_ = 1;
+constexpr int MPOL_BIND_ = 2;
+constexpr unsigned long MPOL_MF_MOVE_ = 1 << 1;
+constexpr unsigned long MPOL_F_NODE_ = 1 << 0;
+constexpr unsigned long MPOL_F_ADDR_ = 1 << 1;
+
+//! Bits of the node masks passed to the kernel
+constexpr unsigned long NODE_MASK_BITS = 64;
+
+//! Directory of the NUMA nodes in sysfs
+constexpr const char* NODES_PATH = "/sys/devices/system/node/";
+
+//! First line of file \c path , or empty if it could not be read
+std::string read_line(
+        const std::string& path) noexcept
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+#endif // if defined(__linux__)
+
+//! Whether \c node can be used in the node masks passed to the kernel
+bool valid_node(
+        int node) noexcept
+{
+#if defined(__linux__)
+    return node >= 0 && static_cast<unsigned long>(node) < NODE_MASK_BITS;
+#else
+    static_cast<void>(node);
+    return false;
+#endif // if defined(__linux__)
+}
+
+} /* namespace */
+
+unsigned int number_of_nodes() noexcept
+{
+#if defined(__linux__)
+    std::set<unsigned int> nodes = parse_cpu_list(read_line(std::string(NODES_PATH) + "online"));
+    if (!nodes.empty())
+    {
+        return *nodes.rbegin() + 1;
+    }
+#endif // if defined(__linux__)
+    return 1;
+}
+
+std::set<unsigned int> node_cpus(
+        int node) noexcept
+{
+#if defined(__linux__)
+    if (node >= 0)
+    {
+        return parse_cpu_list(read_line(std::string(NODES_PATH) + "node" + std::to_string(node) + "/cpulist"));
+    }
+#else
+    static_cast<void>(node);
+#endif // if defined(__linux__)
+    return {};
+}
+
+std::set<unsigned int> parse_cpu_list(
+        const std::string& cpu_list) noexcept
+{
+    std::set<unsigned int> cpus;
+    std::stringstream ss(cpu_list);
+    std::string range;
+
+    while (std::getline(ss, range, ','))
+    {
+        unsigned int first;
+        unsigned int last;
+        char separator;
+        std::stringstream range_ss(range);
+
+        if (!(range_ss >> first))
+        {
+            return {};
+        }
+
+        if (range_ss >> separator)
+        {
+            if (separator != '-' || !(range_ss >> last) || last < first)
+            {
+                return {};
+            }
+        }
+        else
+        {
+            last = first;
+        }
+
+        for (unsigned int cpu = first; cpu <= last; cpu++)
+        {
+            cpus.insert(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+bool bind_thread_to_node(
+        int node) noexcept
+{
+#if defined(__linux__)
+    std::set<unsigned int> cpus = node_cpus(node);
+    if (cpus.empty() || !valid_node(node))
+    {
+        logWarning(DDSROUTER_NUMA, "NUMA node " << node << " not found in this host. Thread not bound.");
+        return false;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (unsigned int cpu : cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+    {
+        logWarning(DDSROUTER_NUMA, "Error binding thread to the CPUs of NUMA node " << node << ".");
+        return false;
+    }
+
+    unsigned long node_mask = 1ul << node;
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED_, &node_mask, NODE_MASK_BITS) != 0)
+    {
+        logWarning(DDSROUTER_NUMA, "Error setting memory policy of thread to NUMA node " << node << ".");
+        return false;
+    }
+
+    return true;
+#else
+    static_cast<void>(node);
+    logWarning(DDSROUTER_NUMA, "NUMA binding is not supported in this platform. Thread not bound.");
+    return false;
+#endif // if defined(__linux__)
+}
+
+bool bind_memory_to_node(
+        void* address,
+        size_t size,
+        int node) noexcept
+{
+#if defined(__linux__)
+    if (!valid_node(node) || node >= static_cast<int>(number_of_nodes()))
+    {
+        logWarning(DDSROUTER_NUMA, "NUMA node " << node << " not found in this host. Memory not bound.");
+        return false;
+    }
+
+    unsigned long node_mask = 1ul << node;
+    if (syscall(SYS_mbind, address, size, MPOL_BIND_, &node_mask, NODE_MASK_BITS, MPOL_MF_MOVE_) != 0)
+    {
+        logWarning(DDSROUTER_NUMA, "Error binding " << size << " bytes of memory to NUMA node " << node << ".");
+        return false;
+    }
+
+    return true;
+#else
+    static_cast<void>(address);
+    static_cast<void>(size);
+    static_cast<void>(node);
+    logWarning(DDSROUTER_NUMA, "NUMA binding is not supported in this platform. Memory not bound.");
+    return false;
+#endif // if defined(__linux__)
+}
+
+int node_of_address(
+        const void* address) noexcept
+{
+#if defined(__linux__)
+    int node = NO_NUMA_NODE;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address, MPOL_F_NODE_ | MPOL_F_ADDR_) != 0)
+    {
+        return NO_NUMA_NODE;
+    }
+    return node;
+#else
+    static_cast<void>(address);
+    return NO_NUMA_NODE;
+#endif // if defined(__linux__)
+}
+
+} /* namespace numa */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
@@ -56,6 +56,7 @@ bool ParticipantId::is_valid_id(
     return
         (tag != ALLOWLIST_TAG) &&
         (tag != BLOCKLIST_TAG) &&
+        (tag != SPECS_TAG) &&
         (tag != INVALID_ID);
 }
 
@@ -55,6 +55,11 @@ bool ParticipantType::is_valid() const noexcept
     return value_ != PARTICIPANT_TYPE_INVALID;
 }
 
+bool ParticipantType::connects_routers() const noexcept
+{
+    return value_ == WAN || value_ == LOCAL_DISCOVERY_SERVER;
+}
+
 std::string ParticipantType::to_string() const noexcept
 {
     auto it = ParticipantType::participant_type_with_aliases_.find(value_);
@@ -0,0 +1,62 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TopicSpecs.cpp
+ */
+
+#include <ddsrouter/types/topic/TopicSpecs.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+std::ostream& operator <<(
+        std::ostream& os,
+        const EgressOverflowPolicy& policy)
+{
+    switch (policy)
+    {
+        case EgressOverflowPolicy::DROP_OLDEST:
+            os << "drop-oldest";
+            break;
+
+        case EgressOverflowPolicy::DROP_NEWEST:
+            os << "drop-newest";
+            break;
+
+        case EgressOverflowPolicy::BLOCK:
+            os << "block";
+            break;
+
+        default:
+            os << "unknown";
+            break;
+    }
+    return os;
+}
+
+std::ostream& operator <<(
+        std::ostream& os,
+        const TopicSpecs& specs)
+{
+    os << "TopicSpecs{spin_budget:" << specs.spin_budget << "us;inline:" << specs.inline_forwarding
+       << ";egress_queue:" << specs.egress_queue_size << ";egress_overflow:" << specs.egress_overflow_policy
+       << ";parallel_fanout:" << specs.parallel_fanout << ";history_depth:" << specs.history_depth
+       << ";history_max_samples:" << specs.history_max_samples << ";low_priority:" << specs.low_priority
+       << ";skip_without_readers:" << specs.skip_without_readers << ";zero_copy:" << specs.zero_copy << "}";
+    return os;
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
@@ -80,6 +80,11 @@ ReturnCode BaseWriter::write(
     }
 }
 
+bool BaseWriter::has_remote_readers() const noexcept
+{
+    return true;
+}
+
 void BaseWriter::enable_() noexcept
 {
     // It does nothing. Override this method so it has functionality.
@@ -16,14 +16,39 @@
  * @file DummyWriter.cpp
  */
 
+#include <ddsrouter/types/Log.hpp>
 #include <ddsrouter/writer/implementations/auxiliar/DummyWriter.hpp>
 
 namespace eprosima {
 namespace ddsrouter {
 
+DummyWriter::DummyWriter(
+        const ParticipantId& participant_id,
+        const RealTopic& topic,
+        std::shared_ptr<PayloadPool> payload_pool,
+        bool check_numa_node /* = false */)
+    : BaseWriter(participant_id, topic, payload_pool)
+    , check_numa_node_(check_numa_node)
+{
+}
+
 ReturnCode DummyWriter::write_(
         std::unique_ptr<DataReceived>& data) noexcept
 {
+    if (full_history_.load(std::memory_order_relaxed))
+    {
+        return ReturnCode::RETCODE_OUT_OF_RESOURCES;
+    }
+
+    // Get the payload to send from the pool as a real Writer does, so it is referenced or copied the same way
+    Payload payload;
+    eprosima::fastrtps::rtps::IPayloadPool* payload_owner = data->payload_owner;
+    if (!payload_pool_->get_payload(data->payload, payload_owner, payload))
+    {
+        logError(DDSROUTER_DUMMYWRITER, "Error getting Payload.");
+        return ReturnCode::RETCODE_ERROR;
+    }
+
     {
         std::lock_guard<std::mutex> lock(dummy_mutex_);
 
@@ -33,14 +58,19 @@ ReturnCode DummyWriter::write_(
         new_data_to_store.source_guid = data->source_guid;
 
         // Copying data as it should not be stored in PayloadPool
-        for (int i = 0; i < data->payload.length; i++)
+        new_data_to_store.payload.assign(payload.data, payload.data + payload.length);
+
+        // Node where the transport sending the data would read it from
+        if (check_numa_node_)
         {
-            new_data_to_store.payload.push_back(data->payload.data[i]);
+            new_data_to_store.numa_node = numa::node_of_address(payload.data);
         }
 
         data_stored_.push_back(new_data_to_store);
     }
 
+    payload_pool_->release_payload(payload);
+
     // Notify that a new message has been sent
     wait_condition_variable_.notify_all();
 
@@ -59,6 +89,23 @@ void DummyWriter::wait_until_n_data_sent(
         });
 }
 
+bool DummyWriter::has_remote_readers() const noexcept
+{
+    return remote_readers_.load(std::memory_order_relaxed);
+}
+
+void DummyWriter::simulate_remote_readers(
+        bool remote_readers) noexcept
+{
+    remote_readers_.store(remote_readers, std::memory_order_relaxed);
+}
+
+void DummyWriter::simulate_full_history(
+        bool full_history) noexcept
+{
+    full_history_.store(full_history, std::memory_order_relaxed);
+}
+
 std::vector<DummyDataStored> DummyWriter::get_data_that_should_have_been_sent() const noexcept
 {
     std::lock_guard<std::mutex> lock(dummy_mutex_);
@@ -0,0 +1,284 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file QueuedWriter.cpp
+ */
+
+#include <algorithm>
+
+#include <ddsrouter/types/Log.hpp>
+#include <ddsrouter/writer/implementations/auxiliar/QueuedWriter.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+
+QueuedWriter::QueuedWriter(
+        std::shared_ptr<IWriter> writer,
+        std::shared_ptr<PayloadPool> payload_pool,
+        std::shared_ptr<SlotThreadPool> thread_pool,
+        unsigned int max_size,
+        EgressOverflowPolicy overflow_policy)
+    : writer_(writer)
+    , payload_pool_(payload_pool)
+    , thread_pool_(thread_pool)
+    , max_size_(std::max(max_size, 1u))
+    , overflow_policy_(overflow_policy)
+    , enabled_(false)
+    , draining_(false)
+    , dropped_samples_(0)
+{
+    // Every sample that can be in the queue, plus the one being sent, is allocated in advance
+    free_data_.reserve(max_size_ + 1);
+    for (unsigned int i = 0; i <= max_size_; ++i)
+    {
+        free_data_.push_back(std::make_unique<DataReceived>());
+    }
+
+    drain_slot_id_ = thread_pool_->register_slot(std::bind(&QueuedWriter::drain_, this));
+
+    logDebug(DDSROUTER_QUEUEDWRITER, "Queued Writer created with size " << max_size_ << " and overflow policy "
+                                                                        << overflow_policy_ << ".");
+}
+
+QueuedWriter::~QueuedWriter()
+{
+    // Wait for the drain task if running, and stop emitting it
+    thread_pool_->unregister_slot(drain_slot_id_);
+
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    clear_queue_nts_();
+}
+
+void QueuedWriter::enable() noexcept
+{
+    std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+    writer_->enable();
+    enabled_ = true;
+
+    // Data may have been queued while it was being disabled
+    if (queued_samples() > 0)
+    {
+        thread_pool_->emit(drain_slot_id_);
+    }
+}
+
+void QueuedWriter::disable() noexcept
+{
+    // Wait for the sample that is being sent, if any
+    std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+    enabled_ = false;
+    writer_->disable();
+
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    clear_queue_nts_();
+
+    // Writes waiting for room must see the Writer disabled
+    room_available_cv_.notify_all();
+}
+
+ReturnCode QueuedWriter::write(
+        std::unique_ptr<DataReceived>& data) noexcept
+{
+    std::unique_ptr<DataReceived> sample;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+
+        // New data dropped do not need a payload
+        if (enabled_ && overflow_policy_ == EgressOverflowPolicy::DROP_NEWEST && queue_.size() >= max_size_)
+        {
+            dropped_samples_++;
+            logDebug(DDSROUTER_QUEUEDWRITER, "Egress queue full, dropping new data from " << data->source_guid << ".");
+            return ReturnCode::RETCODE_OK;
+        }
+
+        sample = take_free_sample_nts_();
+    }
+
+    // Reference the payload. It is only copied if it belongs to other pool, e.g. the one of other NUMA node.
+    // The queue is not locked meanwhile, as a pool with a memory budget may wait for the drain task to release data.
+    eprosima::fastrtps::rtps::IPayloadPool* payload_owner = data->payload_owner;
+    if (!payload_pool_->get_payload(data->payload, payload_owner, sample->payload))
+    {
+        logError(DDSROUTER_QUEUEDWRITER, "Error referencing Payload.");
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        free_data_.push_back(std::move(sample));
+        return ReturnCode::RETCODE_ERROR;
+    }
+    sample->payload_owner = payload_pool_.get();
+    sample->source_guid = data->source_guid;
+
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+
+    while (queue_.size() >= max_size_)
+    {
+        if (!enabled_)
+        {
+            break;
+        }
+
+        if (overflow_policy_ == EgressOverflowPolicy::DROP_NEWEST)
+        {
+            dropped_samples_++;
+            logDebug(DDSROUTER_QUEUEDWRITER, "Egress queue full, dropping new data from " << data->source_guid << ".");
+            release_sample_nts_(sample);
+            return ReturnCode::RETCODE_OK;
+        }
+        else if (overflow_policy_ == EgressOverflowPolicy::DROP_OLDEST)
+        {
+            dropped_samples_++;
+            logDebug(DDSROUTER_QUEUEDWRITER, "Egress queue full, dropping data from "
+                    << queue_.front()->source_guid << ".");
+            release_sample_nts_(queue_.front());
+            queue_.pop_front();
+        }
+        else
+        {
+            // Wait for the drain task to make room, so the data is sent by a thread of the pool while this one goes on
+            // with the rest of Writers once there is room.
+            // If the drain task is not running after a while, every thread of the pool may be waiting for a full
+            // queue, so the oldest sample is sent from this thread to guarantee progress.
+            if (room_available_cv_.wait_for(lock, DRAIN_STALL_PERIOD_) == std::cv_status::timeout && !draining_ &&
+                    queue_.size() >= max_size_)
+            {
+                lock.unlock();
+                write_next_();
+                lock.lock();
+            }
+        }
+    }
+
+    if (!enabled_)
+    {
+        logWarning(DDSROUTER_QUEUEDWRITER, "Attempt to write data from disabled Queued Writer.");
+        release_sample_nts_(sample);
+        return ReturnCode::RETCODE_NOT_ENABLED;
+    }
+
+    queue_.push_back(std::move(sample));
+    lock.unlock();
+
+    thread_pool_->emit(drain_slot_id_);
+
+    return ReturnCode::RETCODE_OK;
+}
+
+bool QueuedWriter::has_remote_readers() const noexcept
+{
+    return writer_->has_remote_readers();
+}
+
+uint64_t QueuedWriter::dropped_samples() const noexcept
+{
+    return dropped_samples_.load();
+}
+
+size_t QueuedWriter::queued_samples() const noexcept
+{
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return queue_.size();
+}
+
+void QueuedWriter::drain_() noexcept
+{
+    draining_ = true;
+
+    for (unsigned int writes = 0; writes < MAX_WRITES_PER_TASK_; ++writes)
+    {
+        if (!write_next_())
+        {
+            draining_ = false;
+            return;
+        }
+    }
+
+    // Give other tasks the chance to use this thread. The rest of the data is sent in a new execution
+    draining_ = false;
+    thread_pool_->emit(drain_slot_id_);
+}
+
+bool QueuedWriter::write_next_() noexcept
+{
+    std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+    if (!enabled_)
+    {
+        return false;
+    }
+
+    std::unique_ptr<DataReceived> sample;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (queue_.empty())
+        {
+            return false;
+        }
+        sample = std::move(queue_.front());
+        queue_.pop_front();
+    }
+    room_available_cv_.notify_one();
+
+    ReturnCode ret = writer_->write(sample);
+    if (ret == ReturnCode::RETCODE_OUT_OF_RESOURCES)
+    {
+        // The history of the Writer is full of data not acknowledged, so it does not keep this one
+        dropped_samples_++;
+        logDebug(DDSROUTER_QUEUEDWRITER, "Writer history full, dropping data from " << sample->source_guid << ".");
+    }
+    else if (!ret)
+    {
+        logWarning(DDSROUTER_QUEUEDWRITER, "Error writting queued data. Error code " << ret
+                                                                                     << ". Skipping data.");
+    }
+
+    payload_pool_->release_payload(sample->payload);
+
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    free_data_.push_back(std::move(sample));
+
+    return true;
+}
+
+void QueuedWriter::clear_queue_nts_() noexcept
+{
+    for (std::unique_ptr<DataReceived>& sample : queue_)
+    {
+        release_sample_nts_(sample);
+    }
+    queue_.clear();
+}
+
+std::unique_ptr<DataReceived> QueuedWriter::take_free_sample_nts_() noexcept
+{
+    if (free_data_.empty())
+    {
+        return std::make_unique<DataReceived>();
+    }
+
+    std::unique_ptr<DataReceived> sample = std::move(free_data_.back());
+    free_data_.pop_back();
+    return sample;
+}
+
+void QueuedWriter::release_sample_nts_(
+        std::unique_ptr<DataReceived>& sample) noexcept
+{
+    payload_pool_->release_payload(sample->payload);
+    free_data_.push_back(std::move(sample));
+}
+
+} /* namespace ddsrouter */
+} /* namespace eprosima */
@@ -35,5 +35,10 @@ ReturnCode VoidWriter::write(
     return ReturnCode::RETCODE_OK;
 }
 
+bool VoidWriter::has_remote_readers() const noexcept
+{
+    return false;
+}
+
 } /* namespace ddsrouter */
 } /* namespace eprosima */
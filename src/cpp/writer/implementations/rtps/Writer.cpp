@@ -16,9 +16,13 @@
  * @file Writer.cpp
  */
 
+#include <algorithm>
+#include <mutex>
+
 #include <fastrtps/rtps/RTPSDomain.h>
 #include <fastrtps/rtps/participant/RTPSParticipant.h>
 #include <fastrtps/rtps/common/CacheChange.h>
+#include <fastrtps/utils/TimedMutex.hpp>
 
 #include <ddsrouter/writer/implementations/rtps/Writer.hpp>
 #include <ddsrouter/exceptions/InitializationException.hpp>
@@ -32,23 +36,25 @@ Writer::Writer(
         const ParticipantId& participant_id,
         const RealTopic& topic,
         std::shared_ptr<PayloadPool> payload_pool,
-        fastrtps::rtps::RTPSParticipant* rtps_participant)
+        fastrtps::rtps::RTPSParticipant* rtps_participant,
+        const TopicSpecs& specs)
     : BaseWriter(participant_id, topic, payload_pool)
+    , history_depth_(specs.history_depth)
+    , history_max_samples_(specs.history_max_samples)
+    , matched_readers_(0)
 {
-    // TODO Use payload pool for this writer, so change does not need to be copied
-
     // Create History
     fastrtps::rtps::HistoryAttributes history_att = history_attributes_();
     rtps_history_ = new fastrtps::rtps::WriterHistory(history_att);
 
-    // Create Writer
+    // Create Writer with the payload pool of the Participant, so data of this pool are sent without being copied
     fastrtps::rtps::WriterAttributes writer_att = writer_attributes_();
     rtps_writer_ = fastrtps::rtps::RTPSDomain::createRTPSWriter(
         rtps_participant,
         writer_att,
         payload_pool_,
         rtps_history_,
-        nullptr);
+        this);
 
     if (!rtps_writer_)
     {
@@ -68,6 +74,13 @@ Writer::Writer(
                       " for Simple RTPSWriter in Participant " << participant_id);
     }
 
+    // Let the PayloadPool evict the changes of this Writer when the memory budget is reached
+    memory_reclaimer_id_ = payload_pool_->register_memory_reclaimer(
+        [this]()
+        {
+            return reclaim_memory_();
+        });
+
     logInfo(DDSROUTER_RTPS_WRITER, "New Writer created in Participant " << participant_id_ << " for topic " <<
             topic << " with guid " << rtps_writer_->getGuid());
 }
@@ -77,6 +90,9 @@ Writer::~Writer()
     // This variables should be set, otherwise the creation should have fail
     // Anyway, the if case is used for safety reasons
 
+    // Once unregistered, the PayloadPool does not access the History anymore
+    payload_pool_->unregister_memory_reclaimer(memory_reclaimer_id_);
+
     // Delete writer
     if (rtps_writer_)
     {
@@ -94,37 +110,65 @@ Writer::~Writer()
             participant_id_ << " for topic " << topic_);
 }
 
+bool Writer::has_remote_readers() const noexcept
+{
+    return matched_readers_.load(std::memory_order_relaxed) > 0;
+}
+
+void Writer::onWriterMatched(
+        fastrtps::rtps::RTPSWriter* writer,
+        fastrtps::rtps::MatchingInfo& info) noexcept
+{
+    // Readers of this same Participant never get the data of this Writer, as they filter it
+    if (info.remoteEndpointGuid.guidPrefix == writer->getGuid().guidPrefix)
+    {
+        return;
+    }
+
+    if (info.status == fastrtps::rtps::MatchingStatus::MATCHED_MATCHING)
+    {
+        matched_readers_.fetch_add(1, std::memory_order_relaxed);
+        logInfo(DDSROUTER_RTPS_WRITER,
+                "Writer " << *this << " matched with a new Reader with guid " << info.remoteEndpointGuid);
+    }
+    else
+    {
+        matched_readers_.fetch_sub(1, std::memory_order_relaxed);
+        logInfo(DDSROUTER_RTPS_WRITER,
+                "Writer " << *this << " unmatched with Reader " << info.remoteEndpointGuid);
+    }
+}
+
 // Specific enable/disable do not need to be implemented
 ReturnCode Writer::write_(
         std::unique_ptr<DataReceived>& data) noexcept
 {
-    uint32_t data_size = data->payload.length;
+    // Bounded histories must remove old changes before getting a new one
+    if (!make_room_in_history_())
+    {
+        logDebug(DDSROUTER_RTPS_WRITER,
+                "Writer " << *this << " History is full of data not acknowledged. Skipping data from " <<
+                data->source_guid);
+        return ReturnCode::RETCODE_OUT_OF_RESOURCES;
+    }
 
     // Take new Change from history
     fastrtps::rtps::CacheChange_t* new_change = rtps_writer_->new_change(eprosima::fastrtps::rtps::ChangeKind_t::ALIVE);
 
-    // TODO : Set method to remove old changes in order to get a new one
-    // In case it fails, remove old changes from history and try again
-    // if (!new_change)
-    // {
-    //     rtps_writer_->remove_older_changes(1);
-    //     new_change = rtps_writer_->new_change([data_size]() -> uint32_t
-    //     {
-    //         return data_size;
-    //     }, eprosima::fastrtps::rtps::ChangeKind_t::ALIVE);
-    // }
-
-    // If still is not able to get a change, return an error code
+    // If it is not able to get a change, return an error code
     if (!new_change)
     {
         return ReturnCode::RETCODE_ERROR;
     }
 
-    // Get the Payload (copying it)
-    eprosima::fastrtps::rtps::IPayloadPool* payload_owner = payload_pool_.get();
+    // Get the Payload. It is only copied if it belongs to other pool, e.g. the one of other NUMA node
+    eprosima::fastrtps::rtps::IPayloadPool* payload_owner = data->payload_owner;
     if (!payload_pool_->get_payload(data->payload, payload_owner, (*new_change)))
     {
         logError(DDSROUTER_RTPS_WRITER, "Error getting Payload.");
+
+        // The change must be given back, or a bounded History would run out of changes
+        rtps_writer_->release_change(new_change);
         return ReturnCode::RETCODE_ERROR;
     }
 
@@ -135,16 +179,68 @@ ReturnCode Writer::write_(
     // Send data by adding it to Writer History
     rtps_history_->add_change(new_change);
 
-    // TODO: Data is never removed till destruction
-
     return ReturnCode::RETCODE_OK;
 }
 
+bool Writer::make_room_in_history_() noexcept
+{
+    if (history_depth_ > 0)
+    {
+        // KEEP_LAST: oldest changes are removed even if some reader has not received them
+        while (rtps_history_->getHistorySize() >= history_depth_)
+        {
+            if (!rtps_history_->remove_min_change())
+            {
+                return false;
+            }
+        }
+    }
+    else if (history_max_samples_ > 0)
+    {
+        // KEEP_ALL: only changes already received by every reader can be removed
+        while (rtps_history_->getHistorySize() >= history_max_samples_)
+        {
+            fastrtps::rtps::CacheChange_t* oldest_change = nullptr;
+            if (!rtps_history_->get_min_change(&oldest_change) ||
+                    !rtps_writer_->is_acked_by_all(oldest_change) ||
+                    !rtps_history_->remove_min_change())
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Writer::reclaim_memory_() noexcept
+{
+    std::unique_lock<fastrtps::RecursiveTimedMutex> lock(*rtps_history_->getMutex(), std::try_to_lock);
+    if (!lock.owns_lock() || rtps_history_->getHistorySize() == 0)
+    {
+        return false;
+    }
+
+    logDebug(DDSROUTER_RTPS_WRITER,
+            "Writer " << *this << " removing oldest change to release memory.");
+
+    return rtps_history_->remove_min_change();
+}
+
 fastrtps::rtps::HistoryAttributes Writer::history_attributes_() const noexcept
 {
     fastrtps::rtps::HistoryAttributes att;
     att.memoryPolicy =
             eprosima::fastrtps::rtps::MemoryManagementPolicy_t::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
+
+    // Bounded histories never hold more changes than their limit
+    int32_t max_changes = static_cast<int32_t>(history_depth_ > 0 ? history_depth_ : history_max_samples_);
+    if (max_changes > 0)
+    {
+        att.maximumReservedCaches = max_changes;
+        att.initialReservedCaches = std::min(att.initialReservedCaches, max_changes);
+    }
+
     return att;
 }
 
@@ -178,6 +274,18 @@ fastrtps::TopicAttributes Writer::topic_attributes_() const noexcept
     }
     att.topicName = topic_.topic_name();
     att.topicDataType = topic_.topic_type();
+
+    if (history_depth_ > 0)
+    {
+        att.historyQos.kind = eprosima::fastdds::dds::HistoryQosPolicyKind::KEEP_LAST_HISTORY_QOS;
+        att.historyQos.depth = static_cast<int32_t>(history_depth_);
+    }
+    else if (history_max_samples_ > 0)
+    {
+        att.historyQos.kind = eprosima::fastdds::dds::HistoryQosPolicyKind::KEEP_ALL_HISTORY_QOS;
+        att.resourceLimitsQos.max_samples = static_cast<int32_t>(history_max_samples_);
+    }
+
     return att;
 }
 
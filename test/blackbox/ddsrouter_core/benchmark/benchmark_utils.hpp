@@ -0,0 +1,171 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file benchmark_utils.hpp
+ *
+ * Harness shared by the DDS Router benchmarks.
+ *
+ * The benchmarks are only built with CMake option \c BUILD_BENCHMARKS .
+ * Their parameters are kept small so they finish in a few seconds. Increase them to get more stable measures.
+ */
+
+#ifndef _TEST_BLACKBOX_DDSROUTERCORE_BENCHMARK_BENCHMARK_UTILS_HPP_
+#define _TEST_BLACKBOX_DDSROUTERCORE_BENCHMARK_BENCHMARK_UTILS_HPP_
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+#include <test_utils.hpp>
+
+#include <ddsrouter/core/DDSRouter.hpp>
+#include <ddsrouter/participant/implementations/auxiliar/DummyParticipant.hpp>
+#include <ddsrouter/types/configuration_tags.hpp>
+#include <ddsrouter/types/RawConfiguration.hpp>
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+//! Index of the participant that receives the data published in a benchmark
+constexpr const unsigned int BENCHMARK_SOURCE_PARTICIPANT = 0;
+
+//! Index of the participant whose sent data is checked in a benchmark
+constexpr const unsigned int BENCHMARK_TARGET_PARTICIPANT = 1;
+
+//! Topic used by a benchmark with index \c i
+inline RealTopic benchmark_topic(
+        unsigned int i = 0)
+{
+    return RealTopic("benchmark_topic_" + std::to_string(i), "benchmark_type");
+}
+
+//! Id of the participant used by a benchmark with index \c i
+inline ParticipantId benchmark_participant(
+        unsigned int i)
+{
+    return ParticipantId("participant_" + std::to_string(i));
+}
+
+/**
+ * @brief Configuration with \c n_participants dummy participants and \c n_topics benchmark topics
+ *
+ * The specs of the DDS Router are left unset, so each benchmark sets the ones it measures.
+ *
+ * @param n_topics : number of topics in the allowlist
+ * @param n_participants : number of dummy participants
+ * @param topic_specs : tags added to every topic of the allowlist
+ */
+inline RawConfiguration benchmark_configuration(
+        unsigned int n_topics,
+        unsigned int n_participants,
+        const RawConfiguration& topic_specs = RawConfiguration())
+{
+    RawConfiguration configuration;
+
+    for (unsigned int i = 0; i < n_topics; ++i)
+    {
+        RawConfiguration topic;
+        topic[TOPIC_NAME_TAG] = benchmark_topic(i).topic_name();
+        topic[TOPIC_TYPE_NAME_TAG] = benchmark_topic(i).topic_type();
+        for (const auto& spec : topic_specs)
+        {
+            topic[spec.first.as<std::string>()] = spec.second;
+        }
+        configuration[ALLOWLIST_TAG].push_back(topic);
+    }
+
+    for (unsigned int i = 0; i < n_participants; ++i)
+    {
+        configuration[benchmark_participant(i).id_name()][PARTICIPANT_TYPE_TAG] = "dummy";
+    }
+
+    return configuration;
+}
+
+/**
+ * @brief Send \c n_messages in each of the first \c n_topics benchmark topics from the source participant to the
+ * target one, and measure the throughput
+ *
+ * Each topic is published from a different thread, simulating independent remote publishers.
+ *
+ * @param configuration : configuration of the DDS Router, with the source and target participants and the topics
+ * @param n_topics : number of topics published
+ * @param n_messages : messages published in each topic
+ * @param payload_size : size of each message
+ *
+ * @return messages per second forwarded by the DDS Router
+ */
+inline double forwarded_messages_per_second(
+        const RawConfiguration& configuration,
+        unsigned int n_topics,
+        uint16_t n_messages,
+        unsigned int payload_size)
+{
+    DDSRouter router(configuration);
+    router.start();
+
+    DummyParticipant* source = DummyParticipant::get_participant(benchmark_participant(BENCHMARK_SOURCE_PARTICIPANT));
+    DummyParticipant* target = DummyParticipant::get_participant(benchmark_participant(BENCHMARK_TARGET_PARTICIPANT));
+
+    DummyDataReceived data;
+    data.source_guid = random_guid();
+    data.payload = std::vector<PayloadUnit>(payload_size, 0xAA);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> publishers;
+    for (unsigned int i = 0; i < n_topics; ++i)
+    {
+        publishers.emplace_back(
+            [source, &data, i, n_messages]()
+            {
+                for (uint16_t j = 0; j < n_messages; ++j)
+                {
+                    source->simulate_data_reception(benchmark_topic(i), data);
+                }
+            });
+    }
+
+    for (std::thread& publisher : publishers)
+    {
+        publisher.join();
+    }
+
+    for (unsigned int i = 0; i < n_topics; ++i)
+    {
+        target->wait_until_n_data_sent(benchmark_topic(i), n_messages);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (unsigned int i = 0; i < n_topics; ++i)
+    {
+        EXPECT_EQ(target->get_data_that_should_have_been_sent(benchmark_topic(i)).size(), n_messages);
+    }
+
+    router.stop();
+
+    return (n_topics * n_messages) / elapsed.count();
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+#endif /* _TEST_BLACKBOX_DDSROUTERCORE_BENCHMARK_BENCHMARK_UTILS_HPP_ */
@@ -0,0 +1,117 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/communication/payload_pool/PayloadPoolFactory.hpp>
+
+using namespace eprosima::ddsrouter;
+
+/*
+ * Benchmark parameters.
+ * Samples of a type with a large max size but small typical length, kept alive as a Writer history would.
+ */
+constexpr const unsigned int BENCHMARK_NUMBER_SAMPLES = 1000;
+constexpr const uint32_t BENCHMARK_MAX_SIZE = 64 * 1024;
+constexpr const uint32_t BENCHMARK_MIN_LENGTH = 64;
+constexpr const uint32_t BENCHMARK_MAX_LENGTH = 1024;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+/**
+ * @brief Copy \c BENCHMARK_NUMBER_SAMPLES payloads not owned by any pool, as Fast DDS does with the data received,
+ * into a pool with the given copy size, and keep them all.
+ *
+ * @return bytes reserved by the pool to keep every sample
+ */
+uint64_t reserved_bytes(
+        PayloadCopySize copy_size)
+{
+    PayloadPoolConfiguration configuration;
+    configuration.copy_size = copy_size;
+    std::shared_ptr<PayloadPool> pool = PayloadPoolFactory::create_payload_pool(configuration);
+
+    // Same lengths for every copy size
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<uint32_t> length_distribution(BENCHMARK_MIN_LENGTH, BENCHMARK_MAX_LENGTH);
+
+    Payload src_payload;
+    src_payload.reserve(BENCHMARK_MAX_SIZE);
+    std::fill(src_payload.data, src_payload.data + BENCHMARK_MAX_SIZE, 0xAA);
+
+    std::vector<Payload> payloads(BENCHMARK_NUMBER_SAMPLES);
+    uint64_t bytes = 0;
+
+    for (Payload& payload : payloads)
+    {
+        src_payload.length = length_distribution(generator);
+        eprosima::fastrtps::rtps::IPayloadPool* data_owner = nullptr;
+
+        EXPECT_TRUE(pool->get_payload(src_payload, data_owner, payload));
+        EXPECT_EQ(payload.length, src_payload.length);
+        EXPECT_GE(payload.max_size, payload.length);
+
+        bytes += payload.max_size;
+    }
+
+    for (Payload& payload : payloads)
+    {
+        pool->release_payload(payload);
+    }
+    EXPECT_TRUE(pool->is_clean());
+
+    return bytes;
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Measure the memory reserved to keep samples copied from outside the pool with each copy size.
+ */
+TEST(CopySizeBenchmarkTest, copy_memory)
+{
+    std::cout << std::setw(20) << "copy size" << std::setw(20) << "KiB reserved" << std::setw(20)
+              << "vs max-size" << std::endl;
+
+    uint64_t max_size_bytes = test::reserved_bytes(PayloadCopySize::COPY_MAX_SIZE);
+
+    for (PayloadCopySize copy_size :
+            {PayloadCopySize::COPY_MAX_SIZE, PayloadCopySize::COPY_LENGTH, PayloadCopySize::COPY_SIZE_CLASS})
+    {
+        uint64_t bytes = test::reserved_bytes(copy_size);
+        std::cout << std::setw(20) << copy_size << std::setw(20) << bytes / 1024 << std::setw(19)
+                  << std::fixed << std::setprecision(1) << 100.0 * bytes / max_size_bytes << "%" << std::endl;
+
+        EXPECT_LE(bytes, max_size_bytes);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,226 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/dynamic/DiscoveryDatabase.hpp>
+#include <ddsrouter/types/endpoint/Endpoint.hpp>
+#include <ddsrouter/types/endpoint/QoS.hpp>
+
+using namespace eprosima::ddsrouter;
+
+/*
+ * Benchmark parameters.
+ * The endpoints are spread evenly among the topics, half of them Readers and half Writers.
+ * The queries of the linear scan are few so the benchmark can run as part of the test suite.
+ */
+constexpr const uint32_t BENCHMARK_NUMBER_ENDPOINTS = 100000;
+constexpr const uint32_t BENCHMARK_NUMBER_TOPICS = 1000;
+constexpr const uint32_t BENCHMARK_NUMBER_QUERIES = 100;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+//! Topic with index \c i
+RealTopic benchmark_topic(
+        uint32_t i)
+{
+    return RealTopic("rt/session_" + std::to_string(i) + "/benchmark_topic", "benchmark_type");
+}
+
+//! Endpoint with index \c i , in topic \c i % BENCHMARK_NUMBER_TOPICS
+Endpoint benchmark_endpoint(
+        uint32_t i)
+{
+    Guid guid;
+    guid.guidPrefix.value[0] = 0x01;
+    guid.guidPrefix.value[1] = 0x0f;
+    for (unsigned int byte = 0; byte < 4; ++byte)
+    {
+        guid.entityId.value[byte] = static_cast<fastrtps::rtps::octet>(i >> (8 * (3 - byte)));
+    }
+
+    return Endpoint(
+        i % 2 ? EndpointKind::WRITER : EndpointKind::READER,
+        guid,
+        QoS(),
+        benchmark_topic(i % BENCHMARK_NUMBER_TOPICS));
+}
+
+/**
+ * @brief Whether \c topic exists going through every endpoint
+ *
+ * This is how the database looked up a topic before it was indexed by topic.
+ */
+bool scan_topic_exists(
+        const std::map<Guid, Endpoint>& entities,
+        const RealTopic& topic)
+{
+    for (auto entity : entities)
+    {
+        if (entity.second.topic() == topic)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! Endpoints of \c topic going through every endpoint
+std::vector<Endpoint> scan_topic_endpoints(
+        const std::map<Guid, Endpoint>& entities,
+        const RealTopic& topic)
+{
+    std::vector<Endpoint> endpoints;
+    for (const auto& entity : entities)
+    {
+        if (entity.second.topic() == topic)
+        {
+            endpoints.push_back(entity.second);
+        }
+    }
+    return endpoints;
+}
+
+/**
+ * @brief Average time in microseconds of \c query over \c BENCHMARK_NUMBER_QUERIES topics
+ *
+ * @param query : query to measure
+ * @param first_topic : index of the first topic queried. Topics from \c BENCHMARK_NUMBER_TOPICS have no endpoints
+ */
+template <typename Query>
+double query_time_us(
+        Query query,
+        uint32_t first_topic = 0)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCHMARK_NUMBER_QUERIES; ++i)
+    {
+        query(benchmark_topic(first_topic + i * (BENCHMARK_NUMBER_TOPICS / BENCHMARK_NUMBER_QUERIES)));
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCHMARK_NUMBER_QUERIES;
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Measure the time to look up the topics of a database with \c BENCHMARK_NUMBER_ENDPOINTS endpoints, using the
+ * topic index and going through every endpoint.
+ */
+TEST(DiscoveryDatabaseBenchmarkTest, topic_queries)
+{
+    DiscoveryDatabase discovery_database;
+    std::map<Guid, Endpoint> entities;
+
+    unsigned int notified = 0;
+    uint64_t callback_id = discovery_database.register_endpoint_callback(
+        [&notified](DatabaseOperation, const Endpoint&)
+        {
+            notified++;
+        });
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCHMARK_NUMBER_ENDPOINTS; ++i)
+    {
+        Endpoint endpoint = test::benchmark_endpoint(i);
+        discovery_database.add_endpoint(endpoint);
+        entities.emplace(endpoint.guid(), endpoint);
+    }
+    std::chrono::duration<double, std::milli> insertion = std::chrono::steady_clock::now() - start;
+
+    discovery_database.unregister_endpoint_callback(callback_id);
+    ASSERT_EQ(notified, BENCHMARK_NUMBER_ENDPOINTS);
+
+    // Results must not depend on the lookup
+    bool results_match = true;
+
+    double indexed_exists = test::query_time_us(
+        [&](const RealTopic& topic)
+        {
+            results_match &= discovery_database.topic_exists(topic);
+        });
+    double scan_exists = test::query_time_us(
+        [&](const RealTopic& topic)
+        {
+            results_match &= test::scan_topic_exists(entities, topic);
+        });
+
+    double indexed_absent = test::query_time_us(
+        [&](const RealTopic& topic)
+        {
+            results_match &= !discovery_database.topic_exists(topic);
+        },
+        BENCHMARK_NUMBER_TOPICS);
+    double scan_absent = test::query_time_us(
+        [&](const RealTopic& topic)
+        {
+            results_match &= !test::scan_topic_exists(entities, topic);
+        },
+        BENCHMARK_NUMBER_TOPICS);
+
+    double indexed_endpoints = test::query_time_us(
+        [&](const RealTopic& topic)
+        {
+            results_match &= discovery_database.topic_endpoints(topic).size() ==
+            BENCHMARK_NUMBER_ENDPOINTS / BENCHMARK_NUMBER_TOPICS;
+        });
+    double scan_endpoints = test::query_time_us(
+        [&](const RealTopic& topic)
+        {
+            results_match &= test::scan_topic_endpoints(entities, topic).size() ==
+            BENCHMARK_NUMBER_ENDPOINTS / BENCHMARK_NUMBER_TOPICS;
+        });
+
+    double indexed_count = test::query_time_us(
+        [&](const RealTopic& topic)
+        {
+            TopicEndpointsCount count = discovery_database.topic_endpoints_count(topic);
+            results_match &= count.readers + count.writers == BENCHMARK_NUMBER_ENDPOINTS / BENCHMARK_NUMBER_TOPICS;
+        });
+
+    std::cout << BENCHMARK_NUMBER_ENDPOINTS << " endpoints in " << BENCHMARK_NUMBER_TOPICS << " topics inserted in "
+              << std::fixed << std::setprecision(1) << insertion.count() << " ms" << std::endl;
+    std::cout << std::setw(25) << "query" << std::setw(20) << "indexed us" << std::setw(20) << "scan us"
+              << std::endl;
+    std::cout << std::setw(25) << "topic_exists" << std::setw(20) << indexed_exists << std::setw(20)
+              << scan_exists << std::endl;
+    std::cout << std::setw(25) << "topic_exists (absent)" << std::setw(20) << indexed_absent << std::setw(20)
+              << scan_absent << std::endl;
+    std::cout << std::setw(25) << "topic_endpoints" << std::setw(20) << indexed_endpoints << std::setw(20)
+              << scan_endpoints << std::endl;
+    std::cout << std::setw(25) << "topic_endpoints_count" << std::setw(20) << indexed_count << std::setw(20)
+              << "-" << std::endl;
+
+    ASSERT_TRUE(results_match);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include <benchmark_utils.hpp>
+
+using namespace eprosima::ddsrouter;
+
+/*
+ * Benchmark parameters.
+ */
+constexpr const unsigned int BENCHMARK_MAX_PARTICIPANTS = 16;
+constexpr const uint16_t BENCHMARK_NUMBER_MESSAGES = 200;
+constexpr const unsigned int BENCHMARK_PAYLOAD_SIZE = 1024;
+constexpr const unsigned int BENCHMARK_NUMBER_THREADS = 4;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+/**
+ * @brief Send \c BENCHMARK_NUMBER_MESSAGES one by one and measure the time till every other participant sends it
+ *
+ * Each message is sent once the previous one has arrived to every participant, so the measure is the forwarding
+ * latency of a single sample and not the throughput.
+ *
+ * @return average forwarding latency in microseconds
+ */
+double forwarding_latency_us(
+        unsigned int n_participants,
+        bool parallel_fanout)
+{
+    RawConfiguration topic_specs;
+    topic_specs[TOPIC_PARALLEL_FANOUT_TAG] = parallel_fanout;
+    RawConfiguration configuration = benchmark_configuration(1, n_participants, topic_specs);
+    configuration[SPECS_TAG][NUMBER_THREADS_TAG] = BENCHMARK_NUMBER_THREADS;
+
+    DDSRouter router(configuration);
+    router.start();
+
+    DummyParticipant* source = DummyParticipant::get_participant(benchmark_participant(BENCHMARK_SOURCE_PARTICIPANT));
+    std::vector<DummyParticipant*> targets;
+    for (unsigned int i = BENCHMARK_SOURCE_PARTICIPANT + 1; i < n_participants; ++i)
+    {
+        targets.push_back(DummyParticipant::get_participant(benchmark_participant(i)));
+    }
+
+    DummyDataReceived data;
+    data.source_guid = random_guid();
+    data.payload = std::vector<PayloadUnit>(BENCHMARK_PAYLOAD_SIZE, 0xAA);
+
+    std::chrono::duration<double, std::micro> elapsed(0);
+
+    for (uint16_t j = 1; j <= BENCHMARK_NUMBER_MESSAGES; ++j)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        source->simulate_data_reception(benchmark_topic(), data);
+        for (DummyParticipant* target : targets)
+        {
+            target->wait_until_n_data_sent(benchmark_topic(), j);
+        }
+
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+
+    for (DummyParticipant* target : targets)
+    {
+        EXPECT_EQ(target->get_data_that_should_have_been_sent(benchmark_topic()).size(), BENCHMARK_NUMBER_MESSAGES);
+    }
+
+    router.stop();
+
+    return elapsed.count() / BENCHMARK_NUMBER_MESSAGES;
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Measure the forwarding latency of a sample when the number of participants grows from 2 to
+ * \c BENCHMARK_MAX_PARTICIPANTS , writing every participant sequentially and in parallel.
+ */
+TEST(FanoutBenchmarkTest, fanout_latency)
+{
+    std::cout << std::setw(20) << "participants" << std::setw(20) << "sequential us" << std::setw(20)
+              << "parallel us" << std::endl;
+
+    for (unsigned int n_participants = 2; n_participants <= BENCHMARK_MAX_PARTICIPANTS; n_participants *= 2)
+    {
+        double sequential = test::forwarding_latency_us(n_participants, false);
+        double parallel = test::forwarding_latency_us(n_participants, true);
+        std::cout << std::setw(20) << n_participants << std::setw(20) << std::fixed << std::setprecision(1)
+                  << sequential << std::setw(20) << parallel << std::endl;
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
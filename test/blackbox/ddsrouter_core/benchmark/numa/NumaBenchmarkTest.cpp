@@ -0,0 +1,188 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark_utils.hpp>
+
+#include <ddsrouter/types/numa.hpp>
+
+using namespace eprosima::ddsrouter;
+
+/*
+ * Benchmark parameters.
+ * A source participant in node 0 forwards large samples to writer participants in node 1 (or in node 0 if the host
+ * has a single node), each of them sending every sample to several remote readers, so the data is read once per
+ * reader from the memory it is in.
+ */
+constexpr const uint16_t BENCHMARK_NUMBER_MESSAGES = 200;
+constexpr const unsigned int BENCHMARK_PAYLOAD_SIZE = 64 * 1024;
+constexpr const unsigned int BENCHMARK_NUMBER_WRITERS = 4;
+constexpr const unsigned int BENCHMARK_READERS_PER_WRITER = 8;
+constexpr const unsigned int BENCHMARK_ARENA_SIZE = 32 * 1024 * 1024;
+
+constexpr const int BENCHMARK_SOURCE_NODE = 0;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+//! Placement of the data sent by the writer participants
+struct NumaBenchmarkResult
+{
+    //! Payloads sent from memory of the node of their writer participant
+    uint64_t local_payloads = 0;
+
+    //! Payloads sent from memory of other node, or whose node could not be checked
+    uint64_t remote_payloads = 0;
+
+    //! Bytes the remote readers would read from memory of a node different than the one of the writer participant
+    uint64_t cross_node_bytes = 0;
+
+    //! Time elapsed forwarding every sample
+    std::chrono::duration<double, std::milli> elapsed {0};
+};
+
+//! Node of the writer participants: other than the source one if the host has it
+int writers_node()
+{
+    return numa::number_of_nodes() > 1 ? 1 : BENCHMARK_SOURCE_NODE;
+}
+
+/**
+ * @brief Forward \c BENCHMARK_NUMBER_MESSAGES samples through a DDS Router with its participants placed in NUMA nodes
+ *
+ * The source participant is placed in \c BENCHMARK_SOURCE_NODE and the rest in \c writers_node , so each node has
+ * its own payload pool of kind \c pool_type .
+ * The thread simulating the reception is bound to the source node, as the router binds the receive threads of a
+ * participant to its node.
+ * The node of each payload sent is the one \c numa::node_of_address reports for the memory the writer has got from
+ * its pool.
+ */
+NumaBenchmarkResult forward_samples(
+        const std::string& pool_type)
+{
+    RawConfiguration configuration = benchmark_configuration(1, BENCHMARK_NUMBER_WRITERS + 1);
+    configuration[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = pool_type;
+    configuration[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_ARENA_SIZE_TAG] = BENCHMARK_ARENA_SIZE;
+    configuration[benchmark_participant(BENCHMARK_SOURCE_PARTICIPANT).id_name()][PARTICIPANT_NUMA_NODE_TAG] =
+            BENCHMARK_SOURCE_NODE;
+    for (unsigned int i = BENCHMARK_SOURCE_PARTICIPANT + 1; i <= BENCHMARK_NUMBER_WRITERS; ++i)
+    {
+        configuration[benchmark_participant(i).id_name()][PARTICIPANT_NUMA_NODE_TAG] = writers_node();
+    }
+
+    DDSRouter router(configuration);
+    router.start();
+
+    DummyParticipant* source = DummyParticipant::get_participant(benchmark_participant(BENCHMARK_SOURCE_PARTICIPANT));
+
+    DummyDataReceived data;
+    data.source_guid = random_guid();
+    data.payload = std::vector<PayloadUnit>(BENCHMARK_PAYLOAD_SIZE, 0xAA);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread receive_thread(
+        [source, &data]()
+        {
+            if (static_cast<unsigned int>(BENCHMARK_SOURCE_NODE) < numa::number_of_nodes())
+            {
+                numa::bind_thread_to_node(BENCHMARK_SOURCE_NODE);
+            }
+            for (uint16_t j = 0; j < BENCHMARK_NUMBER_MESSAGES; ++j)
+            {
+                source->simulate_data_reception(benchmark_topic(), data);
+            }
+        });
+    receive_thread.join();
+
+    NumaBenchmarkResult result;
+
+    for (unsigned int i = BENCHMARK_SOURCE_PARTICIPANT + 1; i <= BENCHMARK_NUMBER_WRITERS; ++i)
+    {
+        DummyParticipant* target = DummyParticipant::get_participant(benchmark_participant(i));
+        target->wait_until_n_data_sent(benchmark_topic(), BENCHMARK_NUMBER_MESSAGES);
+
+        for (const DummyDataStored& sample : target->get_data_that_should_have_been_sent(benchmark_topic()))
+        {
+            EXPECT_EQ(sample.payload.size(), BENCHMARK_PAYLOAD_SIZE);
+
+            if (sample.numa_node == writers_node())
+            {
+                result.local_payloads++;
+            }
+            else
+            {
+                result.remote_payloads++;
+                result.cross_node_bytes += sample.payload.size() * BENCHMARK_READERS_PER_WRITER;
+            }
+        }
+    }
+
+    result.elapsed = std::chrono::steady_clock::now() - start;
+
+    router.stop();
+
+    return result;
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Measure where the data sent by participants of a NUMA node are, with the heap pool and the arena pool per node.
+ *
+ * The arena of each node is bound to it, so every payload sent by the writer participants is in their node.
+ * The heap memory of the refcount pool is placed in the node of the thread that first touches it, which is any thread
+ * of the DDS Router thread pool, so part of the data may be read across nodes.
+ * In hosts with a single node every participant is placed in it, so no data crosses nodes.
+ */
+TEST(NumaBenchmarkTest, cross_node_traffic)
+{
+    std::cout << "NUMA nodes: " << numa::number_of_nodes() << std::endl;
+    std::cout << std::setw(20) << "payload pools" << std::setw(20) << "local payloads" << std::setw(20)
+              << "remote payloads" << std::setw(20) << "cross node MB" << std::setw(20) << "ms" << std::endl;
+
+    test::NumaBenchmarkResult refcount = test::forward_samples(PAYLOAD_POOL_REFCOUNT_TAG);
+    test::NumaBenchmarkResult arena = test::forward_samples(PAYLOAD_POOL_ARENA_TAG);
+
+    for (const auto& result : {std::make_pair(PAYLOAD_POOL_REFCOUNT_TAG, refcount),
+                               std::make_pair(PAYLOAD_POOL_ARENA_TAG, arena)})
+    {
+        std::cout << std::setw(20) << result.first << std::setw(20) << result.second.local_payloads
+                  << std::setw(20) << result.second.remote_payloads << std::setw(20)
+                  << (result.second.cross_node_bytes >> 20) << std::setw(20) << std::fixed << std::setprecision(1)
+                  << result.second.elapsed.count() << std::endl;
+    }
+
+    // Every payload has been checked, and the ones of the arena bound to the node of the writers are in it
+    EXPECT_EQ(refcount.local_payloads + refcount.remote_payloads, BENCHMARK_NUMBER_WRITERS * BENCHMARK_NUMBER_MESSAGES);
+    EXPECT_EQ(arena.local_payloads, BENCHMARK_NUMBER_WRITERS * BENCHMARK_NUMBER_MESSAGES);
+    EXPECT_EQ(arena.cross_node_bytes, 0u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,91 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <benchmark_utils.hpp>
+
+using namespace eprosima::ddsrouter;
+
+/*
+ * Benchmark parameters.
+ * Small samples, as heartbeats or IMU readings, forwarded through a single Track.
+ */
+constexpr const uint16_t BENCHMARK_NUMBER_MESSAGES = 20000;
+constexpr const unsigned int BENCHMARK_PAYLOAD_SIZE = 32;
+constexpr const unsigned int BENCHMARK_SMALL_PAYLOAD_SIZE = 64;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+/**
+ * @brief Forward small samples from one participant to the other with the payload pool \c pool_type
+ *
+ * Every sample is reserved in the payload pool by the source Reader and released once the target Writer has sent it.
+ *
+ * @param pool_type : value of the payload pool type tag
+ * @param small_payloads : whether to reserve small data from the free list of the pool
+ *
+ * @return messages per second forwarded by the DDS Router
+ */
+double small_payload_messages_per_second(
+        const std::string& pool_type,
+        bool small_payloads)
+{
+    RawConfiguration configuration = benchmark_configuration(1, 2);
+    configuration[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = pool_type;
+    if (small_payloads)
+    {
+        configuration[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_SMALL_PAYLOAD_SIZE_TAG] = BENCHMARK_SMALL_PAYLOAD_SIZE;
+    }
+
+    return forwarded_messages_per_second(configuration, 1, BENCHMARK_NUMBER_MESSAGES, BENCHMARK_PAYLOAD_SIZE);
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Measure the throughput of small samples forwarded through a Track with each payload pool, with and without
+ * the free list of small data.
+ */
+TEST(SmallPayloadBenchmarkTest, small_payload_throughput)
+{
+    std::cout << std::setw(20) << "payload pool" << std::setw(20) << "msg/s" << std::setw(20)
+              << "small payloads msg/s" << std::endl;
+
+    uint64_t map_throughput = test::small_payload_messages_per_second(PAYLOAD_POOL_MAP_TAG, false);
+    std::cout << std::setw(20) << PAYLOAD_POOL_MAP_TAG << std::setw(20) << map_throughput << std::setw(20) << "-"
+              << std::endl;
+
+    for (const char* pool_type : {PAYLOAD_POOL_REFCOUNT_TAG, PAYLOAD_POOL_SLAB_TAG})
+    {
+        uint64_t throughput = test::small_payload_messages_per_second(pool_type, false);
+        uint64_t small_payloads_throughput = test::small_payload_messages_per_second(pool_type, true);
+        std::cout << std::setw(20) << pool_type << std::setw(20) << throughput << std::setw(20)
+                  << small_payloads_throughput << std::endl;
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
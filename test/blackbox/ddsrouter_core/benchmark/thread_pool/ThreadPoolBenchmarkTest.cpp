@@ -0,0 +1,86 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <benchmark_utils.hpp>
+
+using namespace eprosima::ddsrouter;
+
+/*
+ * Benchmark parameters.
+ */
+constexpr const unsigned int BENCHMARK_NUMBER_TOPICS = 16;
+constexpr const uint16_t BENCHMARK_NUMBER_MESSAGES = 2000;
+constexpr const unsigned int BENCHMARK_PAYLOAD_SIZE = 64;
+constexpr const unsigned int BENCHMARK_NUMBER_PARTICIPANTS = 2;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+/**
+ * @brief Forward every benchmark topic from one participant to the other
+ *
+ * @param n_threads threads of the thread pool
+ * @param thread_per_track whether every Track runs in its own thread instead of in the pool
+ *
+ * @return messages per second forwarded by the DDS Router
+ */
+double thread_pool_messages_per_second(
+        unsigned int n_threads,
+        bool thread_per_track = false)
+{
+    RawConfiguration configuration = benchmark_configuration(BENCHMARK_NUMBER_TOPICS, BENCHMARK_NUMBER_PARTICIPANTS);
+    configuration[SPECS_TAG][NUMBER_THREADS_TAG] = n_threads;
+    configuration[SPECS_TAG][THREAD_PER_TRACK_TAG] = thread_per_track;
+
+    return forwarded_messages_per_second(
+        configuration, BENCHMARK_NUMBER_TOPICS, BENCHMARK_NUMBER_MESSAGES, BENCHMARK_PAYLOAD_SIZE);
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Measure the throughput of the DDS Router when the size of the thread pool grows from 1 to the number of cores.
+ *
+ * The result is compared with the former model, where every Track had its own thread.
+ */
+TEST(ThreadPoolBenchmarkTest, thread_pool_scaling)
+{
+    unsigned int max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << std::setw(20) << "threads" << std::setw(20) << "msg/s" << std::endl;
+
+    for (unsigned int n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+    {
+        uint64_t throughput = test::thread_pool_messages_per_second(n_threads);
+        std::cout << std::setw(20) << n_threads << std::setw(20) << throughput << std::endl;
+    }
+
+    uint64_t throughput = test::thread_pool_messages_per_second(1, true);
+    std::cout << std::setw(20) << "thread per Track" << std::setw(20) << throughput << std::endl;
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -21,6 +21,7 @@
 #include <TestLogHandler.hpp>
 
 #include <ddsrouter/core/DDSRouter.hpp>
+#include <ddsrouter/types/configuration_tags.hpp>
 #include <ddsrouter/types/Log.hpp>
 #include <ddsrouter/types/RawConfiguration.hpp>
 
@@ -30,15 +31,20 @@ using namespace eprosima::ddsrouter;
 
 constexpr const uint32_t SAMPLES_TO_RECEIVE = 5;
 constexpr const uint32_t MILLISECONDS_PUBLISH_LOOP = 100;
+constexpr const uint32_t MILLISECONDS_BRIDGE_IDLE_TIMEOUT = 500;
+constexpr const uint32_t MILLISECONDS_WAIT_IDLE_BRIDGES = 10000;
 
 /**
  * Test communication between two DDS Participants hosted in the same device, but which are at different DDS domains.
  * This is accomplished by connecting two WAN Participants belonging to different DDS Router instances. These router
  * instances communicate with the DDS Participants through Simple Participants deployed at those domains.
+ *
+ * With \c interest_driven , both routers create their Bridges and endpoints on demand.
  */
 void test_WAN_communication(
         std::string server_config_path,
-        std::string client_config_path)
+        std::string client_config_path,
+        bool interest_driven = false)
 {
     // Check there are no warnings/errors
     // TODO: Uncomment when having no listening addresses is no longer considered an error by the middleware
@@ -69,6 +75,12 @@ void test_WAN_communication(
     RawConfiguration client_router_configuration =
             load_configuration_from_file(client_config_path);
 
+    if (interest_driven)
+    {
+        server_router_configuration[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG] = true;
+        client_router_configuration[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG] = true;
+    }
+
     // Create DDSRouter entity whose WAN Participant is configured as server
     DDSRouter server_router(server_router_configuration);
     server_router.start();
@@ -178,6 +190,85 @@ TEST(DDSTestWAN, end_to_end_WAN_communication_TLSv6)
     test_WAN_communication_all("../../resources/configurations/dds/WAN/TLS/IPv6/", true);
 }
 
+/**
+ * Test communication in HelloWorld topic between two DDS participants created in different domains,
+ * by using two routers with interest driven endpoints, connected through UDPv4.
+ * The WAN Participants keep their endpoints, so each router discovers the endpoints of the other one.
+ */
+TEST(DDSTestWAN, end_to_end_WAN_communication_interest_driven)
+{
+    test_WAN_communication(
+        "../../resources/configurations/dds/WAN/UDP/IPv4/server.yaml",
+        "../../resources/configurations/dds/WAN/UDP/IPv4/client.yaml",
+        true);
+}
+
+/**
+ * Test the Bridges of two routers connected through UDPv4 WAN Participants are destroyed once the applications of a
+ * topic leave, even if each router still has the WAN endpoints of the other one in the topic.
+ *
+ * STEPS:
+ *  A publisher and a subscriber in different domains communicate through both routers
+ *  Both of them leave
+ *  The Bridge of the topic in both routers is destroyed after the idle timeout
+ */
+TEST(DDSTestWAN, end_to_end_WAN_idle_bridges)
+{
+    RealTopic topic("HelloWorldTopic", "HelloWorld");
+
+    RawConfiguration server_router_configuration =
+            load_configuration_from_file("../../resources/configurations/dds/WAN/UDP/IPv4/server.yaml");
+    RawConfiguration client_router_configuration =
+            load_configuration_from_file("../../resources/configurations/dds/WAN/UDP/IPv4/client.yaml");
+
+    server_router_configuration[SPECS_TAG][BRIDGE_IDLE_TIMEOUT_TAG] = MILLISECONDS_BRIDGE_IDLE_TIMEOUT;
+    client_router_configuration[SPECS_TAG][BRIDGE_IDLE_TIMEOUT_TAG] = MILLISECONDS_BRIDGE_IDLE_TIMEOUT;
+
+    DDSRouter server_router(server_router_configuration);
+    server_router.start();
+
+    DDSRouter client_router(client_router_configuration);
+    client_router.start();
+
+    {
+        uint32_t samples_sent = 0;
+        std::atomic<uint32_t> samples_received(0);
+
+        HelloWorld msg;
+        msg.message("Testing DDS-Router Blackbox WAN...");
+
+        // Create DDS Publisher in domain 0 and DDS Subscriber in domain 1
+        HelloWorldPublisher<HelloWorld> publisher;
+        ASSERT_TRUE(publisher.init(0));
+
+        HelloWorldSubscriber<HelloWorld> subscriber;
+        ASSERT_TRUE(subscriber.init(1, &msg, &samples_received));
+
+        while (samples_received.load() < SAMPLES_TO_RECEIVE)
+        {
+            msg.index(++samples_sent);
+            publisher.publish(msg);
+            std::this_thread::sleep_for(std::chrono::milliseconds(MILLISECONDS_PUBLISH_LOOP));
+        }
+
+        ASSERT_FALSE(server_router.tracks_statistics(topic).empty());
+        ASSERT_FALSE(client_router.tracks_statistics(topic).empty());
+
+        // Publisher and subscriber leave
+    }
+
+    // Once the applications leave, only the endpoints of the other router remain, which do not keep the Bridges
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(MILLISECONDS_WAIT_IDLE_BRIDGES);
+    while (!server_router.tracks_statistics(topic).empty() || !client_router.tracks_statistics(topic).empty())
+    {
+        ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(MILLISECONDS_PUBLISH_LOOP));
+    }
+
+    client_router.stop();
+    server_router.stop();
+}
+
 int main(
         int argc,
         char** argv)
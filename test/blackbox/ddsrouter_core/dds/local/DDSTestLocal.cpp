@@ -175,6 +175,50 @@ TEST(DDSTestLocal, end_to_end_local_communication_high_throughput)
         1000); // 50K message size
 }
 
+/**
+ * Test a TRANSIENT_LOCAL subscriber that joins after the data has been forwarded receives it, as the Writer of the
+ * router keeps the data in its history even while it has no readers.
+ */
+TEST(DDSTestLocal, end_to_end_local_communication_late_joiner)
+{
+    test::TestLogHandler test_log_handler(Log::Kind::Error);
+
+    std::atomic<uint32_t> samples_received(0);
+
+    HelloWorld msg;
+    msg.message("Testing DDSRouter Blackbox Local Communication ...");
+
+    // Create DDS Publisher in domain 0
+    HelloWorldPublisher<HelloWorld> publisher;
+    ASSERT_TRUE(publisher.init(0));
+
+    // Create DDSRouter entity, with no subscriber in domain 1 yet
+    RawConfiguration router_configuration =
+            load_configuration_from_file("../../resources/configurations/dds/local/dds_test_simple_configuration.yaml");
+    DDSRouter router(router_configuration);
+    router.start();
+
+    // Publish while the Reader of the router matches the publisher, so some data is forwarded without readers
+    for (uint32_t i = 1; i <= DEFAULT_SAMPLES_TO_RECEIVE; ++i)
+    {
+        msg.index(i);
+        publisher.publish(msg);
+        std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_MILLISECONDS_PUBLISH_LOOP));
+    }
+
+    // Create the late joiner DDS Subscriber in domain 1 once nothing else is published
+    HelloWorldSubscriber<HelloWorld> subscriber;
+    ASSERT_TRUE(subscriber.init(1, &msg, &samples_received, true));
+
+    for (uint32_t i = 0; i < 50 && samples_received.load() == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_MILLISECONDS_PUBLISH_LOOP));
+    }
+    ASSERT_GT(samples_received.load(), 0u);
+
+    router.stop();
+}
+
 int main(
         int argc,
         char** argv)
@@ -206,11 +206,17 @@ public:
         }
     }
 
-    //! Initialize the subscriber
+    /**
+     * @brief Initialize the subscriber
+     *
+     * @param transient_local whether the reader is reliable and TRANSIENT_LOCAL, so it receives the data sent before
+     * it matched
+     */
     bool init(
             uint32_t domain,
             MsgStruct* msg_should_receive,
-            std::atomic<uint32_t>* samples_received)
+            std::atomic<uint32_t>* samples_received,
+            bool transient_local = false)
     {
         // INITIALIZE THE LISTENER
         listener_.init(msg_should_receive, samples_received);
@@ -260,6 +266,11 @@ public:
         eprosima::fastdds::dds::DataReaderQos rqos =  eprosima::fastdds::dds::DATAREADER_QOS_DEFAULT;
         rqos.endpoint().history_memory_policy =
                 eprosima::fastrtps::rtps::MemoryManagementPolicy_t::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
+        if (transient_local)
+        {
+            rqos.durability().kind = eprosima::fastdds::dds::TRANSIENT_LOCAL_DURABILITY_QOS;
+            rqos.reliability().kind = eprosima::fastdds::dds::RELIABLE_RELIABILITY_QOS;
+        }
         reader_ = subscriber_->create_datareader(topic_, rqos, &listener_);
 
         if (reader_ == nullptr)
@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <thread>
 
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
@@ -21,6 +24,7 @@
 
 #include <ddsrouter/core/DDSRouter.hpp>
 #include <ddsrouter/participant/implementations/auxiliar/DummyParticipant.hpp>
+#include <ddsrouter/types/configuration_tags.hpp>
 #include <ddsrouter/types/Log.hpp>
 #include <ddsrouter/types/RawConfiguration.hpp>
 #include <ddsrouter/types/utils.hpp>
@@ -40,6 +44,43 @@ std::vector<PayloadUnit> random_payload(
     return payload;
 }
 
+//! Configuration with two dummy participants in NUMA nodes \c node_1 and \c node_2 , and \c topic
+RawConfiguration numa_configuration(
+        const RealTopic& topic,
+        int node_1,
+        int node_2,
+        bool zero_copy = false)
+{
+    RawConfiguration router_configuration;
+    RawConfiguration topic_configuration;
+    topic_configuration[TOPIC_NAME_TAG] = topic.topic_name();
+    topic_configuration[TOPIC_TYPE_NAME_TAG] = topic.topic_type();
+    topic_configuration[TOPIC_ZERO_COPY_TAG] = zero_copy;
+    router_configuration[ALLOWLIST_TAG].push_back(topic_configuration);
+    router_configuration["participant_1"][PARTICIPANT_TYPE_TAG] = "dummy";
+    router_configuration["participant_1"][PARTICIPANT_NUMA_NODE_TAG] = node_1;
+    router_configuration["participant_2"][PARTICIPANT_TYPE_TAG] = "dummy";
+    router_configuration["participant_2"][PARTICIPANT_NUMA_NODE_TAG] = node_2;
+    return router_configuration;
+}
+
+//! Wait until \c condition is true, for \c timeout_ms at most, and return whether it is
+bool wait_until(
+        std::function<bool()> condition,
+        unsigned int timeout_ms = 5000)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
 /**
  * Test Whole DDSRouter initialization by initializing two VoidParticipants
  */
@@ -106,6 +147,492 @@ TEST(TrivialTest, trivial_communication)
     ASSERT_EQ(data_received[0].source_guid, guid);
     ASSERT_EQ(data_received[0].payload, payload);
 
+    // Data has gone through the PayloadPool of the router
+    PayloadPoolStatistics statistics = router.payload_pool_statistics();
+    ASSERT_GE(statistics.reserved_payloads, 1u);
+    ASSERT_GE(statistics.max_reserved_bytes, payload.size());
+    ASSERT_EQ(statistics.size_histogram[PayloadPoolStatistics::size_bucket(payload.size())], 1u);
+
+    router.stop();
+}
+
+/**
+ * Test Whole DDSRouter interfaces with two DummyParticipants placed in different NUMA nodes
+ *
+ * Node 1 may not exist in the host, in which case the participant is not bound but still uses its own pool.
+ */
+TEST(TrivialTest, trivial_numa_communication)
+{
+    RealTopic topic("trivial_topic", "trivial_type");
+
+    // Create DDSRouter entity
+    DDSRouter router(numa_configuration(topic, 0, 1));
+    router.start();
+
+    DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+    DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+    std::vector<PayloadUnit> payload = random_payload(3);
+
+    DummyDataReceived data;
+    data.source_guid = test::random_guid();
+    data.payload = payload;
+
+    participant_1->simulate_data_reception(topic, data);
+    participant_2->wait_until_n_data_sent(topic, 1);
+
+    std::vector<DummyDataStored> data_received = participant_2->get_data_that_should_have_been_sent(topic);
+    ASSERT_EQ(1, data_received.size());
+    ASSERT_EQ(data_received[0].payload, payload);
+
+    // Statistics gather the pools of every node: the data received and its copy to be sent
+    PayloadPoolStatistics statistics = router.payload_pool_statistics();
+    ASSERT_GE(statistics.reserved_payloads, 2u);
+    ASSERT_EQ(statistics.size_histogram[PayloadPoolStatistics::size_bucket(payload.size())], 2u);
+
+    // The data is copied once to the pool of the node of the Writer.
+    // The Track accounts the payload once the Writer has it, so it may not be accounted yet
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return router.tracks_statistics(topic)[ParticipantId("participant_1")].copied_payloads > 0;
+            }));
+    std::map<ParticipantId, TrackStatistics> tracks_statistics = router.tracks_statistics(topic);
+    ASSERT_EQ(tracks_statistics[ParticipantId("participant_1")].copied_payloads, 1u);
+    ASSERT_EQ(tracks_statistics[ParticipantId("participant_1")].referenced_payloads, 0u);
+
+    router.stop();
+}
+
+/**
+ * Test data of a zero copy topic are forwarded referencing the payload, and that the topic is not forwarded if
+ * it would be copied
+ *
+ * CASES:
+ *  Participants sharing payload pool
+ *  Participants in different NUMA nodes
+ */
+TEST(TrivialTest, trivial_zero_copy)
+{
+    RealTopic topic("trivial_topic", "trivial_type");
+
+    DummyDataReceived data;
+    data.source_guid = test::random_guid();
+    data.payload = random_payload(3);
+
+    // Participants sharing payload pool
+    {
+        DDSRouter router(numa_configuration(topic, 0, 0, true));
+        router.start();
+
+        DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+        DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+
+        participant_1->simulate_data_reception(topic, data);
+        participant_2->wait_until_n_data_sent(topic, 1);
+        ASSERT_TRUE(wait_until([&]()
+                {
+                    return router.tracks_statistics(topic)[ParticipantId("participant_1")].referenced_payloads > 0;
+                }));
+
+        std::map<ParticipantId, TrackStatistics> tracks_statistics = router.tracks_statistics(topic);
+        ASSERT_EQ(tracks_statistics[ParticipantId("participant_1")].referenced_payloads, 1u);
+        ASSERT_EQ(tracks_statistics[ParticipantId("participant_1")].copied_payloads, 0u);
+
+        router.stop();
+    }
+
+    // Participants in different NUMA nodes
+    {
+        DDSRouter router(numa_configuration(topic, 0, 1, true));
+        router.start();
+
+        ASSERT_TRUE(router.tracks_statistics(topic).empty());
+
+        router.stop();
+    }
+}
+
+/**
+ * Test the data is not given to the Writers that have no remote readers if the topic skips them
+ *
+ * STEPS:
+ *  The Writer of participant_2 has no remote readers, so the data received in participant_1 is skipped
+ *  Once it has remote readers, the data received is sent
+ */
+TEST(TrivialTest, trivial_skip_writers_without_readers)
+{
+    RawConfiguration router_configuration =
+            load_configuration_from_file("../resources/configurations/trivial/trivial_test_dummy_configuration.yaml");
+    router_configuration[ALLOWLIST_TAG][0][TOPIC_SKIP_WITHOUT_READERS_TAG] = true;
+
+    DDSRouter router(router_configuration);
+    router.start();
+
+    DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+    DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+    RealTopic topic("trivial_topic", "trivial_type");
+
+    DummyDataReceived data;
+    data.source_guid = test::random_guid();
+    data.payload = random_payload(3);
+
+    // No remote readers
+    participant_2->simulate_remote_readers(topic, false);
+    participant_1->simulate_data_reception(topic, data);
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return router.tracks_statistics(topic)[ParticipantId("participant_1")].skipped_payloads > 0;
+            }));
+    ASSERT_TRUE(participant_2->get_data_that_should_have_been_sent(topic).empty());
+
+    // Remote readers matched
+    participant_2->simulate_remote_readers(topic, true);
+    participant_1->simulate_data_reception(topic, data);
+    participant_2->wait_until_n_data_sent(topic, 1);
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return router.tracks_statistics(topic)[ParticipantId("participant_1")].referenced_payloads > 0;
+            }));
+
+    TrackStatistics statistics = router.tracks_statistics(topic)[ParticipantId("participant_1")];
+    ASSERT_EQ(statistics.skipped_payloads, 1u);
+    ASSERT_EQ(statistics.referenced_payloads, 1u);
+    ASSERT_EQ(participant_2->get_data_that_should_have_been_sent(topic).size(), 1u);
+
+    router.stop();
+}
+
+/**
+ * Test the data is kept in the Writers without remote readers by default, so readers that match later receive it
+ *
+ * STEPS:
+ *  The Writer of participant_2 has no remote readers, but the data received in participant_1 is written in it
+ *  A reader matches afterwards, and the data is still in the Writer
+ */
+TEST(TrivialTest, trivial_late_joiner)
+{
+    RawConfiguration router_configuration =
+            load_configuration_from_file("../resources/configurations/trivial/trivial_test_dummy_configuration.yaml");
+
+    DDSRouter router(router_configuration);
+    router.start();
+
+    DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+    DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+    RealTopic topic("trivial_topic", "trivial_type");
+
+    DummyDataReceived data;
+    data.source_guid = test::random_guid();
+    data.payload = random_payload(3);
+
+    // No remote readers, but the data is written
+    participant_2->simulate_remote_readers(topic, false);
+    participant_1->simulate_data_reception(topic, data);
+    participant_2->wait_until_n_data_sent(topic, 1);
+
+    // A reader matches afterwards, and the data is still in the Writer
+    participant_2->simulate_remote_readers(topic, true);
+
+    std::vector<DummyDataStored> data_received = participant_2->get_data_that_should_have_been_sent(topic);
+    ASSERT_EQ(data_received.size(), 1u);
+    ASSERT_EQ(data_received[0].payload, data.payload);
+    ASSERT_EQ(router.tracks_statistics(topic)[ParticipantId("participant_1")].skipped_payloads, 0u);
+
+    router.stop();
+}
+
+/**
+ * Test the data is dropped and counted when the history of a Writer is full of data not acknowledged
+ *
+ * STEPS:
+ *  The Writer of participant_2 has its history full, so the data received in participant_1 is dropped
+ *  Once there is room in the history, the data received is sent
+ */
+TEST(TrivialTest, trivial_full_writer_history)
+{
+    RawConfiguration router_configuration =
+            load_configuration_from_file("../resources/configurations/trivial/trivial_test_dummy_configuration.yaml");
+
+    DDSRouter router(router_configuration);
+    router.start();
+
+    DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+    DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+    RealTopic topic("trivial_topic", "trivial_type");
+
+    DummyDataReceived data;
+    data.source_guid = test::random_guid();
+    data.payload = random_payload(3);
+
+    // History full
+    participant_2->simulate_full_history(topic, true);
+    participant_1->simulate_data_reception(topic, data);
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return router.tracks_statistics(topic)[ParticipantId("participant_1")].dropped_payloads > 0;
+            }));
+    ASSERT_TRUE(participant_2->get_data_that_should_have_been_sent(topic).empty());
+
+    // Room in the history
+    participant_2->simulate_full_history(topic, false);
+    participant_1->simulate_data_reception(topic, data);
+    participant_2->wait_until_n_data_sent(topic, 1);
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return router.tracks_statistics(topic)[ParticipantId("participant_1")].referenced_payloads > 0;
+            }));
+
+    TrackStatistics statistics = router.tracks_statistics(topic)[ParticipantId("participant_1")];
+    ASSERT_EQ(statistics.dropped_payloads, 1u);
+    ASSERT_EQ(statistics.referenced_payloads, 1u);
+    ASSERT_EQ(participant_2->get_data_that_should_have_been_sent(topic).size(), 1u);
+
+    router.stop();
+}
+
+/**
+ * Test the data of an inline topic is forwarded by the thread receiving it, unless its Writers are queued
+ *
+ * STEPS:
+ *  Inline topic: the data is sent before the reception returns
+ *  Inline topic with an egress queue of a single data that blocks when full: the data is handed off to the pool,
+ *  so the reception thread never waits for the queue, and every data is sent
+ */
+TEST(TrivialTest, trivial_inline_forwarding)
+{
+    RealTopic topic("trivial_topic", "trivial_type");
+    DummyDataReceived data;
+    data.source_guid = test::random_guid();
+    data.payload = random_payload(3);
+
+    RawConfiguration router_configuration =
+            load_configuration_from_file("../resources/configurations/trivial/trivial_test_dummy_configuration.yaml");
+    router_configuration[ALLOWLIST_TAG][0][TOPIC_INLINE_TAG] = true;
+
+    {
+        // Inline topic
+        DDSRouter router(router_configuration);
+        router.start();
+
+        DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+        DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+
+        participant_1->simulate_data_reception(topic, data);
+        ASSERT_EQ(participant_2->get_data_that_should_have_been_sent(topic).size(), 1u);
+
+        router.stop();
+    }
+
+    {
+        // Inline topic with an egress queue
+        router_configuration[ALLOWLIST_TAG][0][TOPIC_EGRESS_QUEUE_TAG] = 1;
+        router_configuration[ALLOWLIST_TAG][0][TOPIC_EGRESS_OVERFLOW_TAG] = TOPIC_EGRESS_OVERFLOW_BLOCK_TAG;
+
+        DDSRouter router(router_configuration);
+        router.start();
+
+        DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+        DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+
+        constexpr const uint16_t n_data = 200;
+        for (uint16_t i = 0; i < n_data; ++i)
+        {
+            participant_1->simulate_data_reception(topic, data);
+        }
+        participant_2->wait_until_n_data_sent(topic, n_data);
+        ASSERT_EQ(participant_2->get_data_that_should_have_been_sent(topic).size(), n_data);
+
+        router.stop();
+    }
+}
+
+/**
+ * Test lazy Bridges are created once a remote Writer is discovered, without interest driven endpoints
+ *
+ * STEPS:
+ *  No endpoint exists without remote endpoints
+ *  No Bridge exists while the topic only has a remote Reader
+ *  A remote Writer creates the Bridge, with both endpoints in every Participant
+ *  Data is forwarded from participant_1 to participant_2
+ */
+TEST(TrivialTest, trivial_lazy_bridges)
+{
+    RealTopic topic("trivial_topic", "trivial_type");
+
+    RawConfiguration router_configuration = numa_configuration(topic, 0, 0);
+    router_configuration[SPECS_TAG][LAZY_BRIDGES_TAG] = true;
+
+    DDSRouter router(router_configuration);
+    router.start();
+
+    DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+    DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+
+    // No endpoint exists without remote endpoints
+    ASSERT_TRUE(router.tracks_statistics(topic).empty());
+    ASSERT_FALSE(participant_1->has_reader(topic));
+    ASSERT_FALSE(participant_2->has_writer(topic));
+
+    // No Bridge exists while the topic only has a remote Reader
+    participant_2->simulate_discovered_endpoint(Endpoint(EndpointKind::READER, test::random_guid(2), QoS(), topic));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(router.tracks_statistics(topic).empty());
+    ASSERT_FALSE(participant_2->has_writer(topic));
+
+    // A remote Writer creates the Bridge, with both endpoints in every Participant
+    Guid remote_writer = test::random_guid(1);
+    participant_1->simulate_discovered_endpoint(Endpoint(EndpointKind::WRITER, remote_writer, QoS(), topic));
+
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return !router.tracks_statistics(topic).empty();
+            }));
+    ASSERT_TRUE(participant_1->has_reader(topic));
+    ASSERT_TRUE(participant_1->has_writer(topic));
+    ASSERT_TRUE(participant_2->has_reader(topic));
+    ASSERT_TRUE(participant_2->has_writer(topic));
+
+    // Data is forwarded from participant_1 to participant_2
+    DummyDataReceived data;
+    data.source_guid = remote_writer;
+    data.payload = random_payload(3);
+
+    participant_1->simulate_data_reception(topic, data);
+    participant_2->wait_until_n_data_sent(topic, 1);
+    ASSERT_EQ(participant_2->get_data_that_should_have_been_sent(topic).size(), 1u);
+
+    router.stop();
+}
+
+/**
+ * Test the Bridge is created once a remote Writer is discovered, and the endpoints of the Participants when remote
+ * endpoints are discovered, and deleted once they have been idle during the grace period
+ *
+ * STEPS:
+ *  No endpoint exists without remote endpoints
+ *  No Bridge exists while the topic only has a remote Reader
+ *  A remote Writer discovered in participant_1 creates its Reader, and the remote Reader in participant_2 its Writer
+ *  Data is forwarded from participant_1 to participant_2
+ *  The Reader of participant_1 is deleted after the remote Writer leaves
+ */
+TEST(TrivialTest, trivial_interest_driven_endpoints)
+{
+    RealTopic topic("trivial_topic", "trivial_type");
+
+    RawConfiguration router_configuration = numa_configuration(topic, 0, 0);
+    router_configuration[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG] = true;
+    router_configuration[SPECS_TAG][ENDPOINT_GRACE_PERIOD_TAG] = 50;
+
+    DDSRouter router(router_configuration);
+    router.start();
+
+    DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+    DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+
+    // No endpoint exists without remote endpoints
+    ASSERT_FALSE(participant_1->has_reader(topic));
+    ASSERT_FALSE(participant_1->has_writer(topic));
+    ASSERT_FALSE(participant_2->has_reader(topic));
+    ASSERT_FALSE(participant_2->has_writer(topic));
+
+    // No Bridge exists while the topic only has a remote Reader
+    Guid remote_reader = test::random_guid(2);
+    participant_2->simulate_discovered_endpoint(Endpoint(EndpointKind::READER, remote_reader, QoS(), topic));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(router.tracks_statistics(topic).empty());
+    ASSERT_FALSE(participant_2->has_writer(topic));
+
+    // Remote endpoints discovered create the local ones, once the remote Writer creates the Bridge
+    Guid remote_writer = test::random_guid(1);
+    participant_1->simulate_discovered_endpoint(Endpoint(EndpointKind::WRITER, remote_writer, QoS(), topic));
+
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return participant_1->has_reader(topic) && participant_2->has_writer(topic);
+            }));
+    ASSERT_FALSE(participant_1->has_writer(topic));
+    ASSERT_FALSE(participant_2->has_reader(topic));
+
+    // Data is forwarded through the endpoints created
+    DummyDataReceived data;
+    data.source_guid = remote_writer;
+    data.payload = random_payload(3);
+
+    participant_1->simulate_data_reception(topic, data);
+    participant_2->wait_until_n_data_sent(topic, 1);
+
+    std::vector<DummyDataStored> data_received = participant_2->get_data_that_should_have_been_sent(topic);
+    ASSERT_EQ(1, data_received.size());
+    ASSERT_EQ(data_received[0].payload, data.payload);
+
+    // The Reader is deleted after the grace period once the remote Writer leaves
+    participant_1->simulate_undiscovered_endpoint(remote_writer);
+
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return !participant_1->has_reader(topic);
+            }));
+    ASSERT_TRUE(participant_2->has_writer(topic));
+
+    router.stop();
+}
+
+/**
+ * Test a Bridge without remote endpoints nor data is destroyed after the idle timeout, and created again when a
+ * remote endpoint of its topic is discovered
+ *
+ * STEPS:
+ *  The Bridge is kept while there is a remote endpoint in its topic
+ *  The Bridge is destroyed once the remote endpoint leaves
+ *  The Bridge is created again when the remote endpoint comes back, and forwards data
+ */
+TEST(TrivialTest, trivial_idle_bridge)
+{
+    RealTopic topic("trivial_topic", "trivial_type");
+
+    RawConfiguration router_configuration = numa_configuration(topic, 0, 0);
+    router_configuration[SPECS_TAG][BRIDGE_IDLE_TIMEOUT_TAG] = 50;
+
+    DDSRouter router(router_configuration);
+    router.start();
+
+    DummyParticipant* participant_1 = DummyParticipant::get_participant(ParticipantId("participant_1"));
+    DummyParticipant* participant_2 = DummyParticipant::get_participant(ParticipantId("participant_2"));
+
+    // The Bridge is kept while there is a remote endpoint
+    Guid remote_writer = test::random_guid(1);
+    participant_1->simulate_discovered_endpoint(Endpoint(EndpointKind::WRITER, remote_writer, QoS(), topic));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_FALSE(router.tracks_statistics(topic).empty());
+
+    // The Bridge is destroyed once the remote endpoint leaves
+    participant_1->simulate_undiscovered_endpoint(remote_writer);
+
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return router.tracks_statistics(topic).empty();
+            }));
+    ASSERT_FALSE(participant_1->has_reader(topic));
+    ASSERT_FALSE(participant_2->has_writer(topic));
+
+    // The Bridge is created again when the remote endpoint comes back
+    participant_1->simulate_discovered_endpoint(Endpoint(EndpointKind::WRITER, remote_writer, QoS(), topic));
+
+    ASSERT_TRUE(wait_until([&]()
+            {
+                return participant_1->has_reader(topic) && participant_2->has_writer(topic);
+            }));
+
+    DummyDataReceived data;
+    data.source_guid = remote_writer;
+    data.payload = random_payload(3);
+
+    participant_1->simulate_data_reception(topic, data);
+    participant_2->wait_until_n_data_sent(topic, 1);
+    ASSERT_EQ(participant_2->get_data_that_should_have_been_sent(topic).size(), 1u);
+
     router.stop();
 }
 
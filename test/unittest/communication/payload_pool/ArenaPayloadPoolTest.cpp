@@ -0,0 +1,311 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <thread>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/communication/payload_pool/ArenaPayloadPool.hpp>
+#include <ddsrouter/communication/payload_pool/MemoryArena.hpp>
+#include <ddsrouter/types/numa.hpp>
+
+using namespace eprosima::ddsrouter;
+
+const constexpr uint16_t TEST_NUMBER = 5;
+const constexpr size_t TEST_ARENA_SIZE = 1u << 20;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+//! Configuration of an arena pool of \c arena_size bytes
+PayloadPoolConfiguration arena_configuration(
+        uint64_t arena_size,
+        bool huge_pages = false)
+{
+    PayloadPoolConfiguration configuration;
+    configuration.kind = PayloadPoolKind::ARENA_PAYLOAD_POOL;
+    configuration.arena_size = arena_size;
+    configuration.huge_pages = huge_pages;
+    return configuration;
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Test blocks carved from a MemoryArena
+ *
+ * CASES:
+ *  Blocks are aligned and inside the arena
+ *  Arena exhausted
+ *  Arena of 0 bytes
+ */
+TEST(ArenaPayloadPoolTest, memory_arena)
+{
+    // Blocks are aligned and inside the arena
+    {
+        MemoryArena arena(TEST_ARENA_SIZE, false, true);
+        ASSERT_EQ(arena.size(), TEST_ARENA_SIZE);
+        ASSERT_EQ(arena.used(), 0u);
+
+        void* block_1 = arena.allocate(10);
+        void* block_2 = arena.allocate(100);
+        ASSERT_NE(block_1, nullptr);
+        ASSERT_NE(block_2, nullptr);
+        ASSERT_TRUE(arena.contains(block_1));
+        ASSERT_TRUE(arena.contains(block_2));
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(block_1) % alignof(std::max_align_t), 0u);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(block_2) % alignof(std::max_align_t), 0u);
+        ASSERT_GE(static_cast<unsigned char*>(block_2) - static_cast<unsigned char*>(block_1), 10);
+
+        int heap_data = 0;
+        ASSERT_FALSE(arena.contains(&heap_data));
+
+        // This would (maybe) fail with SEG FAULT if the memory is not mapped
+        static_cast<unsigned char*>(block_2)[99] = 1u;
+    }
+
+    // Arena exhausted
+    {
+        MemoryArena arena(TEST_ARENA_SIZE, false, false);
+        ASSERT_NE(arena.allocate(TEST_ARENA_SIZE / 2), nullptr);
+        ASSERT_EQ(arena.allocate(TEST_ARENA_SIZE), nullptr);
+        ASSERT_NE(arena.allocate(TEST_ARENA_SIZE / 2), nullptr);
+        ASSERT_EQ(arena.allocate(1), nullptr);
+        ASSERT_EQ(arena.used(), TEST_ARENA_SIZE);
+    }
+
+    // Arena of 0 bytes
+    {
+        MemoryArena arena(0, false, true);
+        ASSERT_EQ(arena.size(), 0u);
+        ASSERT_EQ(arena.allocate(1), nullptr);
+    }
+}
+
+/**
+ * Test the data of the pool are carved from its arena and recycled
+ *
+ * STEPS:
+ *  get N payloads
+ *  release all
+ *  get N payloads reusing the blocks
+ */
+TEST(ArenaPayloadPoolTest, carve_from_arena)
+{
+    ArenaPayloadPool pool(test::arena_configuration(TEST_ARENA_SIZE));
+    std::vector<Payload> payloads(TEST_NUMBER);
+
+    // get N payloads
+    for (Payload& payload : payloads)
+    {
+        ASSERT_TRUE(pool.get_payload(1000, payload));
+        ASSERT_TRUE(pool.arena().contains(payload.data));
+    }
+    ASSERT_EQ(pool.heap_allocations(), 0u);
+    size_t used = pool.arena().used();
+    ASSERT_GE(used, TEST_NUMBER * 1024u);
+
+    // release all
+    for (Payload& payload : payloads)
+    {
+        ASSERT_TRUE(pool.release_payload(payload));
+    }
+    ASSERT_TRUE(pool.is_clean());
+
+    // get N payloads reusing the blocks
+    for (Payload& payload : payloads)
+    {
+        ASSERT_TRUE(pool.get_payload(1024, payload));
+    }
+    ASSERT_EQ(pool.arena().used(), used);
+
+    // END : release all
+    for (Payload& payload : payloads)
+    {
+        pool.release_payload(payload);
+    }
+    ASSERT_TRUE(pool.is_clean());
+}
+
+/**
+ * Test data are allocated from the heap when they do not fit in the arena
+ *
+ * CASES:
+ *  Arena exhausted
+ *  Data larger than the maximum size class
+ *  Data larger than the default maximum size class with a larger one configured
+ */
+TEST(ArenaPayloadPoolTest, heap_fallback)
+{
+    // Arena exhausted
+    {
+        ArenaPayloadPool pool(test::arena_configuration(4096));
+        std::vector<Payload> payloads(TEST_NUMBER);
+
+        for (Payload& payload : payloads)
+        {
+            ASSERT_TRUE(pool.get_payload(1000, payload));
+        }
+        ASSERT_GT(pool.heap_allocations(), 0u);
+        ASSERT_LT(pool.heap_allocations(), TEST_NUMBER);
+        ASSERT_EQ(pool.arena_exhausted_allocations(), pool.heap_allocations());
+        ASSERT_TRUE(pool.arena().contains(payloads.front().data));
+        ASSERT_FALSE(pool.arena().contains(payloads.back().data));
+
+        // Blocks from the arena and from the heap are kept mixed till the pool is destroyed
+        for (Payload& payload : payloads)
+        {
+            ASSERT_TRUE(pool.release_payload(payload));
+        }
+        ASSERT_TRUE(pool.is_clean());
+    }
+
+    // Data larger than the maximum size class
+    {
+        ArenaPayloadPool pool(test::arena_configuration(4 * SlabPayloadPool::MAX_SIZE_CLASS));
+        Payload payload;
+
+        ASSERT_TRUE(pool.get_payload(SlabPayloadPool::MAX_SIZE_CLASS + 1, payload));
+        ASSERT_FALSE(pool.arena().contains(payload.data));
+        ASSERT_EQ(pool.arena().used(), 0u);
+        ASSERT_EQ(pool.arena_exhausted_allocations(), 0u);
+
+        ASSERT_TRUE(pool.release_payload(payload));
+    }
+
+    // Data larger than the default maximum size class with a larger one configured
+    {
+        PayloadPoolConfiguration configuration = test::arena_configuration(8 * SlabPayloadPool::MAX_SIZE_CLASS);
+        configuration.max_size_class = 3 * SlabPayloadPool::MAX_SIZE_CLASS;
+        ArenaPayloadPool pool(configuration);
+        ASSERT_EQ(pool.max_size_class(), 4 * SlabPayloadPool::MAX_SIZE_CLASS);
+
+        Payload payload;
+        ASSERT_TRUE(pool.get_payload(SlabPayloadPool::MAX_SIZE_CLASS + 1, payload));
+        ASSERT_TRUE(pool.arena().contains(payload.data));
+        void* data = payload.data;
+        ASSERT_TRUE(pool.release_payload(payload));
+
+        // The block is recycled
+        ASSERT_TRUE(pool.get_payload(SlabPayloadPool::MAX_SIZE_CLASS * 2, payload));
+        ASSERT_EQ(payload.data, data);
+        ASSERT_EQ(pool.heap_allocations(), 0u);
+
+        ASSERT_TRUE(pool.release_payload(payload));
+    }
+}
+
+/**
+ * Test payloads preallocated in construction are carved from the arena
+ */
+TEST(ArenaPayloadPoolTest, preallocation)
+{
+    PayloadPoolConfiguration configuration = test::arena_configuration(TEST_ARENA_SIZE);
+    configuration.preallocated_payloads = {{1000, TEST_NUMBER}};
+    ArenaPayloadPool pool(configuration);
+
+    ASSERT_EQ(pool.heap_allocations(), 0u);
+    size_t used = pool.arena().used();
+    ASSERT_GE(used, TEST_NUMBER * 1024u);
+
+    std::vector<Payload> payloads(TEST_NUMBER);
+    for (Payload& payload : payloads)
+    {
+        ASSERT_TRUE(pool.get_payload(1000, payload));
+    }
+    ASSERT_EQ(pool.arena().used(), used);
+
+    // END : release all
+    for (Payload& payload : payloads)
+    {
+        pool.release_payload(payload);
+    }
+    ASSERT_TRUE(pool.is_clean());
+}
+
+/**
+ * Test the pool works whether huge pages are available or not
+ *
+ * If the system has no huge pages reserved, the arena falls back to normal pages.
+ */
+TEST(ArenaPayloadPoolTest, huge_pages)
+{
+    ArenaPayloadPool pool(test::arena_configuration(TEST_ARENA_SIZE, true));
+    ASSERT_GE(pool.arena().size(), TEST_ARENA_SIZE);
+
+    Payload payload;
+    ASSERT_TRUE(pool.get_payload(1000, payload));
+    ASSERT_TRUE(pool.arena().contains(payload.data));
+    payload.data[999] = 1u;
+
+    ASSERT_TRUE(pool.release_payload(payload));
+    ASSERT_TRUE(pool.is_clean());
+}
+
+/**
+ * Test the arena of a pool placed in a NUMA node
+ *
+ * The arena is bound to node 0, that exists in every host. Hosts without NUMA support keep it unbound.
+ */
+TEST(ArenaPayloadPoolTest, numa_node)
+{
+    PayloadPoolConfiguration configuration = test::arena_configuration(TEST_ARENA_SIZE);
+    configuration.numa_node = 0;
+    ArenaPayloadPool pool(configuration);
+
+    Payload payload;
+    ASSERT_TRUE(pool.get_payload(1000, payload));
+    ASSERT_TRUE(pool.arena().contains(payload.data));
+    payload.data[0] = 1u;
+
+    int node = numa::node_of_address(payload.data);
+    ASSERT_TRUE(node == 0 || node == numa::NO_NUMA_NODE);
+
+    ASSERT_TRUE(pool.release_payload(payload));
+    ASSERT_TRUE(pool.is_clean());
+}
+
+/**
+ * Test the arena is kept mapped while other thread keeps blocks of it in its magazines
+ */
+TEST(ArenaPayloadPoolTest, destroy_with_thread_magazines)
+{
+    std::unique_ptr<ArenaPayloadPool> pool =
+            std::make_unique<ArenaPayloadPool>(test::arena_configuration(TEST_ARENA_SIZE));
+
+    std::thread thread(
+        [&pool]()
+        {
+            Payload payload;
+            pool->get_payload(100, payload);
+            pool->release_payload(payload);
+
+            // The block stays in the magazine of this thread after the pool is destroyed
+            pool.reset();
+        });
+    thread.join();
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
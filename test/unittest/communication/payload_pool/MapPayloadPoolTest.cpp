@@ -12,11 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
+
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
 
 #include <fastdds/rtps/common/CacheChange.h>
 
+#include <ddsrouter/communication/payload_pool/CopyPayloadPool.hpp>
 #include <ddsrouter/communication/payload_pool/PayloadPool.hpp>
 #include <ddsrouter/communication/payload_pool/MapPayloadPool.hpp>
 #include <ddsrouter/exceptions/InconsistencyException.hpp>
@@ -228,6 +231,139 @@ TEST(MapPayloadPoolTest, get_payload_from_src_no_owner)
     ASSERT_EQ(pool_->pointers_stored(), 0);
 }
 
+/**
+ * Test whether a pool references or copies the data of each owner, as get_payload does
+ *
+ * CASES:
+ *  Data of the pool itself
+ *  Data of other pool
+ *  Copy pool never references
+ */
+TEST(MapPayloadPoolTest, references_data_of)
+{
+    MapPayloadPool pool;
+    MapPayloadPool other_pool;
+    CopyPayloadPool copy_pool;
+
+    Payload payload_src;
+    ASSERT_TRUE(pool.get_payload(DEFAULT_SIZE, payload_src));
+    payload_src.length = DEFAULT_SIZE;
+
+    // Data of the pool itself
+    {
+        ASSERT_TRUE(pool.references_data_of(&pool));
+
+        Payload payload_target;
+        eprosima::fastrtps::rtps::IPayloadPool* owner = &pool;
+        ASSERT_TRUE(pool.get_payload(payload_src, owner, payload_target));
+        ASSERT_EQ(payload_target.data, payload_src.data);
+        ASSERT_EQ(pool.statistics().referenced_payloads, 1u);
+        pool.release_payload(payload_target);
+    }
+
+    // Data of other pool
+    {
+        ASSERT_FALSE(other_pool.references_data_of(&pool));
+
+        Payload payload_target;
+        eprosima::fastrtps::rtps::IPayloadPool* owner = &pool;
+        ASSERT_TRUE(other_pool.get_payload(payload_src, owner, payload_target));
+        ASSERT_NE(payload_target.data, payload_src.data);
+        ASSERT_EQ(other_pool.statistics().copied_payloads, 1u);
+        other_pool.release_payload(payload_target);
+    }
+
+    // Copy pool never references
+    {
+        ASSERT_FALSE(copy_pool.references_data_of(&copy_pool));
+        ASSERT_FALSE(copy_pool.references_data_of(&pool));
+    }
+
+    pool.release_payload(payload_src);
+    ASSERT_TRUE(pool.is_clean());
+    ASSERT_TRUE(other_pool.is_clean());
+}
+
+/**
+ * Check the bytes reserved to copy a payload from a different pool
+ *
+ * CASES:
+ *  Copy max size
+ *  Copy length
+ *  Copy length rounded to size class
+ *  Size class larger than max size
+ *  Source without length
+ */
+TEST(MapPayloadPoolTest, get_payload_from_src_copy_size)
+{
+    // Source with large max size and small length
+    test::MockMapPayloadPool pool_aux;
+    eprosima::fastrtps::rtps::IPayloadPool* pool_aux_ = &pool_aux; // Requires to be ptr to pass it to get_payload
+    Payload payload_src;
+    pool_aux.get_payload(0x10000, payload_src);
+    payload_src.length = 100;
+    std::memset(payload_src.data, 0x42, payload_src.length);
+
+    std::vector<std::pair<PayloadCopySize, uint32_t>> cases = {
+        {PayloadCopySize::COPY_MAX_SIZE, 0x10000},  // Copy max size
+        {PayloadCopySize::COPY_LENGTH, 100},        // Copy length
+        {PayloadCopySize::COPY_SIZE_CLASS, 128},    // Copy length rounded to size class
+    };
+
+    for (const auto& test_case : cases)
+    {
+        PayloadPoolConfiguration configuration;
+        configuration.copy_size = test_case.first;
+        test::MockMapPayloadPool pool(configuration);
+        Payload payload_target;
+
+        ASSERT_TRUE(pool.get_payload(payload_src, pool_aux_, payload_target));
+        ASSERT_EQ(payload_target.max_size, test_case.second);
+        ASSERT_EQ(payload_target.length, payload_src.length);
+        ASSERT_EQ(std::memcmp(payload_target.data, payload_src.data, payload_src.length), 0);
+
+        pool.release_payload(payload_target);
+    }
+
+    // Size class larger than max size
+    {
+        PayloadPoolConfiguration configuration;
+        configuration.copy_size = PayloadCopySize::COPY_SIZE_CLASS;
+        test::MockMapPayloadPool pool(configuration);
+        Payload payload_src_full;
+        Payload payload_target;
+
+        pool_aux.get_payload(100, payload_src_full);
+        payload_src_full.length = 100;
+
+        ASSERT_TRUE(pool.get_payload(payload_src_full, pool_aux_, payload_target));
+        ASSERT_EQ(payload_target.max_size, 100u);
+
+        pool.release_payload(payload_target);
+        pool_aux.release_payload(payload_src_full);
+    }
+
+    // Source without length
+    {
+        PayloadPoolConfiguration configuration;
+        configuration.copy_size = PayloadCopySize::COPY_LENGTH;
+        test::MockMapPayloadPool pool(configuration);
+        Payload payload_src_empty;
+        Payload payload_target;
+
+        pool_aux.get_payload(100, payload_src_empty);
+
+        ASSERT_TRUE(pool.get_payload(payload_src_empty, pool_aux_, payload_target));
+        ASSERT_EQ(payload_target.max_size, 100u);
+        ASSERT_EQ(payload_target.length, 0u);
+
+        pool.release_payload(payload_target);
+        pool_aux.release_payload(payload_src_empty);
+    }
+
+    pool_aux.release_payload(payload_src);
+}
+
 /**
  * Check negative cases for get_payload from source
  *
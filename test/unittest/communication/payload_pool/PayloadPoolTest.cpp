@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include <gtest_aux.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -19,6 +23,7 @@
 #include <fastdds/rtps/common/CacheChange.h>
 
 #include <ddsrouter/communication/payload_pool/PayloadPool.hpp>
+#include <ddsrouter/communication/payload_pool/PayloadPoolConfiguration.hpp>
 #include <ddsrouter/exceptions/InconsistencyException.hpp>
 #include <ddsrouter/types/Data.hpp>
 
@@ -48,8 +53,20 @@ public:
     using PayloadPool::release_payload;
     using PayloadPool::reserve_;
     using PayloadPool::release_;
-    using PayloadPool::reserve_count_;
-    using PayloadPool::release_count_;
+    using PayloadPool::configuration_;
+
+    //! Number of data reserved from this pool
+    uint64_t reserve_count()
+    {
+        return statistics().reserved_payloads;
+    }
+
+    //! Number of data released to this pool
+    uint64_t release_count()
+    {
+        PayloadPoolStatistics current_statistics = statistics();
+        return current_statistics.reserved_payloads - current_statistics.live_payloads;
+    }
 
     // Mock this virtual methods not implemented in parent class
     MOCK_METHOD(
@@ -75,6 +92,17 @@ public:
         (override));
 };
 
+//! Configuration with a memory budget of \c budget bytes and policy \c policy
+PayloadPoolConfiguration budget_configuration(
+        uint64_t budget,
+        MemoryBudgetPolicy policy)
+{
+    PayloadPoolConfiguration configuration;
+    configuration.memory_budget = budget;
+    configuration.memory_policy = policy;
+    return configuration;
+}
+
 } /* namespace test */
 } /* namespace ddsrouter */
 } /* namespace eprosima */
@@ -195,34 +223,34 @@ TEST(PayloadPoolTest, reserve_and_release_counter)
     // store 5 values
     for (int i = 0; i < 5; ++i)
     {
-        ASSERT_EQ(pool.reserve_count_, i);
+        ASSERT_EQ(pool.reserve_count(), i);
         pool.reserve_(sizeof(PayloadUnit), payloads[i]);
     }
-    ASSERT_EQ(pool.reserve_count_, 5);
+    ASSERT_EQ(pool.reserve_count(), 5);
 
     // release 4 values
     for (int i = 0; i < 4; ++i)
     {
-        ASSERT_EQ(pool.release_count_, i);
+        ASSERT_EQ(pool.release_count(), i);
         pool.release_(payloads[i]);
     }
-    ASSERT_EQ(pool.release_count_, 4);
+    ASSERT_EQ(pool.release_count(), 4);
 
     // store 5 values
     for (int i = 5; i < 10; ++i)
     {
-        ASSERT_EQ(pool.reserve_count_, i);
+        ASSERT_EQ(pool.reserve_count(), i);
         pool.reserve_(sizeof(PayloadUnit), payloads[i]);
     }
-    ASSERT_EQ(pool.reserve_count_, 10);
+    ASSERT_EQ(pool.reserve_count(), 10);
 
     // release 6 values
     for (int i = 4; i < 10; ++i)
     {
-        ASSERT_EQ(pool.release_count_, i);
+        ASSERT_EQ(pool.release_count(), i);
         pool.release_(payloads[i]);
     }
-    ASSERT_EQ(pool.release_count_, 10);
+    ASSERT_EQ(pool.release_count(), 10);
 
     // release more values than reserved
     ASSERT_THROW(pool.release_(payloads[10]), InconsistencyException);
@@ -372,6 +400,418 @@ TEST(PayloadPoolTest, release_payload_cache_change)
     }
 }
 
+/**
+ * Test that the bytes reserved are accounted and limited by the memory budget with MEMORY_REJECT policy
+ *
+ * CASES:
+ *  no budget
+ *  data over budget rejected
+ *  data fits again after release
+ */
+TEST(PayloadPoolTest, memory_budget_reject)
+{
+    // no budget
+    {
+        test::MockPayloadPool pool;
+        Payload payload;
+
+        ASSERT_TRUE(pool.reserve_(0x1000, payload));
+        ASSERT_EQ(pool.reserved_bytes(), 0x1000u);
+        ASSERT_FALSE(pool.low_priority_limit_reached());
+
+        ASSERT_TRUE(pool.release_(payload));
+        ASSERT_EQ(pool.reserved_bytes(), 0u);
+    }
+
+    // data over budget rejected
+    {
+        test::MockPayloadPool pool(test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_REJECT));
+        Payload payload_1;
+        Payload payload_2;
+
+        ASSERT_TRUE(pool.reserve_(60, payload_1));
+        ASSERT_FALSE(pool.reserve_(60, payload_2));
+        ASSERT_EQ(payload_2.data, nullptr);
+        ASSERT_EQ(pool.reserved_bytes(), 60u);
+        ASSERT_EQ(pool.reserve_count(), 1u);
+
+        ASSERT_TRUE(pool.release_(payload_1));
+    }
+
+    // data fits again after release
+    {
+        test::MockPayloadPool pool(test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_REJECT));
+        Payload payload_1;
+        Payload payload_2;
+
+        ASSERT_TRUE(pool.reserve_(100, payload_1));
+        ASSERT_FALSE(pool.reserve_(1, payload_2));
+
+        ASSERT_TRUE(pool.release_(payload_1));
+        ASSERT_TRUE(pool.reserve_(1, payload_2));
+        ASSERT_EQ(pool.reserved_bytes(), 1u);
+
+        ASSERT_TRUE(pool.release_(payload_2));
+    }
+}
+
+/**
+ * Test that with MEMORY_EVICT policy the memory reclaimers are called till the new data fits
+ *
+ * CASES:
+ *  reclaimer releases data
+ *  reclaimer has nothing to release
+ *  unregistered reclaimer is not called
+ */
+TEST(PayloadPoolTest, memory_budget_evict)
+{
+    // reclaimer releases data
+    {
+        test::MockPayloadPool pool(test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_EVICT));
+        std::vector<Payload> stored(4);
+        unsigned int reclaimed = 0;
+
+        for (Payload& payload : stored)
+        {
+            ASSERT_TRUE(pool.reserve_(25, payload));
+        }
+
+        // Release the oldest data stored each time it is called
+        pool.register_memory_reclaimer(
+            [&pool, &stored, &reclaimed]()
+            {
+                if (reclaimed == stored.size())
+                {
+                    return false;
+                }
+                return pool.release_(stored[reclaimed++]);
+            });
+
+        Payload payload;
+        ASSERT_TRUE(pool.reserve_(40, payload));
+        ASSERT_EQ(reclaimed, 2u);
+        ASSERT_EQ(pool.reserved_bytes(), 90u);
+
+        ASSERT_TRUE(pool.release_(payload));
+        ASSERT_TRUE(pool.release_(stored[2]));
+        ASSERT_TRUE(pool.release_(stored[3]));
+    }
+
+    // reclaimer has nothing to release
+    {
+        test::MockPayloadPool pool(test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_EVICT));
+        unsigned int calls = 0;
+
+        pool.register_memory_reclaimer(
+            [&calls]()
+            {
+                calls++;
+                return false;
+            });
+
+        Payload payload_1;
+        Payload payload_2;
+        ASSERT_TRUE(pool.reserve_(100, payload_1));
+        ASSERT_FALSE(pool.reserve_(1, payload_2));
+        ASSERT_EQ(calls, 1u);
+
+        ASSERT_TRUE(pool.release_(payload_1));
+    }
+
+    // unregistered reclaimer is not called
+    {
+        test::MockPayloadPool pool(test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_EVICT));
+        unsigned int calls = 0;
+
+        uint64_t id = pool.register_memory_reclaimer(
+            [&calls]()
+            {
+                calls++;
+                return false;
+            });
+        pool.unregister_memory_reclaimer(id);
+
+        Payload payload_1;
+        Payload payload_2;
+        ASSERT_TRUE(pool.reserve_(100, payload_1));
+        ASSERT_FALSE(pool.reserve_(1, payload_2));
+        ASSERT_EQ(calls, 0u);
+
+        ASSERT_TRUE(pool.release_(payload_1));
+    }
+}
+
+/**
+ * Test that with MEMORY_BLOCK policy the reservation waits for other thread to release memory
+ *
+ * CASES:
+ *  memory released while waiting
+ *  timeout
+ */
+TEST(PayloadPoolTest, memory_budget_block)
+{
+    // memory released while waiting
+    {
+        PayloadPoolConfiguration configuration = test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_BLOCK);
+        configuration.memory_block_timeout = 10000;
+        test::MockPayloadPool pool(configuration);
+
+        Payload payload_1;
+        Payload payload_2;
+        ASSERT_TRUE(pool.reserve_(100, payload_1));
+
+        std::thread releaser(
+            [&pool, &payload_1]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                pool.release_(payload_1);
+            });
+
+        ASSERT_TRUE(pool.reserve_(50, payload_2));
+        releaser.join();
+
+        ASSERT_EQ(pool.reserved_bytes(), 50u);
+        ASSERT_TRUE(pool.release_(payload_2));
+    }
+
+    // timeout
+    {
+        PayloadPoolConfiguration configuration = test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_BLOCK);
+        configuration.memory_block_timeout = 20;
+        test::MockPayloadPool pool(configuration);
+
+        Payload payload_1;
+        Payload payload_2;
+        ASSERT_TRUE(pool.reserve_(100, payload_1));
+
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_FALSE(pool.reserve_(50, payload_2));
+        ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+        ASSERT_TRUE(pool.release_(payload_1));
+    }
+}
+
+/**
+ * Test that the limit for low priority topics is reached with \c LOW_PRIORITY_BUDGET_RATIO of the budget
+ */
+TEST(PayloadPoolTest, low_priority_limit)
+{
+    test::MockPayloadPool pool(test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_REJECT));
+    Payload payload_1;
+    Payload payload_2;
+
+    ASSERT_TRUE(pool.reserve_(79, payload_1));
+    ASSERT_FALSE(pool.low_priority_limit_reached());
+
+    ASSERT_TRUE(pool.reserve_(1, payload_2));
+    ASSERT_TRUE(pool.low_priority_limit_reached());
+
+    ASSERT_TRUE(pool.release_(payload_2));
+    ASSERT_FALSE(pool.low_priority_limit_reached());
+
+    ASSERT_TRUE(pool.release_(payload_1));
+}
+
+/**
+ * Test that the data of low priority topics received by a Reader is rejected before reserving it
+ *
+ * CASES:
+ *  below the limit
+ *  limit reached
+ *  normal priority data with limit reached
+ */
+TEST(PayloadPoolTest, ingress_low_priority)
+{
+    test::MockPayloadPool pool(test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_REJECT));
+    EXPECT_CALL(pool, get_payload(_, _)).WillRepeatedly(Invoke(
+                [&pool](uint32_t size, Payload& payload)
+                {
+                    return pool.reserve_(size, payload);
+                }));
+
+    // below the limit
+    Payload payload_1;
+    ASSERT_TRUE(pool.get_ingress_payload(80, payload_1, true));
+    ASSERT_EQ(pool.statistics().low_priority_rejected_payloads, 0u);
+
+    // limit reached
+    Payload payload_2;
+    ASSERT_FALSE(pool.get_ingress_payload(10, payload_2, true));
+    ASSERT_EQ(pool.statistics().low_priority_rejected_payloads, 1u);
+    ASSERT_EQ(pool.statistics().reserved_payloads, 1u);
+    ASSERT_EQ(pool.reserved_bytes(), 80u);
+
+    // normal priority data with limit reached
+    ASSERT_TRUE(pool.get_ingress_payload(10, payload_2, false));
+    ASSERT_EQ(pool.statistics().low_priority_rejected_payloads, 1u);
+
+    ASSERT_TRUE(pool.release_(payload_1));
+    ASSERT_TRUE(pool.release_(payload_2));
+}
+
+/**
+ * Test that with MEMORY_BLOCK policy the data received by a Reader is rejected instead of waiting for memory,
+ * while the rest of reservations keep waiting
+ */
+TEST(PayloadPoolTest, ingress_memory_budget_block)
+{
+    PayloadPoolConfiguration configuration = test::budget_configuration(100, MemoryBudgetPolicy::MEMORY_BLOCK);
+    configuration.memory_block_timeout = 10000;
+    test::MockPayloadPool pool(configuration);
+    EXPECT_CALL(pool, get_payload(_, _)).WillRepeatedly(Invoke(
+                [&pool](uint32_t size, Payload& payload)
+                {
+                    return pool.reserve_(size, payload);
+                }));
+
+    Payload payload_1;
+    Payload payload_2;
+    ASSERT_TRUE(pool.get_ingress_payload(100, payload_1, false));
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(pool.get_ingress_payload(50, payload_2, false));
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(5000));
+
+    std::thread releaser(
+        [&pool, &payload_1]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            pool.release_(payload_1);
+        });
+
+    ASSERT_TRUE(pool.get_payload(50, payload_2));
+    releaser.join();
+
+    ASSERT_TRUE(pool.release_(payload_2));
+}
+
+/**
+ * Test bucket of the size histogram of each size
+ *
+ * CASES:
+ *  Sizes in first bucket
+ *  Limits of buckets
+ *  Sizes larger than the last bucket
+ */
+TEST(PayloadPoolTest, statistics_size_bucket)
+{
+    // Sizes in first bucket
+    ASSERT_EQ(PayloadPoolStatistics::size_bucket(0), 0u);
+    ASSERT_EQ(PayloadPoolStatistics::size_bucket(1), 0u);
+    ASSERT_EQ(PayloadPoolStatistics::size_bucket(PayloadPoolStatistics::SMALLEST_SIZE_BUCKET), 0u);
+
+    // Limits of buckets
+    ASSERT_EQ(PayloadPoolStatistics::size_bucket(PayloadPoolStatistics::SMALLEST_SIZE_BUCKET + 1), 1u);
+    ASSERT_EQ(PayloadPoolStatistics::size_bucket(1024), 4u);
+    ASSERT_EQ(PayloadPoolStatistics::size_bucket(1025), 5u);
+
+    // Sizes larger than the last bucket
+    ASSERT_EQ(PayloadPoolStatistics::size_bucket(UINT32_MAX), PayloadPoolStatistics::NUMBER_OF_SIZE_BUCKETS - 1);
+}
+
+/**
+ * Test statistics of bytes and payloads reserved
+ *
+ * STEPS:
+ *  reserve data of different sizes
+ *  release one of them
+ *  release all
+ */
+TEST(PayloadPoolTest, statistics)
+{
+    test::MockPayloadPool pool;
+    Payload payload_1;
+    Payload payload_2;
+
+    // reserve data of different sizes
+    ASSERT_TRUE(pool.reserve_(100, payload_1));
+    ASSERT_TRUE(pool.reserve_(1000, payload_2));
+
+    PayloadPoolStatistics statistics = pool.statistics();
+    ASSERT_EQ(statistics.reserved_bytes, 1100u);
+    ASSERT_EQ(statistics.max_reserved_bytes, 1100u);
+    ASSERT_EQ(statistics.live_payloads, 2u);
+    ASSERT_EQ(statistics.reserved_payloads, 2u);
+    ASSERT_EQ(statistics.size_histogram[PayloadPoolStatistics::size_bucket(100)], 1u);
+    ASSERT_EQ(statistics.size_histogram[PayloadPoolStatistics::size_bucket(1000)], 1u);
+    ASSERT_EQ(statistics.size_histogram[0], 0u);
+
+    // release one of them
+    ASSERT_TRUE(pool.release_(payload_2));
+
+    statistics = pool.statistics();
+    ASSERT_EQ(statistics.reserved_bytes, 100u);
+    ASSERT_EQ(statistics.max_reserved_bytes, 1100u);
+    ASSERT_EQ(statistics.live_payloads, 1u);
+    ASSERT_EQ(statistics.reserved_payloads, 2u);
+
+    // release all
+    ASSERT_TRUE(pool.release_(payload_1));
+
+    statistics = pool.statistics();
+    ASSERT_EQ(statistics.reserved_bytes, 0u);
+    ASSERT_EQ(statistics.max_reserved_bytes, 1100u);
+    ASSERT_EQ(statistics.live_payloads, 0u);
+    ASSERT_EQ(statistics.referenced_payloads, 0u);
+    ASSERT_EQ(statistics.copied_payloads, 0u);
+}
+
+/**
+ * Test statistics add up the counters updated by every thread
+ *
+ * STEPS:
+ *  reserve data from more threads than shards of counters
+ *  release all from the main thread
+ */
+TEST(PayloadPoolTest, statistics_several_threads)
+{
+    constexpr unsigned int n_threads = 20;
+    constexpr unsigned int n_payloads = 100;
+
+    test::MockPayloadPool pool;
+    std::vector<std::vector<Payload>> payloads(n_threads, std::vector<Payload>(n_payloads));
+
+    // reserve data from more threads than shards of counters
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < n_threads; ++i)
+    {
+        threads.emplace_back(
+            [&pool, &payloads, i]()
+            {
+                for (Payload& payload : payloads[i])
+                {
+                    pool.reserve_(10, payload);
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    PayloadPoolStatistics statistics = pool.statistics();
+    ASSERT_EQ(statistics.reserved_payloads, n_threads * n_payloads);
+    ASSERT_EQ(statistics.live_payloads, n_threads * n_payloads);
+    ASSERT_EQ(statistics.size_histogram[0], n_threads * n_payloads);
+    ASSERT_EQ(statistics.reserved_bytes, n_threads * n_payloads * 10u);
+
+    // release all from the main thread
+    for (std::vector<Payload>& thread_payloads : payloads)
+    {
+        for (Payload& payload : thread_payloads)
+        {
+            ASSERT_TRUE(pool.release_(payload));
+        }
+    }
+
+    statistics = pool.statistics();
+    ASSERT_EQ(statistics.reserved_payloads, n_threads * n_payloads);
+    ASSERT_EQ(statistics.live_payloads, 0u);
+    ASSERT_EQ(statistics.reserved_bytes, 0u);
+    ASSERT_TRUE(pool.is_clean());
+}
+
 int main(
         int argc,
         char** argv)
@@ -0,0 +1,900 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstring>
+#include <set>
+#include <thread>
+#include <tuple>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/communication/payload_pool/FixedSizeFreeList.hpp>
+#include <ddsrouter/communication/payload_pool/PayloadPool.hpp>
+#include <ddsrouter/communication/payload_pool/RefCountPayloadPool.hpp>
+#include <ddsrouter/exceptions/InconsistencyException.hpp>
+
+using namespace eprosima::ddsrouter;
+
+const constexpr uint16_t TEST_NUMBER = 5;
+const constexpr size_t DEFAULT_SIZE = sizeof(PayloadUnit);
+const constexpr uint16_t TEST_NUMBER_THREADS = 8;
+const constexpr uint32_t TEST_NUMBER_ITERATIONS = 10000;
+const constexpr uint32_t DEDUPLICATION_SIZE = 4096;
+const constexpr uint32_t SMALL_PAYLOAD_SIZE = 64;
+const constexpr uint32_t SMALL_PAYLOAD_COUNT = 16;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+/**
+ * @brief Mock over RefCountPayloadPool implementing public access to protected variables.
+ *
+ */
+class MockRefCountPayloadPool : public RefCountPayloadPool
+{
+public:
+
+    using RefCountPayloadPool::RefCountPayloadPool;
+
+    uint64_t pointers_stored()
+    {
+        return live_payloads_;
+    }
+
+    uint32_t reference_count(
+            const Payload& payload)
+    {
+        return header_(payload)->references.load();
+    }
+
+    bool is_small_payload(
+            const Payload& payload)
+    {
+        return small_payloads_ && small_payloads_->contains(header_(payload));
+    }
+
+    void clean_all(
+            std::vector<Payload>& payloads)
+    {
+        for (Payload& payload : payloads)
+        {
+            release_payload(payload);
+        }
+    }
+
+};
+
+//! Configuration of a pool with deduplication of data from \c DEDUPLICATION_SIZE bytes
+PayloadPoolConfiguration deduplication_configuration()
+{
+    PayloadPoolConfiguration configuration;
+    configuration.deduplication = true;
+    configuration.deduplication_min_size = DEDUPLICATION_SIZE;
+    return configuration;
+}
+
+//! Get a payload of \c size bytes from \c pool with every byte set to \c value
+void get_filled_payload(
+        RefCountPayloadPool& pool,
+        uint32_t size,
+        PayloadUnit value,
+        Payload& payload)
+{
+    ASSERT_TRUE(pool.get_payload(size, payload));
+    std::memset(payload.data, value, size);
+    payload.length = size;
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/*
+ * This tests does not check the methods calling cacheChange, this is tested in generic PayloadPool test.
+ */
+
+/**
+ * Test get_payload method for new changes
+ *
+ * CASES:
+ *  Get N different pointers
+ *  fail reserve memory
+ */
+TEST(RefCountPayloadPoolTest, get_payload)
+{
+    // Get N different pointers
+    {
+        test::MockRefCountPayloadPool pool;
+        std::vector<Payload> payloads(TEST_NUMBER);
+
+        for (int i = 0; i < TEST_NUMBER; i++)
+        {
+            pool.get_payload(DEFAULT_SIZE, payloads[i]);
+
+            ASSERT_EQ(payloads[i].max_size, DEFAULT_SIZE);
+            ASSERT_EQ(pool.pointers_stored(), i + 1);
+            ASSERT_EQ(pool.reference_count(payloads[i]), 1);
+        }
+
+        // END : Clean all remaining payloads
+        pool.clean_all(payloads);
+    }
+
+    // fail reserve memory
+    {
+        test::MockRefCountPayloadPool pool;
+        Payload payload;
+
+        ASSERT_FALSE(pool.get_payload(0, payload));
+    }
+}
+
+/**
+ * Check to get_payload from a source that has been created in same pool increase references.
+ *
+ * STEPS:
+ *  get payload0
+ *  get payload1 from src payload0
+ *  get payload2 from src payload1
+ *  release payload0
+ *  get payload3 from src payload1
+ *  get payload4
+ *  get payload5 from src payload4
+ *  release all
+ */
+TEST(RefCountPayloadPoolTest, get_payload_from_src)
+{
+    test::MockRefCountPayloadPool pool_;
+    eprosima::fastrtps::rtps::IPayloadPool* pool = &pool_; // Requires to be ptr to pass it to get_payload
+
+    Payload payload0;
+    Payload payload1;
+    Payload payload2;
+    Payload payload3;
+    Payload payload4;
+    Payload payload5;
+
+    // get payload0
+    ASSERT_TRUE(pool_.get_payload(DEFAULT_SIZE, payload0));
+    ASSERT_EQ(pool_.pointers_stored(), 1);
+    ASSERT_EQ(pool_.reference_count(payload0), 1);
+
+    // get payload1 from src payload0
+    ASSERT_TRUE(pool_.get_payload(payload0, pool, payload1));
+    ASSERT_EQ(pool_.pointers_stored(), 1);
+    ASSERT_EQ(pool_.reference_count(payload1), 2);
+    ASSERT_EQ(payload1.max_size, payload0.max_size);
+    ASSERT_EQ(payload1.data, payload0.data);
+
+    // get payload2 from src payload1
+    ASSERT_TRUE(pool_.get_payload(payload1, pool, payload2));
+    ASSERT_EQ(pool_.pointers_stored(), 1);
+    ASSERT_EQ(pool_.reference_count(payload2), 3);
+    ASSERT_EQ(payload2.data, payload0.data);
+
+    // release payload0
+    ASSERT_TRUE(pool_.release_payload(payload0));
+    ASSERT_EQ(pool_.pointers_stored(), 1);
+    ASSERT_EQ(pool_.reference_count(payload2), 2);
+    ASSERT_EQ(payload0.data, nullptr);
+
+    // get payload3 from src payload1
+    ASSERT_TRUE(pool_.get_payload(payload1, pool, payload3));
+    ASSERT_EQ(pool_.pointers_stored(), 1);
+    ASSERT_EQ(pool_.reference_count(payload3), 3);
+    ASSERT_EQ(payload3.data, payload1.data);
+
+    // get payload4
+    ASSERT_TRUE(pool_.get_payload(DEFAULT_SIZE * 0x100, payload4));
+    ASSERT_EQ(pool_.pointers_stored(), 2);
+    ASSERT_EQ(pool_.reference_count(payload1), 3);
+    ASSERT_EQ(pool_.reference_count(payload4), 1);
+
+    // get payload5 from src payload4
+    ASSERT_TRUE(pool_.get_payload(payload4, pool, payload5));
+    ASSERT_EQ(pool_.pointers_stored(), 2);
+    ASSERT_EQ(pool_.reference_count(payload1), 3);
+    ASSERT_EQ(pool_.reference_count(payload5), 2);
+    ASSERT_EQ(payload5.max_size, payload4.max_size);
+    ASSERT_EQ(payload5.data, payload4.data);
+
+    // release all
+    ASSERT_TRUE(pool_.release_payload(payload1));
+    ASSERT_TRUE(pool_.release_payload(payload2));
+    ASSERT_TRUE(pool_.release_payload(payload3));
+    ASSERT_TRUE(pool_.release_payload(payload4));
+    ASSERT_TRUE(pool_.release_payload(payload5));
+
+    // Check payload pool is empty
+    ASSERT_TRUE(pool_.is_clean());
+    ASSERT_EQ(pool_.pointers_stored(), 0);
+}
+
+/**
+ * Check to get_payload from a source that has been created in a different pool
+ *
+ * STEPS:
+ *  get payload aux from pool aux
+ *  get payload from src payload aux
+ *  release payload aux from pool aux
+ *  release payload
+ */
+TEST(RefCountPayloadPoolTest, get_payload_from_src_no_owner)
+{
+    test::MockRefCountPayloadPool pool_;
+    test::MockRefCountPayloadPool pool_aux_;
+    eprosima::fastrtps::rtps::IPayloadPool* pool_aux = &pool_aux_; // Requires to be ptr to pass it to get_payload
+
+    Payload payload_src;
+    Payload payload_target;
+
+    // get payload aux from pool aux
+    pool_aux_.get_payload(DEFAULT_SIZE, payload_src);
+    payload_src.data[0] = 0x42;
+    payload_src.length = DEFAULT_SIZE;
+    ASSERT_EQ(pool_aux_.pointers_stored(), 1);
+    ASSERT_EQ(pool_.pointers_stored(), 0);
+
+    // get payload from src payload aux
+    ASSERT_TRUE(pool_.get_payload(payload_src, pool_aux, payload_target));
+    ASSERT_EQ(pool_.pointers_stored(), 1);
+    ASSERT_NE(payload_target.data, payload_src.data);
+    ASSERT_EQ(payload_target.data[0], 0x42);
+    ASSERT_EQ(payload_target.length, payload_src.length);
+
+    // release payload aux from pool aux
+    pool_aux_.release_payload(payload_src);
+    ASSERT_EQ(pool_aux_.pointers_stored(), 0);
+    ASSERT_EQ(pool_.pointers_stored(), 1);
+
+    // release payload
+    pool_.release_payload(payload_target);
+    ASSERT_EQ(pool_.pointers_stored(), 0);
+}
+
+/**
+ * Check negative cases for get_payload from source
+ *
+ * CASES:
+ *  The source says the owner is the same pool, but is not
+ *  Source has size 0 and different owner
+ */
+TEST(RefCountPayloadPoolTest, get_payload_from_src_negative)
+{
+    // The source says the owner is the same pool, but is not
+    {
+        test::MockRefCountPayloadPool pool_;
+        eprosima::fastrtps::rtps::IPayloadPool* pool = &pool_; // Requires to be ptr to pass it to get_payload
+        test::MockRefCountPayloadPool pool_aux;
+
+        Payload payload_src;
+        Payload payload_target;
+
+        // Get payload for source
+        pool_aux.get_payload(DEFAULT_SIZE, payload_src);
+
+        // In a different pool, try to source it as if it was from same pool
+        ASSERT_THROW(pool_.get_payload(payload_src, pool, payload_target), InconsistencyException);
+
+        // END : release payload
+        pool_aux.release_payload(payload_src);
+    }
+
+    // Source has size 0 and different owner
+    {
+        test::MockRefCountPayloadPool pool_;
+        eprosima::fastrtps::rtps::IPayloadPool* pool_aux = nullptr;
+
+        Payload payload_src;
+        Payload payload_target;
+
+        ASSERT_FALSE(
+            pool_.get_payload(
+                payload_src,
+                pool_aux,
+                payload_target));
+    }
+}
+
+/**
+ * Get some payloads from pool from src and release each of them separatly checking reference count
+ *
+ * STEPS:
+ *  get first payload
+ *  get N-1 payloads from first
+ *  release N-1 payloads
+ *  release first payload
+ */
+TEST(RefCountPayloadPoolTest, release_payload)
+{
+    test::MockRefCountPayloadPool pool_;
+    eprosima::fastrtps::rtps::IPayloadPool* pool = &pool_; // Requires to be ptr to pass it to get_payload
+    std::vector<Payload> payloads(TEST_NUMBER);
+
+    // get first payload
+    pool_.get_payload(DEFAULT_SIZE, payloads[0]);
+
+    // get N-1 payloads from first
+    for (int i = 1; i < TEST_NUMBER; i++)
+    {
+        pool_.get_payload(payloads[0], pool, payloads[i]);
+        ASSERT_EQ(pool_.reference_count(payloads[0]), i + 1) << i;
+    }
+
+    // release N-1 payloads
+    for (int i = 1; i < TEST_NUMBER; i++)
+    {
+        ASSERT_TRUE(pool_.release_payload(payloads[i]));
+        ASSERT_EQ(pool_.reference_count(payloads[0]), TEST_NUMBER - i) << i;
+        ASSERT_EQ(pool_.pointers_stored(), 1);
+    }
+
+    // release first payload
+    ASSERT_TRUE(pool_.release_payload(payloads[0]));
+
+    // Check payload pool is empty
+    ASSERT_TRUE(pool_.is_clean());
+    ASSERT_EQ(pool_.pointers_stored(), 0);
+}
+
+/**
+ * Check release a payload that has been get from a different payload pool
+ */
+TEST(RefCountPayloadPoolTest, release_payload_negative)
+{
+    test::MockRefCountPayloadPool pool;
+    test::MockRefCountPayloadPool pool_aux;
+    Payload payload;
+
+    pool_aux.get_payload(DEFAULT_SIZE, payload);
+
+    ASSERT_THROW(pool.release_payload(payload), InconsistencyException);
+
+    // Data of this pool cannot be freed by the payload, so it must be released
+    pool_aux.release_payload(payload);
+}
+
+/**
+ * Reference and release the same data from several threads at the same time.
+ *
+ * Data must be released only once, after the last reference is released.
+ */
+TEST(RefCountPayloadPoolTest, concurrent_references)
+{
+    test::MockRefCountPayloadPool pool_;
+    eprosima::fastrtps::rtps::IPayloadPool* pool = &pool_; // Requires to be ptr to pass it to get_payload
+
+    Payload payload_src;
+    pool_.get_payload(DEFAULT_SIZE, payload_src);
+
+    std::vector<std::thread> threads;
+    for (uint16_t i = 0; i < TEST_NUMBER_THREADS; i++)
+    {
+        threads.emplace_back(
+            [&pool_, pool, &payload_src]()
+            {
+                eprosima::fastrtps::rtps::IPayloadPool* owner = pool;
+                for (uint32_t j = 0; j < TEST_NUMBER_ITERATIONS; j++)
+                {
+                    Payload payload;
+                    pool_.get_payload(payload_src, owner, payload);
+                    pool_.release_payload(payload);
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(pool_.reference_count(payload_src), 1);
+    ASSERT_EQ(pool_.pointers_stored(), 1);
+
+    pool_.release_payload(payload_src);
+    ASSERT_TRUE(pool_.is_clean());
+}
+
+/**
+ * Test statistics count the payloads referenced and copied
+ *
+ * STEPS:
+ *  get payload
+ *  reference it from this pool
+ *  copy it from other pool
+ *  release all
+ */
+TEST(RefCountPayloadPoolTest, statistics)
+{
+    test::MockRefCountPayloadPool pool_;
+    test::MockRefCountPayloadPool pool_aux_;
+    eprosima::fastrtps::rtps::IPayloadPool* pool = &pool_; // Requires to be ptr to pass it to get_payload
+
+    Payload payload_src;
+    Payload payload_referenced;
+    Payload payload_copied;
+
+    // get payload
+    ASSERT_TRUE(pool_.get_payload(DEFAULT_SIZE, payload_src));
+    payload_src.length = DEFAULT_SIZE;
+
+    // reference it from this pool
+    ASSERT_TRUE(pool_.get_payload(payload_src, pool, payload_referenced));
+
+    // copy it from other pool
+    ASSERT_TRUE(pool_aux_.get_payload(payload_src, pool, payload_copied));
+
+    PayloadPoolStatistics statistics = pool_.statistics();
+    ASSERT_EQ(statistics.reserved_payloads, 1u);
+    ASSERT_EQ(statistics.live_payloads, 1u);
+    ASSERT_EQ(statistics.reserved_bytes, DEFAULT_SIZE);
+    ASSERT_EQ(statistics.referenced_payloads, 1u);
+    ASSERT_EQ(statistics.copied_payloads, 0u);
+
+    PayloadPoolStatistics statistics_aux = pool_aux_.statistics();
+    ASSERT_EQ(statistics_aux.reserved_payloads, 1u);
+    ASSERT_EQ(statistics_aux.referenced_payloads, 0u);
+    ASSERT_EQ(statistics_aux.copied_payloads, 1u);
+
+    // release all
+    pool_.release_payload(payload_src);
+    pool_.release_payload(payload_referenced);
+    pool_aux_.release_payload(payload_copied);
+
+    statistics = pool_.statistics();
+    ASSERT_EQ(statistics.live_payloads, 0u);
+    ASSERT_EQ(statistics.reserved_bytes, 0u);
+    ASSERT_EQ(statistics.max_reserved_bytes, DEFAULT_SIZE);
+}
+
+/**
+ * Test the payload operations of a thread count what its get_payload calls have done
+ *
+ * STEPS:
+ *  get payload
+ *  reference it from this pool
+ *  copy it from other pool
+ *  operations of other thread are not counted
+ *  release all
+ */
+TEST(RefCountPayloadPoolTest, thread_payload_operations)
+{
+    test::MockRefCountPayloadPool pool_;
+    test::MockRefCountPayloadPool pool_aux_;
+    eprosima::fastrtps::rtps::IPayloadPool* pool = &pool_; // Requires to be ptr to pass it to get_payload
+
+    Payload payload_src;
+    Payload payload_referenced;
+    Payload payload_copied;
+    Payload payload_other_thread;
+
+    // get payload
+    PayloadPool::PayloadOperations operations = PayloadPool::thread_payload_operations();
+    ASSERT_TRUE(pool_.get_payload(DEFAULT_SIZE, payload_src));
+    payload_src.length = DEFAULT_SIZE;
+    ASSERT_EQ(PayloadPool::thread_payload_operations().referenced, operations.referenced);
+    ASSERT_EQ(PayloadPool::thread_payload_operations().copied, operations.copied);
+
+    // reference it from this pool
+    ASSERT_TRUE(pool_.get_payload(payload_src, pool, payload_referenced));
+    ASSERT_EQ(PayloadPool::thread_payload_operations().referenced, operations.referenced + 1);
+    ASSERT_EQ(PayloadPool::thread_payload_operations().copied, operations.copied);
+
+    // copy it from other pool
+    ASSERT_TRUE(pool_aux_.get_payload(payload_src, pool, payload_copied));
+    ASSERT_EQ(PayloadPool::thread_payload_operations().referenced, operations.referenced + 1);
+    ASSERT_EQ(PayloadPool::thread_payload_operations().copied, operations.copied + 1);
+
+    // operations of other thread are not counted
+    std::thread other_thread(
+        [&]()
+        {
+            ASSERT_TRUE(pool_aux_.get_payload(payload_src, pool, payload_other_thread));
+        });
+    other_thread.join();
+    ASSERT_EQ(PayloadPool::thread_payload_operations().copied, operations.copied + 1);
+
+    // release all
+    pool_.release_payload(payload_src);
+    pool_.release_payload(payload_referenced);
+    pool_aux_.release_payload(payload_copied);
+    pool_aux_.release_payload(payload_other_thread);
+}
+
+/**
+ * Test payloads with the same content reference the same data
+ *
+ * CASES:
+ *  Data copied from other pool
+ *  Data received in this pool
+ *  Data released is not referenced anymore
+ */
+TEST(RefCountPayloadPoolTest, deduplication)
+{
+    // Data copied from other pool
+    {
+        test::MockRefCountPayloadPool pool_(test::deduplication_configuration());
+        test::MockRefCountPayloadPool pool_aux_;
+        eprosima::fastrtps::rtps::IPayloadPool* pool_aux = &pool_aux_;
+
+        Payload payload_src_1;
+        Payload payload_src_2;
+        test::get_filled_payload(pool_aux_, DEDUPLICATION_SIZE, 0x42, payload_src_1);
+        test::get_filled_payload(pool_aux_, DEDUPLICATION_SIZE, 0x42, payload_src_2);
+
+        Payload payload_target_1;
+        Payload payload_target_2;
+        ASSERT_TRUE(pool_.get_payload(payload_src_1, pool_aux, payload_target_1));
+        ASSERT_TRUE(pool_.get_payload(payload_src_2, pool_aux, payload_target_2));
+
+        ASSERT_EQ(payload_target_1.data, payload_target_2.data);
+        ASSERT_EQ(payload_target_2.length, DEDUPLICATION_SIZE);
+        ASSERT_EQ(pool_.reference_count(payload_target_1), 2);
+        ASSERT_EQ(pool_.pointers_stored(), 1);
+
+        PayloadPoolStatistics statistics = pool_.statistics();
+        ASSERT_EQ(statistics.copied_payloads, 1u);
+        ASSERT_EQ(statistics.deduplicated_payloads, 1u);
+        ASSERT_EQ(statistics.deduplicated_bytes, DEDUPLICATION_SIZE);
+
+        // END : release all
+        pool_aux_.release_payload(payload_src_1);
+        pool_aux_.release_payload(payload_src_2);
+        pool_.release_payload(payload_target_1);
+        pool_.release_payload(payload_target_2);
+        ASSERT_TRUE(pool_.is_clean());
+    }
+
+    // Data received in this pool
+    {
+        test::MockRefCountPayloadPool pool_(test::deduplication_configuration());
+        eprosima::fastrtps::rtps::IPayloadPool* pool = &pool_;
+
+        Payload payload_src_1;
+        Payload payload_src_2;
+        test::get_filled_payload(pool_, DEDUPLICATION_SIZE, 0x42, payload_src_1);
+        test::get_filled_payload(pool_, DEDUPLICATION_SIZE, 0x42, payload_src_2);
+
+        Payload payload_target_1;
+        Payload payload_target_2;
+        Payload payload_target_3;
+        ASSERT_TRUE(pool_.get_payload(payload_src_1, pool, payload_target_1));
+        ASSERT_TRUE(pool_.get_payload(payload_src_2, pool, payload_target_2));
+        ASSERT_TRUE(pool_.get_payload(payload_target_2, pool, payload_target_3));
+        ASSERT_EQ(payload_target_1.data, payload_src_1.data);
+        ASSERT_EQ(payload_target_2.data, payload_src_1.data);
+        ASSERT_EQ(payload_target_3.data, payload_src_1.data);
+
+        // Duplicated data is released once the source releases it
+        pool_.release_payload(payload_src_2);
+        ASSERT_EQ(pool_.pointers_stored(), 1);
+        ASSERT_EQ(pool_.reference_count(payload_src_1), 4);
+
+        PayloadPoolStatistics statistics = pool_.statistics();
+        ASSERT_EQ(statistics.referenced_payloads, 2u);
+        ASSERT_EQ(statistics.deduplicated_payloads, 1u);
+
+        // END : release all
+        pool_.release_payload(payload_src_1);
+        pool_.release_payload(payload_target_1);
+        pool_.release_payload(payload_target_2);
+        pool_.release_payload(payload_target_3);
+        ASSERT_TRUE(pool_.is_clean());
+    }
+
+    // Data released is not referenced anymore
+    {
+        test::MockRefCountPayloadPool pool_(test::deduplication_configuration());
+        test::MockRefCountPayloadPool pool_aux_;
+        eprosima::fastrtps::rtps::IPayloadPool* pool_aux = &pool_aux_;
+
+        Payload payload_src;
+        test::get_filled_payload(pool_aux_, DEDUPLICATION_SIZE, 0x42, payload_src);
+
+        Payload payload_target;
+        ASSERT_TRUE(pool_.get_payload(payload_src, pool_aux, payload_target));
+        pool_.release_payload(payload_target);
+
+        ASSERT_TRUE(pool_.get_payload(payload_src, pool_aux, payload_target));
+        ASSERT_EQ(pool_.statistics().copied_payloads, 2u);
+        ASSERT_EQ(pool_.statistics().deduplicated_payloads, 0u);
+
+        // END : release all
+        pool_aux_.release_payload(payload_src);
+        pool_.release_payload(payload_target);
+        ASSERT_TRUE(pool_.is_clean());
+    }
+}
+
+/**
+ * Test payloads that must not be deduplicated
+ *
+ * CASES:
+ *  Different content
+ *  Data smaller than the minimum size
+ *  Deduplication not configured
+ */
+TEST(RefCountPayloadPoolTest, deduplication_negative)
+{
+    std::vector<std::tuple<PayloadPoolConfiguration, uint32_t, PayloadUnit>> cases = {
+        // Different content
+        {test::deduplication_configuration(), DEDUPLICATION_SIZE, 0x43},
+        // Data smaller than the minimum size
+        {test::deduplication_configuration(), DEDUPLICATION_SIZE - 1, 0x42},
+        // Deduplication not configured
+        {PayloadPoolConfiguration(), DEDUPLICATION_SIZE, 0x42},
+    };
+
+    for (const auto& test_case : cases)
+    {
+        test::MockRefCountPayloadPool pool_(std::get<0>(test_case));
+        test::MockRefCountPayloadPool pool_aux_;
+        eprosima::fastrtps::rtps::IPayloadPool* pool_aux = &pool_aux_;
+
+        Payload payload_src_1;
+        Payload payload_src_2;
+        test::get_filled_payload(pool_aux_, std::get<1>(test_case), 0x42, payload_src_1);
+        test::get_filled_payload(pool_aux_, std::get<1>(test_case), std::get<2>(test_case), payload_src_2);
+
+        Payload payload_target_1;
+        Payload payload_target_2;
+        ASSERT_TRUE(pool_.get_payload(payload_src_1, pool_aux, payload_target_1));
+        ASSERT_TRUE(pool_.get_payload(payload_src_2, pool_aux, payload_target_2));
+
+        ASSERT_NE(payload_target_1.data, payload_target_2.data);
+        ASSERT_EQ(pool_.pointers_stored(), 2);
+        ASSERT_EQ(pool_.statistics().deduplicated_payloads, 0u);
+
+        // END : release all
+        pool_aux_.release_payload(payload_src_1);
+        pool_aux_.release_payload(payload_src_2);
+        pool_.release_payload(payload_target_1);
+        pool_.release_payload(payload_target_2);
+        ASSERT_TRUE(pool_.is_clean());
+    }
+}
+
+/**
+ * Copy the same content from several threads while releasing it.
+ *
+ * A data being released must never be referenced, and every data must be released once.
+ */
+TEST(RefCountPayloadPoolTest, concurrent_deduplication)
+{
+    test::MockRefCountPayloadPool pool_(test::deduplication_configuration());
+    test::MockRefCountPayloadPool pool_aux_;
+
+    Payload payload_src;
+    test::get_filled_payload(pool_aux_, DEDUPLICATION_SIZE, 0x42, payload_src);
+
+    std::vector<std::thread> threads;
+    for (uint16_t i = 0; i < TEST_NUMBER_THREADS; i++)
+    {
+        threads.emplace_back(
+            [&pool_, &pool_aux_, &payload_src]()
+            {
+                eprosima::fastrtps::rtps::IPayloadPool* owner = &pool_aux_;
+                for (uint32_t j = 0; j < TEST_NUMBER_ITERATIONS / 10; j++)
+                {
+                    Payload payload;
+                    ASSERT_TRUE(pool_.get_payload(payload_src, owner, payload));
+                    ASSERT_EQ(payload.data[DEDUPLICATION_SIZE - 1], 0x42);
+                    pool_.release_payload(payload);
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_TRUE(pool_.is_clean());
+
+    pool_aux_.release_payload(payload_src);
+}
+
+/**
+ * Test taking and giving back blocks of a FixedSizeFreeList
+ *
+ * CASES:
+ *  Every block is different, aligned and contained in the list
+ *  Exhausted list
+ *  Blocks given back are reused
+ *  Empty list
+ */
+TEST(RefCountPayloadPoolTest, fixed_size_free_list)
+{
+    // Every block is different, aligned and contained in the list
+    FixedSizeFreeList list(SMALL_PAYLOAD_SIZE + 1, SMALL_PAYLOAD_COUNT);
+    ASSERT_EQ(list.count(), SMALL_PAYLOAD_COUNT);
+    ASSERT_GE(list.block_size(), SMALL_PAYLOAD_SIZE + 1);
+    ASSERT_EQ(list.block_size() % alignof(std::max_align_t), 0u);
+
+    std::set<void*> blocks;
+    for (uint32_t i = 0; i < SMALL_PAYLOAD_COUNT; i++)
+    {
+        void* block = list.allocate();
+        ASSERT_NE(block, nullptr);
+        ASSERT_TRUE(list.contains(block));
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t), 0u);
+        std::memset(block, 0xAA, SMALL_PAYLOAD_SIZE + 1);
+        ASSERT_TRUE(blocks.insert(block).second);
+    }
+
+    // Exhausted list
+    ASSERT_EQ(list.allocate(), nullptr);
+
+    // Blocks given back are reused
+    void* block = *blocks.begin();
+    list.free(block);
+    ASSERT_EQ(list.allocate(), block);
+
+    for (void* block : blocks)
+    {
+        list.free(block);
+    }
+
+    int out_of_list;
+    ASSERT_FALSE(list.contains(&out_of_list));
+
+    // Empty list
+    FixedSizeFreeList empty_list(SMALL_PAYLOAD_SIZE, 0);
+    ASSERT_EQ(empty_list.allocate(), nullptr);
+    ASSERT_FALSE(empty_list.contains(&out_of_list));
+}
+
+/**
+ * Take and give back blocks of a FixedSizeFreeList from several threads.
+ *
+ * A block must never be held by two threads at the same time.
+ */
+TEST(RefCountPayloadPoolTest, concurrent_fixed_size_free_list)
+{
+    FixedSizeFreeList list(sizeof(uint32_t), SMALL_PAYLOAD_COUNT);
+
+    std::vector<std::thread> threads;
+    for (uint16_t i = 0; i < TEST_NUMBER_THREADS; i++)
+    {
+        threads.emplace_back(
+            [&list, i]()
+            {
+                for (uint32_t j = 0; j < TEST_NUMBER_ITERATIONS; j++)
+                {
+                    uint32_t* block = static_cast<uint32_t*>(list.allocate());
+                    if (block == nullptr)
+                    {
+                        continue;
+                    }
+                    *block = i;
+                    std::this_thread::yield();
+                    ASSERT_EQ(*block, i);
+                    list.free(block);
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every block is back in the list
+    for (uint32_t i = 0; i < SMALL_PAYLOAD_COUNT; i++)
+    {
+        ASSERT_NE(list.allocate(), nullptr);
+    }
+    ASSERT_EQ(list.allocate(), nullptr);
+}
+
+/**
+ * Test small data are reserved from the free list of the pool
+ *
+ * CASES:
+ *  Small data are in the free list
+ *  Larger data are not in the free list
+ *  Exhausted free list
+ *  Blocks released are reused
+ *  Memory budget
+ */
+TEST(RefCountPayloadPoolTest, small_payloads)
+{
+    PayloadPoolConfiguration configuration;
+    configuration.small_payload_size = SMALL_PAYLOAD_SIZE;
+    configuration.small_payload_count = SMALL_PAYLOAD_COUNT;
+
+    // Small data are in the free list
+    {
+        test::MockRefCountPayloadPool pool(configuration);
+
+        Payload payload;
+        ASSERT_TRUE(pool.get_payload(SMALL_PAYLOAD_SIZE, payload));
+        ASSERT_TRUE(pool.is_small_payload(payload));
+        ASSERT_EQ(payload.max_size, SMALL_PAYLOAD_SIZE);
+        std::memset(payload.data, 0xAA, SMALL_PAYLOAD_SIZE);
+
+        // References share the block
+        Payload payload_reference;
+        eprosima::fastrtps::rtps::IPayloadPool* owner = &pool;
+        ASSERT_TRUE(pool.get_payload(payload, owner, payload_reference));
+        ASSERT_EQ(payload_reference.data, payload.data);
+
+        pool.release_payload(payload);
+        pool.release_payload(payload_reference);
+        ASSERT_TRUE(pool.is_clean());
+    }
+
+    // Larger data are not in the free list
+    {
+        test::MockRefCountPayloadPool pool(configuration);
+
+        Payload payload;
+        ASSERT_TRUE(pool.get_payload(SMALL_PAYLOAD_SIZE + 1, payload));
+        ASSERT_FALSE(pool.is_small_payload(payload));
+
+        pool.release_payload(payload);
+        ASSERT_TRUE(pool.is_clean());
+    }
+
+    // Exhausted free list
+    {
+        test::MockRefCountPayloadPool pool(configuration);
+
+        std::vector<Payload> payloads(SMALL_PAYLOAD_COUNT + 1);
+        for (uint32_t i = 0; i < SMALL_PAYLOAD_COUNT; i++)
+        {
+            ASSERT_TRUE(pool.get_payload(DEFAULT_SIZE, payloads[i]));
+            ASSERT_TRUE(pool.is_small_payload(payloads[i]));
+        }
+        ASSERT_TRUE(pool.get_payload(DEFAULT_SIZE, payloads[SMALL_PAYLOAD_COUNT]));
+        ASSERT_FALSE(pool.is_small_payload(payloads[SMALL_PAYLOAD_COUNT]));
+
+        // Blocks released are reused
+        PayloadUnit* data = payloads[0].data;
+        pool.release_payload(payloads[0]);
+        ASSERT_TRUE(pool.get_payload(DEFAULT_SIZE, payloads[0]));
+        ASSERT_EQ(payloads[0].data, data);
+
+        pool.clean_all(payloads);
+        ASSERT_TRUE(pool.is_clean());
+    }
+
+    // Memory budget
+    {
+        PayloadPoolConfiguration budget_configuration = configuration;
+        budget_configuration.memory_budget = SMALL_PAYLOAD_SIZE;
+        test::MockRefCountPayloadPool pool(budget_configuration);
+
+        Payload payload_1;
+        Payload payload_2;
+        ASSERT_TRUE(pool.get_payload(DEFAULT_SIZE, payload_1));
+        ASSERT_EQ(pool.statistics().reserved_bytes, SMALL_PAYLOAD_SIZE);
+        ASSERT_FALSE(pool.get_payload(DEFAULT_SIZE, payload_2));
+
+        pool.release_payload(payload_1);
+        ASSERT_TRUE(pool.is_clean());
+        ASSERT_EQ(pool.statistics().reserved_bytes, 0u);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
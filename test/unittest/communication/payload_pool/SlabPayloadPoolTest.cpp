@@ -0,0 +1,368 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <thread>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/communication/payload_pool/SlabPayloadPool.hpp>
+#include <ddsrouter/exceptions/InconsistencyException.hpp>
+
+using namespace eprosima::ddsrouter;
+
+const constexpr uint16_t TEST_NUMBER = 5;
+const constexpr uint32_t TEST_NUMBER_ITERATIONS = 10000;
+
+/**
+ * Test size class of different sizes
+ *
+ * CASES:
+ *  Sizes smaller than the minimum size class
+ *  Powers of two
+ *  Sizes between powers of two
+ *  Sizes larger than the maximum size class
+ *  Maximum size class configured
+ */
+TEST(SlabPayloadPoolTest, size_class)
+{
+    // Sizes smaller than the minimum size class
+    ASSERT_EQ(SlabPayloadPool::size_class(1), SlabPayloadPool::MIN_SIZE_CLASS);
+    ASSERT_EQ(SlabPayloadPool::size_class(SlabPayloadPool::MIN_SIZE_CLASS), SlabPayloadPool::MIN_SIZE_CLASS);
+
+    // Powers of two
+    ASSERT_EQ(SlabPayloadPool::size_class(1024), 1024u);
+    ASSERT_EQ(SlabPayloadPool::size_class(SlabPayloadPool::MAX_SIZE_CLASS), SlabPayloadPool::MAX_SIZE_CLASS);
+
+    // Sizes between powers of two
+    ASSERT_EQ(SlabPayloadPool::size_class(SlabPayloadPool::MIN_SIZE_CLASS + 1), SlabPayloadPool::MIN_SIZE_CLASS * 2);
+    ASSERT_EQ(SlabPayloadPool::size_class(1000), 1024u);
+    ASSERT_EQ(SlabPayloadPool::size_class(1025), 2048u);
+
+    // Sizes larger than the maximum size class
+    ASSERT_EQ(SlabPayloadPool::size_class(SlabPayloadPool::MAX_SIZE_CLASS + 1), 0u);
+
+    // Maximum size class configured
+    ASSERT_EQ(SlabPayloadPool::size_class(SlabPayloadPool::MAX_SIZE_CLASS + 1, SlabPayloadPool::LARGEST_SIZE_CLASS),
+            SlabPayloadPool::MAX_SIZE_CLASS * 2);
+    ASSERT_EQ(SlabPayloadPool::size_class(SlabPayloadPool::LARGEST_SIZE_CLASS, SlabPayloadPool::LARGEST_SIZE_CLASS),
+            SlabPayloadPool::LARGEST_SIZE_CLASS);
+    ASSERT_EQ(SlabPayloadPool::size_class(1025, 1024), 0u);
+}
+
+/**
+ * Test data released is reused by next data of the same size class
+ *
+ * STEPS:
+ *  get N payloads of same size class
+ *  release all
+ *  get N payloads of same size class, reusing the blocks
+ *  get payload of a different size class
+ */
+TEST(SlabPayloadPoolTest, reuse_released_data)
+{
+    SlabPayloadPool pool;
+    std::vector<Payload> payloads(TEST_NUMBER);
+    std::set<PayloadUnit*> data;
+
+    // get N payloads of same size class
+    for (int i = 0; i < TEST_NUMBER; i++)
+    {
+        ASSERT_TRUE(pool.get_payload(1000, payloads[i]));
+        ASSERT_EQ(payloads[i].max_size, 1000u);
+        data.insert(payloads[i].data);
+    }
+    ASSERT_EQ(pool.heap_allocations(), TEST_NUMBER);
+
+    // release all
+    for (int i = 0; i < TEST_NUMBER; i++)
+    {
+        ASSERT_TRUE(pool.release_payload(payloads[i]));
+    }
+    ASSERT_TRUE(pool.is_clean());
+
+    // get N payloads of same size class, reusing the blocks
+    for (int i = 0; i < TEST_NUMBER; i++)
+    {
+        ASSERT_TRUE(pool.get_payload(600 + i, payloads[i]));
+        ASSERT_NE(data.find(payloads[i].data), data.end());
+    }
+    ASSERT_EQ(pool.heap_allocations(), TEST_NUMBER);
+
+    // get payload of a different size class
+    Payload payload;
+    ASSERT_TRUE(pool.get_payload(10, payload));
+    ASSERT_EQ(pool.heap_allocations(), TEST_NUMBER + 1);
+
+    // END : release all
+    pool.release_payload(payload);
+    for (int i = 0; i < TEST_NUMBER; i++)
+    {
+        pool.release_payload(payloads[i]);
+    }
+    ASSERT_TRUE(pool.is_clean());
+}
+
+/**
+ * Test payloads preallocated in construction are used without allocating new ones
+ *
+ * CASES:
+ *  Preallocated payloads are used
+ *  Preallocation larger than the maximum size class is ignored
+ */
+TEST(SlabPayloadPoolTest, preallocation)
+{
+    // Preallocated payloads are used
+    {
+        PayloadPoolConfiguration configuration;
+        configuration.preallocated_payloads = {{1000, TEST_NUMBER}, {100, 1}};
+        SlabPayloadPool pool(configuration);
+        ASSERT_EQ(pool.heap_allocations(), TEST_NUMBER + 1);
+
+        std::vector<Payload> payloads(TEST_NUMBER);
+        for (int i = 0; i < TEST_NUMBER; i++)
+        {
+            ASSERT_TRUE(pool.get_payload(1024, payloads[i]));
+        }
+        ASSERT_EQ(pool.heap_allocations(), TEST_NUMBER + 1);
+
+        // END : release all
+        for (int i = 0; i < TEST_NUMBER; i++)
+        {
+            pool.release_payload(payloads[i]);
+        }
+    }
+
+    // Preallocation larger than the maximum size class is ignored
+    {
+        PayloadPoolConfiguration configuration;
+        configuration.preallocated_payloads = {{SlabPayloadPool::MAX_SIZE_CLASS + 1, TEST_NUMBER}};
+        SlabPayloadPool pool(configuration);
+        ASSERT_EQ(pool.heap_allocations(), 0u);
+    }
+}
+
+/**
+ * Test data larger than the maximum size class is reserved from the heap and not kept
+ */
+TEST(SlabPayloadPoolTest, large_data)
+{
+    SlabPayloadPool pool;
+    Payload payload;
+
+    ASSERT_TRUE(pool.get_payload(SlabPayloadPool::MAX_SIZE_CLASS + 1, payload));
+    ASSERT_EQ(payload.max_size, SlabPayloadPool::MAX_SIZE_CLASS + 1);
+    ASSERT_EQ(pool.heap_allocations(), 0u);
+
+    ASSERT_TRUE(pool.release_payload(payload));
+    ASSERT_TRUE(pool.is_clean());
+}
+
+/**
+ * Check references to the data and release of data from other pool work as in the parent class
+ *
+ * STEPS:
+ *  get payload
+ *  get payload from src payload
+ *  release payload from a different pool
+ *  release all
+ */
+TEST(SlabPayloadPoolTest, get_payload_from_src)
+{
+    SlabPayloadPool pool_;
+    SlabPayloadPool pool_aux;
+    eprosima::fastrtps::rtps::IPayloadPool* pool = &pool_; // Requires to be ptr to pass it to get_payload
+
+    Payload payload_src;
+    Payload payload_target;
+
+    // get payload
+    ASSERT_TRUE(pool_.get_payload(100, payload_src));
+
+    // get payload from src payload
+    ASSERT_TRUE(pool_.get_payload(payload_src, pool, payload_target));
+    ASSERT_EQ(payload_target.data, payload_src.data);
+
+    // release payload from a different pool
+    ASSERT_THROW(pool_aux.release_payload(payload_target), InconsistencyException);
+
+    // release all
+    ASSERT_TRUE(pool_.release_payload(payload_src));
+    ASSERT_FALSE(pool_.is_clean());
+    ASSERT_TRUE(pool_.release_payload(payload_target));
+    ASSERT_TRUE(pool_.is_clean());
+    ASSERT_EQ(pool_.heap_allocations(), 1u);
+}
+
+/**
+ * Reserve data in a thread and release it in another one, as the Readers and the Tracks do.
+ *
+ * Once every magazine and the depot are filled, no more data is allocated from the heap.
+ */
+TEST(SlabPayloadPoolTest, producer_consumer)
+{
+    SlabPayloadPool pool;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::queue<Payload*> queue;
+    bool finished = false;
+
+    std::thread consumer(
+        [&]()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                cv.wait(lock, [&](){
+                    return !queue.empty() || finished;
+                });
+                if (queue.empty())
+                {
+                    return;
+                }
+                Payload* payload = queue.front();
+                queue.pop();
+                pool.release_payload(*payload);
+                delete payload;
+                cv.notify_one();
+            }
+        });
+
+    for (uint32_t i = 0; i < TEST_NUMBER_ITERATIONS; i++)
+    {
+        Payload* payload = new Payload();
+        ASSERT_TRUE(pool.get_payload(100, *payload));
+        {
+            // Bound the payloads in flight, so the blocks released by the consumer are reused
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&](){
+                return queue.size() < SlabPayloadPool::MAGAZINE_SIZE;
+            });
+            queue.push(payload);
+        }
+        cv.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+    }
+    cv.notify_one();
+    consumer.join();
+
+    ASSERT_TRUE(pool.is_clean());
+    ASSERT_LT(pool.heap_allocations(), TEST_NUMBER_ITERATIONS);
+}
+
+/**
+ * Destroy the pool while other thread still keeps blocks of it in its magazines.
+ *
+ * Blocks are freed when the thread finishes (checked by leak sanitizer when enabled).
+ */
+TEST(SlabPayloadPoolTest, destroy_with_thread_magazines)
+{
+    SlabPayloadPool* pool = new SlabPayloadPool();
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool released = false;
+    bool destroyed = false;
+
+    std::thread thread(
+        [&]()
+        {
+            Payload payload;
+            pool->get_payload(100, payload);
+            pool->release_payload(payload);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            released = true;
+            cv.notify_one();
+            cv.wait(lock, [&](){
+                return destroyed;
+            });
+        });
+
+    // Wait till the thread has released its payload
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&](){
+            return released;
+        });
+    }
+
+    ASSERT_TRUE(pool->is_clean());
+    delete pool;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        destroyed = true;
+    }
+    cv.notify_one();
+    thread.join();
+}
+
+/**
+ * Test the memory budget accounts the size class of each data and not the size requested
+ *
+ * STEPS:
+ *  get payloads till the budget is full
+ *  next payload is rejected
+ *  release one payload and get a new one
+ */
+TEST(SlabPayloadPoolTest, memory_budget)
+{
+    PayloadPoolConfiguration configuration;
+    configuration.memory_budget = 2048;
+    SlabPayloadPool pool(configuration);
+    std::vector<Payload> payloads(2);
+
+    // get payloads till the budget is full
+    for (Payload& payload : payloads)
+    {
+        ASSERT_TRUE(pool.get_payload(1000, payload));
+    }
+    ASSERT_EQ(pool.reserved_bytes(), 2048u);
+
+    // next payload is rejected
+    Payload payload;
+    ASSERT_FALSE(pool.get_payload(10, payload));
+    ASSERT_EQ(pool.reserved_bytes(), 2048u);
+
+    // release one payload and get a new one
+    ASSERT_TRUE(pool.release_payload(payloads[0]));
+    ASSERT_EQ(pool.reserved_bytes(), 1024u);
+    ASSERT_TRUE(pool.get_payload(10, payload));
+    ASSERT_EQ(pool.reserved_bytes(), 1024u + SlabPayloadPool::MIN_SIZE_CLASS);
+
+    // END : release all
+    pool.release_payload(payload);
+    pool.release_payload(payloads[1]);
+    ASSERT_TRUE(pool.is_clean());
+    ASSERT_EQ(pool.reserved_bytes(), 0u);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
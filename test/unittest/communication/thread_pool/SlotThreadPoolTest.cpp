@@ -0,0 +1,368 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/communication/thread_pool/SlotThreadPool.hpp>
+
+using namespace eprosima::ddsrouter;
+
+const constexpr unsigned int TEST_NUMBER_THREADS = 4;
+const constexpr unsigned int TEST_NUMBER_SLOTS = 20;
+const constexpr unsigned int TEST_NUMBER_EMISSIONS = 1000;
+
+/*
+ * Wait till the value of \c counter reaches \c expected or a timeout expires
+ */
+bool wait_for_counter(
+        const std::atomic<unsigned int>& counter,
+        unsigned int expected)
+{
+    for (unsigned int i = 0; i < 500 && counter.load() < expected; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return counter.load() >= expected;
+}
+
+/**
+ * Test that the pool creates the required threads
+ *
+ * CASES:
+ *  Several threads
+ *  0 threads creates 1 thread
+ */
+TEST(SlotThreadPoolTest, constructor)
+{
+    {
+        SlotThreadPool pool(TEST_NUMBER_THREADS);
+        EXPECT_EQ(pool.n_threads(), TEST_NUMBER_THREADS);
+    }
+
+    {
+        SlotThreadPool pool(0);
+        EXPECT_EQ(pool.n_threads(), 1u);
+    }
+}
+
+/**
+ * Test that emitting a slot executes its task
+ *
+ * CASES:
+ *  One emission
+ *  Emissions of several slots
+ */
+TEST(SlotThreadPoolTest, emit)
+{
+    SlotThreadPool pool(TEST_NUMBER_THREADS);
+
+    std::atomic<unsigned int> counters[TEST_NUMBER_SLOTS];
+    TaskId ids[TEST_NUMBER_SLOTS];
+    for (unsigned int i = 0; i < TEST_NUMBER_SLOTS; ++i)
+    {
+        counters[i].store(0);
+        ids[i] = pool.register_slot(
+            [&counters, i]()
+            {
+                counters[i]++;
+            });
+    }
+
+    // One emission
+    pool.emit(ids[0]);
+    ASSERT_TRUE(wait_for_counter(counters[0], 1));
+
+    // Emissions of several slots
+    for (unsigned int i = 0; i < TEST_NUMBER_SLOTS; ++i)
+    {
+        pool.emit(ids[i]);
+    }
+    for (unsigned int i = 0; i < TEST_NUMBER_SLOTS; ++i)
+    {
+        ASSERT_TRUE(wait_for_counter(counters[i], (i == 0 ? 2 : 1)));
+    }
+
+    for (unsigned int i = 0; i < TEST_NUMBER_SLOTS; ++i)
+    {
+        pool.unregister_slot(ids[i]);
+    }
+}
+
+/**
+ * Test that a slot is never executed concurrently and that an emission while it is running is not lost
+ *
+ * CASES:
+ *  Many emissions from different threads over the same slot
+ */
+TEST(SlotThreadPoolTest, slot_serialized)
+{
+    SlotThreadPool pool(TEST_NUMBER_THREADS);
+
+    std::atomic<unsigned int> executing(0);
+    std::atomic<unsigned int> executions(0);
+    std::atomic<bool> concurrent_execution(false);
+
+    TaskId id = pool.register_slot(
+        [&]()
+        {
+            if (executing++ != 0)
+            {
+                concurrent_execution.store(true);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            executions++;
+            executing--;
+        });
+
+    std::vector<std::thread> emitters;
+    for (unsigned int i = 0; i < TEST_NUMBER_THREADS; ++i)
+    {
+        emitters.emplace_back(
+            [&pool, id]()
+            {
+                for (unsigned int j = 0; j < TEST_NUMBER_EMISSIONS; ++j)
+                {
+                    pool.emit(id);
+                }
+            });
+    }
+    for (std::thread& emitter : emitters)
+    {
+        emitter.join();
+    }
+
+    // Last emission must always produce an execution after it
+    unsigned int executions_after_emissions = executions.load();
+    pool.emit(id);
+    ASSERT_TRUE(wait_for_counter(executions, executions_after_emissions + 1));
+
+    pool.unregister_slot(id);
+
+    EXPECT_FALSE(concurrent_execution.load());
+    EXPECT_LE(executions.load(), TEST_NUMBER_THREADS * TEST_NUMBER_EMISSIONS + 1);
+}
+
+/**
+ * Test that a slot unregistered is not executed anymore
+ *
+ * CASES:
+ *  Unregister waits for the running task
+ *  Emit after unregister does nothing
+ */
+TEST(SlotThreadPoolTest, unregister_slot)
+{
+    SlotThreadPool pool(TEST_NUMBER_THREADS);
+
+    std::atomic<unsigned int> started(0);
+    std::atomic<unsigned int> finished(0);
+
+    TaskId id = pool.register_slot(
+        [&]()
+        {
+            started++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished++;
+        });
+
+    // Unregister waits for the running task
+    pool.emit(id);
+    ASSERT_TRUE(wait_for_counter(started, 1));
+    pool.unregister_slot(id);
+    EXPECT_EQ(finished.load(), 1u);
+
+    // Emit after unregister does nothing
+    pool.emit(id);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(started.load(), 1u);
+}
+
+/**
+ * Test that slots queued in a worker that is busy are executed by other workers
+ *
+ * CASES:
+ *  One slot blocks a worker while the rest of slots are emitted
+ */
+TEST(SlotThreadPoolTest, work_stealing)
+{
+    SlotThreadPool pool(TEST_NUMBER_THREADS);
+
+    std::atomic<bool> release_blocking(false);
+    std::atomic<unsigned int> blocking_started(0);
+    TaskId blocking_id = pool.register_slot(
+        [&]()
+        {
+            blocking_started++;
+            while (!release_blocking)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+    pool.emit(blocking_id);
+    ASSERT_TRUE(wait_for_counter(blocking_started, 1));
+
+    // Slots are distributed among every worker queue, the blocked one included
+    std::atomic<unsigned int> executions(0);
+    std::vector<TaskId> ids;
+    for (unsigned int i = 0; i < TEST_NUMBER_SLOTS; ++i)
+    {
+        ids.push_back(pool.register_slot(
+                    [&executions]()
+                    {
+                        executions++;
+                    }));
+        pool.emit(ids.back());
+    }
+
+    // Every slot is executed while the blocked worker is still blocked
+    ASSERT_TRUE(wait_for_counter(executions, TEST_NUMBER_SLOTS));
+    EXPECT_FALSE(release_blocking.load());
+
+    release_blocking.store(true);
+    pool.unregister_slot(blocking_id);
+    for (TaskId id : ids)
+    {
+        pool.unregister_slot(id);
+    }
+}
+
+/**
+ * Test that a slot emitted inline is executed in the calling thread when idle, and by the pool otherwise
+ *
+ * CASES:
+ *  Idle slot is executed by the calling thread
+ *  Running slot is executed again afterwards by the pool
+ */
+TEST(SlotThreadPoolTest, emit_inline)
+{
+    SlotThreadPool pool(TEST_NUMBER_THREADS);
+
+    std::atomic<unsigned int> executions(0);
+    std::atomic<bool> block(false);
+    std::thread::id last_thread;
+
+    TaskId id = pool.register_slot(
+        [&]()
+        {
+            last_thread = std::this_thread::get_id();
+            executions++;
+            while (block)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+    // Idle slot is executed by the calling thread
+    pool.emit_inline(id);
+    EXPECT_EQ(executions.load(), 1u);
+    EXPECT_EQ(last_thread, std::this_thread::get_id());
+
+    // Running slot is executed again afterwards by the pool
+    block.store(true);
+    std::thread inline_thread([&pool, id]()
+            {
+                pool.emit_inline(id);
+            });
+    ASSERT_TRUE(wait_for_counter(executions, 2));
+
+    pool.emit_inline(id);
+    EXPECT_EQ(executions.load(), 2u);
+
+    block.store(false);
+    inline_thread.join();
+    ASSERT_TRUE(wait_for_counter(executions, 3));
+
+    pool.unregister_slot(id);
+    EXPECT_NE(last_thread, std::this_thread::get_id());
+}
+
+/**
+ * Test that a pool with a thread per slot runs each slot in its own thread
+ *
+ * CASES:
+ *  Each slot is executed by a different thread, that is not the calling one
+ *  A slot blocked does not delay the rest
+ *  Unregister waits for the running task
+ */
+TEST(SlotThreadPoolTest, thread_per_slot)
+{
+    SlotThreadPool pool(TEST_NUMBER_THREADS, true);
+    EXPECT_EQ(pool.n_threads(), 0u);
+
+    std::atomic<bool> release_blocking(false);
+    std::atomic<unsigned int> blocking_started(0);
+    std::atomic<unsigned int> blocking_finished(0);
+    TaskId blocking_id = pool.register_slot(
+        [&]()
+        {
+            blocking_started++;
+            while (!release_blocking)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            blocking_finished++;
+        });
+
+    pool.emit_inline(blocking_id);
+    ASSERT_TRUE(wait_for_counter(blocking_started, 1));
+
+    // Each slot is executed by a different thread, and a slot blocked does not delay the rest
+    std::atomic<unsigned int> executions(0);
+    std::thread::id threads[TEST_NUMBER_SLOTS];
+    std::vector<TaskId> ids;
+    for (unsigned int i = 0; i < TEST_NUMBER_SLOTS; ++i)
+    {
+        ids.push_back(pool.register_slot(
+                    [&executions, &threads, i]()
+                    {
+                        threads[i] = std::this_thread::get_id();
+                        executions++;
+                    }));
+        pool.emit(ids.back());
+    }
+
+    ASSERT_TRUE(wait_for_counter(executions, TEST_NUMBER_SLOTS));
+    for (unsigned int i = 0; i < TEST_NUMBER_SLOTS; ++i)
+    {
+        EXPECT_NE(threads[i], std::this_thread::get_id());
+        for (unsigned int j = 0; j < i; ++j)
+        {
+            EXPECT_NE(threads[i], threads[j]);
+        }
+    }
+
+    // Unregister waits for the running task
+    release_blocking.store(true);
+    pool.unregister_slot(blocking_id);
+    EXPECT_EQ(blocking_finished.load(), 1u);
+
+    for (TaskId id : ids)
+    {
+        pool.unregister_slot(id);
+    }
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -21,6 +21,7 @@
 #include <ddsrouter/configuration/DDSRouterConfiguration.hpp>
 #include <ddsrouter/exceptions/ConfigurationException.hpp>
 #include <ddsrouter/types/configuration_tags.hpp>
+#include <ddsrouter/types/numa.hpp>
 #include <ddsrouter/types/RawConfiguration.hpp>
 #include <ddsrouter/types/topic/WildcardTopic.hpp>
 
@@ -299,6 +300,7 @@ TEST(ConfigurationTest, constructor)
  *  Other tags that are not participant valid ids
  *  One Participant Configuration
  *  Many Participant Configurations
+ *  Participant placed in a NUMA node
  */
 TEST(ConfigurationTest, participants_configurations)
 {
@@ -377,6 +379,27 @@ TEST(ConfigurationTest, participants_configurations)
             ASSERT_TRUE(in_configurations);
         }
     }
+
+    {
+        // Participant placed in a NUMA node
+        RawConfiguration yaml5;
+        yaml5["participant"][PARTICIPANT_TYPE_TAG] = "dummy";
+        yaml5["participant"][PARTICIPANT_NUMA_NODE_TAG] = 1;
+        yaml5["other_participant"][PARTICIPANT_TYPE_TAG] = "dummy";
+        DDSRouterConfiguration config5(yaml5);
+
+        for (auto part_config: config5.participants_configurations())
+        {
+            if (part_config.id() == ParticipantId("participant"))
+            {
+                EXPECT_EQ(part_config.numa_node(), 1);
+            }
+            else
+            {
+                EXPECT_EQ(part_config.numa_node(), numa::NO_NUMA_NODE);
+            }
+        }
+    }
 }
 
 /**
@@ -562,6 +585,482 @@ TEST(ConfigurationTest, allowlist_and_blocklist)
     EXPECT_EQ(config.blocklist().size(), random_filter_topic_names().size());
 }
 
+/**
+ * Test get number of threads from yaml
+ *
+ * CASES:
+ *  Empty configuration
+ *  Specs without threads
+ *  Threads set
+ *  Thread per Track
+ */
+TEST(ConfigurationTest, number_of_threads)
+{
+    {
+        // Empty configuration
+        RawConfiguration yaml;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.number_of_threads(), DDSRouterConfiguration::DEFAULT_NUMBER_OF_THREADS);
+        EXPECT_FALSE(config.thread_per_track());
+    }
+
+    {
+        // Specs without threads
+        RawConfiguration yaml;
+        yaml[SPECS_TAG]["other_tag"] = "value";
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.number_of_threads(), DDSRouterConfiguration::DEFAULT_NUMBER_OF_THREADS);
+    }
+
+    {
+        // Threads set
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][NUMBER_THREADS_TAG] = 3;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.number_of_threads(), 3u);
+
+        // Specs is not taken as a Participant
+        EXPECT_TRUE(config.participants_configurations().empty());
+    }
+
+    {
+        // Thread per Track
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][THREAD_PER_TRACK_TAG] = true;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_TRUE(config.thread_per_track());
+    }
+}
+
+/**
+ * Test get interest driven endpoints and their grace period from yaml
+ *
+ * CASES:
+ *  Empty configuration
+ *  Interest driven endpoints with grace period
+ */
+TEST(ConfigurationTest, interest_driven_endpoints)
+{
+    {
+        // Empty configuration
+        RawConfiguration yaml;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_FALSE(config.interest_driven_endpoints());
+        EXPECT_EQ(config.endpoint_grace_period(), DDSRouterConfiguration::DEFAULT_ENDPOINT_GRACE_PERIOD);
+    }
+
+    {
+        // Interest driven endpoints with grace period
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG] = true;
+        yaml[SPECS_TAG][ENDPOINT_GRACE_PERIOD_TAG] = 200;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_TRUE(config.interest_driven_endpoints());
+        EXPECT_EQ(config.endpoint_grace_period(), 200u);
+    }
+}
+
+/**
+ * Test get lazy bridges from yaml
+ *
+ * CASES:
+ *  Empty configuration
+ *  Lazy bridges by default with interest driven endpoints
+ *  Lazy bridges set
+ *  Lazy bridges unset with interest driven endpoints
+ */
+TEST(ConfigurationTest, lazy_bridges)
+{
+    {
+        // Empty configuration
+        RawConfiguration yaml;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_FALSE(config.lazy_bridges());
+    }
+
+    {
+        // Lazy bridges by default with interest driven endpoints
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG] = true;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_TRUE(config.lazy_bridges());
+    }
+
+    {
+        // Lazy bridges set
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][LAZY_BRIDGES_TAG] = true;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_TRUE(config.lazy_bridges());
+        EXPECT_FALSE(config.interest_driven_endpoints());
+    }
+
+    {
+        // Lazy bridges unset with interest driven endpoints
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG] = true;
+        yaml[SPECS_TAG][LAZY_BRIDGES_TAG] = false;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_FALSE(config.lazy_bridges());
+        EXPECT_TRUE(config.interest_driven_endpoints());
+    }
+}
+
+/**
+ * Test get bridge idle timeout from yaml
+ *
+ * CASES:
+ *  Empty configuration
+ *  Idle timeout set
+ */
+TEST(ConfigurationTest, bridge_idle_timeout)
+{
+    {
+        // Empty configuration
+        RawConfiguration yaml;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.bridge_idle_timeout(), 0u);
+    }
+
+    {
+        // Idle timeout set
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][BRIDGE_IDLE_TIMEOUT_TAG] = 60000;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.bridge_idle_timeout(), 60000u);
+    }
+}
+
+/**
+ * Test get payload pool configuration from yaml
+ *
+ * CASES:
+ *  Empty configuration
+ *  Payload pool without type
+ *  Map payload pool
+ *  Refcount payload pool
+ *  Slab payload pool with preallocation
+ *  Copy size of payloads from other pools
+ *  Memory budget with each policy
+ *  Arena payload pool with huge pages
+ */
+TEST(ConfigurationTest, payload_pool_configuration)
+{
+    {
+        // Empty configuration
+        RawConfiguration yaml;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.payload_pool_configuration().kind, PayloadPoolKind::MAP_PAYLOAD_POOL);
+    }
+
+    {
+        // Payload pool without type
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG]["other_tag"] = "value";
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.payload_pool_configuration().kind, PayloadPoolKind::MAP_PAYLOAD_POOL);
+    }
+
+    {
+        // Map payload pool
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = PAYLOAD_POOL_MAP_TAG;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.payload_pool_configuration().kind, PayloadPoolKind::MAP_PAYLOAD_POOL);
+    }
+
+    {
+        // Refcount payload pool
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = PAYLOAD_POOL_REFCOUNT_TAG;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_EQ(config.payload_pool_configuration().kind, PayloadPoolKind::REFCOUNT_PAYLOAD_POOL);
+    }
+
+    {
+        // Slab payload pool with preallocation
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = PAYLOAD_POOL_SLAB_TAG;
+        RawConfiguration preallocation1;
+        preallocation1[PAYLOAD_POOL_SIZE_TAG] = 1024;
+        preallocation1[PAYLOAD_POOL_COUNT_TAG] = 100;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_PREALLOCATE_TAG].push_back(preallocation1);
+        RawConfiguration preallocation2;
+        preallocation2[PAYLOAD_POOL_SIZE_TAG] = 64;
+        preallocation2[PAYLOAD_POOL_COUNT_TAG] = 10;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_PREALLOCATE_TAG].push_back(preallocation2);
+        DDSRouterConfiguration config(yaml);
+
+        PayloadPoolConfiguration pool_configuration = config.payload_pool_configuration();
+        EXPECT_EQ(pool_configuration.kind, PayloadPoolKind::SLAB_PAYLOAD_POOL);
+        std::map<uint32_t, unsigned int> expected_preallocation = {{1024, 100}, {64, 10}};
+        EXPECT_EQ(pool_configuration.preallocated_payloads, expected_preallocation);
+        EXPECT_EQ(pool_configuration.copy_size, PayloadCopySize::COPY_MAX_SIZE);
+    }
+
+    {
+        // Copy size of payloads from other pools
+        std::vector<std::pair<const char*, PayloadCopySize>> copy_sizes = {
+            {PAYLOAD_POOL_COPY_MAX_SIZE_TAG, PayloadCopySize::COPY_MAX_SIZE},
+            {PAYLOAD_POOL_COPY_LENGTH_TAG, PayloadCopySize::COPY_LENGTH},
+            {PAYLOAD_POOL_COPY_SIZE_CLASS_TAG, PayloadCopySize::COPY_SIZE_CLASS},
+        };
+
+        for (const auto& copy_size : copy_sizes)
+        {
+            RawConfiguration yaml;
+            yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_COPY_SIZE_TAG] = copy_size.first;
+            DDSRouterConfiguration config(yaml);
+            EXPECT_EQ(config.payload_pool_configuration().copy_size, copy_size.second);
+        }
+    }
+
+    {
+        // Memory budget with each policy
+        std::vector<std::pair<const char*, MemoryBudgetPolicy>> policies = {
+            {PAYLOAD_POOL_MEMORY_REJECT_TAG, MemoryBudgetPolicy::MEMORY_REJECT},
+            {PAYLOAD_POOL_MEMORY_EVICT_TAG, MemoryBudgetPolicy::MEMORY_EVICT},
+            {PAYLOAD_POOL_MEMORY_BLOCK_TAG, MemoryBudgetPolicy::MEMORY_BLOCK},
+        };
+
+        for (const auto& policy : policies)
+        {
+            RawConfiguration yaml;
+            yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_MEMORY_BUDGET_TAG] = 1000000;
+            yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_MEMORY_POLICY_TAG] = policy.first;
+            yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_MEMORY_BLOCK_TIMEOUT_TAG] = 50;
+            DDSRouterConfiguration config(yaml);
+
+            PayloadPoolConfiguration pool_configuration = config.payload_pool_configuration();
+            EXPECT_EQ(pool_configuration.memory_budget, 1000000u);
+            EXPECT_EQ(pool_configuration.memory_policy, policy.second);
+            EXPECT_EQ(pool_configuration.memory_block_timeout, 50u);
+        }
+    }
+
+    {
+        // Arena payload pool with huge pages
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = PAYLOAD_POOL_ARENA_TAG;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_ARENA_SIZE_TAG] = 4294967296;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_MAX_SIZE_CLASS_TAG] = 16777216;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_HUGE_PAGES_TAG] = true;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_PREFAULT_TAG] = false;
+        DDSRouterConfiguration config(yaml);
+
+        PayloadPoolConfiguration pool_configuration = config.payload_pool_configuration();
+        EXPECT_EQ(pool_configuration.kind, PayloadPoolKind::ARENA_PAYLOAD_POOL);
+        EXPECT_EQ(pool_configuration.arena_size, 4294967296u);
+        EXPECT_EQ(pool_configuration.max_size_class, 16777216u);
+        EXPECT_TRUE(pool_configuration.huge_pages);
+        EXPECT_FALSE(pool_configuration.prefault);
+    }
+
+    {
+        // Deduplication
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = PAYLOAD_POOL_SLAB_TAG;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_DEDUP_TAG] = true;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_DEDUP_MIN_SIZE_TAG] = 4096;
+        DDSRouterConfiguration config(yaml);
+
+        PayloadPoolConfiguration pool_configuration = config.payload_pool_configuration();
+        EXPECT_TRUE(pool_configuration.deduplication);
+        EXPECT_EQ(pool_configuration.deduplication_min_size, 4096u);
+    }
+
+    {
+        // Small payloads
+        RawConfiguration yaml;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = PAYLOAD_POOL_REFCOUNT_TAG;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_SMALL_PAYLOAD_SIZE_TAG] = 64;
+        yaml[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_SMALL_PAYLOAD_COUNT_TAG] = 1000;
+        DDSRouterConfiguration config(yaml);
+
+        PayloadPoolConfiguration pool_configuration = config.payload_pool_configuration();
+        EXPECT_EQ(pool_configuration.small_payload_size, 64u);
+        EXPECT_EQ(pool_configuration.small_payload_count, 1000u);
+    }
+}
+
+/**
+ * Test get topic specifications from yaml
+ *
+ * CASES:
+ *  Empty configuration
+ *  Topic without specs
+ *  Topic forwarded inline
+ *  Topic with egress queue
+ *  Topic with parallel fan-out
+ *  Topics with bounded history
+ *  Low priority topic
+ *  Topic skipping Writers without readers
+ *  Zero copy topic
+ *  First matching entry is the one used
+ */
+TEST(ConfigurationTest, topics_specs)
+{
+    {
+        // Empty configuration
+        RawConfiguration yaml;
+        DDSRouterConfiguration config(yaml);
+        EXPECT_TRUE(config.topics_specs().empty());
+    }
+
+    {
+        // Topic without specs
+        RawConfiguration yaml;
+        add_topic_to_list_to_yaml(yaml, ALLOWLIST_TAG, "topic", "type");
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 1u);
+        EXPECT_TRUE(specs.front().first->matches(RealTopic("topic", "type")));
+        EXPECT_EQ(specs.front().second.spin_budget, TopicSpecs().spin_budget);
+    }
+
+    {
+        // Topic with spin budget
+        RawConfiguration yaml;
+        RawConfiguration topic;
+        topic[TOPIC_NAME_TAG] = "topic";
+        topic[TOPIC_SPIN_BUDGET_TAG] = 50;
+        yaml[ALLOWLIST_TAG].push_back(topic);
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 1u);
+        EXPECT_EQ(specs.front().second.spin_budget, 50u);
+        EXPECT_FALSE(specs.front().second.inline_forwarding);
+    }
+
+    {
+        // Topic forwarded inline
+        RawConfiguration yaml;
+        RawConfiguration topic;
+        topic[TOPIC_NAME_TAG] = "topic";
+        topic[TOPIC_INLINE_TAG] = true;
+        yaml[ALLOWLIST_TAG].push_back(topic);
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 1u);
+        EXPECT_TRUE(specs.front().second.inline_forwarding);
+    }
+
+    {
+        // Topic with egress queue
+        RawConfiguration yaml;
+        RawConfiguration topic;
+        topic[TOPIC_NAME_TAG] = "topic";
+        topic[TOPIC_EGRESS_QUEUE_TAG] = 100;
+        topic[TOPIC_EGRESS_OVERFLOW_TAG] = TOPIC_EGRESS_OVERFLOW_DROP_OLDEST_TAG;
+        yaml[ALLOWLIST_TAG].push_back(topic);
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 1u);
+        EXPECT_EQ(specs.front().second.egress_queue_size, 100u);
+        EXPECT_EQ(specs.front().second.egress_overflow_policy, EgressOverflowPolicy::DROP_OLDEST);
+    }
+
+    {
+        // Topic with parallel fan-out
+        RawConfiguration yaml;
+        RawConfiguration topic;
+        topic[TOPIC_NAME_TAG] = "topic";
+        topic[TOPIC_PARALLEL_FANOUT_TAG] = true;
+        yaml[ALLOWLIST_TAG].push_back(topic);
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 1u);
+        EXPECT_TRUE(specs.front().second.parallel_fanout);
+        EXPECT_EQ(specs.front().second.egress_queue_size, 0u);
+    }
+
+    {
+        // Topics with bounded history
+        RawConfiguration yaml;
+        RawConfiguration keep_last_topic;
+        keep_last_topic[TOPIC_NAME_TAG] = "keep_last_topic";
+        keep_last_topic[TOPIC_HISTORY_DEPTH_TAG] = 10;
+        yaml[ALLOWLIST_TAG].push_back(keep_last_topic);
+        RawConfiguration keep_all_topic;
+        keep_all_topic[TOPIC_NAME_TAG] = "keep_all_topic";
+        keep_all_topic[TOPIC_HISTORY_MAX_SAMPLES_TAG] = 1000;
+        yaml[ALLOWLIST_TAG].push_back(keep_all_topic);
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 2u);
+        EXPECT_EQ(specs.front().second.history_depth, 10u);
+        EXPECT_EQ(specs.front().second.history_max_samples, 0u);
+        EXPECT_EQ(specs.back().second.history_depth, 0u);
+        EXPECT_EQ(specs.back().second.history_max_samples, 1000u);
+    }
+
+    {
+        // Low priority topic
+        RawConfiguration yaml;
+        RawConfiguration topic;
+        topic[TOPIC_NAME_TAG] = "topic";
+        topic[TOPIC_LOW_PRIORITY_TAG] = true;
+        yaml[ALLOWLIST_TAG].push_back(topic);
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 1u);
+        EXPECT_TRUE(specs.front().second.low_priority);
+    }
+
+    {
+        // Topic skipping Writers without readers
+        RawConfiguration yaml;
+        RawConfiguration topic;
+        topic[TOPIC_NAME_TAG] = "topic";
+        topic[TOPIC_SKIP_WITHOUT_READERS_TAG] = true;
+        yaml[ALLOWLIST_TAG].push_back(topic);
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 1u);
+        EXPECT_TRUE(specs.front().second.skip_without_readers);
+    }
+
+    {
+        // Zero copy topic
+        RawConfiguration yaml;
+        RawConfiguration topic;
+        topic[TOPIC_NAME_TAG] = "topic";
+        topic[TOPIC_ZERO_COPY_TAG] = true;
+        yaml[ALLOWLIST_TAG].push_back(topic);
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 1u);
+        EXPECT_TRUE(specs.front().second.zero_copy);
+    }
+
+    {
+        // First matching entry is the one used
+        RawConfiguration yaml;
+        RawConfiguration control_topic;
+        control_topic[TOPIC_NAME_TAG] = "control*";
+        control_topic[TOPIC_SPIN_BUDGET_TAG] = 20;
+        yaml[ALLOWLIST_TAG].push_back(control_topic);
+        add_topic_to_list_to_yaml(yaml, ALLOWLIST_TAG, "*");
+        DDSRouterConfiguration config(yaml);
+
+        auto specs = config.topics_specs();
+        ASSERT_EQ(specs.size(), 2u);
+        EXPECT_TRUE(specs.front().first->matches(RealTopic("control_topic", "type")));
+        EXPECT_FALSE(specs.front().first->matches(RealTopic("data_topic", "type")));
+        EXPECT_EQ(specs.front().second.spin_budget, 20u);
+        EXPECT_EQ(specs.back().second.spin_budget, 0u);
+    }
+}
+
 /******************************
 * PUBLIC METHODS ERROR CASES *
 ******************************/
@@ -595,11 +1094,26 @@ TEST(ConfigurationTest, constructor_fail)
 
 /**
  * Test get participants configurations negative cases
+ *
+ * CASES:
+ *  Negative NUMA node
+ *  String instead of NUMA node
  */
 TEST(ConfigurationTest, participants_configurations_fail)
 {
-    // There is currently no way to induce an error when getting participant configurations
-    ASSERT_TRUE(true);
+    // Negative NUMA node
+    RawConfiguration participant1;
+    participant1[PARTICIPANT_TYPE_TAG] = "dummy";
+    participant1[PARTICIPANT_NUMA_NODE_TAG] = -1;
+    ParticipantConfiguration pc1(ParticipantId("participant"), participant1);
+    EXPECT_THROW(pc1.numa_node(), ConfigurationException);
+
+    // String instead of NUMA node
+    RawConfiguration participant2;
+    participant2[PARTICIPANT_TYPE_TAG] = "dummy";
+    participant2[PARTICIPANT_NUMA_NODE_TAG] = "local";
+    ParticipantConfiguration pc2(ParticipantId("participant"), participant2);
+    EXPECT_THROW(pc2.numa_node(), ConfigurationException);
 }
 
 /**
@@ -657,6 +1171,283 @@ TEST(ConfigurationTest, blocklist_wildcard_fail)
     EXPECT_THROW(dc.blocklist(), ConfigurationException);
 }
 
+/**
+ * Test get number of threads from yaml negative cases
+ *
+ * CASES:
+ *  Zero threads
+ *  Negative number of threads
+ *  String instead of number
+ *  Thread per Track is not a bool
+ */
+TEST(ConfigurationTest, number_of_threads_fail)
+{
+    // Zero threads
+    RawConfiguration yaml1;
+    yaml1[SPECS_TAG][NUMBER_THREADS_TAG] = 0;
+    DDSRouterConfiguration dc1(yaml1);
+    EXPECT_THROW(dc1.number_of_threads(), ConfigurationException);
+
+    // Negative number of threads
+    RawConfiguration yaml2;
+    yaml2[SPECS_TAG][NUMBER_THREADS_TAG] = -2;
+    DDSRouterConfiguration dc2(yaml2);
+    EXPECT_THROW(dc2.number_of_threads(), ConfigurationException);
+
+    // String instead of number
+    RawConfiguration yaml3;
+    yaml3[SPECS_TAG][NUMBER_THREADS_TAG] = "many";
+    DDSRouterConfiguration dc3(yaml3);
+    EXPECT_THROW(dc3.number_of_threads(), ConfigurationException);
+
+    // Thread per Track is not a bool
+    RawConfiguration yaml4;
+    yaml4[SPECS_TAG][THREAD_PER_TRACK_TAG] = "sometimes";
+    DDSRouterConfiguration dc4(yaml4);
+    EXPECT_THROW(dc4.thread_per_track(), ConfigurationException);
+}
+
+/**
+ * Test get interest driven endpoints and their grace period from yaml negative cases
+ *
+ * CASES:
+ *  Interest driven endpoints is not a bool
+ *  Zero grace period
+ *  String instead of grace period
+ *  Lazy bridges is not a bool
+ */
+TEST(ConfigurationTest, interest_driven_endpoints_fail)
+{
+    // Interest driven endpoints is not a bool
+    RawConfiguration yaml1;
+    yaml1[SPECS_TAG][INTEREST_DRIVEN_ENDPOINTS_TAG] = "sometimes";
+    DDSRouterConfiguration dc1(yaml1);
+    EXPECT_THROW(dc1.interest_driven_endpoints(), ConfigurationException);
+
+    // Zero grace period
+    RawConfiguration yaml2;
+    yaml2[SPECS_TAG][ENDPOINT_GRACE_PERIOD_TAG] = 0;
+    DDSRouterConfiguration dc2(yaml2);
+    EXPECT_THROW(dc2.endpoint_grace_period(), ConfigurationException);
+
+    // String instead of grace period
+    RawConfiguration yaml3;
+    yaml3[SPECS_TAG][ENDPOINT_GRACE_PERIOD_TAG] = "long";
+    DDSRouterConfiguration dc3(yaml3);
+    EXPECT_THROW(dc3.endpoint_grace_period(), ConfigurationException);
+
+    // Lazy bridges is not a bool
+    RawConfiguration yaml4;
+    yaml4[SPECS_TAG][LAZY_BRIDGES_TAG] = "sometimes";
+    DDSRouterConfiguration dc4(yaml4);
+    EXPECT_THROW(dc4.lazy_bridges(), ConfigurationException);
+}
+
+/**
+ * Test get bridge idle timeout from yaml negative cases
+ *
+ * CASES:
+ *  Negative idle timeout
+ *  String instead of idle timeout
+ */
+TEST(ConfigurationTest, bridge_idle_timeout_fail)
+{
+    // Negative idle timeout
+    RawConfiguration yaml1;
+    yaml1[SPECS_TAG][BRIDGE_IDLE_TIMEOUT_TAG] = -1;
+    DDSRouterConfiguration dc1(yaml1);
+    EXPECT_THROW(dc1.bridge_idle_timeout(), ConfigurationException);
+
+    // String instead of idle timeout
+    RawConfiguration yaml2;
+    yaml2[SPECS_TAG][BRIDGE_IDLE_TIMEOUT_TAG] = "forever";
+    DDSRouterConfiguration dc2(yaml2);
+    EXPECT_THROW(dc2.bridge_idle_timeout(), ConfigurationException);
+}
+
+/**
+ * Test get payload pool configuration from yaml negative cases
+ *
+ * CASES:
+ *  Unknown type
+ *  Type is not a string
+ *  Preallocation without count
+ *  Preallocation of size 0
+ *  Negative preallocation count
+ *  Unknown copy size
+ *  Negative memory budget
+ *  Unknown memory policy
+ *  Negative memory block timeout
+ *  Arena of 0 bytes
+ *  Huge pages is not a bool
+ *  Size class larger than the largest one
+ */
+TEST(ConfigurationTest, payload_pool_configuration_fail)
+{
+    // Unknown type
+    RawConfiguration yaml1;
+    yaml1[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG] = "unknown";
+    DDSRouterConfiguration dc1(yaml1);
+    EXPECT_THROW(dc1.payload_pool_configuration(), ConfigurationException);
+
+    // Type is not a string
+    RawConfiguration yaml2;
+    yaml2[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_TYPE_TAG]["map"] = "value";
+    DDSRouterConfiguration dc2(yaml2);
+    EXPECT_THROW(dc2.payload_pool_configuration(), ConfigurationException);
+
+    // Preallocation without count
+    RawConfiguration yaml3;
+    RawConfiguration preallocation3;
+    preallocation3[PAYLOAD_POOL_SIZE_TAG] = 1024;
+    yaml3[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_PREALLOCATE_TAG].push_back(preallocation3);
+    DDSRouterConfiguration dc3(yaml3);
+    EXPECT_THROW(dc3.payload_pool_configuration(), ConfigurationException);
+
+    // Preallocation of size 0
+    RawConfiguration yaml4;
+    RawConfiguration preallocation4;
+    preallocation4[PAYLOAD_POOL_SIZE_TAG] = 0;
+    preallocation4[PAYLOAD_POOL_COUNT_TAG] = 10;
+    yaml4[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_PREALLOCATE_TAG].push_back(preallocation4);
+    DDSRouterConfiguration dc4(yaml4);
+    EXPECT_THROW(dc4.payload_pool_configuration(), ConfigurationException);
+
+    // Negative preallocation count
+    RawConfiguration yaml5;
+    RawConfiguration preallocation5;
+    preallocation5[PAYLOAD_POOL_SIZE_TAG] = 1024;
+    preallocation5[PAYLOAD_POOL_COUNT_TAG] = -1;
+    yaml5[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_PREALLOCATE_TAG].push_back(preallocation5);
+    DDSRouterConfiguration dc5(yaml5);
+    EXPECT_THROW(dc5.payload_pool_configuration(), ConfigurationException);
+
+    // Unknown copy size
+    RawConfiguration yaml6;
+    yaml6[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_COPY_SIZE_TAG] = "everything";
+    DDSRouterConfiguration dc6(yaml6);
+    EXPECT_THROW(dc6.payload_pool_configuration(), ConfigurationException);
+
+    // Negative memory budget
+    RawConfiguration yaml7;
+    yaml7[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_MEMORY_BUDGET_TAG] = -1;
+    DDSRouterConfiguration dc7(yaml7);
+    EXPECT_THROW(dc7.payload_pool_configuration(), ConfigurationException);
+
+    // Unknown memory policy
+    RawConfiguration yaml8;
+    yaml8[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_MEMORY_POLICY_TAG] = "swap";
+    DDSRouterConfiguration dc8(yaml8);
+    EXPECT_THROW(dc8.payload_pool_configuration(), ConfigurationException);
+
+    // Negative memory block timeout
+    RawConfiguration yaml9;
+    yaml9[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_MEMORY_BLOCK_TIMEOUT_TAG] = -10;
+    DDSRouterConfiguration dc9(yaml9);
+    EXPECT_THROW(dc9.payload_pool_configuration(), ConfigurationException);
+
+    // Arena of 0 bytes
+    RawConfiguration yaml10;
+    yaml10[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_ARENA_SIZE_TAG] = 0;
+    DDSRouterConfiguration dc10(yaml10);
+    EXPECT_THROW(dc10.payload_pool_configuration(), ConfigurationException);
+
+    // Huge pages is not a bool
+    RawConfiguration yaml11;
+    yaml11[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_HUGE_PAGES_TAG] = "maybe";
+    DDSRouterConfiguration dc11(yaml11);
+    EXPECT_THROW(dc11.payload_pool_configuration(), ConfigurationException);
+
+    // Negative deduplication min size
+    RawConfiguration yaml12;
+    yaml12[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_DEDUP_MIN_SIZE_TAG] = -1;
+    DDSRouterConfiguration dc12(yaml12);
+    EXPECT_THROW(dc12.payload_pool_configuration(), ConfigurationException);
+
+    // Negative small payload size
+    RawConfiguration yaml13;
+    yaml13[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_SMALL_PAYLOAD_SIZE_TAG] = -64;
+    DDSRouterConfiguration dc13(yaml13);
+    EXPECT_THROW(dc13.payload_pool_configuration(), ConfigurationException);
+
+    // Size class larger than the largest one
+    RawConfiguration yaml14;
+    yaml14[SPECS_TAG][PAYLOAD_POOL_TAG][PAYLOAD_POOL_MAX_SIZE_CLASS_TAG] = 4294967296;
+    DDSRouterConfiguration dc14(yaml14);
+    EXPECT_THROW(dc14.payload_pool_configuration(), ConfigurationException);
+}
+
+/**
+ * Test get topic specifications from yaml negative cases
+ *
+ * CASES:
+ *  Negative spin budget
+ *  String instead of number
+ *  Inline with spin budget
+ *  Negative egress queue size
+ *  Unknown overflow policy
+ *  History depth with max samples
+ */
+TEST(ConfigurationTest, topics_specs_fail)
+{
+    // Negative spin budget
+    RawConfiguration yaml1;
+    RawConfiguration topic1;
+    topic1[TOPIC_NAME_TAG] = "topic";
+    topic1[TOPIC_SPIN_BUDGET_TAG] = -1;
+    yaml1[ALLOWLIST_TAG].push_back(topic1);
+    DDSRouterConfiguration dc1(yaml1);
+    EXPECT_THROW(dc1.topics_specs(), ConfigurationException);
+
+    // String instead of number
+    RawConfiguration yaml2;
+    RawConfiguration topic2;
+    topic2[TOPIC_NAME_TAG] = "topic";
+    topic2[TOPIC_SPIN_BUDGET_TAG] = "fast";
+    yaml2[ALLOWLIST_TAG].push_back(topic2);
+    DDSRouterConfiguration dc2(yaml2);
+    EXPECT_THROW(dc2.topics_specs(), ConfigurationException);
+
+    // Inline with spin budget
+    RawConfiguration yaml3;
+    RawConfiguration topic3;
+    topic3[TOPIC_NAME_TAG] = "topic";
+    topic3[TOPIC_SPIN_BUDGET_TAG] = 10;
+    topic3[TOPIC_INLINE_TAG] = true;
+    yaml3[ALLOWLIST_TAG].push_back(topic3);
+    DDSRouterConfiguration dc3(yaml3);
+    EXPECT_THROW(dc3.topics_specs(), ConfigurationException);
+
+    // Negative egress queue size
+    RawConfiguration yaml4;
+    RawConfiguration topic4;
+    topic4[TOPIC_NAME_TAG] = "topic";
+    topic4[TOPIC_EGRESS_QUEUE_TAG] = -1;
+    yaml4[ALLOWLIST_TAG].push_back(topic4);
+    DDSRouterConfiguration dc4(yaml4);
+    EXPECT_THROW(dc4.topics_specs(), ConfigurationException);
+
+    // Unknown overflow policy
+    RawConfiguration yaml5;
+    RawConfiguration topic5;
+    topic5[TOPIC_NAME_TAG] = "topic";
+    topic5[TOPIC_EGRESS_QUEUE_TAG] = 10;
+    topic5[TOPIC_EGRESS_OVERFLOW_TAG] = "drop-all";
+    yaml5[ALLOWLIST_TAG].push_back(topic5);
+    DDSRouterConfiguration dc5(yaml5);
+    EXPECT_THROW(dc5.topics_specs(), ConfigurationException);
+
+    // History depth with max samples
+    RawConfiguration yaml6;
+    RawConfiguration topic6;
+    topic6[TOPIC_NAME_TAG] = "topic";
+    topic6[TOPIC_HISTORY_DEPTH_TAG] = 10;
+    topic6[TOPIC_HISTORY_MAX_SAMPLES_TAG] = 100;
+    yaml6[ALLOWLIST_TAG].push_back(topic6);
+    DDSRouterConfiguration dc6(yaml6);
+    EXPECT_THROW(dc6.topics_specs(), ConfigurationException);
+}
+
 int main(
         int argc,
         char** argv)
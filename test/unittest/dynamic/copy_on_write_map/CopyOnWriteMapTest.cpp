@@ -0,0 +1,135 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/dynamic/CopyOnWriteMap.hpp>
+
+using namespace eprosima::ddsrouter;
+
+/**
+ * Test \c CopyOnWriteMap \c find , \c set and \c erase methods
+ *
+ * CASES:
+ *  Key not present
+ *  Key added
+ *  Key set again
+ *  Key erased
+ *  Key not present erased
+ *  Many keys, several of them in the same bucket
+ */
+TEST(CopyOnWriteMapTest, find_set_erase)
+{
+    CopyOnWriteMap<std::string, int> map;
+
+    // Key not present
+    ASSERT_EQ(map.find("key"), nullptr);
+    ASSERT_EQ(map.size(), 0u);
+
+    // Key added
+    map.set("key", std::make_shared<const int>(1));
+    ASSERT_NE(map.find("key"), nullptr);
+    ASSERT_EQ(*map.find("key"), 1);
+    ASSERT_EQ(map.size(), 1u);
+
+    // Key set again
+    map.set("key", std::make_shared<const int>(2));
+    ASSERT_EQ(*map.find("key"), 2);
+    ASSERT_EQ(map.size(), 1u);
+
+    // Key erased
+    ASSERT_TRUE(map.erase("key"));
+    ASSERT_EQ(map.find("key"), nullptr);
+    ASSERT_EQ(map.size(), 0u);
+
+    // Key not present erased
+    ASSERT_FALSE(map.erase("key"));
+    ASSERT_EQ(map.size(), 0u);
+
+    // Many keys, several of them in the same bucket
+    CopyOnWriteMap<int, int> int_map;
+    for (int i = 0; i < 10000; ++i)
+    {
+        int_map.set(i, std::make_shared<const int>(-i));
+    }
+    ASSERT_EQ(int_map.size(), 10000u);
+    for (int i = 0; i < 10000; i += 2)
+    {
+        ASSERT_TRUE(int_map.erase(i));
+    }
+    ASSERT_EQ(int_map.size(), 5000u);
+    for (int i = 0; i < 10000; ++i)
+    {
+        if (i % 2)
+        {
+            ASSERT_EQ(*int_map.find(i), -i);
+        }
+        else
+        {
+            ASSERT_EQ(int_map.find(i), nullptr);
+        }
+    }
+}
+
+/**
+ * Test \c CopyOnWriteMap copies are not modified by the modifications of the original, nor the other way around
+ *
+ * CASES:
+ *  Key added to the copy
+ *  Key set in the copy
+ *  Key erased from the copy
+ *  Key added to the original
+ */
+TEST(CopyOnWriteMapTest, copies_not_modified)
+{
+    CopyOnWriteMap<std::string, int> original;
+    original.set("key", std::make_shared<const int>(1));
+    original.set("other_key", std::make_shared<const int>(2));
+
+    CopyOnWriteMap<std::string, int> copy = original;
+
+    // Key added to the copy
+    copy.set("new_key", std::make_shared<const int>(3));
+    ASSERT_EQ(*copy.find("new_key"), 3);
+    ASSERT_EQ(original.find("new_key"), nullptr);
+
+    // Key set in the copy
+    copy.set("key", std::make_shared<const int>(4));
+    ASSERT_EQ(*copy.find("key"), 4);
+    ASSERT_EQ(*original.find("key"), 1);
+
+    // Key erased from the copy
+    ASSERT_TRUE(copy.erase("other_key"));
+    ASSERT_EQ(copy.find("other_key"), nullptr);
+    ASSERT_EQ(*original.find("other_key"), 2);
+    ASSERT_EQ(original.size(), 2u);
+    ASSERT_EQ(copy.size(), 2u);
+
+    // Key added to the original
+    original.set("original_key", std::make_shared<const int>(5));
+    ASSERT_EQ(*original.find("original_key"), 5);
+    ASSERT_EQ(copy.find("original_key"), nullptr);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -12,6 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gtest_aux.hpp>
 #include <gtest/gtest.h>
 #include <test_utils.hpp>
@@ -200,6 +207,319 @@ TEST(DiscoveryDatabaseTest, get_endpoint)
     ASSERT_EQ(discovery_database.get_endpoint(guid), endpoint);
 }
 
+/**
+ * Test \c DiscoveryDatabase \c topic_endpoints method
+ *
+ * CASES:
+ *  Topic without endpoints
+ *  Endpoints of the topic, active and inactive, and not of other topics
+ */
+TEST(DiscoveryDatabaseTest, topic_endpoints)
+{
+    DiscoveryDatabase discovery_database;
+    QoS qos;
+    RealTopic topic("test", "test");
+    RealTopic other_topic("other", "other");
+    Endpoint writer(EndpointKind::WRITER, test::random_guid(1), qos, topic);
+    Endpoint reader(EndpointKind::READER, test::random_guid(2), qos, topic);
+    Endpoint other_reader(EndpointKind::READER, test::random_guid(3), qos, other_topic);
+    reader.active(false);
+
+    // Topic without endpoints
+    ASSERT_TRUE(discovery_database.topic_endpoints(topic).empty());
+
+    // Endpoints of the topic
+    discovery_database.add_endpoint(writer);
+    discovery_database.add_endpoint(reader);
+    discovery_database.add_endpoint(other_reader);
+
+    std::vector<Endpoint> endpoints = discovery_database.topic_endpoints(topic);
+    ASSERT_EQ(endpoints.size(), 2u);
+    ASSERT_NE(std::find(endpoints.begin(), endpoints.end(), writer), endpoints.end());
+    ASSERT_NE(std::find(endpoints.begin(), endpoints.end(), reader), endpoints.end());
+}
+
+/**
+ * Test \c DiscoveryDatabase \c topic_endpoints_count method
+ *
+ * CASES:
+ *  Topic without endpoints
+ *  Active Readers and Writers are counted
+ *  Inactive endpoints are not counted
+ *  Endpoint updated to other topic
+ *  Endpoints erased
+ */
+TEST(DiscoveryDatabaseTest, topic_endpoints_count)
+{
+    DiscoveryDatabase discovery_database;
+    QoS qos;
+    RealTopic topic("test", "test");
+    RealTopic other_topic("other", "other");
+    Guid writer_guid = test::random_guid(1);
+    Guid reader_guid = test::random_guid(2);
+    Endpoint writer(EndpointKind::WRITER, writer_guid, qos, topic);
+    Endpoint reader(EndpointKind::READER, reader_guid, qos, topic);
+
+    // Topic without endpoints
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).readers, 0u);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).writers, 0u);
+
+    // Active Readers and Writers are counted
+    discovery_database.add_endpoint(writer);
+    discovery_database.add_endpoint(reader);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).readers, 1u);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).writers, 1u);
+
+    // Inactive endpoints are not counted
+    reader.active(false);
+    discovery_database.update_endpoint(reader);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).readers, 0u);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).writers, 1u);
+    ASSERT_TRUE(discovery_database.topic_exists(topic));
+
+    // Endpoint updated to other topic
+    Endpoint other_writer(EndpointKind::WRITER, writer_guid, qos, other_topic);
+    discovery_database.update_endpoint(other_writer);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).writers, 0u);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(other_topic).writers, 1u);
+    ASSERT_EQ(discovery_database.topic_endpoints(topic).size(), 1u);
+
+    // Endpoints erased
+    discovery_database.erase_endpoint(reader_guid);
+    discovery_database.erase_endpoint(writer_guid);
+    ASSERT_FALSE(discovery_database.topic_exists(topic));
+    ASSERT_FALSE(discovery_database.topic_exists(other_topic));
+    ASSERT_EQ(discovery_database.topic_endpoints_count(other_topic).writers, 0u);
+}
+
+/**
+ * Test \c DiscoveryDatabase keeps an entry for each Participant that discovers the same endpoint
+ *
+ * CASES:
+ *  Same endpoint added by two discoverers
+ *  Update of one discoverer does not modify the entry of the other
+ *  Erase of one discoverer keeps the entry of the other
+ */
+TEST(DiscoveryDatabaseTest, several_discoverers)
+{
+    DiscoveryDatabase discovery_database;
+    Guid guid = test::random_guid(1);
+    QoS qos;
+    RealTopic topic("test", "test");
+    ParticipantId discoverer_1("participant_1");
+    ParticipantId discoverer_2("participant_2");
+    Endpoint endpoint_1(EndpointKind::WRITER, guid, qos, topic, discoverer_1);
+    Endpoint endpoint_2(EndpointKind::WRITER, guid, qos, topic, discoverer_2);
+
+    // Same endpoint added by two discoverers
+    ASSERT_TRUE(discovery_database.add_endpoint(endpoint_1));
+    ASSERT_TRUE(discovery_database.add_endpoint(endpoint_2));
+    ASSERT_TRUE(discovery_database.endpoint_exists(guid, discoverer_1));
+    ASSERT_TRUE(discovery_database.endpoint_exists(guid, discoverer_2));
+    ASSERT_FALSE(discovery_database.endpoint_exists(guid));
+    ASSERT_EQ(discovery_database.topic_endpoints(topic).size(), 2u);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).writers, 2u);
+
+    // Update of one discoverer does not modify the entry of the other
+    endpoint_1.active(false);
+    ASSERT_TRUE(discovery_database.update_endpoint(endpoint_1));
+    ASSERT_FALSE(discovery_database.get_endpoint(guid, discoverer_1).active());
+    ASSERT_TRUE(discovery_database.get_endpoint(guid, discoverer_2).active());
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).writers, 1u);
+
+    // Erase of one discoverer keeps the entry of the other
+    ASSERT_EQ(discovery_database.erase_endpoint(guid, discoverer_2), ReturnCode::RETCODE_OK);
+    ASSERT_FALSE(discovery_database.endpoint_exists(guid, discoverer_2));
+    ASSERT_TRUE(discovery_database.endpoint_exists(guid, discoverer_1));
+    ASSERT_THROW(discovery_database.erase_endpoint(guid, discoverer_2), InconsistencyException);
+    ASSERT_EQ(discovery_database.topic_endpoints(topic).size(), 1u);
+    ASSERT_EQ(discovery_database.topic_endpoints(topic)[0].discoverer_participant_id(), discoverer_1);
+    ASSERT_EQ(discovery_database.topic_endpoints_count(topic).writers, 0u);
+}
+
+/**
+ * Test \c DiscoveryDatabase endpoint callbacks
+ *
+ * CASES:
+ *  Endpoint added
+ *  Endpoint updated
+ *  Endpoint erased is notified as inactive
+ *  Every callback registered is called
+ *  Nothing is notified once the callbacks are unregistered
+ */
+TEST(DiscoveryDatabaseTest, endpoint_callbacks)
+{
+    DiscoveryDatabase discovery_database;
+    Guid guid = test::random_guid(1);
+    QoS qos;
+    RealTopic topic("test", "test");
+    ParticipantId discoverer("participant");
+    Endpoint endpoint(EndpointKind::READER, guid, qos, topic, discoverer);
+
+    std::vector<std::pair<DatabaseOperation, Endpoint>> notified;
+    uint64_t callback_id = discovery_database.register_endpoint_callback(
+        [&notified](DatabaseOperation operation, const Endpoint& endpoint)
+        {
+            notified.emplace_back(operation, endpoint);
+        });
+
+    // Endpoint added
+    discovery_database.add_endpoint(endpoint);
+    ASSERT_EQ(notified.size(), 1u);
+    ASSERT_EQ(notified.back().first, DatabaseOperation::ADD);
+    ASSERT_EQ(notified.back().second, endpoint);
+    ASSERT_EQ(notified.back().second.discoverer_participant_id(), discoverer);
+
+    // Endpoint updated
+    endpoint.active(false);
+    discovery_database.update_endpoint(endpoint);
+    ASSERT_EQ(notified.size(), 2u);
+    ASSERT_EQ(notified.back().first, DatabaseOperation::UPDATE);
+    ASSERT_FALSE(notified.back().second.active());
+
+    // Endpoint erased is notified as inactive
+    endpoint.active(true);
+    discovery_database.add_endpoint(endpoint);
+    discovery_database.erase_endpoint(guid, discoverer);
+    ASSERT_EQ(notified.size(), 4u);
+    ASSERT_EQ(notified.back().first, DatabaseOperation::ERASE);
+    ASSERT_EQ(notified.back().second.guid(), guid);
+    ASSERT_FALSE(notified.back().second.active());
+
+    // Every callback registered is called
+    unsigned int other_notified = 0;
+    uint64_t other_callback_id = discovery_database.register_endpoint_callback(
+        [&other_notified](DatabaseOperation, const Endpoint&)
+        {
+            other_notified++;
+        });
+    ASSERT_NE(callback_id, other_callback_id);
+
+    discovery_database.add_endpoint(endpoint);
+    ASSERT_EQ(notified.size(), 5u);
+    ASSERT_EQ(other_notified, 1u);
+
+    // Nothing is notified once the callbacks are unregistered
+    discovery_database.unregister_endpoint_callback(callback_id);
+    discovery_database.unregister_endpoint_callback(other_callback_id);
+    discovery_database.erase_endpoint(guid, discoverer);
+    ASSERT_EQ(notified.size(), 5u);
+    ASSERT_EQ(other_notified, 1u);
+}
+
+/**
+ * Test \c DiscoveryDatabase notifies the modifications of several threads in the order they are published
+ *
+ * CASES:
+ *  Every modification is notified
+ *  The last endpoint notified is the one stored in the database
+ */
+TEST(DiscoveryDatabaseTest, notification_order)
+{
+    DiscoveryDatabase discovery_database;
+    Guid guid = test::random_guid(1);
+    QoS qos;
+    const unsigned int number_threads = 4;
+    const unsigned int number_updates = 500;
+
+    discovery_database.add_endpoint(Endpoint(EndpointKind::WRITER, guid, qos, RealTopic("test", "test")));
+
+    // The callback is slow, so other modifications are published while it runs
+    unsigned int notified = 0;
+    Endpoint last_notified;
+    discovery_database.register_endpoint_callback(
+        [&](DatabaseOperation, const Endpoint& endpoint)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            notified++;
+            last_notified = endpoint;
+        });
+
+    // Each thread moves the endpoint to its own topic
+    std::vector<std::thread> writers;
+    for (unsigned int i = 0; i < number_threads; ++i)
+    {
+        writers.emplace_back(
+            [&, i]()
+            {
+                Endpoint endpoint(EndpointKind::WRITER, guid, qos, RealTopic("test", std::to_string(i)));
+                for (unsigned int j = 0; j < number_updates; ++j)
+                {
+                    discovery_database.update_endpoint(endpoint);
+                }
+            });
+    }
+
+    for (std::thread& writer : writers)
+    {
+        writer.join();
+    }
+
+    // Every modification is notified
+    ASSERT_EQ(notified, number_threads * number_updates);
+
+    // The last endpoint notified is the one stored in the database
+    ASSERT_EQ(last_notified, discovery_database.get_endpoint(guid));
+}
+
+/**
+ * Test \c DiscoveryDatabase queries while it is being modified from another thread
+ *
+ * CASES:
+ *  Every query sees the endpoints of a topic consistent with its index
+ *  Queries never see endpoints added before disappear while only additions happen
+ */
+TEST(DiscoveryDatabaseTest, concurrent_queries)
+{
+    DiscoveryDatabase discovery_database;
+    QoS qos;
+    RealTopic topic("test", "test");
+    const unsigned int number_endpoints = 200;
+    const unsigned int number_readers = 4;
+
+    std::atomic<bool> writing(true);
+    std::atomic<bool> consistent(true);
+
+    std::vector<std::thread> readers;
+    for (unsigned int i = 0; i < number_readers; ++i)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                size_t last_size = 0;
+                while (writing)
+                {
+                    std::vector<Endpoint> endpoints = discovery_database.topic_endpoints(topic);
+                    for (const Endpoint& endpoint : endpoints)
+                    {
+                        consistent = consistent && endpoint.topic() == topic &&
+                        discovery_database.endpoint_exists(endpoint.guid());
+                    }
+                    consistent = consistent && endpoints.size() >= last_size;
+                    last_size = endpoints.size();
+                }
+            });
+    }
+
+    for (unsigned int i = 0; i < number_endpoints; ++i)
+    {
+        discovery_database.add_endpoint(
+            Endpoint(i % 2 ? EndpointKind::WRITER : EndpointKind::READER, test::random_guid(i), qos, topic));
+    }
+    writing = false;
+
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_TRUE(consistent);
+    ASSERT_EQ(discovery_database.topic_endpoints(topic).size(), number_endpoints);
+    TopicEndpointsCount count = discovery_database.topic_endpoints_count(topic);
+    ASSERT_EQ(count.readers, number_endpoints / 2);
+    ASSERT_EQ(count.writers, number_endpoints / 2);
+}
+
 int main(
         int argc,
         char** argv)
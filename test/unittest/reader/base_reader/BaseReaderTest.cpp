@@ -0,0 +1,161 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/communication/payload_pool/MapPayloadPool.hpp>
+#include <ddsrouter/reader/implementations/auxiliar/DummyReader.hpp>
+
+using namespace eprosima::ddsrouter;
+
+const constexpr unsigned int TEST_BATCH_SIZE = 8;
+const constexpr unsigned int TEST_NUMBER_BATCHES = 100;
+const constexpr unsigned int TEST_PAYLOAD_SIZE = 16;
+
+/*
+ * Create an enabled DummyReader that uses \c payload_pool
+ */
+std::unique_ptr<DummyReader> create_reader(
+        std::shared_ptr<PayloadPool> payload_pool)
+{
+    std::unique_ptr<DummyReader> reader = std::make_unique<DummyReader>(
+        ParticipantId("participant"),
+        RealTopic("topic", "type"),
+        payload_pool);
+    reader->set_on_data_available_callback([](){});
+    reader->enable();
+    return reader;
+}
+
+/*
+ * Simulate the reception of \c n samples whose payload is filled with its index
+ */
+void simulate_reception(
+        DummyReader& reader,
+        unsigned int n)
+{
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        DummyDataReceived data;
+        data.payload = std::vector<PayloadUnit>(TEST_PAYLOAD_SIZE, static_cast<PayloadUnit>(i));
+        reader.simulate_data_reception(data);
+    }
+}
+
+/*
+ * Release the payloads of \c data and give the samples back to \c reader
+ */
+void release_batch(
+        DummyReader& reader,
+        PayloadPool& payload_pool,
+        std::vector<std::unique_ptr<DataReceived>>& data)
+{
+    for (std::unique_ptr<DataReceived>& sample : data)
+    {
+        payload_pool.release_payload(sample->payload);
+    }
+    reader.return_loan(data);
+}
+
+/**
+ * Test that take_batch takes the oldest samples available in order and at most the maximum requested
+ *
+ * CASES:
+ *  No data
+ *  Less data than maximum
+ *  More data than maximum
+ *  Disabled reader
+ */
+TEST(BaseReaderTest, take_batch)
+{
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>();
+    std::unique_ptr<DummyReader> reader = create_reader(payload_pool);
+    std::vector<std::unique_ptr<DataReceived>> data;
+
+    // No data
+    EXPECT_EQ(reader->take_batch(data, TEST_BATCH_SIZE), ReturnCode::RETCODE_NO_DATA);
+    EXPECT_TRUE(data.empty());
+
+    // Less data than maximum
+    simulate_reception(*reader, TEST_BATCH_SIZE / 2);
+    EXPECT_EQ(reader->take_batch(data, TEST_BATCH_SIZE), ReturnCode::RETCODE_OK);
+    ASSERT_EQ(data.size(), TEST_BATCH_SIZE / 2);
+    for (unsigned int i = 0; i < data.size(); ++i)
+    {
+        EXPECT_EQ(data[i]->payload.length, TEST_PAYLOAD_SIZE);
+        EXPECT_EQ(data[i]->payload.data[0], i);
+    }
+    release_batch(*reader, *payload_pool, data);
+    EXPECT_TRUE(data.empty());
+
+    // More data than maximum
+    simulate_reception(*reader, TEST_BATCH_SIZE * 2);
+    EXPECT_EQ(reader->take_batch(data, TEST_BATCH_SIZE), ReturnCode::RETCODE_OK);
+    ASSERT_EQ(data.size(), TEST_BATCH_SIZE);
+    EXPECT_EQ(data.back()->payload.data[0], TEST_BATCH_SIZE - 1);
+    release_batch(*reader, *payload_pool, data);
+
+    EXPECT_EQ(reader->take_batch(data, TEST_BATCH_SIZE), ReturnCode::RETCODE_OK);
+    ASSERT_EQ(data.size(), TEST_BATCH_SIZE);
+    EXPECT_EQ(data.front()->payload.data[0], TEST_BATCH_SIZE);
+    release_batch(*reader, *payload_pool, data);
+
+    EXPECT_EQ(reader->take_batch(data, TEST_BATCH_SIZE), ReturnCode::RETCODE_NO_DATA);
+
+    // Disabled reader
+    simulate_reception(*reader, 1);
+    reader->disable();
+    EXPECT_EQ(reader->take_batch(data, TEST_BATCH_SIZE), ReturnCode::RETCODE_NOT_ENABLED);
+    EXPECT_TRUE(data.empty());
+}
+
+/**
+ * Test that samples given back with return_loan are reused, so no allocation is done in steady state
+ *
+ * CASES:
+ *  Only the first batch allocates
+ *  Samples not given back are not reused
+ */
+TEST(BaseReaderTest, return_loan)
+{
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>();
+    std::unique_ptr<DummyReader> reader = create_reader(payload_pool);
+    std::vector<std::unique_ptr<DataReceived>> data;
+
+    // Only the first batch allocates
+    for (unsigned int i = 0; i < TEST_NUMBER_BATCHES; ++i)
+    {
+        simulate_reception(*reader, TEST_BATCH_SIZE);
+        ASSERT_EQ(reader->take_batch(data, TEST_BATCH_SIZE), ReturnCode::RETCODE_OK);
+        ASSERT_EQ(data.size(), TEST_BATCH_SIZE);
+        release_batch(*reader, *payload_pool, data);
+
+        EXPECT_EQ(reader->data_allocations(), TEST_BATCH_SIZE);
+    }
+
+    // Samples not given back are not reused
+    simulate_reception(*reader, TEST_BATCH_SIZE * 2);
+    ASSERT_EQ(reader->take_batch(data, TEST_BATCH_SIZE * 2), ReturnCode::RETCODE_OK);
+    EXPECT_EQ(reader->data_allocations(), TEST_BATCH_SIZE * 2);
+    release_batch(*reader, *payload_pool, data);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
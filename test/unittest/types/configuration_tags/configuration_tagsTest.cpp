@@ -29,6 +29,7 @@ TEST(configuration_tagsTest, ddsrouter_tags)
     {
         ALLOWLIST_TAG,
         BLOCKLIST_TAG,
+        SPECS_TAG,
         TOPIC_NAME_TAG,
         TOPIC_TYPE_NAME_TAG
     };
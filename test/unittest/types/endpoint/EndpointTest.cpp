@@ -215,6 +215,33 @@ TEST(EndpointTest, topic_getter)
     }
 }
 
+/**
+ * Test \c Endpoint \c discoverer_participant_id getter method
+ *
+ * CASES:
+ *  Default value
+ *  Discoverer set
+ */
+TEST(EndpointTest, discoverer_participant_id_getter)
+{
+    Guid guid = random_valid_guid();
+    RealTopic topic = random_topic();
+    EndpointKind kind = random_endpoint_kind();
+    QoS qos = random_qos();
+
+    // Default value
+    {
+        Endpoint endpoint(kind, guid, qos, topic);
+        ASSERT_FALSE(endpoint.discoverer_participant_id().is_valid());
+    }
+
+    // Discoverer set
+    {
+        Endpoint endpoint(kind, guid, qos, topic, ParticipantId("participant"));
+        ASSERT_EQ(endpoint.discoverer_participant_id(), ParticipantId("participant"));
+    }
+}
+
 /**
  * Test \c Endpoint \c active getter method
  *
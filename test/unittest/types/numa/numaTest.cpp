@@ -0,0 +1,91 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdlib>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/types/numa.hpp>
+
+using namespace eprosima::ddsrouter::numa;
+
+/**
+ * Test \c parse_cpu_list method
+ *
+ * Cases:
+ *  single cpu
+ *  range of cpus
+ *  list of cpus and ranges
+ *  empty list
+ *  wrong lists
+ */
+TEST(numaTest, parse_cpu_list)
+{
+    // single cpu
+    ASSERT_EQ(parse_cpu_list("3"), std::set<unsigned int>({3}));
+
+    // range of cpus
+    ASSERT_EQ(parse_cpu_list("0-3"), std::set<unsigned int>({0, 1, 2, 3}));
+
+    // list of cpus and ranges
+    ASSERT_EQ(parse_cpu_list("0-1,4,6-7"), std::set<unsigned int>({0, 1, 4, 6, 7}));
+
+    // empty list
+    ASSERT_TRUE(parse_cpu_list("").empty());
+
+    // wrong lists
+    ASSERT_TRUE(parse_cpu_list("a").empty());
+    ASSERT_TRUE(parse_cpu_list("3-1").empty());
+    ASSERT_TRUE(parse_cpu_list("1:3").empty());
+    ASSERT_TRUE(parse_cpu_list("1-").empty());
+}
+
+/**
+ * Test the nodes of the host are consistent
+ *
+ * Binding threads and memory may not be allowed in the host, so the result of binding is not checked.
+ *
+ * Cases:
+ *  there is at least one node
+ *  node not existing has no cpus
+ *  memory is in a node of the host
+ */
+TEST(numaTest, host_nodes)
+{
+    // there is at least one node
+    unsigned int nodes = number_of_nodes();
+    ASSERT_GE(nodes, 1u);
+
+    // node not existing has no cpus
+    ASSERT_TRUE(node_cpus(nodes).empty());
+    ASSERT_TRUE(node_cpus(NO_NUMA_NODE).empty());
+    ASSERT_FALSE(bind_memory_to_node(nullptr, 0, nodes));
+
+    // memory is in a node of the host
+    int* value = static_cast<int*>(std::malloc(sizeof(int)));
+    *value = 0;
+    int node = node_of_address(value);
+    ASSERT_LT(node, static_cast<int>(nodes));
+    std::free(value);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -43,7 +43,8 @@ std::vector<std::string> random_non_valid_ids()
     return
         {
             ALLOWLIST_TAG,
-            BLOCKLIST_TAG
+            BLOCKLIST_TAG,
+            SPECS_TAG
         };
 }
 
@@ -0,0 +1,459 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <ddsrouter/communication/payload_pool/MapPayloadPool.hpp>
+#include <ddsrouter/writer/implementations/auxiliar/DummyWriter.hpp>
+#include <ddsrouter/writer/implementations/auxiliar/QueuedWriter.hpp>
+
+using namespace eprosima::ddsrouter;
+
+const constexpr unsigned int TEST_NUMBER_THREADS = 2;
+const constexpr unsigned int TEST_QUEUE_SIZE = 4;
+const constexpr unsigned int TEST_NUMBER_SAMPLES = 100;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+/**
+ * DummyWriter that does not finish a write until it is opened.
+ *
+ * It simulates a Writer with a congested link.
+ */
+class GatedWriter : public DummyWriter
+{
+public:
+
+    GatedWriter(
+            std::shared_ptr<PayloadPool> payload_pool)
+        : DummyWriter(ParticipantId("participant"), RealTopic("topic", "type"), payload_pool)
+        , open(true)
+        , writing(false)
+        , write_time(0)
+    {
+    }
+
+    //! Threads that have sent data
+    std::set<std::thread::id> writing_threads() const
+    {
+        std::lock_guard<std::mutex> lock(threads_mutex_);
+        return writing_threads_;
+    }
+
+    //! Whether writes are allowed to finish
+    std::atomic<bool> open;
+
+    //! Whether a write is waiting for the gate to open
+    std::atomic<bool> writing;
+
+    //! Time each write takes, simulating a slow link
+    std::chrono::microseconds write_time;
+
+protected:
+
+    ReturnCode write_(
+            std::unique_ptr<DataReceived>& data) noexcept override
+    {
+        {
+            std::lock_guard<std::mutex> lock(threads_mutex_);
+            writing_threads_.insert(std::this_thread::get_id());
+        }
+
+        writing = true;
+        while (!open)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(write_time);
+        writing = false;
+        return DummyWriter::write_(data);
+    }
+
+    mutable std::mutex threads_mutex_;
+
+    std::set<std::thread::id> writing_threads_;
+
+};
+
+//! Write through \c writer a sample of \c size bytes whose payload is \c value
+ReturnCode write_sample(
+        IWriter& writer,
+        PayloadPool& payload_pool,
+        PayloadUnit value,
+        uint32_t size = 1)
+{
+    std::unique_ptr<DataReceived> data = std::make_unique<DataReceived>();
+    payload_pool.get_payload(size, data->payload);
+    data->payload_owner = &payload_pool;
+    std::memset(data->payload.data, value, size);
+    data->payload.length = size;
+
+    ReturnCode ret = writer.write(data);
+
+    payload_pool.release_payload(data->payload);
+    return ret;
+}
+
+//! Wait till the Writer has started a write that blocks in its gate
+void wait_writing(
+        const GatedWriter& writer)
+{
+    for (unsigned int i = 0; i < 500 && !writer.writing; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(writer.writing);
+}
+
+//! Payload values of the data sent by \c writer
+std::vector<PayloadUnit> values_sent(
+        const DummyWriter& writer)
+{
+    std::vector<PayloadUnit> values;
+    for (const DummyDataStored& data : writer.get_data_that_should_have_been_sent())
+    {
+        values.push_back(data.payload[0]);
+    }
+    return values;
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Test that every sample written is sent in order through the internal Writer
+ *
+ * CASES:
+ *  More samples than the size of the queue
+ */
+TEST(QueuedWriterTest, write_in_order)
+{
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>();
+    std::shared_ptr<SlotThreadPool> thread_pool = std::make_shared<SlotThreadPool>(TEST_NUMBER_THREADS);
+    std::shared_ptr<test::GatedWriter> writer = std::make_shared<test::GatedWriter>(payload_pool);
+
+    {
+        QueuedWriter queued_writer(writer, payload_pool, thread_pool, TEST_QUEUE_SIZE, EgressOverflowPolicy::BLOCK);
+        queued_writer.enable();
+
+        for (unsigned int i = 0; i < TEST_NUMBER_SAMPLES; ++i)
+        {
+            ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, i), ReturnCode::RETCODE_OK);
+        }
+
+        writer->wait_until_n_data_sent(TEST_NUMBER_SAMPLES);
+
+        std::vector<PayloadUnit> values = test::values_sent(*writer);
+        ASSERT_EQ(values.size(), TEST_NUMBER_SAMPLES);
+        for (unsigned int i = 0; i < TEST_NUMBER_SAMPLES; ++i)
+        {
+            EXPECT_EQ(values[i], static_cast<PayloadUnit>(i));
+        }
+        EXPECT_EQ(queued_writer.dropped_samples(), 0u);
+    }
+
+    EXPECT_TRUE(payload_pool->is_clean());
+}
+
+/**
+ * Test that new samples are discarded when the queue is full with policy DROP_NEWEST
+ *
+ * CASES:
+ *  Internal Writer blocked while more samples than the queue size are written
+ */
+TEST(QueuedWriterTest, drop_newest)
+{
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>();
+    std::shared_ptr<SlotThreadPool> thread_pool = std::make_shared<SlotThreadPool>(TEST_NUMBER_THREADS);
+    std::shared_ptr<test::GatedWriter> writer = std::make_shared<test::GatedWriter>(payload_pool);
+
+    {
+        QueuedWriter queued_writer(writer, payload_pool, thread_pool, TEST_QUEUE_SIZE,
+                EgressOverflowPolicy::DROP_NEWEST);
+        queued_writer.enable();
+
+        // First sample blocks the internal Writer, so the rest remain in the queue
+        writer->open = false;
+        ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, 0), ReturnCode::RETCODE_OK);
+        test::wait_writing(*writer);
+
+        for (unsigned int i = 1; i <= TEST_QUEUE_SIZE * 2; ++i)
+        {
+            ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, i), ReturnCode::RETCODE_OK);
+        }
+        EXPECT_EQ(queued_writer.queued_samples(), TEST_QUEUE_SIZE);
+        EXPECT_EQ(queued_writer.dropped_samples(), TEST_QUEUE_SIZE);
+
+        writer->open = true;
+        writer->wait_until_n_data_sent(TEST_QUEUE_SIZE + 1);
+
+        std::vector<PayloadUnit> values = test::values_sent(*writer);
+        ASSERT_EQ(values.size(), TEST_QUEUE_SIZE + 1);
+        for (unsigned int i = 0; i <= TEST_QUEUE_SIZE; ++i)
+        {
+            EXPECT_EQ(values[i], static_cast<PayloadUnit>(i));
+        }
+    }
+
+    EXPECT_TRUE(payload_pool->is_clean());
+}
+
+/**
+ * Test that oldest samples are discarded when the queue is full with policy DROP_OLDEST
+ *
+ * CASES:
+ *  Internal Writer blocked while more samples than the queue size are written
+ */
+TEST(QueuedWriterTest, drop_oldest)
+{
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>();
+    std::shared_ptr<SlotThreadPool> thread_pool = std::make_shared<SlotThreadPool>(TEST_NUMBER_THREADS);
+    std::shared_ptr<test::GatedWriter> writer = std::make_shared<test::GatedWriter>(payload_pool);
+
+    {
+        QueuedWriter queued_writer(writer, payload_pool, thread_pool, TEST_QUEUE_SIZE,
+                EgressOverflowPolicy::DROP_OLDEST);
+        queued_writer.enable();
+
+        // First sample blocks the internal Writer, so the rest remain in the queue
+        writer->open = false;
+        ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, 0), ReturnCode::RETCODE_OK);
+        test::wait_writing(*writer);
+
+        for (unsigned int i = 1; i <= TEST_QUEUE_SIZE * 2; ++i)
+        {
+            ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, i), ReturnCode::RETCODE_OK);
+        }
+        EXPECT_EQ(queued_writer.queued_samples(), TEST_QUEUE_SIZE);
+        EXPECT_EQ(queued_writer.dropped_samples(), TEST_QUEUE_SIZE);
+
+        writer->open = true;
+        writer->wait_until_n_data_sent(TEST_QUEUE_SIZE + 1);
+
+        // The blocked sample and the last ones are sent
+        std::vector<PayloadUnit> values = test::values_sent(*writer);
+        ASSERT_EQ(values.size(), TEST_QUEUE_SIZE + 1);
+        EXPECT_EQ(values[0], 0u);
+        for (unsigned int i = 1; i <= TEST_QUEUE_SIZE; ++i)
+        {
+            EXPECT_EQ(values[i], static_cast<PayloadUnit>(TEST_QUEUE_SIZE + i));
+        }
+    }
+
+    EXPECT_TRUE(payload_pool->is_clean());
+}
+
+/**
+ * Test that a write in a full queue waits for room with policy BLOCK
+ *
+ * CASES:
+ *  Internal Writer blocked while more samples than the queue size are written
+ */
+TEST(QueuedWriterTest, block)
+{
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>();
+    std::shared_ptr<SlotThreadPool> thread_pool = std::make_shared<SlotThreadPool>(TEST_NUMBER_THREADS);
+    std::shared_ptr<test::GatedWriter> writer = std::make_shared<test::GatedWriter>(payload_pool);
+
+    {
+        QueuedWriter queued_writer(writer, payload_pool, thread_pool, TEST_QUEUE_SIZE, EgressOverflowPolicy::BLOCK);
+        queued_writer.enable();
+
+        // First sample blocks the internal Writer, so the rest remain in the queue
+        writer->open = false;
+        ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, 0), ReturnCode::RETCODE_OK);
+        test::wait_writing(*writer);
+
+        std::atomic<unsigned int> written(0);
+        std::thread publisher([&]()
+                {
+                    for (unsigned int i = 1; i <= TEST_QUEUE_SIZE * 2; ++i)
+                    {
+                        test::write_sample(queued_writer, *payload_pool, i);
+                        written++;
+                    }
+                });
+
+        // Publisher stops when the queue is full
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_EQ(written.load(), TEST_QUEUE_SIZE);
+
+        writer->open = true;
+        publisher.join();
+        writer->wait_until_n_data_sent(TEST_QUEUE_SIZE * 2 + 1);
+
+        std::vector<PayloadUnit> values = test::values_sent(*writer);
+        ASSERT_EQ(values.size(), TEST_QUEUE_SIZE * 2 + 1);
+        for (unsigned int i = 0; i <= TEST_QUEUE_SIZE * 2; ++i)
+        {
+            EXPECT_EQ(values[i], static_cast<PayloadUnit>(i));
+        }
+        EXPECT_EQ(queued_writer.dropped_samples(), 0u);
+    }
+
+    EXPECT_TRUE(payload_pool->is_clean());
+}
+
+/**
+ * Test that a write in a full queue with policy BLOCK leaves the sending of data to the thread pool
+ *
+ * CASES:
+ *  Slow internal Writer while more samples than the queue size are written
+ */
+TEST(QueuedWriterTest, block_sends_from_pool)
+{
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>();
+    std::shared_ptr<SlotThreadPool> thread_pool = std::make_shared<SlotThreadPool>(TEST_NUMBER_THREADS);
+    std::shared_ptr<test::GatedWriter> writer = std::make_shared<test::GatedWriter>(payload_pool);
+    writer->write_time = std::chrono::microseconds(500);
+
+    {
+        QueuedWriter queued_writer(writer, payload_pool, thread_pool, TEST_QUEUE_SIZE, EgressOverflowPolicy::BLOCK);
+        queued_writer.enable();
+
+        for (unsigned int i = 0; i < TEST_NUMBER_SAMPLES; ++i)
+        {
+            ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, i), ReturnCode::RETCODE_OK);
+        }
+        writer->wait_until_n_data_sent(TEST_NUMBER_SAMPLES);
+
+        // Every sample has been sent by the pool, none by the thread writing them
+        std::set<std::thread::id> writing_threads = writer->writing_threads();
+        EXPECT_EQ(writing_threads.count(std::this_thread::get_id()), 0u);
+
+        std::vector<PayloadUnit> values = test::values_sent(*writer);
+        ASSERT_EQ(values.size(), TEST_NUMBER_SAMPLES);
+        for (unsigned int i = 0; i < TEST_NUMBER_SAMPLES; ++i)
+        {
+            EXPECT_EQ(values[i], static_cast<PayloadUnit>(i));
+        }
+    }
+
+    EXPECT_TRUE(payload_pool->is_clean());
+}
+
+/**
+ * Test that disabling the Writer discards the samples in the queue
+ *
+ * CASES:
+ *  Disable with samples queued
+ *  Write in a disabled Writer
+ */
+TEST(QueuedWriterTest, disable)
+{
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>();
+    std::shared_ptr<SlotThreadPool> thread_pool = std::make_shared<SlotThreadPool>(TEST_NUMBER_THREADS);
+    std::shared_ptr<test::GatedWriter> writer = std::make_shared<test::GatedWriter>(payload_pool);
+
+    QueuedWriter queued_writer(writer, payload_pool, thread_pool, TEST_QUEUE_SIZE, EgressOverflowPolicy::BLOCK);
+    queued_writer.enable();
+
+    // Disable with samples queued
+    writer->open = false;
+    ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, 0), ReturnCode::RETCODE_OK);
+    test::wait_writing(*writer);
+    for (unsigned int i = 1; i <= TEST_QUEUE_SIZE; ++i)
+    {
+        ASSERT_EQ(test::write_sample(queued_writer, *payload_pool, i), ReturnCode::RETCODE_OK);
+    }
+
+    std::thread disabler([&queued_writer]()
+            {
+                queued_writer.disable();
+            });
+    writer->open = true;
+    disabler.join();
+
+    EXPECT_EQ(queued_writer.queued_samples(), 0u);
+    EXPECT_LE(test::values_sent(*writer).size(), TEST_QUEUE_SIZE + 1);
+    EXPECT_TRUE(payload_pool->is_clean());
+
+    // Write in a disabled Writer
+    EXPECT_EQ(test::write_sample(queued_writer, *payload_pool, 0), ReturnCode::RETCODE_NOT_ENABLED);
+}
+
+/**
+ * Test that a write waiting for the memory budget of the pool does not stop the drain of the queue
+ *
+ * The data come from other pool, so the queue copies them to its own pool.
+ *
+ * CASES:
+ *  New data only fit once the samples in the queue have been sent
+ */
+TEST(QueuedWriterTest, block_on_memory_budget)
+{
+    PayloadPoolConfiguration configuration;
+    configuration.memory_budget = 2;
+    configuration.memory_policy = MemoryBudgetPolicy::MEMORY_BLOCK;
+    configuration.memory_block_timeout = 2000;
+
+    std::shared_ptr<PayloadPool> source_pool = std::make_shared<MapPayloadPool>();
+    std::shared_ptr<PayloadPool> payload_pool = std::make_shared<MapPayloadPool>(configuration);
+    std::shared_ptr<SlotThreadPool> thread_pool = std::make_shared<SlotThreadPool>(TEST_NUMBER_THREADS);
+    std::shared_ptr<test::GatedWriter> writer = std::make_shared<test::GatedWriter>(payload_pool);
+
+    {
+        QueuedWriter queued_writer(writer, payload_pool, thread_pool, TEST_QUEUE_SIZE, EgressOverflowPolicy::BLOCK);
+        queued_writer.enable();
+
+        // First sample blocks the internal Writer, and the second one fills the budget
+        writer->open = false;
+        ASSERT_EQ(test::write_sample(queued_writer, *source_pool, 0), ReturnCode::RETCODE_OK);
+        test::wait_writing(*writer);
+        ASSERT_EQ(test::write_sample(queued_writer, *source_pool, 1), ReturnCode::RETCODE_OK);
+
+        // New data only fit once the samples in the queue have been sent
+        ReturnCode ret = ReturnCode::RETCODE_ERROR;
+        std::thread publisher([&]()
+                {
+                    ret = test::write_sample(queued_writer, *source_pool, 2, 2);
+                });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        writer->open = true;
+        publisher.join();
+        ASSERT_EQ(ret, ReturnCode::RETCODE_OK);
+
+        writer->wait_until_n_data_sent(3);
+
+        std::vector<PayloadUnit> values = test::values_sent(*writer);
+        ASSERT_EQ(values.size(), 3u);
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            EXPECT_EQ(values[i], static_cast<PayloadUnit>(i));
+        }
+    }
+
+    EXPECT_TRUE(payload_pool->is_clean());
+    EXPECT_TRUE(source_pool->is_clean());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
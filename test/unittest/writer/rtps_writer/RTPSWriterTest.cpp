@@ -0,0 +1,115 @@
+// Copyright 2022 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+
+#include <gtest_aux.hpp>
+#include <gtest/gtest.h>
+
+#include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastrtps/rtps/participant/RTPSParticipant.h>
+#include <fastrtps/rtps/RTPSDomain.h>
+
+#include <ddsrouter/communication/payload_pool/MapPayloadPool.hpp>
+#include <ddsrouter/writer/implementations/rtps/Writer.hpp>
+
+using namespace eprosima::ddsrouter;
+
+const constexpr unsigned int TEST_HISTORY_DEPTH = 5;
+const constexpr unsigned int TEST_MEMORY_BUDGET = 100;
+const constexpr unsigned int TEST_NUMBER_SAMPLES = 4 * TEST_HISTORY_DEPTH;
+
+namespace eprosima {
+namespace ddsrouter {
+namespace test {
+
+//! Write through \c writer a sample of \c size bytes from \c payload_pool
+ReturnCode write_sample(
+        IWriter& writer,
+        PayloadPool& payload_pool,
+        uint32_t size)
+{
+    std::unique_ptr<DataReceived> data = std::make_unique<DataReceived>();
+    payload_pool.get_payload(size, data->payload);
+    data->payload_owner = &payload_pool;
+    std::memset(data->payload.data, 0xAA, size);
+    data->payload.length = size;
+
+    ReturnCode ret = writer.write(data);
+
+    payload_pool.release_payload(data->payload);
+    return ret;
+}
+
+} /* namespace test */
+} /* namespace ddsrouter */
+} /* namespace eprosima */
+
+/**
+ * Test that a Writer with a bounded History keeps writing after its data have been rejected by the memory budget
+ * of its PayloadPool
+ *
+ * The data come from other pool, so the Writer copies them to its own pool.
+ *
+ * CASES:
+ *  Data over the budget are rejected, more times than changes fit in the History
+ *  Data that fit in the budget are written afterwards
+ */
+TEST(RTPSWriterTest, write_recovers_after_budget_exhausted)
+{
+    eprosima::fastrtps::rtps::RTPSParticipantAttributes participant_attributes;
+    eprosima::fastrtps::rtps::RTPSParticipant* rtps_participant =
+            eprosima::fastrtps::rtps::RTPSDomain::createParticipant(0, participant_attributes);
+    ASSERT_NE(rtps_participant, nullptr);
+
+    PayloadPoolConfiguration configuration;
+    configuration.memory_budget = TEST_MEMORY_BUDGET;
+    configuration.memory_policy = MemoryBudgetPolicy::MEMORY_REJECT;
+
+    std::shared_ptr<PayloadPool> source_pool = std::make_shared<MapPayloadPool>();
+    std::shared_ptr<PayloadPool> writer_pool = std::make_shared<MapPayloadPool>(configuration);
+
+    TopicSpecs specs;
+    specs.history_depth = TEST_HISTORY_DEPTH;
+
+    {
+        rtps::Writer writer(ParticipantId("participant"), RealTopic("topic", "type"), writer_pool, rtps_participant,
+                specs);
+        writer.enable();
+
+        // Data over the budget are rejected, more times than changes fit in the History
+        for (unsigned int i = 0; i < TEST_NUMBER_SAMPLES; ++i)
+        {
+            ASSERT_EQ(test::write_sample(writer, *source_pool, 2 * TEST_MEMORY_BUDGET), ReturnCode::RETCODE_ERROR);
+        }
+
+        // Data that fit in the budget are written afterwards
+        for (unsigned int i = 0; i < TEST_NUMBER_SAMPLES; ++i)
+        {
+            ASSERT_EQ(test::write_sample(writer, *source_pool, TEST_MEMORY_BUDGET / (2 * TEST_HISTORY_DEPTH)),
+                    ReturnCode::RETCODE_OK);
+        }
+    }
+
+    eprosima::fastrtps::rtps::RTPSDomain::removeRTPSParticipant(rtps_participant);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}